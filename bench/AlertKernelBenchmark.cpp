@@ -0,0 +1,141 @@
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <cstdint>
+
+#include "BenchmarkHarness.h"
+#include "../include/AlertKernels.h"
+
+namespace {
+
+/**
+ * @brief Evaluación lectura a lectura: bifurcaciones y mensaje armado en línea
+ *
+ * Replica la verificación de umbrales de ClimateControlService sin el
+ * seguimiento de estado, que no interviene en un reprocesamiento.
+ */
+void checkReading(float temperature, float humidity, time_t timestamp,
+                  const AlertThresholds& t, std::vector<Alert>& alerts) {
+    if (temperature > t.tempHigh) {
+        std::ostringstream msg;
+        msg << "Temperatura crítica: " << temperature << "°C";
+        alerts.push_back(Alert(0, msg.str(), temperature > t.tempCriticalHigh ? AlertSeverity::CRITICAL
+                                                                              : AlertSeverity::HIGH, timestamp));
+    } else if (temperature < t.tempLow) {
+        std::ostringstream msg;
+        msg << "Temperatura muy baja: " << temperature << "°C";
+        alerts.push_back(Alert(0, msg.str(), temperature < t.tempCriticalLow ? AlertSeverity::CRITICAL
+                                                                             : AlertSeverity::HIGH, timestamp));
+    }
+
+    if (humidity > t.humidityHigh) {
+        std::ostringstream msg;
+        msg << "Humedad muy alta: " << humidity << "%";
+        alerts.push_back(Alert(0, msg.str(), humidity > t.humidityCriticalHigh ? AlertSeverity::HIGH
+                                                                               : AlertSeverity::MEDIUM, timestamp));
+    } else if (humidity < t.humidityLow) {
+        std::ostringstream msg;
+        msg << "Humedad muy baja: " << humidity << "%";
+        alerts.push_back(Alert(0, msg.str(), humidity < t.humidityCriticalLow ? AlertSeverity::HIGH
+                                                                              : AlertSeverity::MEDIUM, timestamp));
+    }
+}
+
+} // namespace
+
+/**
+ * Benchmark de la evaluación de umbrales por lote.
+ *
+ * Genera un bloque de lecturas con una fracción fuera de rango y lo recorre
+ * repetidamente hasta sumar el total pedido. Compara la evaluación lectura
+ * a lectura con los kernels por lote (escalar, SSE2 y AVX2), tanto solo
+ * clasificando como materializando las alertas.
+ *
+ * Uso: AlertKernelBenchmark [lecturas] [porcentaje_fuera_de_rango] [tamaño_bloque]
+ */
+int main(int argc, char* argv[]) {
+    const uint64_t total = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000ULL;
+    const double outOfRangePct = argc > 2 ? std::atof(argv[2]) : 0.1;
+    const size_t blockSize = argc > 3 ? static_cast<size_t>(std::atol(argv[3])) : (1 << 22);
+    const uint64_t passes = (total + blockSize - 1) / blockSize;
+    const uint64_t samples = passes * blockSize;
+
+    std::vector<float> temperatures(blockSize);
+    std::vector<float> humidities(blockSize);
+    std::vector<int64_t> timestamps(blockSize);
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> normalTemp(17.0f, 28.0f);
+    std::uniform_real_distribution<float> normalHum(25.0f, 75.0f);
+    std::uniform_real_distribution<float> anyTemp(5.0f, 40.0f);
+    std::uniform_real_distribution<float> anyHum(0.0f, 100.0f);
+    std::uniform_real_distribution<double> pick(0.0, 100.0);
+    for (size_t i = 0; i < blockSize; ++i) {
+        bool outlier = pick(rng) < outOfRangePct;
+        temperatures[i] = outlier ? anyTemp(rng) : normalTemp(rng);
+        humidities[i] = outlier ? anyHum(rng) : normalHum(rng);
+        timestamps[i] = 1700000000 + static_cast<int64_t>(i);
+    }
+
+    const AlertThresholds thresholds;
+    std::vector<uint8_t> codes(blockSize);
+    std::vector<uint8_t> reference(blockSize);
+    std::vector<Alert> alerts;
+
+    std::cout << "\n=== BENCHMARK DE EVALUACIÓN DE UMBRALES POR LOTE ===" << std::endl;
+    std::cout << "Lecturas: " << samples << " (" << passes << " pasadas de " << blockSize
+              << "), fuera de rango: " << outOfRangePct << "%" << std::endl;
+    std::cout << "Kernel detectado: " << AlertKernels::isaName(AlertKernels::detectIsa()) << std::endl;
+
+    // Línea base: lectura a lectura
+    uint64_t baselineAlerts = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t p = 0; p < passes; ++p) {
+        alerts.clear();
+        for (size_t i = 0; i < blockSize; ++i) {
+            checkReading(temperatures[i], humidities[i], static_cast<time_t>(timestamps[i]), thresholds, alerts);
+        }
+        baselineAlerts += alerts.size();
+    }
+    double baselineSeconds = secondsSince(start);
+    std::cout << "Lectura a lectura: " << baselineSeconds << " s, "
+              << samples / baselineSeconds / 1e6 << " M lecturas/s, " << baselineAlerts << " alertas" << std::endl;
+
+    AlertKernels::evaluateWith(KernelIsa::SCALAR, temperatures.data(), humidities.data(),
+                               blockSize, thresholds, reference.data());
+
+    const KernelIsa isas[] = { KernelIsa::SCALAR, KernelIsa::SSE2, KernelIsa::AVX2 };
+    for (KernelIsa isa : isas) {
+        if (static_cast<int>(isa) > static_cast<int>(AlertKernels::detectIsa())) {
+            continue;
+        }
+        uint64_t hits = 0;
+        start = std::chrono::steady_clock::now();
+        for (uint64_t p = 0; p < passes; ++p) {
+            hits += AlertKernels::evaluateWith(isa, temperatures.data(), humidities.data(),
+                                               blockSize, thresholds, codes.data());
+        }
+        double seconds = secondsSince(start);
+        bool matches = codes == reference;
+        std::cout << "Clasificación (" << AlertKernels::isaName(isa) << "): "
+                  << seconds << " s, " << samples / seconds / 1e6 << " M lecturas/s, "
+                  << hits << " filas con alerta" << (matches ? "" : " (CÓDIGOS DISTINTOS AL ESCALAR)") << std::endl;
+    }
+
+    uint64_t kernelAlerts = 0;
+    start = std::chrono::steady_clock::now();
+    for (uint64_t p = 0; p < passes; ++p) {
+        alerts.clear();
+        kernelAlerts += AlertKernels::collectAlerts(temperatures.data(), humidities.data(), timestamps.data(),
+                                                    nullptr, blockSize, thresholds, alerts);
+    }
+    double collectSeconds = secondsSince(start);
+    std::cout << "Kernel + alertas: " << collectSeconds << " s, "
+              << samples / collectSeconds / 1e6 << " M lecturas/s, " << kernelAlerts << " alertas"
+              << (kernelAlerts == baselineAlerts ? "" : " (DISTINTO A LA LÍNEA BASE)") << std::endl;
+    std::cout << "Aceleración con alertas: " << baselineSeconds / collectSeconds << "x" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <iostream>
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+
+#include "../include/MSForecastMock.h"
+#include "../include/ClimateDataManager.h"
+#include "../include/EmailService.h"
+#include "../include/SmtpTransportMock.h"
+#include "../include/ClimateControlService.h"
+
+/**
+ * Benchmark de volumen de alertas ante un sobrecalentamiento sostenido.
+ *
+ * Simula varios racks a ~31 °C con ruido alrededor del umbral durante el
+ * tiempo indicado (una lectura por segundo y sensor) y compara la cantidad
+ * de lecturas fuera de rango con las alertas guardadas y los emails enviados.
+ *
+ * Uso: AlertStormBenchmark [sensores] [segundos]
+ */
+int main(int argc, char* argv[]) {
+    const int sensorCount = argc > 1 ? std::atoi(argv[1]) : 20;
+    const int seconds = argc > 2 ? std::atoi(argv[2]) : 3600;
+    const std::string dbPath = "output/bench_alerts.db";
+
+    std::remove(dbPath.c_str());
+    std::remove((dbPath + "-wal").c_str());
+    std::remove((dbPath + "-shm").c_str());
+
+    MSForecastMock forecast;
+    ClimateDataManager dataManager(dbPath);
+    EmailService emailService;
+    SmtpTransportMock* transport = new SmtpTransportMock(0, false);
+    emailService.setTransport(transport);
+    ClimateControlService service(&forecast, &dataManager, &emailService);
+
+    // Se silencia la consola durante la simulación
+    std::streambuf* console = std::cout.rdbuf(nullptr);
+
+    const time_t baseTime = time(nullptr) - seconds;
+    long overThreshold = 0;
+    std::srand(42);
+    for (int second = 0; second < seconds; ++second) {
+        for (int sensor = 1; sensor <= sensorCount; ++sensor) {
+            // 31 °C ± 1.5 °C: cruza el umbral de 30 °C con frecuencia
+            float temperature = 31.0f + (std::rand() % 301 - 150) / 100.0f;
+            if (temperature > 30.0f) {
+                ++overThreshold;
+            }
+            service.ingestReading(ClimateReading(0, temperature, 45.0f, baseTime + second, sensor));
+        }
+    }
+
+    std::cout.rdbuf(console);
+    std::cout.clear();
+
+    size_t storedAlerts = dataManager.forEachAlert([](const Alert&) { return true; });
+    AlertTrackerStats stats = service.getAlertStats();
+
+    std::cout << "\n=== BENCHMARK DE TORMENTA DE ALERTAS ===" << std::endl;
+    std::cout << "Sensores: " << sensorCount << ", duración simulada: " << seconds << " s" << std::endl;
+    std::cout << "Lecturas fuera de rango (alertas sin seguimiento): " << overThreshold << std::endl;
+    std::cout << "Alertas guardadas: " << storedAlerts << ", emails enviados: " << transport->getSentCount() << std::endl;
+    std::cout << "Nuevas: " << stats.raised << ", escaladas: " << stats.escalated
+              << ", recordatorios: " << stats.renotified << ", normalizadas: " << stats.cleared << std::endl;
+    std::cout << "Suprimidas: " << stats.suppressed << ", limitadas: " << stats.rateLimited << std::endl;
+    if (storedAlerts > 0) {
+        std::cout << "Reducción: " << overThreshold / static_cast<double>(storedAlerts) << "x" << std::endl;
+    }
+
+    return 0;
+}
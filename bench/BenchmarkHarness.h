@@ -0,0 +1,408 @@
+#ifndef BENCHMARKHARNESS_H
+#define BENCHMARKHARNESS_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+
+#include "../include/MSForecastMock.h"
+
+/**
+ * @brief Arnés mínimo para microbenchmarks con salida JSON
+ *
+ * Cada benchmark recibe la cantidad de iteraciones a ejecutar y las
+ * corre en un bucle propio, de modo que el arnés no agrega una llamada
+ * indirecta por operación. El arnés calibra las iteraciones hasta que una
+ * repetición dure al menos minRepetitionMs, descarta las corridas de
+ * calentamiento y reporta mínimo, mediana, media, máximo y desvío en ns
+ * por operación. La mediana es la métrica estable para comparar corridas.
+ *
+ * El JSON escribe un benchmark por línea para que los resultados de dos
+ * commits se puedan comparar con diff o con la opción --baseline.
+ */
+class BenchmarkHarness {
+public:
+    typedef std::function<void(uint64_t)> Body; ///< Ejecuta la operación medida n veces
+
+    /**
+     * @brief Configuración de una corrida
+     */
+    struct Options {
+        size_t warmupRuns;          ///< Corridas descartadas antes de medir
+        size_t repetitions;         ///< Repeticiones medidas por benchmark
+        double minRepetitionMs;     ///< Duración mínima de cada repetición
+        double maxRegressionPct;    ///< Aumento de la mediana considerado regresión
+        std::string filter;         ///< Solo benchmarks cuyo nombre contenga este texto
+        std::string jsonPath;       ///< Archivo JSON de salida (vacío = no escribir)
+        std::string baselinePath;   ///< JSON de una corrida anterior para comparar
+        std::string label;          ///< Etiqueta de la corrida (por ejemplo, el commit)
+
+        Options()
+            : warmupRuns(2), repetitions(7), minRepetitionMs(50.0), maxRegressionPct(10.0) {}
+    };
+
+    /**
+     * @brief Resultado de un benchmark en ns por operación
+     */
+    struct Result {
+        std::string name;       ///< Nombre del benchmark
+        uint64_t iterations;    ///< Iteraciones por repetición
+        size_t repetitions;     ///< Repeticiones medidas
+        double minNs;           ///< Mínimo
+        double medianNs;        ///< Mediana
+        double meanNs;          ///< Media
+        double maxNs;           ///< Máximo
+        double stddevNs;        ///< Desvío estándar
+    };
+
+private:
+    struct Entry {
+        std::string name;
+        Body body;
+    };
+
+    Options options;
+    std::vector<Entry> entries;
+    std::vector<Result> results;
+
+    static double runOnce(const Body& body, uint64_t iterations) {
+        auto start = std::chrono::steady_clock::now();
+        body(iterations);
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /**
+     * @brief Busca la cantidad de iteraciones que alcanza la duración mínima
+     */
+    uint64_t calibrate(const Body& body) const {
+        const double targetNs = options.minRepetitionMs * 1e6;
+        uint64_t iterations = 1;
+        while (true) {
+            double elapsed = runOnce(body, iterations);
+            if (elapsed >= targetNs || iterations >= (1ULL << 40)) {
+                return iterations;
+            }
+            // Crecer hacia el objetivo con margen, como máximo x10 por paso
+            double factor = elapsed > 0.0 ? targetNs * 1.2 / elapsed : 10.0;
+            factor = std::max(2.0, std::min(10.0, factor));
+            iterations = static_cast<uint64_t>(std::ceil(iterations * factor));
+        }
+    }
+
+    Result measure(const Entry& entry) const {
+        Result result;
+        result.name = entry.name;
+        result.iterations = calibrate(entry.body);
+        result.repetitions = std::max<size_t>(1, options.repetitions);
+
+        for (size_t w = 0; w < options.warmupRuns; ++w) {
+            runOnce(entry.body, result.iterations);
+        }
+
+        std::vector<double> samples;
+        samples.reserve(result.repetitions);
+        for (size_t r = 0; r < result.repetitions; ++r) {
+            samples.push_back(runOnce(entry.body, result.iterations) / result.iterations);
+        }
+        std::sort(samples.begin(), samples.end());
+
+        double sum = 0.0;
+        for (double s : samples) {
+            sum += s;
+        }
+        result.meanNs = sum / samples.size();
+        double variance = 0.0;
+        for (double s : samples) {
+            variance += (s - result.meanNs) * (s - result.meanNs);
+        }
+        result.stddevNs = std::sqrt(variance / samples.size());
+        result.minNs = samples.front();
+        result.maxNs = samples.back();
+        const size_t mid = samples.size() / 2;
+        result.medianNs = samples.size() % 2 ? samples[mid] : (samples[mid - 1] + samples[mid]) / 2.0;
+        return result;
+    }
+
+    static std::string jsonEscape(const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    static std::string utcTimestamp() {
+        time_t now = time(nullptr);
+        struct tm tmUtc;
+        gmtime_r(&now, &tmUtc);
+        char buffer[32];
+        strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", &tmUtc);
+        return buffer;
+    }
+
+    bool writeJson(const std::string& path) const {
+        std::ofstream out(path.c_str());
+        if (!out) {
+            std::cerr << "No se pudo escribir " << path << std::endl;
+            return false;
+        }
+        out << std::setprecision(6) << std::fixed;
+        out << "{\n";
+        out << "  \"schema\": 1,\n";
+        out << "  \"label\": \"" << jsonEscape(options.label) << "\",\n";
+        out << "  \"timestamp\": \"" << utcTimestamp() << "\",\n";
+#ifdef __VERSION__
+        out << "  \"compiler\": \"" << jsonEscape(__VERSION__) << "\",\n";
+#endif
+        out << "  \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ",\n";
+        out << "  \"warmup_runs\": " << options.warmupRuns << ",\n";
+        out << "  \"repetitions\": " << options.repetitions << ",\n";
+        out << "  \"min_repetition_ms\": " << options.minRepetitionMs << ",\n";
+        out << "  \"benchmarks\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            out << "    {\"name\": \"" << jsonEscape(r.name) << "\", \"iterations\": " << r.iterations
+                << ", \"repetitions\": " << r.repetitions << ", \"median_ns\": " << r.medianNs
+                << ", \"min_ns\": " << r.minNs << ", \"mean_ns\": " << r.meanNs
+                << ", \"max_ns\": " << r.maxNs << ", \"stddev_ns\": " << r.stddevNs << "}"
+                << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n";
+        out << "}\n";
+        return true;
+    }
+
+    /**
+     * @brief Lee las medianas de un JSON escrito por writeJson
+     */
+    static bool readBaseline(const std::string& path, std::vector<std::pair<std::string, double>>& medians) {
+        std::ifstream in(path.c_str());
+        if (!in) {
+            return false;
+        }
+        std::string line;
+        while (std::getline(in, line)) {
+            std::string::size_type name = line.find("\"name\": \"");
+            std::string::size_type median = line.find("\"median_ns\": ");
+            if (name == std::string::npos || median == std::string::npos) {
+                continue;
+            }
+            name += std::strlen("\"name\": \"");
+            std::string::size_type nameEnd = line.find('"', name);
+            medians.push_back(std::make_pair(line.substr(name, nameEnd - name),
+                                             std::strtod(line.c_str() + median + std::strlen("\"median_ns\": "), nullptr)));
+        }
+        return true;
+    }
+
+    /**
+     * @brief Compara las medianas con la corrida base
+     * @return Cantidad de regresiones por encima de maxRegressionPct
+     */
+    size_t compareWithBaseline() const {
+        std::vector<std::pair<std::string, double>> baseline;
+        if (!readBaseline(options.baselinePath, baseline)) {
+            std::cerr << "No se pudo leer la corrida base " << options.baselinePath << std::endl;
+            return 0;
+        }
+
+        size_t regressions = 0;
+        std::cout << "\nComparación con " << options.baselinePath << " (mediana):" << std::endl;
+        for (const Result& r : results) {
+            auto it = std::find_if(baseline.begin(), baseline.end(),
+                [&r](const std::pair<std::string, double>& b) { return b.first == r.name; });
+            if (it == baseline.end() || it->second <= 0.0) {
+                std::cout << "  " << std::left << std::setw(60) << r.name << " (nuevo)" << std::endl;
+                continue;
+            }
+            double deltaPct = (r.medianNs - it->second) / it->second * 100.0;
+            bool regression = deltaPct > options.maxRegressionPct;
+            regressions += regression;
+            std::cout << "  " << std::left << std::setw(60) << r.name << std::right << std::setw(12)
+                      << std::fixed << std::setprecision(1) << it->second << " -> " << std::setw(12)
+                      << r.medianNs << " ns  " << std::showpos << deltaPct << "%" << std::noshowpos
+                      << (regression ? "  REGRESIÓN" : "") << std::endl;
+        }
+        return regressions;
+    }
+
+public:
+    explicit BenchmarkHarness(const Options& opts = Options()) : options(opts) {}
+
+    /**
+     * @brief Interpreta los argumentos de línea de comandos
+     * @param argc Cantidad de argumentos
+     * @param argv Argumentos
+     * @param opts Opciones a completar (salida)
+     * @return false si se pidió la ayuda o hay un argumento inválido
+     */
+    static bool parseArgs(int argc, char* argv[], Options& opts) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--filter" && hasValue) {
+                opts.filter = argv[++i];
+            } else if (arg == "--json" && hasValue) {
+                opts.jsonPath = argv[++i];
+            } else if (arg == "--baseline" && hasValue) {
+                opts.baselinePath = argv[++i];
+            } else if (arg == "--label" && hasValue) {
+                opts.label = argv[++i];
+            } else if (arg == "--repetitions" && hasValue) {
+                opts.repetitions = static_cast<size_t>(std::atoi(argv[++i]));
+            } else if (arg == "--warmup" && hasValue) {
+                opts.warmupRuns = static_cast<size_t>(std::atoi(argv[++i]));
+            } else if (arg == "--min-time-ms" && hasValue) {
+                opts.minRepetitionMs = std::atof(argv[++i]);
+            } else if (arg == "--max-regression-pct" && hasValue) {
+                opts.maxRegressionPct = std::atof(argv[++i]);
+            } else {
+                std::cout << "Uso: " << argv[0] << " [--filter texto] [--json archivo] [--baseline archivo]\n"
+                          << "       [--label texto] [--repetitions n] [--warmup n] [--min-time-ms ms]\n"
+                          << "       [--max-regression-pct pct]" << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Registra un benchmark
+     * @param name Nombre estable usado para comparar corridas
+     * @param body Función que ejecuta la operación medida n veces
+     */
+    void add(const std::string& name, Body body) {
+        Entry entry = { name, body };
+        entries.push_back(entry);
+    }
+
+    /**
+     * @brief Ejecuta los benchmarks registrados que pasan el filtro
+     * @return 0 si no hubo regresiones respecto de la corrida base, 1 en caso contrario
+     */
+    int run() {
+        std::cout << std::left << std::setw(60) << "Benchmark" << std::right << std::setw(14) << "mediana ns"
+                  << std::setw(14) << "mín ns" << std::setw(12) << "desvío" << std::setw(14) << "iteraciones" << std::endl;
+
+        for (const Entry& entry : entries) {
+            if (!options.filter.empty() && entry.name.find(options.filter) == std::string::npos) {
+                continue;
+            }
+            Result r = measure(entry);
+            results.push_back(r);
+            std::cout << std::left << std::setw(60) << r.name << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(14) << r.medianNs << std::setw(14) << r.minNs << std::setw(11)
+                      << (r.meanNs > 0.0 ? r.stddevNs / r.meanNs * 100.0 : 0.0) << "%"
+                      << std::setw(14) << r.iterations << std::endl;
+        }
+
+        if (!options.jsonPath.empty() && writeJson(options.jsonPath)) {
+            std::cout << "\nResultados guardados en " << options.jsonPath << std::endl;
+        }
+        if (!options.baselinePath.empty() && compareWithBaseline() > 0) {
+            return 1;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Obtiene los resultados de la última corrida
+     * @return Resultados en orden de registro
+     */
+    const std::vector<Result>& getResults() const {
+        return results;
+    }
+
+    /**
+     * @brief Evita que el compilador descarte un valor calculado en el bucle medido
+     * @param value Valor a conservar
+     */
+    template <typename T>
+    static void doNotOptimize(const T& value) {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+};
+
+/**
+ * @brief Segundos transcurridos desde un instante
+ * @param start Instante inicial
+ * @return Segundos hasta ahora
+ */
+inline double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Elimina los segmentos de una corrida anterior
+ * @param dir Directorio del almacén
+ */
+inline void removeSegments(const std::string& dir) {
+    DIR* handle = opendir(dir.c_str());
+    if (!handle) {
+        return;
+    }
+    while (struct dirent* entry = readdir(handle)) {
+        std::string name = entry->d_name;
+        if (name != "." && name != "..") {
+            std::remove((dir + "/" + name).c_str());
+        }
+    }
+    closedir(handle);
+}
+
+/**
+ * @brief MSForecastMock con latencia fija por petición, como la API remota
+ */
+class RemoteForecastMock : public MSForecastMock {
+private:
+    int latencyMicros;
+
+    void simulateRoundTrip() const {
+        if (latencyMicros > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(latencyMicros));
+        }
+    }
+
+public:
+    explicit RemoteForecastMock(int latency) : latencyMicros(latency) {}
+
+    float readTemp() const override {
+        simulateRoundTrip();
+        return MSForecastMock::readTemp();
+    }
+
+    float readHumidity() const override {
+        simulateRoundTrip();
+        return MSForecastMock::readHumidity();
+    }
+
+    ClimateSnapshot readSnapshot() const override {
+        simulateRoundTrip();
+        return MSForecastMock::readSnapshot();
+    }
+
+    bool readSnapshots(const std::vector<int>& sensorIds,
+                       std::vector<ClimateSnapshot>& snapshots) const override {
+        simulateRoundTrip();
+        return MSForecastMock::readSnapshots(sensorIds, snapshots);
+    }
+};
+
+#endif // BENCHMARKHARNESS_H
@@ -0,0 +1,105 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include "BenchmarkHarness.h"
+#include "../include/BinaryRecordCodec.h"
+
+/**
+ * Benchmark del formato binario de registros.
+ *
+ * Codifica y decodifica un historial de lecturas y un conjunto de alertas,
+ * verifica que los valores se conserven (a centésimas) y compara los bytes
+ * por registro con la representación en memoria y con el texto de
+ * toString().
+ *
+ * Uso: BinaryRecordBenchmark [lecturas] [sensores]
+ */
+int main(int argc, char* argv[]) {
+    const long count = argc > 1 ? std::atol(argv[1]) : 1000000;
+    const int sensors = argc > 2 ? std::atoi(argv[2]) : 40;
+    const time_t baseTime = 1700000000;
+
+    std::vector<ClimateReading> readings;
+    readings.reserve(count);
+    for (long i = 0; i < count; ++i) {
+        float temperature = 23.0f + 3.0f * static_cast<float>(std::sin(i * 2.0 * M_PI / 86400.0));
+        float humidity = 50.0f + 25.0f * static_cast<float>(std::sin(i * 2.0 * M_PI / 604800.0));
+        readings.push_back(ClimateReading(0, std::round(temperature * 10) / 10, std::round(humidity * 10) / 10,
+                                          baseTime + i, static_cast<int>(i % sensors) + 1));
+    }
+
+    std::cout << "\n=== BENCHMARK DEL FORMATO BINARIO ===" << std::endl;
+
+    std::vector<uint8_t> block;
+    block.reserve(BinaryRecordCodec::HEADER_SIZE + count * BinaryRecordCodec::READING_SIZE);
+    auto start = std::chrono::steady_clock::now();
+    if (!BinaryRecordCodec::appendReadings(readings.data(), readings.size(), block)) {
+        std::cout << "No se pudo codificar el historial" << std::endl;
+        return 1;
+    }
+    double encodeSeconds = secondsSince(start);
+
+    RecordBlockReader reader(block.data(), block.size());
+    double checksum = 0;
+    long mismatches = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < reader.size(); ++i) {
+        ClimateReading decoded = reader.reading(i);
+        checksum += decoded.getTemperature();
+        if (std::fabs(decoded.getTemperature() - readings[i].getTemperature()) > 0.005f ||
+            std::fabs(decoded.getHumidity() - readings[i].getHumidity()) > 0.005f ||
+            decoded.getTimestamp() != readings[i].getTimestamp() ||
+            decoded.getSensorId() != readings[i].getSensorId()) {
+            ++mismatches;
+        }
+    }
+    double decodeSeconds = secondsSince(start);
+
+    size_t textBytes = 0;
+    for (long i = 0; i < count; i += 100) {
+        textBytes += readings[i].toString().size();
+    }
+
+    std::cout << "Lecturas: " << count << " en " << block.size() << " bytes ("
+              << static_cast<double>(block.size()) / count << " bytes/lectura)" << std::endl;
+    std::cout << "  En memoria (sizeof ClimateReading): " << sizeof(ClimateReading) << " bytes/lectura" << std::endl;
+    std::cout << "  Texto (toString): " << static_cast<double>(textBytes) / ((count + 99) / 100)
+              << " bytes/lectura" << std::endl;
+    std::cout << "  Codificación: " << encodeSeconds * 1e9 / count << " ns/lectura, decodificación: "
+              << decodeSeconds * 1e9 / count << " ns/lectura" << std::endl;
+    std::cout << "  Diferencias tras el ida y vuelta: " << mismatches << std::endl;
+
+    std::vector<Alert> alerts;
+    const AlertCode codes[] = { AlertCode::TEMPERATURE_HIGH, AlertCode::HUMIDITY_LOW, AlertCode::TEMPERATURE_NORMAL };
+    for (int i = 0; i < 10000; ++i) {
+        alerts.push_back(Alert(codes[i % 3], 31.5f + (i % 7) * 0.1f, i % sensors + 1,
+                               static_cast<AlertSeverity>(i % 4), baseTime + i * 60,
+                               static_cast<AlertNote>(i % 3)));
+    }
+    std::vector<uint8_t> alertBlock;
+    if (!BinaryRecordCodec::appendAlerts(alerts.data(), alerts.size(), alertBlock)) {
+        std::cout << "No se pudieron codificar las alertas" << std::endl;
+        return 1;
+    }
+    RecordBlockReader alertReader(alertBlock.data(), alertBlock.size());
+    size_t messageBytes = 0;
+    long alertMismatches = 0;
+    for (size_t i = 0; i < alertReader.size(); ++i) {
+        Alert decoded = alertReader.alert(i);
+        messageBytes += alerts[i].getMessage().size();
+        if (decoded.getMessage() != alerts[i].getMessage() || decoded.getSeverity() != alerts[i].getSeverity() ||
+            decoded.getTimestamp() != alerts[i].getTimestamp()) {
+            ++alertMismatches;
+        }
+    }
+    std::cout << "Alertas: " << alerts.size() << " en " << alertBlock.size() << " bytes ("
+              << static_cast<double>(alertBlock.size()) / alerts.size() << " bytes/alerta, mensaje de texto "
+              << static_cast<double>(messageBytes) / alerts.size() << " bytes de media)" << std::endl;
+    std::cout << "  Diferencias tras el ida y vuelta: " << alertMismatches << std::endl;
+
+    return checksum != 0 && mismatches == 0 && alertMismatches == 0 ? 0 : 1;
+}
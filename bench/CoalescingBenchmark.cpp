@@ -0,0 +1,135 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
+#include "../include/MSForecastMock.h"
+#include "../include/ClimateDataManager.h"
+#include "../include/EmailService.h"
+#include "../include/SmtpTransportMock.h"
+#include "../include/ClimateControlService.h"
+#include "../include/Logger.h"
+
+namespace {
+
+/**
+ * @brief Resultado de una ráfaga de comandos
+ */
+struct BurstResult {
+    double elapsedMs;           ///< Duración de la ráfaga
+    uint64_t apiRequests;       ///< Peticiones a la API (comandos y lecturas)
+    size_t storedReadings;      ///< Lecturas guardadas tras los comandos
+    CoalescerStats stats;       ///< Contadores del agrupamiento
+    bool netOk;                 ///< La temperatura y la humedad finales suman todos los deltas
+};
+
+/**
+ * @brief Envía comandos de control desde varios hilos a la vez
+ *
+ * Cada hilo alterna subidas y bajadas de 1 a 3 pasos con pausas cortas,
+ * como varios operadores o scripts ajustando la misma sala.
+ */
+BurstResult runBurst(int window, int threads, int commandsPerThread) {
+    const std::string dbPath = "output/bench_coalescing.db";
+    std::remove(dbPath.c_str());
+    std::remove((dbPath + "-wal").c_str());
+    std::remove((dbPath + "-shm").c_str());
+
+    MSForecastMock forecast;
+    ClimateDataManager dataManager(dbPath);
+    EmailService emailService;
+    emailService.setTransport(new SmtpTransportMock(0, false));
+    ClimateControlService service(&forecast, &dataManager, &emailService);
+    service.setCommandCoalesceWindow(std::chrono::milliseconds(window));
+
+    const float startTemperature = forecast.readTemp();
+    const float startHumidity = forecast.readHumidity();
+    const uint64_t requestsBefore = forecast.getRequestCount();
+    std::atomic<int> temperatureSum(0);
+    std::atomic<int> humiditySum(0);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&, t]() {
+            std::mt19937 random(1000 + t);
+            for (int i = 0; i < commandsPerThread; ++i) {
+                const int amount = 1 + static_cast<int>(random() % 3);
+                const bool up = random() % 2 == 0;
+                if (random() % 4 == 0) {
+                    if (service.controlHumidity(up ? "up" : "down", amount)) {
+                        humiditySum += up ? amount : -amount;
+                    }
+                } else if (service.controlTemperature(up ? "up" : "down", amount)) {
+                    temperatureSum += up ? amount : -amount;
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(random() % 2000));
+            }
+        }));
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    BurstResult result;
+    result.elapsedMs = std::chrono::duration<double, std::milli>(end - start).count();
+    result.apiRequests = forecast.getRequestCount() - requestsBefore;
+    result.stats = service.getCommandStats();
+    result.storedReadings = dataManager.forEachReading([](const ClimateReading&) { return true; });
+    result.netOk = std::fabs(forecast.readTemp() - (startTemperature + temperatureSum.load())) < 1e-3f &&
+                   std::fabs(forecast.readHumidity() - (startHumidity + humiditySum.load())) < 1e-3f;
+    return result;
+}
+
+void printBurst(const char* name, const BurstResult& result) {
+    std::cout << "  " << name << ": " << result.stats.submitted << " comandos en " << result.stats.batches
+              << " lotes, " << result.stats.apiCalls << " enviados a la API, " << result.stats.cancelled
+              << " cancelados" << std::endl;
+    std::cout << "    Peticiones a la API: " << result.apiRequests << ", lecturas guardadas: "
+              << result.storedReadings << ", duración: " << result.elapsedMs << " ms, delta neto "
+              << (result.netOk ? "correcto" : "INCORRECTO") << std::endl;
+}
+
+} // namespace
+
+/**
+ * Benchmark del agrupamiento de comandos de control.
+ *
+ * Varios hilos envían ráfagas de controlTemperature/controlHumidity contra
+ * el servicio, primero sin agrupar (cada comando va a la API y toma su
+ * lectura) y luego con la ventana indicada. Compara las peticiones a la
+ * API y las lecturas guardadas, y verifica que la temperatura y la
+ * humedad finales reflejen la suma de todos los comandos aceptados.
+ *
+ * Uso: CoalescingBenchmark [hilos] [comandos_por_hilo] [ventana_ms]
+ */
+int main(int argc, char* argv[]) {
+    const int threads = argc > 1 ? std::max(1, std::atoi(argv[1])) : 8;
+    const int commands = argc > 2 ? std::max(1, std::atoi(argv[2])) : 100;
+    const int window = argc > 3 ? std::max(1, std::atoi(argv[3])) : 50;
+    Logger::setLevel(LogLevel::ERROR);
+
+    std::streambuf* console = std::cout.rdbuf(nullptr);
+    BurstResult direct = runBurst(0, threads, commands);
+    BurstResult coalesced = runBurst(window, threads, commands);
+    std::cout.rdbuf(console);
+    std::cout.clear();
+
+    std::cout << "\n=== BENCHMARK DE AGRUPAMIENTO DE COMANDOS ===" << std::endl;
+    std::cout << "Hilos: " << threads << ", comandos por hilo: " << commands << std::endl;
+    printBurst("Sin agrupar", direct);
+    printBurst(("Ventana de " + std::to_string(window) + " ms").c_str(), coalesced);
+    if (coalesced.apiRequests > 0) {
+        std::cout << "Reducción de peticiones a la API: "
+                  << direct.apiRequests / static_cast<double>(coalesced.apiRequests) << "x" << std::endl;
+    }
+
+    return direct.netOk && coalesced.netOk && coalesced.apiRequests < direct.apiRequests ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+
+#include "BenchmarkHarness.h"
+#include "../include/ColumnarReadingStore.h"
+
+/**
+ * Benchmark del almacén columnar mapeado en memoria.
+ *
+ * Mide la velocidad de anexado, el tiempo de reapertura del historial y
+ * un recorrido que sólo toca la columna de temperaturas.
+ *
+ * Uso: ColumnarStoreBenchmark [total_lecturas]
+ */
+int main(int argc, char* argv[]) {
+    const long totalReadings = argc > 1 ? std::atol(argv[1]) : 10000000;
+    const std::string dir = "output/bench_columnar.columns";
+    const time_t baseTime = time(nullptr) - totalReadings;
+
+    std::system("mkdir -p output");
+    removeSegments(dir);
+
+    double appendSeconds = 0.0;
+    {
+        ColumnarReadingStore store(dir);
+        std::vector<ClimateReading> batch;
+        batch.reserve(4096);
+
+        auto start = std::chrono::steady_clock::now();
+        for (long i = 0; i < totalReadings; ++i) {
+            batch.push_back(ClimateReading(0, 22.0f + (i % 100) * 0.01f, 45.0f + (i % 50) * 0.02f, baseTime + i));
+            if (batch.size() == 4096 || i + 1 == totalReadings) {
+                store.appendBatch(batch);
+                batch.clear();
+            }
+        }
+        appendSeconds = secondsSince(start);
+    }
+
+    auto reopenStart = std::chrono::steady_clock::now();
+    ColumnarReadingStore store(dir);
+    double reopenSeconds = secondsSince(reopenStart);
+
+    auto scanStart = std::chrono::steady_clock::now();
+    double sum = 0.0;
+    uint64_t rows = 0;
+    store.forEachSegment([&](const SegmentView& view) {
+        for (size_t i = 0; i < view.count; ++i) {
+            sum += view.temperatures[i];
+        }
+        rows += view.count;
+        return true;
+    });
+    double scanSeconds = secondsSince(scanStart);
+
+    std::cout << "\n=== BENCHMARK DE ALMACÉN COLUMNAR ===" << std::endl;
+    std::cout << "Lecturas: " << rows << " en " << store.segmentCount() << " segmentos" << std::endl;
+    std::cout << "Anexado: " << static_cast<long>(totalReadings / appendSeconds) << " lecturas/s" << std::endl;
+    std::cout << "Reapertura: " << reopenSeconds * 1000.0 << " ms" << std::endl;
+    std::cout << "Recorrido de temperaturas: " << scanSeconds * 1000.0 << " ms ("
+              << (rows * sizeof(float)) / scanSeconds / 1e9 << " GB/s, promedio "
+              << (rows ? sum / rows : 0.0) << "°C)" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,191 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+#include "BenchmarkHarness.h"
+#include "../include/GorillaCodec.h"
+#include "../include/ColumnarReadingStore.h"
+
+namespace {
+
+/// Bytes lógicos de una lectura: timestamp, temperatura, humedad y sensor
+const double LOGICAL_READING_BYTES = sizeof(int64_t) + 2 * sizeof(float) + sizeof(int32_t);
+
+bool sameBits(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+} // namespace
+
+/**
+ * Benchmark de la compresión de historiales sellados.
+ *
+ * Genera un historial realista: sensores intercalados que informan cada
+ * 10 s, con la resolución de 0,1 del hardware, un ciclo diario y ruido que
+ * cambia el valor informado en una de cada diez lecturas. Mide la tasa de
+ * compresión y la velocidad de GorillaEncoder/GorillaDecoder por bloques
+ * de SEALED_BLOCK_ROWS, verifica que el ida y vuelta sea exacto bit a bit
+ * y luego repite el historial en ColumnarReadingStore (con sellado) para
+ * medir recorridos completos y consultas de 15 minutos.
+ *
+ * Uso: CompressionBenchmark [lecturas] [sensores]
+ */
+int main(int argc, char* argv[]) {
+    const long count = argc > 1 ? std::atol(argv[1]) : 10000000;
+    const int sensors = argc > 2 ? std::atoi(argv[2]) : 40;
+    const int64_t baseTime = 1700000000;
+
+    std::vector<int64_t> timestamps(count);
+    std::vector<float> temperatures(count);
+    std::vector<float> humidities(count);
+    std::vector<int32_t> sensorIds(count);
+    std::vector<float> lastTemperature(sensors, 0.0f);
+    std::vector<float> lastHumidity(sensors, 0.0f);
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> noise(-0.15f, 0.15f);
+    std::uniform_int_distribution<int> change(0, 9);
+    for (long i = 0; i < count; ++i) {
+        const int sensor = static_cast<int>(i % sensors);
+        const int64_t ts = baseTime + (i / sensors) * 10;
+        const double day = std::sin((ts % 86400) * 2.0 * M_PI / 86400.0);
+        if (i < sensors || change(random) == 0) {
+            lastTemperature[sensor] = std::round((22.0 + sensor * 0.05 + 1.5 * day + noise(random)) * 10) / 10;
+            lastHumidity[sensor] = std::round((48.0 + sensor * 0.1 - 4.0 * day + noise(random)) * 10) / 10;
+        }
+        timestamps[i] = ts;
+        temperatures[i] = lastTemperature[sensor];
+        humidities[i] = lastHumidity[sensor];
+        sensorIds[i] = sensor + 1;
+    }
+
+    std::cout << "\n=== BENCHMARK DE COMPRESIÓN DE HISTORIAL ===" << std::endl;
+    std::cout << "Lecturas: " << count << " de " << sensors << " sensores" << std::endl;
+
+    const size_t blockRows = ColumnarReadingStore::SEALED_BLOCK_ROWS;
+    std::vector<uint8_t> packed;
+    packed.reserve(count * 2);
+    std::vector<size_t> offsets;
+    auto start = std::chrono::steady_clock::now();
+    for (long begin = 0; begin < count; begin += blockRows) {
+        const long end = std::min<long>(count, begin + blockRows);
+        offsets.push_back(packed.size());
+        GorillaEncoder encoder(packed);
+        for (long i = begin; i < end; ++i) {
+            encoder.append(timestamps[i], temperatures[i], humidities[i], sensorIds[i]);
+        }
+        encoder.finish();
+    }
+    offsets.push_back(packed.size());
+    double encodeSeconds = secondsSince(start);
+
+    std::vector<int64_t> outTimestamps(blockRows);
+    std::vector<float> outTemperatures(blockRows);
+    std::vector<float> outHumidities(blockRows);
+    std::vector<int32_t> outSensors(blockRows);
+    long mismatches = 0;
+    double checksum = 0;
+    double decodeSeconds = 0;
+    for (int pass = 0; pass < 3; ++pass) {
+        start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b + 1 < offsets.size(); ++b) {
+            const size_t begin = b * blockRows;
+            const size_t rows = std::min<size_t>(blockRows, count - begin);
+            GorillaDecoder decoder(packed.data() + offsets[b], offsets[b + 1] - offsets[b], rows);
+            decoder.read(outTimestamps.data(), outTemperatures.data(), outHumidities.data(), outSensors.data(), rows);
+            checksum += outTemperatures[rows - 1];
+            if (pass == 0) {
+                for (size_t i = 0; i < rows; ++i) {
+                    if (outTimestamps[i] != timestamps[begin + i] || outSensors[i] != sensorIds[begin + i] ||
+                        !sameBits(outTemperatures[i], temperatures[begin + i]) ||
+                        !sameBits(outHumidities[i], humidities[begin + i])) {
+                        ++mismatches;
+                    }
+                }
+                mismatches += decoder.isValid() ? 0 : 1;
+            }
+        }
+        double seconds = secondsSince(start);
+        decodeSeconds = pass == 0 || seconds < decodeSeconds ? seconds : decodeSeconds;
+    }
+
+    const double logicalBytes = count * LOGICAL_READING_BYTES;
+    std::cout << "Codec: " << packed.size() << " bytes (" << static_cast<double>(packed.size()) * 8 / count
+              << " bits/lectura), tasa " << logicalBytes / packed.size() << "x" << std::endl;
+    std::cout << "  Compresión: " << encodeSeconds * 1e9 / count << " ns/lectura" << std::endl;
+    std::cout << "  Descompresión: " << decodeSeconds * 1e9 / count << " ns/lectura, "
+              << logicalBytes / decodeSeconds / 1e9 << " GB/s de lecturas lógicas" << std::endl;
+    std::cout << "  Diferencias tras el ida y vuelta: " << mismatches << std::endl;
+
+    const std::string dir = "output/bench_compression.columns";
+    std::system("mkdir -p output");
+    removeSegments(dir);
+    const size_t segmentRows = 1 << 20;
+    double appendSeconds;
+    {
+        ColumnarReadingStore store(dir, segmentRows);
+        std::vector<ClimateReading> batch;
+        batch.reserve(4096);
+        start = std::chrono::steady_clock::now();
+        for (long i = 0; i < count; ++i) {
+            batch.push_back(ClimateReading(0, temperatures[i], humidities[i], static_cast<time_t>(timestamps[i]),
+                                           sensorIds[i]));
+            if (batch.size() == 4096 || i + 1 == count) {
+                store.appendBatch(batch);
+                batch.clear();
+            }
+        }
+        appendSeconds = secondsSince(start);
+    }
+
+    ColumnarReadingStore store(dir, segmentRows);
+    const long sealedRows = static_cast<long>(store.sealedSegmentCount() * segmentRows);
+    std::cout << "Almacén: " << store.sealedSegmentCount() << " de " << store.segmentCount()
+              << " segmentos sellados, " << store.sealedBytes() << " bytes frente a "
+              << sealedRows * (LOGICAL_READING_BYTES) << " sin comprimir" << std::endl;
+    std::cout << "  Anexado con sellado: " << static_cast<long>(count / appendSeconds) << " lecturas/s" << std::endl;
+
+    long scanMismatches = 0;
+    long scanned = 0;
+    start = std::chrono::steady_clock::now();
+    store.forEachSegment([&](const SegmentView& view) {
+        const size_t first = static_cast<size_t>(view.firstId - 1);
+        for (size_t i = 0; i < view.count; ++i) {
+            if (view.timestamps[i] != timestamps[first + i] || view.sensorAt(i) != sensorIds[first + i] ||
+                !sameBits(view.temperatures[i], temperatures[first + i])) {
+                ++scanMismatches;
+            }
+        }
+        scanned += static_cast<long>(view.count);
+        return true;
+    });
+    double scanSeconds = secondsSince(start);
+    std::cout << "  Recorrido completo: " << scanSeconds * 1000 << " ms (" << scanned << " lecturas, "
+              << scanMismatches << " diferencias)" << std::endl;
+
+    const int queries = 2000;
+    const int64_t span = timestamps[count - 1] - baseTime;
+    std::mt19937 picker(7);
+    long matched = 0;
+    start = std::chrono::steady_clock::now();
+    for (int q = 0; q < queries; ++q) {
+        const int64_t from = baseTime + static_cast<int64_t>(picker() % static_cast<uint64_t>(span > 900 ? span - 900 : 1));
+        store.forEachInRange(from, from + 899, [&](const SegmentView& view, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                matched += view.timestamps[i] >= from && view.timestamps[i] <= from + 899 ? 1 : 0;
+            }
+            return true;
+        });
+    }
+    double querySeconds = secondsSince(start);
+    std::cout << "  Consultas de 15 minutos: " << querySeconds * 1e6 / queries << " us/consulta ("
+              << matched / queries << " lecturas de media)" << std::endl;
+
+    removeSegments(dir);
+    return checksum != 0 && mismatches == 0 && scanMismatches == 0 && scanned == count ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+
+#include "../include/MSForecastMock.h"
+#include "../include/ZoneController.h"
+#include "../include/Logger.h"
+
+namespace {
+
+/**
+ * @brief Resultado de una simulación fuera de línea
+ */
+struct SimulationResult {
+    double rmsError;            ///< Error cuadrático medio de temperatura en régimen, °C
+    double maxDeviation;        ///< Mayor desvío de temperatura tras la perturbación, °C
+    double humidityRmsError;    ///< Error cuadrático medio de humedad en régimen, %
+    uint64_t commands;          ///< Comandos enviados
+};
+
+/**
+ * @brief Simula una zona con paso fijo de un segundo
+ *
+ * La sala arranca en el setpoint y sin control derivaría hacia el
+ * ambiente de la planta; a la mitad de la simulación la carga de IT sube
+ * 3 °C. El error en régimen se mide en la última cuarta parte.
+ */
+SimulationResult simulate(bool controlled, ControlMode mode, long seconds) {
+    MSForecastMock room;
+    ThermalPlant plant;
+    plant.timeScale = 0.0;
+    room.enableThermalPlant(plant);
+
+    ZoneController controller;
+    ZoneConfig zone;
+    zone.forecast = &room;
+    zone.mode = mode;
+    controller.addZone(zone);
+
+    SimulationResult result = { 0.0, 0.0, 0.0, 0 };
+    long steady = 0;
+    for (long t = 0; t < seconds; ++t) {
+        if (t == seconds / 2) {
+            room.setHeatLoad(3.0f);
+        }
+        if (controlled) {
+            controller.runOnce(1.0f);
+        }
+        room.advancePlant(1.0);
+
+        ClimateSnapshot snapshot = room.readSnapshot();
+        const double error = snapshot.temperature - zone.temperatureSetpoint;
+        if (t >= seconds / 2) {
+            result.maxDeviation = std::max(result.maxDeviation, std::fabs(error));
+        }
+        if (t >= seconds * 3 / 4) {
+            const double humidityError = snapshot.humidity - zone.humiditySetpoint;
+            result.rmsError += error * error;
+            result.humidityRmsError += humidityError * humidityError;
+            ++steady;
+        }
+    }
+    result.rmsError = std::sqrt(result.rmsError / steady);
+    result.humidityRmsError = std::sqrt(result.humidityRmsError / steady);
+    result.commands = controller.getZoneStatus()[0].commands;
+    return result;
+}
+
+void printSimulation(const char* name, const SimulationResult& result) {
+    std::cout << "  " << name << ": error RMS " << result.rmsError << " °C / " << result.humidityRmsError
+              << " %, desvío máximo tras la perturbación " << result.maxDeviation << " °C, "
+              << result.commands << " comandos" << std::endl;
+}
+
+} // namespace
+
+/**
+ * Benchmark del control automático.
+ *
+ * Primero simula fuera de línea una sala con la planta térmica del mock
+ * (sin control, con PID y con todo o nada) y compara el error respecto del
+ * setpoint y el desvío ante un aumento de la carga. Luego ejecuta el lazo
+ * en su hilo a período fijo contra la planta acelerada y mide el jitter
+ * del inicio de cada iteración y su duración.
+ *
+ * Uso: ControlLoopBenchmark [segundos_simulados] [período_ms] [segundos_en_tiempo_real]
+ */
+int main(int argc, char* argv[]) {
+    const long simulated = argc > 1 ? std::atol(argv[1]) : 4 * 3600;
+    const int periodMs = argc > 2 ? std::max(1, std::atoi(argv[2])) : 10;
+    const int realSeconds = argc > 3 ? std::max(1, std::atoi(argv[3])) : 3;
+    Logger::setLevel(LogLevel::ERROR);
+
+    std::cout << "\n=== BENCHMARK DE CONTROL AUTOMÁTICO ===" << std::endl;
+    std::cout << "Simulación fuera de línea de " << simulated << " s (setpoint 22 °C / 45 %, "
+              << "ambiente 27 °C, +3 °C de carga a la mitad):" << std::endl;
+    SimulationResult open = simulate(false, ControlMode::PID, simulated);
+    SimulationResult pid = simulate(true, ControlMode::PID, simulated);
+    SimulationResult bangBang = simulate(true, ControlMode::BANG_BANG, simulated);
+    printSimulation("Sin control", open);
+    printSimulation("PID", pid);
+    printSimulation("Todo o nada", bangBang);
+
+    // Lazo real: cada iteración equivale a un segundo de la planta
+    MSForecastMock room;
+    ThermalPlant plant;
+    plant.timeScale = 1000.0 / periodMs;
+    room.enableThermalPlant(plant);
+
+    ControlLoopConfig config;
+    config.period = std::chrono::milliseconds(periodMs);
+    config.timeScale = plant.timeScale;
+    ZoneController controller(config);
+    ZoneConfig zone;
+    zone.forecast = &room;
+    controller.addZone(zone);
+
+    controller.start();
+    std::this_thread::sleep_for(std::chrono::seconds(realSeconds));
+    controller.stop();
+
+    ControlLoopStats stats = controller.getStats();
+    ZoneStatus status = controller.getZoneStatus()[0];
+    std::cout << "Lazo en tiempo real a " << periodMs << " ms durante " << realSeconds << " s:" << std::endl;
+    std::cout << "  Iteraciones: " << stats.iterations << ", períodos perdidos: " << stats.overruns << std::endl;
+    std::cout << "  Jitter: medio " << stats.meanJitterUs << " us, máximo " << stats.maxJitterUs << " us" << std::endl;
+    std::cout << "  Iteración: media " << stats.meanIterationUs << " us, máxima " << stats.maxIterationUs
+              << " us" << std::endl;
+    std::cout << "  Sala: " << status.temperature << " °C, " << status.humidity << " % tras "
+              << stats.iterations << " s simulados" << std::endl;
+
+    const bool controlOk = pid.rmsError < 0.5 && pid.rmsError < open.rmsError / 4 &&
+                           bangBang.rmsError < open.rmsError;
+    const uint64_t expected = static_cast<uint64_t>(realSeconds) * 1000 / periodMs;
+    return controlOk && stats.iterations + stats.overruns >= expected * 9 / 10 ? 0 : 1;
+}
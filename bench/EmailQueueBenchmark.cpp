@@ -0,0 +1,77 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+#include "../include/EmailService.h"
+#include "../include/SmtpTransportMock.h"
+
+/**
+ * Benchmark del envío asíncrono de alertas.
+ *
+ * Encola alertas de severidad mixta contra un servidor SMTP simulado lento
+ * y mide la latencia de encolado que ve el llamador, comparándola con el
+ * envío sincrónico de una sola alerta.
+ *
+ * Uso: EmailQueueBenchmark [alertas] [latencia_smtp_ms] [hilos] [capacidad]
+ */
+int main(int argc, char* argv[]) {
+    const int alertCount = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const int smtpLatencyMs = argc > 2 ? std::atoi(argv[2]) : 50;
+    const size_t workers = argc > 3 ? static_cast<size_t>(std::atoi(argv[3])) : 2;
+    const size_t capacity = argc > 4 ? static_cast<size_t>(std::atoi(argv[4])) : 256;
+
+    EmailService service;
+    service.setTransport(new SmtpTransportMock(smtpLatencyMs, false));
+
+    const AlertSeverity severities[] = {
+        AlertSeverity::LOW, AlertSeverity::MEDIUM, AlertSeverity::HIGH, AlertSeverity::CRITICAL
+    };
+
+    auto syncStart = std::chrono::steady_clock::now();
+    service.sendAlert(Alert("Temperatura muy alta: 31.2°C", AlertSeverity::HIGH));
+    double syncMicros = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - syncStart).count();
+
+    service.startAsync(workers, capacity, EmailOverflowPolicy::DROP_LOWEST_SEVERITY);
+
+    std::vector<Alert> alerts;
+    alerts.reserve(alertCount);
+    for (int i = 0; i < alertCount; ++i) {
+        alerts.push_back(Alert("Temperatura muy alta: 31.2°C", severities[i % 4]));
+    }
+
+    std::vector<double> latencies;
+    latencies.reserve(alertCount);
+    for (const auto& alert : alerts) {
+        auto start = std::chrono::steady_clock::now();
+        service.enqueueAlert(alert);
+        latencies.push_back(std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+
+    EmailQueueStats beforeDrain = service.getQueueStats();
+    service.stopAsync();
+    EmailQueueStats stats = service.getQueueStats();
+
+    std::sort(latencies.begin(), latencies.end());
+    double sum = 0.0;
+    for (double value : latencies) {
+        sum += value;
+    }
+
+    std::cout << "\n=== BENCHMARK DE ENVÍO ASÍNCRONO DE ALERTAS ===" << std::endl;
+    std::cout << "Alertas: " << alertCount << ", latencia SMTP: " << smtpLatencyMs
+              << " ms por email, hilos: " << workers << ", capacidad: " << capacity << std::endl;
+    std::cout << "Envío sincrónico de una alerta: " << syncMicros << " us" << std::endl;
+    std::cout << "Encolado: media " << sum / latencies.size() << " us, p50 "
+              << latencies[latencies.size() / 2] << " us, p99 "
+              << latencies[latencies.size() * 99 / 100] << " us, máx "
+              << latencies.back() << " us" << std::endl;
+    std::cout << "Pendientes al terminar de encolar: " << beforeDrain.pending << std::endl;
+    std::cout << "Encoladas: " << stats.enqueued << ", enviadas: " << stats.sent
+              << ", fallidas: " << stats.failed << ", descartadas: " << stats.dropped << std::endl;
+
+    return 0;
+}
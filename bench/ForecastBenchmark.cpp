@@ -0,0 +1,149 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <unistd.h>
+
+#include "BenchmarkHarness.h"
+#include "../include/TrendForecaster.h"
+
+namespace {
+
+/**
+ * @brief Memoria residente del proceso en bytes
+ */
+long residentBytes() {
+    std::ifstream statm("/proc/self/statm");
+    long size = 0;
+    long resident = 0;
+    statm >> size >> resident;
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+} // namespace
+
+/**
+ * Benchmark del pronóstico de cruces de umbral.
+ *
+ * Simula miles de sensores que informan cada pocos segundos con ruido y
+ * un ciclo lento; a una fracción de ellos se les "cae" el aire
+ * acondicionado y la temperatura sube a ritmo constante hasta superar el
+ * umbral alto. Mide el costo de TrendForecaster::update() por lectura, la
+ * memoria por sensor, la anticipación del aviso respecto del cruce real,
+ * los cruces sin aviso previo y los avisos en sensores estables.
+ *
+ * Uso: ForecastBenchmark [sensores] [segundos] [intervalo] [porcentaje_con_falla]
+ */
+int main(int argc, char* argv[]) {
+    const int sensors = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const long seconds = argc > 2 ? std::atol(argv[2]) : 7200;
+    const int interval = argc > 3 ? std::max(1, std::atoi(argv[3])) : 5;
+    const double failingPct = argc > 4 ? std::atof(argv[4]) : 1.0;
+    const time_t baseTime = 1700000000;
+    const float rampPerSecond = 0.5f / 60.0f;
+
+    AlertThresholds thresholds;
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> baseline(21.0f, 25.0f);
+    std::uniform_real_distribution<float> failureStart(0.25f * seconds, 0.75f * seconds);
+    std::uniform_real_distribution<double> pick(0.0, 100.0);
+    std::normal_distribution<float> noise(0.0f, 0.2f);
+
+    std::vector<float> base(sensors);
+    std::vector<long> failureAt(sensors, -1);
+    int failing = 0;
+    for (int s = 0; s < sensors; ++s) {
+        base[s] = baseline(random);
+        if (pick(random) < failingPct) {
+            failureAt[s] = static_cast<long>(failureStart(random));
+            ++failing;
+        }
+    }
+
+    std::cout << "\n=== BENCHMARK DE PRONÓSTICO DE UMBRALES ===" << std::endl;
+    std::cout << "Sensores: " << sensors << " (" << failing << " con falla de refrigeración), "
+              << seconds << " s cada " << interval << " s" << std::endl;
+
+    std::vector<long> predictedAt(sensors, -1);
+    std::vector<long> crossedAt(sensors, -1);
+    long falseAlarms = 0;
+    long updates = 0;
+    double updateSeconds = 0;
+    ThresholdCrossing crossings[TrendForecaster::MAX_CROSSINGS];
+    std::vector<ClimateReading> round;
+    round.reserve(sensors);
+    for (int s = 0; s < sensors; ++s) {
+        round.push_back(ClimateReading(0, 0.0f, 0.0f, baseTime, s + 1));
+    }
+    const long memoryBefore = residentBytes();
+    TrendForecaster forecaster;
+
+    for (long t = 0; t < seconds; t += interval) {
+        const float cycle = 0.5f * std::sin(static_cast<float>(t) * 2.0f * static_cast<float>(M_PI) / 86400.0f);
+        round.clear();
+        for (int s = 0; s < sensors; ++s) {
+            float temperature = base[s] + cycle + noise(random);
+            if (failureAt[s] >= 0 && t > failureAt[s]) {
+                temperature += rampPerSecond * static_cast<float>(t - failureAt[s]);
+            }
+            round.push_back(ClimateReading(0, temperature, 45.0f + noise(random), baseTime + t, s + 1));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& reading : round) {
+            const size_t count = forecaster.update(reading, thresholds, crossings);
+            for (size_t i = 0; i < count; ++i) {
+                const int s = reading.getSensorId() - 1;
+                if (crossings[i].metric != AlertMetric::TEMPERATURE || failureAt[s] < 0) {
+                    ++falseAlarms;
+                } else if (predictedAt[s] < 0) {
+                    predictedAt[s] = t;
+                }
+            }
+        }
+        updateSeconds += secondsSince(start);
+        updates += static_cast<long>(round.size());
+
+        for (const auto& reading : round) {
+            const int s = reading.getSensorId() - 1;
+            if (crossedAt[s] < 0 && reading.getTemperature() >= thresholds.tempHigh) {
+                crossedAt[s] = t;
+            }
+        }
+    }
+    const long memoryAfter = residentBytes();
+
+    std::vector<double> leads;
+    long missed = 0;
+    long crossed = 0;
+    for (int s = 0; s < sensors; ++s) {
+        if (crossedAt[s] < 0) {
+            continue;
+        }
+        ++crossed;
+        if (predictedAt[s] >= 0 && predictedAt[s] < crossedAt[s]) {
+            leads.push_back((crossedAt[s] - predictedAt[s]) / 60.0);
+        } else {
+            ++missed;
+        }
+    }
+    std::sort(leads.begin(), leads.end());
+
+    std::cout << "Actualización: " << updateSeconds * 1e9 / updates << " ns/lectura ("
+              << updates << " lecturas)" << std::endl;
+    std::cout << "Memoria: " << static_cast<double>(memoryAfter - memoryBefore) / forecaster.getSensorCount()
+              << " bytes/sensor (modelo y tabla de sensores)" << std::endl;
+    std::cout << "Cruces del umbral alto: " << crossed << ", avisados antes: " << leads.size()
+              << ", sin aviso previo: " << missed << std::endl;
+    if (!leads.empty()) {
+        std::cout << "Anticipación: mínima " << leads.front() << " min, mediana " << leads[leads.size() / 2]
+                  << " min, máxima " << leads.back() << " min" << std::endl;
+    }
+    std::cout << "Avisos en sensores estables: " << falseAlarms << std::endl;
+
+    return missed == 0 && falseAlarms == 0 && crossed > 0 ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../include/Logger.h"
+
+namespace {
+
+/**
+ * @brief Ejecuta la misma función en varios hilos y mide el costo por llamada
+ * @return Nanosegundos por llamada y por hilo
+ */
+template <typename Call>
+double measure(long messages, int threads, Call call) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&call, messages, threads, t]() {
+            for (long i = t; i < messages; i += threads) {
+                call(i);
+            }
+        }));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed * threads / messages;
+}
+
+} // namespace
+
+/**
+ * Benchmark del logger asíncrono.
+ *
+ * Compara el costo por mensaje en el hilo que registra de std::cout con
+ * std::endl, del logger con un nivel habilitado (sostenido y en ráfaga) y de
+ * un nivel deshabilitado (en compilación y en ejecución). La salida se
+ * descarta en /dev/null.
+ *
+ * Uso: LoggerBenchmark [mensajes] [hilos]
+ */
+int main(int argc, char* argv[]) {
+    const long messages = argc > 1 ? std::atol(argv[1]) : 1000000;
+    const int threads = argc > 2 ? std::atoi(argv[2]) : 4;
+
+    // std::cout se redirige a /dev/null a nivel de descriptor para conservar su sincronización con stdio
+    std::fflush(stdout);
+    int console = dup(STDOUT_FILENO);
+    int devNull = open("/dev/null", O_WRONLY);
+    dup2(devNull, STDOUT_FILENO);
+    double coutNs = measure(messages, threads, [](long i) {
+        std::cout << "ClimateDataManager: Insertando lectura - sensor " << i
+                  << " temperatura " << 22.5f << std::endl;
+    });
+    std::fflush(stdout);
+    dup2(console, STDOUT_FILENO);
+    close(devNull);
+    close(console);
+
+    Logger::instance().setOutputFile("/dev/null");
+
+    // Costo sostenido: se registra de a medio buffer y se vacía fuera de la medición
+    const long chunk = static_cast<long>(Logger::BUFFER_RECORDS / 2);
+    double sustainedNs = 0.0;
+    for (long done = 0; done < messages; done += chunk) {
+        auto start = std::chrono::steady_clock::now();
+        for (long i = done; i < done + chunk; ++i) {
+            LOG_INFO("ClimateDataManager", "Insertando lectura", "sensor", i, "temperature", 22.5f);
+        }
+        sustainedNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        Logger::instance().flush();
+    }
+    sustainedNs /= messages;
+
+    // Ráfaga: todos los hilos registran sin pausa; lo que no entra se descarta
+    double burstNs = measure(messages, threads, [](long i) {
+        LOG_INFO("ClimateDataManager", "Insertando lectura", "sensor", i, "temperature", 22.5f);
+    });
+    Logger::instance().flush();
+    uint64_t dropped = Logger::instance().getDroppedCount();
+
+    double compiledOutNs = measure(messages, threads, [](long i) {
+        LOG_TRACE("ClimateDataManager", "Insertando lectura", "sensor", i, "temperature", 22.5f);
+    });
+
+    Logger::setLevel(LogLevel::ERROR);
+    double runtimeOffNs = measure(messages, threads, [](long i) {
+        LOG_WARN("ClimateDataManager", "Insertando lectura", "sensor", i, "temperature", 22.5f);
+    });
+    Logger::setLevel(LogLevel::INFO);
+
+    std::cout << "\n=== BENCHMARK DEL LOGGER ===" << std::endl;
+    std::cout << "Mensajes: " << messages << ", hilos: " << threads << std::endl;
+    std::cout << "std::cout + std::endl: " << coutNs << " ns/mensaje" << std::endl;
+    std::cout << "Logger (nivel habilitado, sostenido): " << sustainedNs << " ns/mensaje" << std::endl;
+    std::cout << "Logger (nivel habilitado, ráfaga): " << burstNs << " ns/mensaje, descartados por buffer lleno: "
+              << dropped << std::endl;
+    std::cout << "Logger (deshabilitado en compilación): " << compiledOutNs << " ns/mensaje" << std::endl;
+    std::cout << "Logger (deshabilitado en ejecución): " << runtimeOffNs << " ns/mensaje" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+
+#include "../include/MetricsRegistry.h"
+#include "../include/MetricsExporter.h"
+
+namespace {
+
+double nanosPerOp(std::chrono::steady_clock::time_point start, uint64_t ops) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ops;
+}
+
+} // namespace
+
+/**
+ * Benchmark del registro de latencias.
+ *
+ * Mide el costo de LatencyHistogram::record con uno y varios hilos sobre
+ * el mismo histograma, el de ScopedLatency (que además lee el reloj dos
+ * veces) y el de generar el texto de Prometheus.
+ *
+ * Uso: MetricsBenchmark [registros_por_hilo] [hilos]
+ */
+int main(int argc, char* argv[]) {
+    const uint64_t perThread = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000000;
+    const int threads = argc > 2 ? std::atoi(argv[2]) : 4;
+
+    MetricsRegistry registry;
+    LatencyHistogram& histogram = registry.histogram("bench_latency_seconds", "Latencias sintéticas", "op=\"record\"");
+    LatencyHistogram& scoped = registry.histogram("bench_latency_seconds", "Latencias sintéticas", "op=\"scoped\"");
+
+    std::cout << "\n=== BENCHMARK DE MÉTRICAS DE LATENCIA ===" << std::endl;
+
+    // Valores entre 1 µs y ~1 ms con una cola larga
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < perThread; ++i) {
+        histogram.record(1000 + (i * 2654435761u) % 1000000);
+    }
+    std::cout << "record, 1 hilo: " << nanosPerOp(start, perThread) << " ns/registro" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&histogram, perThread, t]() {
+            for (uint64_t i = 0; i < perThread; ++i) {
+                histogram.record(1000 + ((i + t) * 2654435761u) % 1000000);
+            }
+        }));
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    std::cout << "record, " << threads << " hilos: " << nanosPerOp(start, perThread * threads)
+              << " ns/registro (tiempo total / registros)" << std::endl;
+
+    const uint64_t scopedOps = perThread / 4;
+    start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < scopedOps; ++i) {
+        ScopedLatency timer(scoped);
+    }
+    std::cout << "ScopedLatency: " << nanosPerOp(start, scopedOps) << " ns/medición" << std::endl;
+
+    HistogramSnapshot snapshot = histogram.snapshot();
+    std::cout << "Muestras: " << snapshot.count << ", p50 " << snapshot.percentile(0.5) / 1000.0
+              << " µs, p99 " << snapshot.percentile(0.99) / 1000.0 << " µs, p99.9 "
+              << snapshot.percentile(0.999) / 1000.0 << " µs, máx " << snapshot.maxNanos / 1000.0 << " µs"
+              << std::endl;
+
+    const int renders = 200;
+    size_t bytes = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < renders; ++i) {
+        bytes = registry.renderPrometheus().size();
+    }
+    std::cout << "renderPrometheus: " << nanosPerOp(start, renders) / 1000.0 << " µs (" << bytes
+              << " bytes)" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdlib>
+#include <ctime>
+#include <unistd.h>
+
+#include "BenchmarkHarness.h"
+#include "../include/MSForecastMock.h"
+#include "../include/ClimateDataManager.h"
+#include "../include/ClimateControlService.h"
+#include "../include/EmailService.h"
+#include "../include/SmtpTransportMock.h"
+#include "../include/Logger.h"
+
+namespace {
+
+const time_t BASE_TIME = 1700000000;
+
+/**
+ * @brief Carga un historial de una lectura por segundo
+ */
+void loadHistory(ClimateDataManager& manager, long rows) {
+    std::vector<ClimateReading> batch;
+    batch.reserve(8192);
+    for (long i = 0; i < rows; ++i) {
+        batch.push_back(ClimateReading(0, 22.0f + (i % 100) * 0.01f, 45.0f, BASE_TIME + i));
+        if (batch.size() == 8192 || i + 1 == rows) {
+            manager.insertReadings(batch);
+            batch.clear();
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * Suite de microbenchmarks de los componentes principales.
+ *
+ * Mide takeReading, checkAlerts, la inserción y las consultas por rango
+ * de ClimateDataManager (SQLite y columnar), el formateo de Alert y
+ * ClimateReading y el envío de una alerta a varios destinatarios. El log
+ * se limita a WARN para medir el costo propio de cada componente.
+ *
+ * Uso: MicroBenchmarks [--filter texto] [--json archivo] [--baseline archivo] [--label texto]
+ *                      [--repetitions n] [--warmup n] [--min-time-ms ms] [--max-regression-pct pct]
+ */
+int main(int argc, char* argv[]) {
+    BenchmarkHarness::Options options;
+    if (!BenchmarkHarness::parseArgs(argc, argv, options)) {
+        return 2;
+    }
+
+    Logger::setLevel(LogLevel::WARN);
+    std::system("mkdir -p output && rm -rf output/bench_micro_*");
+
+    int status = 0;
+    {
+        const long historyRows = 100000;
+        ClimateDataManager sqliteManager("output/bench_micro_sqlite.db", StorageEngine::SQLITE);
+        ClimateDataManager columnarManager("output/bench_micro_columnar.db", StorageEngine::COLUMNAR);
+        loadHistory(sqliteManager, historyRows);
+        loadHistory(columnarManager, historyRows);
+
+        MSForecastMock forecast;
+        ClimateDataManager serviceManager("output/bench_micro_service.db", StorageEngine::SQLITE);
+        EmailService serviceEmail;
+        serviceEmail.setTransport(new SmtpTransportMock(0, false));
+        ClimateControlService service(&forecast, &serviceManager, &serviceEmail);
+
+        // Escribir a disco lo cargado para que la escritura diferida no se mezcle con las mediciones
+        sync();
+
+        BenchmarkHarness harness(options);
+
+        harness.add("ClimateControlService/takeReading", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                BenchmarkHarness::doNotOptimize(service.takeReading());
+            }
+        });
+
+        harness.add("ClimateControlService/checkAlerts/in_range", [&](uint64_t n) {
+            ClimateReading reading(0, 22.0f, 45.0f, BASE_TIME, 1);
+            for (uint64_t i = 0; i < n; ++i) {
+                BenchmarkHarness::doNotOptimize(service.checkAlerts(reading));
+            }
+        });
+
+        harness.add("ClimateControlService/checkAlerts/out_of_range", [&](uint64_t n) {
+            // Tras la primera alerta el seguimiento suprime las repetidas: mide el camino habitual
+            ClimateReading reading(0, 31.5f, 85.0f, BASE_TIME, 2);
+            for (uint64_t i = 0; i < n; ++i) {
+                BenchmarkHarness::doNotOptimize(service.checkAlerts(reading));
+            }
+        });
+
+        long sqliteNext = historyRows;
+        harness.add("ClimateDataManager/insertReading/sqlite", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i, ++sqliteNext) {
+                sqliteManager.insertReading(ClimateReading(0, 22.5f, 45.0f, BASE_TIME + sqliteNext));
+            }
+        });
+
+        long columnarNext = historyRows;
+        harness.add("ClimateDataManager/insertReading/columnar", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i, ++columnarNext) {
+                columnarManager.insertReading(ClimateReading(0, 22.5f, 45.0f, BASE_TIME + columnarNext));
+            }
+        });
+
+        // Consultas de 15 minutos dentro del historial precargado
+        harness.add("ClimateDataManager/getReadingsByDateRange_15min/sqlite", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                time_t start = BASE_TIME + static_cast<time_t>((i * 7919) % (historyRows - 900));
+                BenchmarkHarness::doNotOptimize(sqliteManager.getReadingsByDateRange(start, start + 899));
+            }
+        });
+
+        harness.add("ClimateDataManager/getReadingsByDateRange_15min/columnar", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                time_t start = BASE_TIME + static_cast<time_t>((i * 7919) % (historyRows - 900));
+                BenchmarkHarness::doNotOptimize(columnarManager.getReadingsByDateRange(start, start + 899));
+            }
+        });
+
+        harness.add("Alert/toString", [&](uint64_t n) {
+            Alert alert(42, "Temperatura crítica: 31.5°C [sensor 7]", AlertSeverity::HIGH, BASE_TIME);
+            for (uint64_t i = 0; i < n; ++i) {
+                BenchmarkHarness::doNotOptimize(alert.toString());
+            }
+        });
+
+        harness.add("Alert/create/coded", [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; ++i) {
+                Alert alert(AlertCode::TEMPERATURE_HIGH, 31.5f, static_cast<int>(i & 63), AlertSeverity::HIGH,
+                            BASE_TIME, AlertNote::ESCALATED);
+                BenchmarkHarness::doNotOptimize(alert);
+            }
+        });
+
+        harness.add("Alert/renderMessage/buffer", [&](uint64_t n) {
+            Alert alert(AlertCode::TEMPERATURE_HIGH, 31.5f, 7, AlertSeverity::HIGH, BASE_TIME);
+            char text[128];
+            for (uint64_t i = 0; i < n; ++i) {
+                BenchmarkHarness::doNotOptimize(alert.renderMessage(text, sizeof(text)));
+            }
+        });
+
+        harness.add("ClimateReading/getDateTimeString", [&](uint64_t n) {
+            ClimateReading reading(1, 22.0f, 45.0f, BASE_TIME, 3);
+            for (uint64_t i = 0; i < n; ++i) {
+                BenchmarkHarness::doNotOptimize(reading.getDateTimeString());
+            }
+        });
+
+        const size_t fanouts[] = { 2, 16 };
+        for (size_t recipients : fanouts) {
+            std::shared_ptr<EmailService> email(new EmailService());
+            email->setTransport(new SmtpTransportMock(0, false));
+            std::vector<std::string> list;
+            for (size_t r = 0; r < recipients; ++r) {
+                list.push_back("oncall" + std::to_string(r) + "@empresa.com");
+            }
+            email->setRecipients(list);
+
+            harness.add("EmailService/sendAlert/fanout_" + std::to_string(recipients), [email](uint64_t n) {
+                Alert alert(7, "Humedad muy alta: 85%", AlertSeverity::MEDIUM, BASE_TIME);
+                for (uint64_t i = 0; i < n; ++i) {
+                    BenchmarkHarness::doNotOptimize(email->sendAlert(alert));
+                }
+            });
+        }
+
+        status = harness.run();
+    }
+
+    std::system("rm -rf output/bench_micro_*");
+    return status;
+}
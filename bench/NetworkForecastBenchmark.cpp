@@ -0,0 +1,180 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+
+#include "../include/MSForecastMock.h"
+#include "../include/MSForecastServer.h"
+#include "../include/MSForecastClient.h"
+#include "../include/Logger.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * @brief Resultado de una carga de lecturas
+ */
+struct LoadResult {
+    uint64_t reads;             ///< Mediciones leídas
+    uint64_t failed;            ///< Mediciones no leídas
+    double readsPerSecond;      ///< Mediciones por segundo
+    double p50Us;               ///< Mediana de la duración de una llamada
+    double p99Us;               ///< Percentil 99 de la duración de una llamada
+};
+
+/**
+ * @brief Lee desde varios hilos durante el tiempo indicado
+ * @param batch Sensores por llamada (1 = readSnapshot, más = readSnapshots encadenado)
+ */
+LoadResult runLoad(MSForecastClient& client, int threads, size_t batch, double seconds) {
+    std::atomic<uint64_t> reads(0);
+    std::atomic<uint64_t> failed(0);
+    std::vector<std::vector<double> > latencies(threads);
+    const Clock::time_point start = Clock::now();
+    const Clock::time_point end = start + std::chrono::microseconds(static_cast<long long>(seconds * 1e6));
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&, t]() {
+            std::vector<int> sensorIds;
+            for (size_t i = 0; i < batch; ++i) {
+                sensorIds.push_back(static_cast<int>(i + 1));
+            }
+            std::vector<ClimateSnapshot> snapshots;
+            uint64_t ok = 0;
+            uint64_t bad = 0;
+            while (Clock::now() < end) {
+                const Clock::time_point before = Clock::now();
+                if (batch == 1) {
+                    ClimateSnapshot snapshot = client.readSnapshot();
+                    std::isnan(snapshot.temperature) ? ++bad : ++ok;
+                } else {
+                    client.readSnapshots(sensorIds, snapshots);
+                    for (const ClimateSnapshot& snapshot : snapshots) {
+                        std::isnan(snapshot.temperature) ? ++bad : ++ok;
+                    }
+                }
+                latencies[t].push_back(std::chrono::duration<double, std::micro>(Clock::now() - before).count());
+            }
+            reads += ok;
+            failed += bad;
+        }));
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<double> all;
+    for (const std::vector<double>& samples : latencies) {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    std::sort(all.begin(), all.end());
+    LoadResult result;
+    result.reads = reads.load();
+    result.failed = failed.load();
+    result.readsPerSecond = result.reads / elapsed;
+    result.p50Us = all.empty() ? 0.0 : all[all.size() / 2];
+    result.p99Us = all.empty() ? 0.0 : all[std::min(all.size() - 1, all.size() * 99 / 100)];
+    return result;
+}
+
+void printLoad(const std::string& name, const LoadResult& result) {
+    std::cout << "  " << name << ": " << static_cast<uint64_t>(result.readsPerSecond) << " lecturas/s, llamada p50 "
+              << result.p50Us << " us, p99 " << result.p99Us << " us, fallidas " << result.failed << std::endl;
+}
+
+} // namespace
+
+/**
+ * Benchmark del cliente de red de MS-Forecast contra el servidor local.
+ *
+ * Mide lecturas por segundo sobre loopback con llamadas sincrónicas desde
+ * varios hilos (que se encadenan en las conexiones del pool) y con
+ * readSnapshots de varios sensores por escritura. Luego verifica que los
+ * comandos llegan una sola vez, que las lecturas sobreviven a respuestas
+ * perdidas gracias a los timeouts y reintentos, y que el pool se reconecta
+ * cuando el servidor se reinicia.
+ *
+ * Uso: NetworkForecastBenchmark [hilos] [sensores_por_lote] [segundos_por_carga]
+ */
+int main(int argc, char* argv[]) {
+    const int threads = argc > 1 ? std::max(1, std::atoi(argv[1])) : 32;
+    const size_t batch = argc > 2 ? static_cast<size_t>(std::max(2, std::atoi(argv[2]))) : 64;
+    const double seconds = argc > 3 ? std::max(0.1, std::atof(argv[3])) : 2.0;
+    Logger::setLevel(LogLevel::ERROR);
+
+    MSForecastMock forecast;
+    MSForecastServer server(&forecast);
+    if (!server.start(0)) {
+        std::cerr << "No se pudo iniciar el servidor local" << std::endl;
+        return 1;
+    }
+    ForecastClientConfig config;
+    config.port = server.getPort();
+    MSForecastClient client(config);
+
+    std::cout << "\n=== BENCHMARK DEL CLIENTE DE RED MS-FORECAST ===" << std::endl;
+    std::cout << "Servidor local en 127.0.0.1:" << config.port << ", pool de " << config.poolSize
+              << " conexiones" << std::endl;
+    std::cout << "Lecturas sobre loopback:" << std::endl;
+    LoadResult single = runLoad(client, 1, 1, seconds);
+    printLoad("readSnapshot, 1 hilo", single);
+    LoadResult concurrent = runLoad(client, threads, 1, seconds);
+    printLoad("readSnapshot, " + std::to_string(threads) + " hilos", concurrent);
+    LoadResult pipelined = runLoad(client, 4, batch, seconds);
+    printLoad("readSnapshots de " + std::to_string(batch) + " sensores, 4 hilos", pipelined);
+
+    // Comandos: cada uno debe aplicarse exactamente una vez
+    const float before = forecast.readTemp();
+    bool commandsOk = true;
+    for (int i = 0; i < 1000; ++i) {
+        commandsOk = (i % 2 == 0 ? client.upTemp(2) : client.downTemp(1)) && commandsOk;
+    }
+    const float expected = before + 500.0f;
+    commandsOk = commandsOk && std::fabs(forecast.readTemp() - expected) < 1e-3f;
+    std::cout << "Comandos: 1000 enviados, temperatura " << before << " -> " << forecast.readTemp()
+              << " °C (esperada " << expected << ") " << (commandsOk ? "correcto" : "INCORRECTO") << std::endl;
+
+    // Una de cada 50 respuestas se pierde: las lecturas se recuperan reintentando
+    ForecastClientConfig lossy = config;
+    lossy.attemptTimeout = std::chrono::milliseconds(20);
+    lossy.deadline = std::chrono::milliseconds(500);
+    lossy.backoffBase = std::chrono::milliseconds(1);
+    lossy.backoffMax = std::chrono::milliseconds(20);
+    MSForecastClient lossyClient(lossy);
+    ServerFaults faults;
+    faults.dropEvery = 50;
+    server.setFaults(faults);
+    LoadResult dropped = runLoad(lossyClient, 8, 1, seconds / 2);
+    server.setFaults(ServerFaults());
+    ForecastClientStats lossyStats = lossyClient.getStats();
+    ForecastServerStats serverStats = server.getStats();
+    std::cout << "Con 1 de cada 50 respuestas perdidas (intento de 20 ms):" << std::endl;
+    printLoad("readSnapshot, 8 hilos", dropped);
+    std::cout << "    Descartadas por el servidor: " << serverStats.dropped << ", timeouts: " << lossyStats.timeouts
+              << ", reintentos: " << lossyStats.retries << ", llamadas fallidas: " << lossyStats.failures << std::endl;
+
+    // Reinicio del servidor: las conexiones del pool se rompen y se reabren
+    const uint16_t port = server.getPort();
+    server.stop();
+    const bool restarted = server.start(port);
+    int recovered = 0;
+    for (int i = 0; i < 100; ++i) {
+        recovered += std::isnan(client.readSnapshot().temperature) ? 0 : 1;
+    }
+    ForecastClientStats stats = client.getStats();
+    std::cout << "Tras reiniciar el servidor: " << recovered << "/100 lecturas, " << stats.connects
+              << " conexiones abiertas en total, " << stats.retries << " reintentos" << std::endl;
+    server.stop();
+
+    const bool ok = commandsOk && restarted && recovered == 100 && dropped.failed == 0 &&
+                    single.failed == 0 && concurrent.failed == 0 && pipelined.failed == 0 &&
+                    std::max(concurrent.readsPerSecond, pipelined.readsPerSecond) >= 100000.0;
+    return ok ? 0 : 1;
+}
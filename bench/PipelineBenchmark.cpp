@@ -0,0 +1,179 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+
+#include "../include/MpscRingBuffer.h"
+#include "../include/IngestPipeline.h"
+#include "../include/AlertTracker.h"
+#include "../include/MSForecastMock.h"
+#include "../include/ClimateDataManager.h"
+#include "../include/EmailService.h"
+#include "../include/SmtpTransportMock.h"
+#include "../include/ClimateControlService.h"
+
+namespace {
+
+long totalReadings = 1000000;
+int producerCount = 4;
+size_t queueCapacity = 65536;
+size_t batchSize = 1024;
+
+/**
+ * @brief Reparte las lecturas entre los productores y ejecuta submit en paralelo
+ * @return Segundos transcurridos hasta que todos los productores terminaron
+ */
+template <typename Submit>
+double runProducers(Submit submit) {
+    const time_t baseTime = time(nullptr) - totalReadings;
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producerCount; ++p) {
+        producers.push_back(std::thread([&submit, p, baseTime]() {
+            for (long i = p; i < totalReadings; i += producerCount) {
+                float temp = 22.0f + static_cast<float>(i % 100) * 0.1f;
+                submit(ClimateReading(0, temp, 45.0f, baseTime + i, p + 1));
+            }
+        }));
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void printPipelineStats(const char* name, double seconds, const IngestPipeline::Stats& stats) {
+    std::cout << name << ": " << static_cast<long>(stats.stored / seconds) << " lecturas/s"
+              << " | lote medio " << stats.meanStorageBatch
+              << " | submit->guardado medio " << stats.meanSensorToDiskMs << " ms, máx "
+              << stats.maxSensorToDiskMs << " ms | esperas por backpressure " << stats.backpressureWaits
+              << std::endl;
+}
+
+void resetDatabase(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + "-wal").c_str());
+    std::remove((path + "-shm").c_str());
+}
+
+} // namespace
+
+/**
+ * Benchmark del pipeline de ingesta por etapas.
+ *
+ * Mide por separado la cola sin locks, la etapa de almacenamiento (SQLite)
+ * y la etapa de alertas (AlertTracker), y luego el pipeline completo de
+ * ClimateControlService, reportando la latencia submit -> guardado.
+ *
+ * Uso: PipelineBenchmark [lecturas] [productores] [capacidad] [lote]
+ */
+int main(int argc, char* argv[]) {
+    totalReadings = argc > 1 ? std::atol(argv[1]) : 1000000;
+    producerCount = argc > 2 ? std::atoi(argv[2]) : 4;
+    queueCapacity = argc > 3 ? static_cast<size_t>(std::atol(argv[3])) : 65536;
+    batchSize = argc > 4 ? static_cast<size_t>(std::atol(argv[4])) : 1024;
+    const std::string dbPath = "output/bench_pipeline.db";
+
+    std::cout << "\n=== BENCHMARK DEL PIPELINE DE INGESTA ===" << std::endl;
+    std::cout << "Lecturas: " << totalReadings << ", productores: " << producerCount
+              << ", capacidad: " << queueCapacity << ", lote: " << batchSize << std::endl;
+
+    // Etapa 0: solo la cola MPSC con un consumidor que descarta
+    {
+        MpscRingBuffer<ClimateReading> queue(queueCapacity);
+        std::atomic<bool> producing(true);
+        long consumed = 0;
+        std::thread consumer([&]() {
+            std::vector<ClimateReading> batch;
+            batch.reserve(batchSize);
+            while (producing.load() || queue.sizeApprox() > 0) {
+                batch.clear();
+                consumed += static_cast<long>(queue.popBatch(batch, batchSize));
+            }
+        });
+        double seconds = runProducers([&queue](const ClimateReading& reading) {
+            while (!queue.tryPush(reading)) {
+                std::this_thread::yield();
+            }
+        });
+        producing = false;
+        consumer.join();
+        std::cout << "Cola MPSC: " << static_cast<long>(consumed / seconds) << " lecturas/s" << std::endl;
+    }
+
+    // Etapa de almacenamiento aislada
+    {
+        resetDatabase(dbPath);
+        ClimateDataManager manager(dbPath);
+        IngestPipeline pipeline(
+            [&manager](const std::vector<ClimateReading>& batch) { return manager.insertReadings(batch); },
+            IngestPipeline::AlertStage(), queueCapacity, batchSize);
+        pipeline.start();
+        auto start = std::chrono::steady_clock::now();
+        runProducers([&pipeline](const ClimateReading& reading) { pipeline.submit(reading); });
+        pipeline.stop();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        printPipelineStats("Etapa de almacenamiento", seconds, pipeline.getStats());
+    }
+
+    // Etapa de alertas aislada (almacenamiento vacío)
+    {
+        AlertTracker tracker;
+        std::atomic<long> transitions(0);
+        IngestPipeline pipeline(
+            [](const std::vector<ClimateReading>&) { return true; },
+            [&tracker, &transitions](const std::vector<ClimateReading>& batch) {
+                for (const auto& reading : batch) {
+                    int direction = reading.getTemperature() > 30.0f ? 1 : 0;
+                    bool cleared = reading.getTemperature() <= 29.0f;
+                    if (tracker.evaluate(reading.getSensorId(), AlertMetric::TEMPERATURE, direction,
+                                         AlertSeverity::HIGH, cleared, reading.getTimestamp())
+                        != AlertTransition::NONE) {
+                        ++transitions;
+                    }
+                }
+            },
+            queueCapacity, batchSize);
+        pipeline.start();
+        auto start = std::chrono::steady_clock::now();
+        runProducers([&pipeline](const ClimateReading& reading) { pipeline.submit(reading); });
+        pipeline.stop();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        IngestPipeline::Stats stats = pipeline.getStats();
+        std::cout << "Etapa de alertas: " << static_cast<long>(stats.evaluated / seconds) << " lecturas/s"
+                  << " | transiciones " << transitions.load() << std::endl;
+    }
+
+    // Pipeline completo a través de ClimateControlService
+    {
+        resetDatabase(dbPath);
+        MSForecastMock forecast;
+        ClimateDataManager manager(dbPath);
+        EmailService emailService;
+        emailService.setTransport(new SmtpTransportMock(0, false));
+        ClimateControlService service(&forecast, &manager, &emailService);
+
+        std::streambuf* console = std::cout.rdbuf(nullptr);
+        service.enableIngestPipeline(queueCapacity, batchSize);
+        auto start = std::chrono::steady_clock::now();
+        runProducers([&service](const ClimateReading& reading) { service.ingestReading(reading); });
+        service.getIngestPipeline()->stop();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        IngestPipeline::Stats stats = service.getIngestPipeline()->getStats();
+        service.disableIngestPipeline();
+        std::cout.rdbuf(console);
+        std::cout.clear();
+
+        printPipelineStats("Pipeline completo", seconds, stats);
+    }
+
+    resetDatabase(dbPath);
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+
+#include "../include/IMSForecast.h"
+#include "../include/SensorPollingEngine.h"
+
+namespace {
+
+/**
+ * @brief Sensor simulado sin salida por consola y con latencia configurable
+ */
+class SimulatedSensor : public IMSForecast {
+private:
+    float temperature;
+    float humidity;
+    int latencyMicros;
+
+    void simulateLatency() const {
+        if (latencyMicros > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(latencyMicros));
+        }
+    }
+
+public:
+    SimulatedSensor(float temp, float hum, int latency)
+        : temperature(temp), humidity(hum), latencyMicros(latency) {}
+
+    bool upTemp(int x) override { temperature += x; return true; }
+    bool downTemp(int x) override { temperature -= x; return true; }
+    bool upHumidity(int x) override { humidity += x; return true; }
+    bool downHumidity(int x) override { humidity -= x; return true; }
+    float readTemp() const override { simulateLatency(); return temperature; }
+    float readHumidity() const override { simulateLatency(); return humidity; }
+};
+
+} // namespace
+
+/**
+ * Benchmark del motor de sondeo multi-sensor.
+ *
+ * Registra N sensores simulados, los sondea a 1 Hz durante el tiempo
+ * indicado y reporta el throughput y el atraso de entrega al sumidero.
+ *
+ * Uso: PollingBenchmark [sensores] [segundos] [hilos] [latencia_us]
+ */
+int main(int argc, char* argv[]) {
+    const int sensorCount = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const int seconds = argc > 2 ? std::atoi(argv[2]) : 10;
+    const size_t threads = argc > 3 ? static_cast<size_t>(std::atoi(argv[3])) : 0;
+    const int latencyMicros = argc > 4 ? std::atoi(argv[4]) : 0;
+
+    std::atomic<uint64_t> received(0);
+    SensorPollingEngine engine([&received](const ClimateReading&) { ++received; }, threads);
+
+    for (int i = 1; i <= sensorCount; ++i) {
+        engine.addSensor(i, new SimulatedSensor(22.0f + (i % 10) * 0.1f, 45.0f, latencyMicros));
+    }
+
+    engine.start();
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    engine.stop();
+
+    SensorPollingEngine::Stats stats = engine.getStats();
+    std::cout << "\n=== BENCHMARK DE SONDEO MULTI-SENSOR ===" << std::endl;
+    std::cout << "Sensores: " << sensorCount << " a 1 Hz durante " << seconds << " s" << std::endl;
+    std::cout << "Lecturas recibidas: " << received.load()
+              << " (" << received.load() / seconds << " lecturas/s, esperado " << sensorCount << ")" << std::endl;
+    std::cout << "Sondeos omitidos: " << stats.overruns << std::endl;
+    std::cout << "Atraso medio: " << stats.meanLagMs << " ms, máximo: " << stats.maxLagMs << " ms" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+
+#include "../include/ClimateDataManager.h"
+
+namespace {
+
+double microsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Mide consultas de 15 minutos sobre un historial de n lecturas por segundo
+ * @param rows Cantidad de lecturas del historial
+ */
+void runForSize(long rows) {
+    char path[64];
+    std::snprintf(path, sizeof(path), "output/bench_range_%ld.db", rows);
+    std::system((std::string("rm -rf ") + path + "*").c_str());
+
+    const time_t baseTime = 1700000000;
+    const time_t lastTime = baseTime + rows - 1;
+    const int queries = 1000;
+
+    {
+        ClimateDataManager loader(path, StorageEngine::COLUMNAR);
+        std::vector<ClimateReading> batch;
+        batch.reserve(8192);
+        for (long i = 0; i < rows; ++i) {
+            batch.push_back(ClimateReading(0, 22.0f + (i % 100) * 0.01f, 45.0f, baseTime + i));
+            if (batch.size() == 8192 || i + 1 == rows) {
+                loader.insertReadings(batch);
+                batch.clear();
+            }
+        }
+    }
+
+    // Se reabre para incluir la construcción diferida del índice en la primera consulta
+    ClimateDataManager manager(path, StorageEngine::COLUMNAR);
+
+    auto start = std::chrono::steady_clock::now();
+    size_t firstRows = manager.getReadingsByDateRange(lastTime - 899, lastTime).size();
+    double firstMicros = microsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    size_t lastRows = 0;
+    for (int q = 0; q < queries; ++q) {
+        lastRows += manager.getReadingsByDateRange(lastTime - 899, lastTime).size();
+    }
+    double lastMicros = microsSince(start) / queries;
+
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<long> offset(0, rows > 900 ? rows - 900 : 0);
+    start = std::chrono::steady_clock::now();
+    size_t randomRows = 0;
+    for (int q = 0; q < queries; ++q) {
+        time_t from = baseTime + offset(rng);
+        randomRows += manager.getReadingsByDateRange(from, from + 899).size();
+    }
+    double randomMicros = microsSince(start) / queries;
+
+    std::cout << "RESULTADO filas=" << rows
+              << " primera_consulta_us=" << firstMicros << " (" << firstRows << " filas)"
+              << " ultimos_15min_us=" << lastMicros << " (" << lastRows / queries << " filas)"
+              << " ventana_aleatoria_us=" << randomMicros << " (" << randomRows / queries << " filas)"
+              << std::endl;
+
+    std::system((std::string("rm -rf ") + path + "*").c_str());
+}
+
+} // namespace
+
+/**
+ * Benchmark de consultas por rango de tiempo sobre el motor columnar.
+ *
+ * Para cada tamaño de historial (una lectura por segundo) mide consultas
+ * de 15 minutos; la latencia debe depender del tamaño del resultado y no
+ * del historial.
+ *
+ * Uso: RangeQueryBenchmark [filas...]   (por defecto 1M 10M 100M)
+ */
+int main(int argc, char* argv[]) {
+    std::vector<long> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(std::atol(argv[i]));
+    }
+    if (sizes.empty()) {
+        sizes.push_back(1000000);
+        sizes.push_back(10000000);
+        sizes.push_back(100000000);
+    }
+
+    for (long rows : sizes) {
+        runForSize(rows);
+    }
+    return 0;
+}
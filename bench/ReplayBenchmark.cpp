@@ -0,0 +1,110 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+
+#include "BenchmarkHarness.h"
+#include "../include/ClimateDataManager.h"
+#include "../include/ThresholdReplayEngine.h"
+
+namespace {
+
+void report(const char* name, const ReplayResult& result) {
+    std::cout << name << ": " << result.elapsedMs << " ms, " << result.partitions << " particiones, "
+              << result.readings / (result.elapsedMs / 1000.0) / 1e6 << " M lecturas/s" << std::endl;
+    std::cout << "  Lecturas fuera de rango: " << result.readingsOutOfRange
+              << ", alertas notificadas: " << result.notifications
+              << " (nuevas " << result.transitions.raised << ", escaladas " << result.transitions.escalated
+              << ", recordatorios " << result.transitions.renotified << ", normalizadas " << result.transitions.cleared
+              << ", limitadas " << result.transitions.rateLimited << ")" << std::endl;
+}
+
+} // namespace
+
+/**
+ * Benchmark de la simulación de umbrales sobre el historial.
+ *
+ * Genera un historial columnar de una lectura por segundo para una sala
+ * (los sensores se turnan) con ciclo diario y excursiones de calor
+ * ocasionales, y lo reprocesa con los umbrales actuales y con umbrales
+ * candidatos, con un hilo y con varios.
+ *
+ * Uso: ReplayBenchmark [días] [sensores] [hilos]
+ */
+int main(int argc, char* argv[]) {
+    const long days = argc > 1 ? std::atol(argv[1]) : 365;
+    const int sensors = argc > 2 ? std::atoi(argv[2]) : 40;
+    const size_t threads = argc > 3 ? static_cast<size_t>(std::atoi(argv[3])) : 4;
+    const long rows = days * 24 * 3600;
+    const time_t baseTime = 1700000000;
+    const std::string path = "output/bench_replay.db";
+
+    std::system(("rm -rf " + path + "*").c_str());
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        ClimateDataManager loader(path, StorageEngine::COLUMNAR);
+        std::vector<ClimateReading> batch;
+        batch.reserve(8192);
+        for (long i = 0; i < rows; ++i) {
+            // Ciclo diario de ±3°C y una excursión de calor de 20 minutos cada ~3,3 días
+            float temperature = 23.0f + 3.0f * static_cast<float>(std::sin(i * 2.0 * M_PI / 86400.0));
+            if (i % 285000 < 1200) {
+                temperature += 6.5f;
+            }
+            float humidity = 50.0f + 25.0f * static_cast<float>(std::sin(i * 2.0 * M_PI / 604800.0));
+            batch.push_back(ClimateReading(0, temperature, humidity, baseTime + i,
+                                           static_cast<int>(i % sensors) + 1));
+            if (batch.size() == 8192 || i + 1 == rows) {
+                loader.insertReadings(batch);
+                batch.clear();
+            }
+        }
+    }
+    double loadSeconds = secondsSince(start);
+
+    ClimateDataManager manager(path, StorageEngine::COLUMNAR);
+
+    ReplayRequest request;
+    request.startTime = baseTime;
+    request.endTime = baseTime + rows - 1;
+    request.bucketSeconds = 24 * 3600;
+
+    std::cout << "\n=== BENCHMARK DE SIMULACIÓN DE UMBRALES ===" << std::endl;
+    std::cout << "Historial: " << rows << " lecturas (" << days << " días a 1 lectura/s, "
+              << sensors << " sensores), generado en " << loadSeconds << " s" << std::endl;
+
+    ThresholdReplayEngine single(&manager, 1);
+    ThresholdReplayEngine parallel(&manager, threads);
+
+    // Primera pasada para que los segmentos queden en la caché de páginas
+    single.replay(request);
+
+    report("Umbrales actuales, 1 hilo", single.replay(request));
+    report("Umbrales actuales, varios hilos", parallel.replay(request));
+
+    request.thresholds.tempHigh = 28.0f;
+    request.thresholds.humidityHigh = 70.0f;
+    ReplayResult candidate = parallel.replay(request);
+    report("Candidatos (28°C / 70%)", candidate);
+
+    request.applyPolicy = false;
+    report("Candidatos sin política", parallel.replay(request));
+
+    size_t busiest = 0;
+    for (size_t b = 1; b < candidate.timeline.size(); ++b) {
+        if (candidate.timeline[b].notifications > candidate.timeline[busiest].notifications) {
+            busiest = b;
+        }
+    }
+    if (!candidate.timeline.empty()) {
+        std::cout << "Día con más alertas candidatas: " << busiest << " ("
+                  << candidate.timeline[busiest].notifications << " alertas)" << std::endl;
+    }
+
+    return 0;
+}
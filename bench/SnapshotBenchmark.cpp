@@ -0,0 +1,82 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+
+#include "BenchmarkHarness.h"
+#include "../include/MSForecastMock.h"
+
+namespace {
+
+void report(const char* name, uint64_t requests, double seconds, int readings) {
+    std::cout << name << ": " << requests << " peticiones, "
+              << seconds * 1000.0 << " ms (" << (seconds * 1e6) / readings
+              << " µs por lectura)" << std::endl;
+}
+
+} // namespace
+
+/**
+ * Benchmark de las lecturas por medición instantánea y por lote.
+ *
+ * Lee una fila de racks varias veces contra una API simulada con latencia
+ * fija por petición y compara tres estrategias: dos llamadas por lectura
+ * (readTemp + readHumidity), una medición por sensor (readSnapshot) y una
+ * sola petición por fila (readSnapshots).
+ *
+ * Uso: SnapshotBenchmark [sensores_por_fila] [rondas] [latencia_us]
+ */
+int main(int argc, char* argv[]) {
+    const int rowSize = argc > 1 ? std::atoi(argv[1]) : 40;
+    const int rounds = argc > 2 ? std::atoi(argv[2]) : 25;
+    const int latencyMicros = argc > 3 ? std::atoi(argv[3]) : 200;
+    const int readings = rowSize * rounds;
+
+    std::vector<int> sensorIds;
+    for (int i = 1; i <= rowSize; ++i) {
+        sensorIds.push_back(i);
+    }
+
+    volatile float sink = 0.0f;
+
+    RemoteForecastMock split(latencyMicros);
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < rowSize; ++i) {
+            sink = split.readTemp() + split.readHumidity();
+        }
+    }
+    double splitSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    RemoteForecastMock single(latencyMicros);
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < rowSize; ++i) {
+            ClimateSnapshot snapshot = single.readSnapshot();
+            sink = snapshot.temperature + snapshot.humidity;
+        }
+    }
+    double singleSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    RemoteForecastMock batch(latencyMicros);
+    std::vector<ClimateSnapshot> snapshots;
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        batch.readSnapshots(sensorIds, snapshots);
+        for (const ClimateSnapshot& snapshot : snapshots) {
+            sink = snapshot.temperature + snapshot.humidity;
+        }
+    }
+    double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    (void)sink;
+
+    std::cout << "\n=== BENCHMARK DE LECTURAS POR MEDICIÓN Y POR LOTE ===" << std::endl;
+    std::cout << "Fila de " << rowSize << " sensores, " << rounds << " rondas, latencia "
+              << latencyMicros << " µs por petición" << std::endl;
+    report("readTemp + readHumidity", split.getRequestCount(), splitSeconds, readings);
+    report("readSnapshot          ", single.getRequestCount(), singleSeconds, readings);
+    report("readSnapshots         ", batch.getRequestCount(), batchSeconds, readings);
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+
+#include "BenchmarkHarness.h"
+#include "../include/MSForecastMock.h"
+#include "../include/ClimateDataManager.h"
+#include "../include/EmailService.h"
+#include "../include/SmtpTransportMock.h"
+#include "../include/ClimateControlService.h"
+#include "../include/Logger.h"
+
+namespace {
+
+/**
+ * @brief Resultado de una carga de consultas de estado
+ */
+struct PollResult {
+    uint64_t queries;           ///< Consultas de estado (temperatura y humedad)
+    uint64_t apiRequests;       ///< Peticiones a la API
+    double queriesPerSecond;    ///< Consultas por segundo
+};
+
+/**
+ * @brief Varios paneles consultan temperatura y humedad sin pausa
+ * @param direct true para llamar a la API como antes de la caché
+ */
+PollResult poll(ClimateControlService& service, RemoteForecastMock& forecast, bool direct,
+                int dashboards, double seconds) {
+    typedef std::chrono::steady_clock Clock;
+    std::atomic<uint64_t> queries(0);
+    const uint64_t requestsBefore = forecast.getRequestCount();
+    const Clock::time_point start = Clock::now();
+    const Clock::time_point end = start + std::chrono::microseconds(static_cast<long long>(seconds * 1e6));
+
+    std::vector<std::thread> workers;
+    for (int d = 0; d < dashboards; ++d) {
+        workers.push_back(std::thread([&]() {
+            uint64_t count = 0;
+            volatile float sink = 0.0f;
+            while (Clock::now() < end) {
+                if (direct) {
+                    sink = forecast.readTemp() + forecast.readHumidity();
+                } else {
+                    sink = service.getCurrentTemperature() + service.getCurrentHumidity();
+                }
+                ++count;
+            }
+            (void)sink;
+            queries += count;
+        }));
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    PollResult result;
+    result.queries = queries.load();
+    result.apiRequests = forecast.getRequestCount() - requestsBefore;
+    result.queriesPerSecond = result.queries / std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+void printPoll(const std::string& name, const PollResult& result) {
+    std::cout << "  " << name << ": " << static_cast<uint64_t>(result.queriesPerSecond) << " consultas/s, "
+              << result.apiRequests << " peticiones a la API ("
+              << (result.apiRequests ? result.queries / static_cast<double>(result.apiRequests) : 0.0)
+              << " consultas por petición)" << std::endl;
+}
+
+} // namespace
+
+/**
+ * Benchmark de la caché de mediciones de las consultas de estado.
+ *
+ * Varios paneles consultan sin pausa la temperatura y la humedad actuales
+ * contra una API simulada con latencia: llamando a la API directamente
+ * (como antes de la caché), con vigencia cero (sólo se comparten las
+ * consultas en curso) y con la vigencia indicada. Luego verifica que una
+ * lectura tomada actualiza la caché sin otra petición.
+ *
+ * Uso: StatusCacheBenchmark [paneles] [latencia_us] [vigencia_ms] [segundos_por_carga]
+ */
+int main(int argc, char* argv[]) {
+    const int dashboards = argc > 1 ? std::max(1, std::atoi(argv[1])) : 16;
+    const int latency = argc > 2 ? std::max(0, std::atoi(argv[2])) : 500;
+    const int ttl = argc > 3 ? std::max(1, std::atoi(argv[3])) : 1000;
+    const double seconds = argc > 4 ? std::max(0.1, std::atof(argv[4])) : 2.0;
+    const std::string dbPath = "output/bench_status_cache.db";
+    Logger::setLevel(LogLevel::ERROR);
+
+    std::remove(dbPath.c_str());
+    std::remove((dbPath + "-wal").c_str());
+    std::remove((dbPath + "-shm").c_str());
+
+    RemoteForecastMock forecast(latency);
+    ClimateDataManager dataManager(dbPath);
+    EmailService emailService;
+    emailService.setTransport(new SmtpTransportMock(0, false));
+    ClimateControlService service(&forecast, &dataManager, &emailService);
+
+    std::streambuf* console = std::cout.rdbuf(nullptr);
+    PollResult direct = poll(service, forecast, true, dashboards, seconds);
+    service.setSnapshotCacheTtl(std::chrono::milliseconds(0));
+    PollResult singleFlight = poll(service, forecast, false, dashboards, seconds);
+    service.setSnapshotCacheTtl(std::chrono::milliseconds(ttl));
+    PollResult cached = poll(service, forecast, false, dashboards, seconds);
+
+    // Una lectura tomada deja la medición en la caché: la consulta siguiente no va a la API
+    forecast.upTemp(3);
+    const uint64_t requestsBefore = forecast.getRequestCount();
+    ClimateReading reading = service.takeReading();
+    const float current = service.getCurrentTemperature();
+    const uint64_t requestsAfter = forecast.getRequestCount();
+    std::cout.rdbuf(console);
+    std::cout.clear();
+
+    const bool refreshed = requestsAfter - requestsBefore == 1 && current == reading.getTemperature();
+    SnapshotCacheStats stats = service.getSnapshotCacheStats();
+
+    std::cout << "\n=== BENCHMARK DE CACHÉ DE MEDICIONES ===" << std::endl;
+    std::cout << "Paneles: " << dashboards << ", latencia de la API: " << latency << " us" << std::endl;
+    printPoll("Sin caché", direct);
+    printPoll("Vigencia 0 (consultas en curso compartidas)", singleFlight);
+    printPoll("Vigencia " + std::to_string(ttl) + " ms", cached);
+    std::cout << "Caché: " << stats.hits << " aciertos, " << stats.loads << " consultas a la API, "
+              << stats.shared << " compartidas, " << stats.stores << " guardadas por lecturas" << std::endl;
+    std::cout << "takeReading actualiza la caché: " << (refreshed ? "sí" : "NO") << " (" << current
+              << " °C, " << requestsAfter - requestsBefore << " petición)" << std::endl;
+
+    return refreshed && singleFlight.apiRequests < direct.apiRequests && cached.apiRequests < singleFlight.apiRequests
+        ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+
+#include "../include/ClimateDataManager.h"
+
+/**
+ * Benchmark de ingesta sostenida en ClimateDataManager.
+ *
+ * Inserta lecturas en lotes (una transacción por lote) mientras un hilo
+ * lector ejecuta consultas de "últimos 15 minutos" de forma continua.
+ *
+ * Uso: StorageBenchmark [total_lecturas] [tamaño_lote]
+ */
+int main(int argc, char* argv[]) {
+    const long totalReadings = argc > 1 ? std::atol(argv[1]) : 1000000;
+    const long batchSize = argc > 2 ? std::atol(argv[2]) : 1000;
+    const std::string dbPath = "output/bench_storage.db";
+
+    std::remove(dbPath.c_str());
+    std::remove((dbPath + "-wal").c_str());
+    std::remove((dbPath + "-shm").c_str());
+
+    ClimateDataManager manager(dbPath);
+    if (!manager.isConnected()) {
+        std::cout << "No se pudo abrir la base de datos de benchmark" << std::endl;
+        return 1;
+    }
+
+    const time_t baseTime = time(nullptr) - totalReadings;
+    std::atomic<long> lastTimestamp(baseTime);
+    std::atomic<bool> running(true);
+    std::atomic<long> queries(0);
+    std::atomic<long> rowsReturned(0);
+
+    // Lector concurrente: consulta los últimos 15 minutos ingresados
+    std::thread reader([&]() {
+        while (running.load()) {
+            time_t end = lastTimestamp.load();
+            std::vector<ClimateReading> rows = manager.getReadingsByDateRange(end - 900, end);
+            rowsReturned += static_cast<long>(rows.size());
+            ++queries;
+        }
+    });
+
+    std::vector<ClimateReading> batch;
+    batch.reserve(batchSize);
+
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < totalReadings; ++i) {
+        float temp = 22.0f + static_cast<float>(i % 100) * 0.01f;
+        float hum = 45.0f + static_cast<float>(i % 50) * 0.02f;
+        batch.push_back(ClimateReading(0, temp, hum, baseTime + i));
+
+        if (static_cast<long>(batch.size()) == batchSize || i + 1 == totalReadings) {
+            if (!manager.insertReadings(batch)) {
+                std::cout << "Error al insertar lote" << std::endl;
+                running = false;
+                reader.join();
+                return 1;
+            }
+            lastTimestamp = baseTime + i;
+            batch.clear();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    running = false;
+    reader.join();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "\n=== BENCHMARK DE ALMACENAMIENTO ===" << std::endl;
+    std::cout << "Lecturas insertadas: " << totalReadings << std::endl;
+    std::cout << "Tamaño de lote: " << batchSize << std::endl;
+    std::cout << "Tiempo total: " << seconds << " s" << std::endl;
+    std::cout << "Ingesta: " << static_cast<long>(totalReadings / seconds) << " lecturas/s" << std::endl;
+    std::cout << "Consultas concurrentes: " << queries.load()
+              << " (" << static_cast<long>(queries.load() / seconds) << " consultas/s, "
+              << rowsReturned.load() << " filas)" << std::endl;
+
+    return 0;
+}
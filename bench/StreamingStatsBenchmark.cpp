@@ -0,0 +1,121 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+#include "BenchmarkHarness.h"
+#include "../include/StreamingStats.h"
+
+namespace {
+
+/**
+ * @brief Rango normalizado de un valor dentro de valores ordenados
+ */
+double rankOf(const std::vector<float>& sorted, float value) {
+    return static_cast<double>(std::upper_bound(sorted.begin(), sorted.end(), value) - sorted.begin()) / sorted.size();
+}
+
+} // namespace
+
+/**
+ * Benchmark de las estadísticas en streaming.
+ *
+ * Agrega un día de lecturas por segundo de varios sensores a
+ * ReadingStatistics y mide el costo por lectura, el error de rango de los
+ * cuantiles frente a ordenar todos los valores, la media y la varianza
+ * frente a dos pasadas exactas, y el costo de consultar las últimas 24
+ * horas y de combinar todos los sensores. El cálculo exacto equivale a lo
+ * que había que hacer antes: traer el historial completo.
+ *
+ * Uso: StreamingStatsBenchmark [sensores] [segundos]
+ */
+int main(int argc, char* argv[]) {
+    const int sensors = argc > 1 ? std::atoi(argv[1]) : 40;
+    const long seconds = argc > 2 ? std::atol(argv[2]) : 86400;
+    const time_t baseTime = 1699999200; // alineado a la hora: el día ocupa 24 ventanas
+    const long count = sensors * seconds;
+
+    std::vector<ClimateReading> readings;
+    readings.reserve(count);
+    std::mt19937 random(42);
+    std::normal_distribution<float> noise(0.0f, 0.4f);
+    for (long t = 0; t < seconds; ++t) {
+        const double day = std::sin(t * 2.0 * M_PI / 86400.0);
+        for (int s = 0; s < sensors; ++s) {
+            float temperature = static_cast<float>(22.0 + 0.05 * s + 2.0 * day) + noise(random);
+            float humidity = static_cast<float>(50.0 - 5.0 * day) + 2.0f * noise(random);
+            readings.push_back(ClimateReading(0, temperature, humidity, baseTime + t, s + 1));
+        }
+    }
+
+    std::cout << "\n=== BENCHMARK DE ESTADÍSTICAS EN STREAMING ===" << std::endl;
+    std::cout << "Lecturas: " << count << " (" << sensors << " sensores, " << seconds << " s)" << std::endl;
+
+    ReadingStatistics stats;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& reading : readings) {
+        stats.add(reading);
+    }
+    double addSeconds = secondsSince(start);
+    std::cout << "Agregado: " << addSeconds * 1e9 / count << " ns/lectura" << std::endl;
+
+    const time_t last = baseTime + seconds - 1;
+    const int queries = 200;
+    MetricStatistics day(QuantileSketch::DEFAULT_K);
+    start = std::chrono::steady_clock::now();
+    for (int q = 0; q < queries; ++q) {
+        day = stats.range(AlertMetric::TEMPERATURE, last - 86399, last);
+    }
+    double rangeSeconds = secondsSince(start) / queries;
+
+    std::vector<int> ids = stats.sensorIds();
+    start = std::chrono::steady_clock::now();
+    MetricStatistics combined(QuantileSketch::DEFAULT_K);
+    for (int q = 0; q < queries; ++q) {
+        combined = stats.combine(AlertMetric::TEMPERATURE, ids);
+    }
+    double combineSeconds = secondsSince(start) / queries;
+
+    start = std::chrono::steady_clock::now();
+    std::vector<float> exact;
+    exact.reserve(count);
+    double sum = 0;
+    for (const auto& reading : readings) {
+        exact.push_back(reading.getTemperature());
+        sum += reading.getTemperature();
+    }
+    std::sort(exact.begin(), exact.end());
+    const double exactMean = sum / count;
+    double squares = 0;
+    for (float value : exact) {
+        squares += (value - exactMean) * (value - exactMean);
+    }
+    const double exactVariance = squares / count;
+    double exactSeconds = secondsSince(start);
+
+    std::cout << "Consulta de 24 horas (todos los sensores): " << rangeSeconds * 1e6 << " us, "
+              << "combinación de " << ids.size() << " sensores: " << combineSeconds * 1e6 << " us" << std::endl;
+    std::cout << "Cálculo exacto sobre el historial: " << exactSeconds * 1e3 << " ms" << std::endl;
+    std::cout << "Media: " << day.mean() << " (exacta " << exactMean << "), varianza: " << day.variance()
+              << " (exacta " << exactVariance << ")" << std::endl;
+
+    const double quantiles[] = { 0.01, 0.1, 0.5, 0.9, 0.95, 0.99 };
+    double worstError = 0;
+    for (double q : quantiles) {
+        const double errorDay = std::fabs(rankOf(exact, day.quantile(q)) - q);
+        const double errorCombined = std::fabs(rankOf(exact, combined.quantile(q)) - q);
+        worstError = std::max(worstError, std::max(errorDay, errorCombined));
+        std::cout << "  p" << q * 100 << ": " << day.quantile(q) << " (exacto "
+                  << exact[std::min<size_t>(exact.size() - 1, static_cast<size_t>(q * exact.size()))]
+                  << ", error de rango " << errorDay * 100 << "% / combinado " << errorCombined * 100 << "%)"
+                  << std::endl;
+    }
+    std::cout << "Peor error de rango: " << worstError * 100 << "%" << std::endl;
+
+    const bool momentsOk = std::fabs(day.mean() - exactMean) < 1e-6 * std::fabs(exactMean) + 1e-9 &&
+                           std::fabs(day.variance() - exactVariance) < 1e-6 * exactVariance + 1e-9;
+    return momentsOk && worstError < 0.03 && day.count() == static_cast<uint64_t>(count) ? 0 : 1;
+}
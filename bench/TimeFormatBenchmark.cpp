@@ -0,0 +1,100 @@
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+
+#include "BenchmarkHarness.h"
+#include "../include/TimeFormatter.h"
+#include "../include/ClimateReading.h"
+
+namespace {
+
+/**
+ * @brief Formateo anterior: localtime + put_time sobre un ostringstream
+ */
+std::string legacyDateTime(time_t timestamp) {
+    std::ostringstream oss;
+    struct tm* timeinfo = localtime(&timestamp);
+    oss << std::put_time(timeinfo, "%Y-%m-%d %H:%M:%S");
+    return oss.str();
+}
+
+} // namespace
+
+/**
+ * Benchmark del formateo de fechas.
+ *
+ * Formatea un historial de lecturas consecutivas (una por segundo) con el
+ * método anterior y con TimeFormatter, verifica que ambos produzcan el
+ * mismo texto (incluidos los cambios de horario de verano de la zona TZ
+ * configurada) y mide ClimateReading::toString con varios hilos.
+ *
+ * Uso: TimeFormatBenchmark [lecturas] [hilos] [inicio_epoch]
+ */
+int main(int argc, char* argv[]) {
+    const long readings = argc > 1 ? std::atol(argv[1]) : 1000000;
+    const int threads = argc > 2 ? std::atoi(argv[2]) : 4;
+    const time_t baseTime = argc > 3 ? static_cast<time_t>(std::atoll(argv[3])) : 1700000000;
+
+    std::cout << "\n=== BENCHMARK DE FORMATEO DE FECHAS ===" << std::endl;
+    std::cout << "Historial: " << readings << " lecturas consecutivas desde " << baseTime << std::endl;
+
+    size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < readings; ++i) {
+        checksum += legacyDateTime(baseTime + i).size();
+    }
+    double legacySeconds = secondsSince(start);
+    std::cout << "localtime + put_time: " << legacySeconds * 1000 << " ms" << std::endl;
+
+    char buffer[TimeFormatter::BUFFER_SIZE];
+    start = std::chrono::steady_clock::now();
+    for (long i = 0; i < readings; ++i) {
+        checksum += TimeFormatter::formatDateTime(baseTime + i, buffer);
+    }
+    double cachedSeconds = secondsSince(start);
+    std::cout << "TimeFormatter (buffer): " << cachedSeconds * 1000 << " ms ("
+              << legacySeconds / cachedSeconds << "x)" << std::endl;
+
+    // Lecturas desordenadas: cada una cae en un minuto distinto
+    start = std::chrono::steady_clock::now();
+    for (long i = 0; i < readings; ++i) {
+        checksum += TimeFormatter::formatDateTime(baseTime + (i * 7919) % (readings * 60), buffer);
+    }
+    std::cout << "TimeFormatter (minutos al azar): " << secondsSince(start) * 1000 << " ms" << std::endl;
+
+    long mismatches = 0;
+    for (long i = 0; i < readings; ++i) {
+        if (TimeFormatter::dateTime(baseTime + i) != legacyDateTime(baseTime + i)) {
+            if (mismatches++ == 0) {
+                std::cout << "Diferencia en " << baseTime + i << ": " << TimeFormatter::dateTime(baseTime + i)
+                          << " vs " << legacyDateTime(baseTime + i) << std::endl;
+            }
+        }
+    }
+    std::cout << "Diferencias con el método anterior: " << mismatches << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    std::vector<size_t> lengths(threads, 0);
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&lengths, t, threads, readings, baseTime]() {
+            for (long i = t; i < readings; i += threads) {
+                ClimateReading reading(static_cast<int>(i), 22.5f, 45.0f, baseTime + i, 7);
+                lengths[t] += reading.toString().size();
+            }
+        }));
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    std::cout << "ClimateReading::toString, " << threads << " hilos: " << secondsSince(start) * 1000
+              << " ms" << std::endl;
+
+    return checksum == 0 || mismatches != 0 ? 1 : 0;
+}
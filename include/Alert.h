@@ -3,6 +3,8 @@
 
 #include <string>
 #include <ctime>
+#include <cstdint>
+#include <cstddef>
 
 /**
  * @brief Enum para los niveles de severidad de las alertas
@@ -14,18 +16,60 @@ enum class AlertSeverity {
     CRITICAL    ///< Severidad crítica
 };
 
+/**
+ * @brief Código del mensaje de una alerta
+ * 
+ * Identifica la plantilla (AlertTemplates) del texto de las alertas
+ * generadas por el sistema sin tener que guardarlo. Los valores forman
+ * parte del formato binario (BinaryRecordCodec) y de la base de datos: no
+ * deben reutilizarse ni renumerarse. Los códigos desde
+ * AlertTemplates::FIRST_INTERNED_CODE son plantillas registradas en
+ * ejecución.
+ */
+enum class AlertCode : uint16_t {
+    CUSTOM = 0,                 ///< Texto libre (sin código)
+    TEMPERATURE_HIGH = 1,       ///< Temperatura por encima del umbral
+    TEMPERATURE_LOW = 2,        ///< Temperatura por debajo del umbral
+    TEMPERATURE_NORMAL = 3,     ///< Temperatura de vuelta en rango
+    HUMIDITY_HIGH = 4,          ///< Humedad por encima del umbral
+    HUMIDITY_LOW = 5,           ///< Humedad por debajo del umbral
+    HUMIDITY_NORMAL = 6,        ///< Humedad de vuelta en rango
+    TEMPERATURE_HIGH_PREDICTED = 7, ///< Temperatura que superará el umbral alto (valor en minutos)
+    TEMPERATURE_LOW_PREDICTED = 8,  ///< Temperatura que bajará del umbral bajo (valor en minutos)
+    HUMIDITY_HIGH_PREDICTED = 9,    ///< Humedad que superará el umbral alto (valor en minutos)
+    HUMIDITY_LOW_PREDICTED = 10     ///< Humedad que bajará del umbral bajo (valor en minutos)
+};
+
+/**
+ * @brief Aclaración agregada al mensaje de una alerta con código
+ */
+enum class AlertNote : uint8_t {
+    NONE = 0,           ///< Sin aclaración
+    ESCALATED = 1,      ///< " (escalada)"
+    PERSISTENT = 2      ///< " (persistente)"
+};
+
 /**
  * @brief Clase que representa una alerta del sistema
  * 
  * Esta clase encapsula los datos de una alerta generada
  * por el sistema de control de clima del datacenter.
+ * 
+ * Las alertas con código guardan sólo la plantilla (AlertTemplates) y sus
+ * parámetros: crearlas no reserva memoria y el texto se arma recién
+ * cuando se muestra o se envía. Las alertas de texto libre (CUSTOM)
+ * guardan el mensaje tal cual.
  */
 class Alert {
 private:
+    std::string message;        ///< Mensaje de las alertas de texto libre (vacío si tiene código)
+    time_t timestamp;           ///< Timestamp de la alerta
     int id;                     ///< Identificador único de la alerta
-    std::string message;        ///< Mensaje descriptivo de la alerta
+    int sensorId;               ///< Sensor que originó la alerta (0 = sensor por defecto)
+    float value;                ///< Valor medido que originó la alerta
     AlertSeverity severity;     ///< Nivel de severidad de la alerta
-    time_t timestamp;           ///< Timestamp de la alerta
+    AlertCode code;             ///< Plantilla del mensaje (CUSTOM = texto libre)
+    AlertNote note;             ///< Aclaración del mensaje con código
 
 public:
     /**
@@ -49,11 +93,35 @@ public:
      */
     Alert(int id, const std::string& msg, AlertSeverity sev, time_t ts);
     
+    /**
+     * @brief Constructor de una alerta con código
+     * @param alertCode Código del mensaje
+     * @param measured Valor medido
+     * @param sensor Sensor que originó la alerta
+     * @param sev Nivel de severidad
+     * @param ts Timestamp de la alerta
+     * @param alertNote Aclaración del mensaje
+     */
+    Alert(AlertCode alertCode, float measured, int sensor, AlertSeverity sev, time_t ts,
+          AlertNote alertNote = AlertNote::NONE);
+    
     // Getters
     int getId() const;
     std::string getMessage() const;
+    
+    /**
+     * @brief Escribe el mensaje en un buffer sin reservar memoria
+     * @param buffer Buffer de destino (queda terminado en '\0' si size > 0)
+     * @param size Tamaño del buffer
+     * @return Largo del mensaje completo; si es mayor o igual a size, el texto se truncó
+     */
+    size_t renderMessage(char* buffer, size_t size) const;
     AlertSeverity getSeverity() const;
     time_t getTimestamp() const;
+    AlertCode getCode() const;
+    AlertNote getNote() const;
+    int getSensorId() const;
+    float getValue() const;
     
     // Setters
     void setId(int id);
@@ -78,6 +146,17 @@ public:
      * @return String con la fecha y hora formateada
      */
     std::string getDateTimeString() const;
+    
+    /**
+     * @brief Arma el texto de una alerta con código
+     * @param alertCode Plantilla del mensaje (CUSTOM devuelve cadena vacía)
+     * @param measured Valor medido
+     * @param sensor Sensor (0 = no se menciona)
+     * @param alertNote Aclaración del mensaje
+     * @return Texto de la alerta, por ejemplo "Temperatura crítica: 31.5°C (escalada) [sensor 7]"
+     */
+    static std::string renderMessage(AlertCode alertCode, float measured, int sensor,
+                                     AlertNote alertNote = AlertNote::NONE);
 };
 
 #endif // ALERT_H 
\ No newline at end of file
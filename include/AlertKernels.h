@@ -0,0 +1,175 @@
+#ifndef ALERTKERNELS_H
+#define ALERTKERNELS_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Alert.h"
+
+/**
+ * @brief Umbrales usados para clasificar lecturas
+ *
+ * Una temperatura por encima de tempHigh (o por debajo de tempLow) es
+ * HIGH, y CRITICAL si además supera tempCriticalHigh (o queda por debajo
+ * de tempCriticalLow). La humedad es MEDIUM fuera de rango y HIGH en la
+ * banda crítica.
+ */
+struct AlertThresholds {
+    float tempHigh;             ///< Umbral alto de temperatura
+    float tempLow;              ///< Umbral bajo de temperatura
+    float tempCriticalHigh;     ///< Temperatura alta crítica
+    float tempCriticalLow;      ///< Temperatura baja crítica
+    float humidityHigh;         ///< Umbral alto de humedad
+    float humidityLow;          ///< Umbral bajo de humedad
+    float humidityCriticalHigh; ///< Humedad alta crítica
+    float humidityCriticalLow;  ///< Humedad baja crítica
+
+    /**
+     * @brief Constructor con los umbrales por defecto del sistema
+     */
+    AlertThresholds();
+};
+
+/**
+ * @brief Conjunto de instrucciones usado por los kernels
+ */
+enum class KernelIsa {
+    SCALAR,     ///< Implementación portable
+    SSE2,       ///< 4 lecturas por iteración
+    AVX2        ///< 8 lecturas por iteración
+};
+
+/**
+ * @brief Kernels de evaluación de umbrales sobre columnas de lecturas
+ *
+ * Clasifican arreglos de temperaturas y humedades sin bifurcaciones y
+ * producen un código de severidad de un byte por fila. Solo las filas con
+ * código distinto de cero se materializan como objetos Alert, de modo que
+ * reprocesar historiales grandes no construye mensajes para lecturas
+ * normales. La variante SIMD se elige en tiempo de ejecución según la CPU.
+ *
+ * Formato del código: los bits 0-2 corresponden a la temperatura y los
+ * bits 3-5 a la humedad. En cada grupo, los bits bajos indican el nivel
+ * (0 = en rango, 1 = fuera de rango, 2 = banda crítica) y el tercer bit
+ * indica que el desvío es hacia arriba.
+ */
+class AlertKernels {
+public:
+    static const uint8_t LEVEL_MASK = 0x3;      ///< Bits de nivel dentro de un grupo
+    static const uint8_t ABOVE_BIT = 0x4;       ///< Bit de desvío hacia arriba
+    static const int HUMIDITY_SHIFT = 3;        ///< Desplazamiento del grupo de humedad
+
+    /**
+     * @brief Detecta el mejor conjunto de instrucciones disponible
+     * @return AVX2, SSE2 o SCALAR según la CPU
+     */
+    static KernelIsa detectIsa();
+
+    /**
+     * @brief Nombre legible de un conjunto de instrucciones
+     * @param isa Conjunto de instrucciones
+     * @return "scalar", "sse2" o "avx2"
+     */
+    static const char* isaName(KernelIsa isa);
+
+    /**
+     * @brief Clasifica una sola lectura
+     * @param temperature Temperatura en °C
+     * @param humidity Humedad en %
+     * @param thresholds Umbrales a aplicar
+     * @return Código de severidad (0 si ambas métricas están en rango)
+     */
+    static uint8_t classify(float temperature, float humidity, const AlertThresholds& thresholds);
+
+    /**
+     * @brief Clasifica un lote de lecturas con el mejor kernel disponible
+     * @param temperatures Columna de temperaturas
+     * @param humidities Columna de humedades
+     * @param count Cantidad de filas
+     * @param thresholds Umbrales a aplicar
+     * @param codes Códigos de severidad, uno por fila (salida, count bytes)
+     * @return Cantidad de filas con código distinto de cero
+     */
+    static size_t evaluate(const float* temperatures, const float* humidities, size_t count,
+                           const AlertThresholds& thresholds, uint8_t* codes);
+
+    /**
+     * @brief Clasifica un lote de lecturas con un kernel concreto
+     *
+     * Si la CPU no soporta el conjunto pedido se usa el mejor disponible.
+     *
+     * @param isa Conjunto de instrucciones a usar
+     * @param temperatures Columna de temperaturas
+     * @param humidities Columna de humedades
+     * @param count Cantidad de filas
+     * @param thresholds Umbrales a aplicar
+     * @param codes Códigos de severidad, uno por fila (salida, count bytes)
+     * @return Cantidad de filas con código distinto de cero
+     */
+    static size_t evaluateWith(KernelIsa isa, const float* temperatures, const float* humidities,
+                               size_t count, const AlertThresholds& thresholds, uint8_t* codes);
+
+    /**
+     * @brief Genera las alertas de un lote de lecturas
+     *
+     * Clasifica el lote y construye un Alert por cada métrica fuera de
+     * rango, con el mismo mensaje que el procesamiento lectura a lectura.
+     * No aplica histéresis ni límites de notificación.
+     *
+     * @param temperatures Columna de temperaturas
+     * @param humidities Columna de humedades
+     * @param timestamps Columna de timestamps (segundos)
+     * @param sensorIds Columna de sensores (nullptr = sensor por defecto)
+     * @param count Cantidad de filas
+     * @param thresholds Umbrales a aplicar
+     * @param alerts Alertas generadas, agregadas al final (salida)
+     * @return Cantidad de alertas agregadas
+     */
+    static size_t collectAlerts(const float* temperatures, const float* humidities,
+                                const int64_t* timestamps, const int32_t* sensorIds, size_t count,
+                                const AlertThresholds& thresholds, std::vector<Alert>& alerts);
+
+    /**
+     * @brief Nivel de la temperatura en un código
+     * @param code Código de severidad
+     * @return 0 = en rango, 1 = fuera de rango, 2 = banda crítica
+     */
+    static int temperatureLevel(uint8_t code) { return code & LEVEL_MASK; }
+
+    /**
+     * @brief Nivel de la humedad en un código
+     * @param code Código de severidad
+     * @return 0 = en rango, 1 = fuera de rango, 2 = banda crítica
+     */
+    static int humidityLevel(uint8_t code) { return (code >> HUMIDITY_SHIFT) & LEVEL_MASK; }
+
+    /**
+     * @brief Sentido del desvío de la temperatura
+     * @param code Código de severidad
+     * @return 1 si está por encima, -1 si está por debajo, 0 si está en rango
+     */
+    static int temperatureDirection(uint8_t code);
+
+    /**
+     * @brief Sentido del desvío de la humedad
+     * @param code Código de severidad
+     * @return 1 si está por encima, -1 si está por debajo, 0 si está en rango
+     */
+    static int humidityDirection(uint8_t code);
+
+    /**
+     * @brief Severidad de la alerta de temperatura
+     * @param code Código de severidad (con nivel de temperatura distinto de cero)
+     * @return HIGH fuera de rango, CRITICAL en la banda crítica
+     */
+    static AlertSeverity temperatureSeverity(uint8_t code);
+
+    /**
+     * @brief Severidad de la alerta de humedad
+     * @param code Código de severidad (con nivel de humedad distinto de cero)
+     * @return MEDIUM fuera de rango, HIGH en la banda crítica
+     */
+    static AlertSeverity humiditySeverity(uint8_t code);
+};
+
+#endif // ALERTKERNELS_H
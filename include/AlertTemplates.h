@@ -0,0 +1,66 @@
+#ifndef ALERTTEMPLATES_H
+#define ALERTTEMPLATES_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "Alert.h"
+
+/**
+ * @brief Catálogo de plantillas de mensajes de alerta
+ *
+ * Cada plantilla se identifica por un AlertCode y contiene el texto del
+ * mensaje con el marcador {value} donde va el valor medido, por ejemplo
+ * "Temperatura crítica: {value}°C". Las plantillas del sistema ocupan los
+ * códigos de AlertCode y son fijas; se pueden agregar otras en ejecución
+ * con intern(), que devuelve siempre el mismo código para el mismo texto.
+ *
+ * Las plantillas se guardan una sola vez y nunca se liberan: find() y
+ * render() no toman locks ni reservan memoria.
+ */
+class AlertTemplates {
+public:
+    static const uint16_t FIRST_INTERNED_CODE = 1024;   ///< Primer código de las plantillas agregadas en ejecución
+    static const size_t MAX_TEMPLATES = 4096;           ///< Cantidad máxima de códigos
+
+    /**
+     * @brief Busca el texto de una plantilla
+     * @param code Código de la plantilla
+     * @return Texto con el marcador {value}, o nullptr si el código no existe
+     */
+    static const char* find(AlertCode code);
+
+    /**
+     * @brief Indica si un código es de una plantilla del sistema
+     *
+     * Sólo esos códigos tienen el mismo significado en todos los procesos y
+     * pueden guardarse o enviarse en lugar del texto.
+     * @param code Código a verificar
+     * @return true si es una plantilla fija distinta de CUSTOM
+     */
+    static bool isBuiltin(AlertCode code);
+
+    /**
+     * @brief Registra una plantilla (o devuelve la existente con el mismo texto)
+     * @param text Texto con el marcador {value} (opcional)
+     * @return Código de la plantilla, o AlertCode::CUSTOM si el catálogo está lleno
+     */
+    static AlertCode intern(const std::string& text);
+
+    /**
+     * @brief Arma el mensaje de una alerta en un buffer
+     *
+     * Reemplaza {value} por el valor (formato %g, igual que std::ostream) y
+     * agrega la aclaración y " [sensor N]" si sensor no es 0.
+     * @param code Código de la plantilla
+     * @param value Valor medido
+     * @param sensor Sensor que originó la alerta
+     * @param note Aclaración del mensaje
+     * @param buffer Buffer de destino (queda terminado en '\0' si size > 0)
+     * @param size Tamaño del buffer
+     * @return Largo del mensaje completo; si es mayor o igual a size, el texto se truncó
+     */
+    static size_t render(AlertCode code, float value, int sensor, AlertNote note, char* buffer, size_t size);
+};
+
+#endif // ALERTTEMPLATES_H
@@ -0,0 +1,173 @@
+#ifndef ALERTTRACKER_H
+#define ALERTTRACKER_H
+
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+#include <ctime>
+#include "Alert.h"
+
+/**
+ * @brief Métrica vigilada por el sistema de alertas
+ */
+enum class AlertMetric {
+    TEMPERATURE,            ///< Temperatura
+    HUMIDITY,               ///< Humedad
+    TEMPERATURE_FORECAST,   ///< Cruce pronosticado de temperatura (sólo para AlertTracker)
+    HUMIDITY_FORECAST       ///< Cruce pronosticado de humedad (sólo para AlertTracker)
+};
+
+/**
+ * @brief Cambio de estado de una alerta que debe notificarse
+ */
+enum class AlertTransition {
+    NONE,       ///< Sin cambios que notificar
+    RAISE,      ///< La métrica salió del rango permitido
+    ESCALATE,   ///< Subió la severidad o cambió el sentido del desvío
+    RENOTIFY,   ///< Recordatorio de una alerta que sigue activa
+    CLEAR       ///< La métrica volvió al rango (fuera de la banda de histéresis)
+};
+
+/**
+ * @brief Configuración del seguimiento de alertas
+ */
+struct AlertPolicy {
+    float temperatureHysteresis;    ///< Margen en °C para considerar normalizada la temperatura
+    float humidityHysteresis;       ///< Margen en % para considerar normalizada la humedad
+    int renotifyIntervalSec;        ///< Segundos entre recordatorios (0 = sin recordatorios)
+    double notificationsPerMinute;  ///< Tasa de reposición del token bucket (0 = sin límite)
+    int notificationBurst;          ///< Capacidad del token bucket
+
+    /**
+     * @brief Constructor con los valores por defecto
+     */
+    AlertPolicy();
+};
+
+/**
+ * @brief Contadores del seguimiento de alertas
+ */
+struct AlertTrackerStats {
+    uint64_t raised;        ///< Alertas nuevas notificadas
+    uint64_t escalated;     ///< Escaladas notificadas
+    uint64_t renotified;    ///< Recordatorios notificados
+    uint64_t cleared;       ///< Normalizaciones notificadas
+    uint64_t suppressed;    ///< Lecturas fuera de rango sin cambio de estado
+    uint64_t rateLimited;   ///< Notificaciones postergadas por el token bucket
+};
+
+/**
+ * @brief Seguimiento con estado de las alertas por sensor y por métrica
+ * 
+ * Recuerda qué métricas de cada sensor están en alerta para notificar
+ * solo los cambios de estado (nueva, escalada, normalizada) y no cada
+ * lectura fuera de rango. Una alerta se normaliza recién cuando la
+ * métrica vuelve dentro del rango con un margen de histéresis, lo que
+ * evita oscilaciones alrededor del umbral. Un token bucket global limita
+ * la cantidad de notificaciones; las alertas CRITICAL nunca se limitan.
+ * Una transición limitada no cambia el estado: queda pendiente y se
+ * notifica en la primera lectura posterior que encuentre un token.
+ */
+class AlertTracker {
+private:
+    /**
+     * @brief Estado de una métrica en alerta
+     */
+    struct MetricState {
+        int direction;              ///< Sentido del desvío (+1 alto, -1 bajo)
+        AlertSeverity severity;     ///< Mayor severidad notificada
+        time_t lastNotified;        ///< Última notificación (0 = nunca)
+    };
+
+    AlertPolicy policy;                                 ///< Configuración vigente
+    std::unordered_map<uint64_t, MetricState> states;   ///< Métricas en alerta
+    double tokens;                                      ///< Tokens disponibles
+    time_t lastRefill;                                  ///< Última reposición de tokens
+    AlertTrackerStats stats;                            ///< Contadores
+    mutable std::mutex mutex;                           ///< Protege el estado
+
+    /**
+     * @brief Calcula la clave de una métrica de un sensor
+     * @param sensorId Identificador del sensor
+     * @param metric Métrica
+     * @return Clave única
+     */
+    static uint64_t key(int sensorId, AlertMetric metric);
+
+    /**
+     * @brief Consume un token del bucket, reponiendo según el tiempo transcurrido
+     * @param now Instante actual
+     * @return true si había un token disponible, false en caso contrario
+     */
+    bool takeToken(time_t now);
+
+public:
+    /**
+     * @brief Constructor
+     * @param alertPolicy Configuración inicial
+     */
+    explicit AlertTracker(const AlertPolicy& alertPolicy = AlertPolicy());
+
+    /**
+     * @brief Evalúa una lectura de una métrica y determina qué notificar
+     * @param sensorId Identificador del sensor
+     * @param metric Métrica evaluada
+     * @param direction Sentido del desvío (+1 sobre el umbral alto, -1 bajo el bajo, 0 en rango)
+     * @param severity Severidad del desvío (ignorada si direction es 0)
+     * @param cleared true si el valor está dentro del rango con el margen de histéresis
+     * @param now Instante de la lectura
+     * @return Cambio de estado a notificar, o NONE
+     */
+    AlertTransition evaluate(int sensorId, AlertMetric metric, int direction,
+                             AlertSeverity severity, bool cleared, time_t now);
+
+    /**
+     * @brief Olvida una alerta activa sin notificar su normalización
+     *
+     * Para alertas que se retiran sin que haya nada que avisar, como un
+     * cruce pronosticado que dejó de estar vigente.
+     * @param sensorId Identificador del sensor
+     * @param metric Métrica
+     * @return true si la alerta estaba activa, false en caso contrario
+     */
+    bool dismiss(int sensorId, AlertMetric metric);
+
+    /**
+     * @brief Indica si una métrica de un sensor está en alerta
+     * @param sensorId Identificador del sensor
+     * @param metric Métrica
+     * @return true si la alerta está activa, false en caso contrario
+     */
+    bool isActive(int sensorId, AlertMetric metric) const;
+
+    /**
+     * @brief Reemplaza la configuración
+     * @param alertPolicy Nueva configuración
+     */
+    void setPolicy(const AlertPolicy& alertPolicy);
+
+    /**
+     * @brief Obtiene la configuración vigente
+     * @return Configuración
+     */
+    AlertPolicy getPolicy() const;
+
+    /**
+     * @brief Obtiene los contadores acumulados
+     * @return Contadores
+     */
+    AlertTrackerStats getStats() const;
+
+    /**
+     * @brief Obtiene la cantidad de métricas actualmente en alerta
+     * @return Cantidad de alertas activas
+     */
+    size_t getActiveCount() const;
+
+    /**
+     * @brief Olvida todas las alertas activas y repone el token bucket
+     */
+    void reset();
+};
+
+#endif // ALERTTRACKER_H
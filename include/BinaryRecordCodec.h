@@ -0,0 +1,174 @@
+#ifndef BINARYRECORDCODEC_H
+#define BINARYRECORDCODEC_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <ctime>
+#include "ClimateReading.h"
+#include "Alert.h"
+
+/**
+ * @brief Tipo de registro de un bloque binario
+ */
+enum class RecordType : uint8_t {
+    READING = 1,    ///< Lecturas de clima
+    ALERT = 2       ///< Alertas con código
+};
+
+/**
+ * @brief Formato binario compacto de lecturas y alertas
+ *
+ * Los registros se agrupan en bloques con una cabecera de HEADER_SIZE
+ * bytes; todos los enteros son little-endian y no hay relleno:
+ *
+ *   Cabecera: magic "CLRB" | version u8 | tipo u8 | tamaño de registro u16 |
+ *             cantidad u32 | reservado u32 | tiempo base i64
+ *   Lectura (10 bytes): delta de tiempo u32 | temperatura i16 (centésimas de °C) |
+ *             humedad u16 (centésimas de %) | sensor u16
+ *   Alerta (12 bytes): delta de tiempo u32 | sensor u16 | código u16 |
+ *             severidad u8 | aclaración u8 | valor i16 (centésimas)
+ *
+ * El tiempo de cada registro es el tiempo base del bloque más el delta.
+ * Temperatura y humedad se redondean a centésimas. Las alertas guardan el
+ * código del mensaje (AlertCode) en lugar del texto; sólo se codifican las
+ * plantillas del sistema (las de texto libre o registradas en ejecución
+ * no tienen el mismo código en otro proceso). Los identificadores asignados por la base
+ * de datos no forman parte del formato.
+ *
+ * Un lector acepta registros más largos que los de su versión (saltando
+ * los bytes que no conoce), de modo que se pueden agregar campos al final
+ * sin cambiar la versión; los cambios incompatibles incrementan
+ * FORMAT_VERSION y los lectores anteriores rechazan esos bloques.
+ */
+class BinaryRecordCodec {
+public:
+    static const uint8_t FORMAT_VERSION = 1;    ///< Versión escrita por este codec
+    static const size_t HEADER_SIZE = 24;       ///< Bytes de la cabecera de bloque
+    static const size_t READING_SIZE = 10;      ///< Bytes por lectura
+    static const size_t ALERT_SIZE = 12;        ///< Bytes por alerta
+
+    /**
+     * @brief Codifica una lectura
+     * @param reading Lectura a codificar
+     * @param baseTime Tiempo base del bloque (no posterior a la lectura)
+     * @param out Destino de READING_SIZE bytes
+     * @return false si algún campo no entra en el formato (rango de tiempo, valores o sensor)
+     */
+    static bool encodeReading(const ClimateReading& reading, time_t baseTime, uint8_t* out);
+
+    /**
+     * @brief Decodifica una lectura
+     * @param in Registro de READING_SIZE bytes
+     * @param baseTime Tiempo base del bloque
+     * @return Lectura con id 0
+     */
+    static ClimateReading decodeReading(const uint8_t* in, time_t baseTime);
+
+    /**
+     * @brief Codifica una alerta con código
+     * @param alert Alerta a codificar
+     * @param baseTime Tiempo base del bloque (no posterior a la alerta)
+     * @param out Destino de ALERT_SIZE bytes
+     * @return false si la alerta no usa una plantilla del sistema o algún campo no entra en el formato
+     */
+    static bool encodeAlert(const Alert& alert, time_t baseTime, uint8_t* out);
+
+    /**
+     * @brief Decodifica una alerta (el mensaje se arma desde el código)
+     * @param in Registro de ALERT_SIZE bytes
+     * @param baseTime Tiempo base del bloque
+     * @return Alerta con id 0
+     */
+    static Alert decodeAlert(const uint8_t* in, time_t baseTime);
+
+    /**
+     * @brief Escribe una cabecera de bloque
+     * @param type Tipo de los registros
+     * @param count Cantidad de registros
+     * @param baseTime Tiempo base del bloque
+     * @param out Destino de HEADER_SIZE bytes
+     */
+    static void writeHeader(RecordType type, uint32_t count, time_t baseTime, uint8_t* out);
+
+    /**
+     * @brief Agrega un bloque de lecturas al final de un buffer
+     * @param readings Lecturas a codificar
+     * @param count Cantidad de lecturas
+     * @param out Buffer de destino (se agrega al final)
+     * @return false si alguna lectura no entra en el formato (el buffer queda como estaba)
+     */
+    static bool appendReadings(const ClimateReading* readings, size_t count, std::vector<uint8_t>& out);
+
+    /**
+     * @brief Agrega un bloque de alertas al final de un buffer
+     * @param alerts Alertas a codificar
+     * @param count Cantidad de alertas
+     * @param out Buffer de destino (se agrega al final)
+     * @return false si alguna alerta no se puede codificar (el buffer queda como estaba)
+     */
+    static bool appendAlerts(const Alert* alerts, size_t count, std::vector<uint8_t>& out);
+};
+
+/**
+ * @brief Lectura sin copias de un bloque binario
+ *
+ * Interpreta la cabecera sobre el buffer original y decodifica cada
+ * registro a pedido; no copia ni reserva memoria. El buffer debe seguir
+ * vivo mientras se use el lector.
+ */
+class RecordBlockReader {
+private:
+    const uint8_t* records;     ///< Primer registro
+    size_t recordCount;         ///< Cantidad de registros
+    size_t recordSize;          ///< Bytes por registro (puede superar al de esta versión)
+    time_t baseTime;            ///< Tiempo base del bloque
+    RecordType recordType;      ///< Tipo de los registros
+    bool valid;                 ///< La cabecera es válida y el buffer contiene todos los registros
+
+public:
+    /**
+     * @brief Constructor
+     * @param data Inicio del bloque
+     * @param size Bytes disponibles desde data
+     */
+    RecordBlockReader(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Indica si el bloque es válido
+     * @return false si la cabecera no es reconocible o el bloque está truncado
+     */
+    bool isValid() const { return valid; }
+
+    RecordType getType() const { return recordType; }
+    size_t size() const { return recordCount; }
+    time_t getBaseTime() const { return baseTime; }
+
+    /**
+     * @brief Obtiene los bytes que ocupa el bloque (para pasar al siguiente)
+     * @return Cabecera más registros, o 0 si el bloque no es válido
+     */
+    size_t getBlockSize() const {
+        return valid ? BinaryRecordCodec::HEADER_SIZE + recordCount * recordSize : 0;
+    }
+
+    /**
+     * @brief Decodifica una lectura (requiere getType() == READING)
+     * @param index Posición del registro
+     * @return Lectura decodificada
+     */
+    ClimateReading reading(size_t index) const {
+        return BinaryRecordCodec::decodeReading(records + index * recordSize, baseTime);
+    }
+
+    /**
+     * @brief Decodifica una alerta (requiere getType() == ALERT)
+     * @param index Posición del registro
+     * @return Alerta decodificada
+     */
+    Alert alert(size_t index) const {
+        return BinaryRecordCodec::decodeAlert(records + index * recordSize, baseTime);
+    }
+};
+
+#endif // BINARYRECORDCODEC_H
@@ -2,11 +2,22 @@
 #define CLIMATECONTROLSERVICE_H
 
 #include <vector>
+#include <memory>
+#include <mutex>
 #include "IMSForecast.h"
 #include "ClimateDataManager.h"
 #include "EmailService.h"
 #include "ClimateReading.h"
 #include "Alert.h"
+#include "AlertTracker.h"
+#include "AlertKernels.h"
+#include "ThresholdReplayEngine.h"
+#include "IngestPipeline.h"
+#include "StreamingStats.h"
+#include "TrendForecaster.h"
+#include "ZoneController.h"
+#include "CommandCoalescer.h"
+#include "SnapshotCache.h"
 
 /**
  * @brief Clase principal que maneja la lógica de negocio del sistema
@@ -21,25 +32,68 @@ private:
     ClimateDataManager* dataManager; ///< Gestor de datos
     EmailService* emailService;     ///< Servicio de email
     
-    // Umbrales de alerta
-    float tempHighThreshold;        ///< Umbral alto de temperatura
-    float tempLowThreshold;         ///< Umbral bajo de temperatura
-    float humidityHighThreshold;    ///< Umbral alto de humedad
-    float humidityLowThreshold;     ///< Umbral bajo de humedad
+    // Umbrales de alerta: el menú los cambia mientras el hilo del pipeline los evalúa
+    AlertThresholds alertThresholds; ///< Umbrales vigentes (protegidos por thresholdsMutex)
+    mutable std::mutex thresholdsMutex; ///< Protege alertThresholds
+    
+    AlertTracker alertTracker;      ///< Estado de las alertas por sensor y métrica
+    std::unique_ptr<IngestPipeline> ingestPipeline; ///< Pipeline de ingesta (nullptr = sincrónico)
+    ReadingStatistics readingStats; ///< Estadísticas en streaming de las lecturas ingresadas
+    TrendForecaster forecaster;     ///< Pronóstico de cruces de umbral por sensor
+    std::unique_ptr<ZoneController> zoneController; ///< Control automático (nullptr = manual)
+    CommandCoalescer commandCoalescer; ///< Agrupa ráfagas de comandos manuales en un delta neto
+    mutable SnapshotCache snapshotCache; ///< Última medición por sensor para las consultas de estado
     
     /**
-     * @brief Verifica si se deben generar alertas basadas en las lecturas
-     * @param temperature Temperatura actual
-     * @param humidity Humedad actual
-     * @return Vector con las alertas generadas
+     * @brief Evalúa una métrica en el AlertTracker y arma la alerta si hay un cambio de estado
+     * @param alerts Vector donde se agrega la alerta (salida)
+     * @param reading Lectura evaluada
+     * @param metric Métrica evaluada
+     * @param value Valor de la métrica
+     * @param direction Sentido del desvío (+1 alto, -1 bajo, 0 en rango)
+     * @param severity Severidad del desvío
+     * @param cleared true si el valor está en rango fuera de la banda de histéresis
+     */
+    void trackMetric(std::vector<Alert>& alerts, const ClimateReading& reading,
+                     AlertMetric metric, float value, int direction,
+                     AlertSeverity severity, bool cleared);
+    
+    /**
+     * @brief Pasa el cruce pronosticado de una métrica por el seguimiento de alertas
+     * @param alerts Vector donde se agrega la alerta (salida)
+     * @param reading Lectura evaluada
+     * @param metric Métrica pronosticada (TEMPERATURE o HUMIDITY)
+     * @param crossings Cruces vigentes informados por el pronóstico
+     * @param count Cantidad de cruces
+     */
+    void trackForecast(std::vector<Alert>& alerts, const ClimateReading& reading,
+                       AlertMetric metric, const ThresholdCrossing* crossings, size_t count);
+    
+    /**
+     * @brief Espera a que el pipeline de ingesta procese lo encolado, si está activo
      */
-    std::vector<Alert> checkAlerts(float temperature, float humidity);
+    void drainIngest();
     
     /**
      * @brief Procesa las alertas generadas
      * @param alerts Vector de alertas a procesar
      */
     void processAlerts(const std::vector<Alert>& alerts);
+    
+    /**
+     * @brief Consulta a la API la medición de un sensor (loader de la caché)
+     * @param sensorId Identificador del sensor
+     * @param snapshot Medición (salida)
+     * @return true si se obtuvo, false si la API falló
+     */
+    bool fetchSnapshot(int sensorId, ClimateSnapshot& snapshot) const;
+    
+    /**
+     * @brief Verifica que una medición de la API tenga valores finitos
+     * @param snapshot Medición a verificar
+     * @return true si temperatura y humedad son finitas
+     */
+    static bool isValidSnapshot(const ClimateSnapshot& snapshot);
 
 public:
     /**
@@ -59,15 +113,107 @@ public:
     
     /**
      * @brief Toma una lectura actual del clima y la guarda
-     * @return Lectura tomada
+     *
+     * Si la API no devuelve valores válidos (por ejemplo, NaN del cliente de
+     * red sin conexión) la lectura no se guarda, ni se evalúa, ni actualiza
+     * las estadísticas, el pronóstico o la caché de mediciones.
+     * @return Lectura tomada (con valores NaN si la API no respondió)
      */
     ClimateReading takeReading();
     
+    /**
+     * @brief Toma una lectura de varios sensores en una sola petición y las guarda
+     *
+     * Usa IMSForecast::readSnapshots, de modo que una fila de racks completa
+     * cuesta una sola llamada a la API MS-Forecast.
+     *
+     * @param sensorIds Identificadores de los sensores a leer
+     * @return Lecturas tomadas (vacío si la API no soporta lecturas por lote o la llamada falló;
+     *         un sensor que no se pudo leer se omite sin descartar al resto del lote)
+     */
+    std::vector<ClimateReading> takeReadings(const std::vector<int>& sensorIds);
+    
+    /**
+     * @brief Guarda una lectura ya tomada y evalúa sus alertas
+     *
+     * Es el punto de entrada común para las lecturas de cualquier sensor,
+     * incluido el SensorPollingEngine. Puede llamarse desde varios hilos.
+     * Con el pipeline de ingesta activo solo encola la lectura; el guardado
+     * y las alertas ocurren en las etapas del pipeline.
+     *
+     * @param reading Lectura a procesar
+     * @return true si se guardó o encoló, false si se descartó por valores no
+     *         finitos, la cola del pipeline estaba llena o falló el guardado
+     */
+    bool ingestReading(const ClimateReading& reading);
+    
+    /**
+     * @brief Verifica si una lectura produce cambios de estado de alerta
+     * 
+     * Solo devuelve alertas para transiciones (nueva, escalada, recordatorio
+     * o normalizada); una métrica que sigue fuera de rango no genera una
+     * alerta por lectura. También devuelve una alerta cuando el pronóstico
+     * de tendencia indica que un umbral se cruzará dentro del horizonte.
+     * Actualiza el seguimiento de alertas y el pronóstico, pero no guarda
+     * ni envía las alertas devueltas.
+     * @param reading Lectura a evaluar
+     * @return Vector con las alertas generadas
+     */
+    std::vector<Alert> checkAlerts(const ClimateReading& reading);
+    
+    /**
+     * @brief Activa el pipeline de ingesta por etapas
+     * @param capacity Capacidad de cada cola del pipeline
+     * @param batchSize Tamaño máximo de lote por etapa
+     * @return true si se activó, false si ya estaba activo
+     */
+    bool enableIngestPipeline(size_t capacity = 65536, size_t batchSize = 1024);
+    
+    /**
+     * @brief Procesa las lecturas pendientes y vuelve a la ingesta sincrónica
+     */
+    void disableIngestPipeline();
+    
+    /**
+     * @brief Obtiene el pipeline de ingesta activo
+     * @return Pipeline activo, o nullptr si la ingesta es sincrónica
+     */
+    IngestPipeline* getIngestPipeline();
+    
+    /**
+     * @brief Activa el control automático en lazo cerrado
+     *
+     * Un ZoneController con una zona sobre la API del servicio mantiene los
+     * setpoints desde su propio hilo. Mientras está activo se rechaza el
+     * control manual para que los comandos no se contradigan.
+     * @param temperatureSetpoint Temperatura deseada, °C
+     * @param humiditySetpoint Humedad deseada, %
+     * @param config Período y espera activa del lazo
+     * @return true si se activó, false si ya estaba activo
+     */
+    bool enableAutomaticControl(float temperatureSetpoint, float humiditySetpoint,
+                                const ControlLoopConfig& config = ControlLoopConfig());
+    
+    /**
+     * @brief Detiene el control automático y vuelve al control manual
+     */
+    void disableAutomaticControl();
+    
+    /**
+     * @brief Obtiene el control automático activo
+     * @return Controlador activo, o nullptr si el control es manual
+     */
+    ZoneController* getZoneController();
+    
     /**
      * @brief Controla la temperatura
+     *
+     * Los comandos que llegan dentro de la ventana de agrupamiento se suman
+     * en un único comando neto por sensor y métrica, seguido de una sola
+     * lectura; la llamada vuelve cuando se envió su lote.
      * @param action Acción a realizar ("up" o "down")
      * @param amount Cantidad de grados
-     * @return true si se ejecutó exitosamente, false en caso contrario
+     * @return true si se ejecutó exitosamente, false en caso contrario (o si el control automático está activo)
      */
     bool controlTemperature(const std::string& action, int amount);
     
@@ -75,22 +221,58 @@ public:
      * @brief Controla la humedad
      * @param action Acción a realizar ("up" o "down")
      * @param amount Cantidad de porcentaje
-     * @return true si se ejecutó exitosamente, false en caso contrario
+     * @return true si se ejecutó exitosamente, false en caso contrario (o si el control automático está activo)
      */
     bool controlHumidity(const std::string& action, int amount);
     
     /**
-     * @brief Obtiene la temperatura actual
+     * @brief Cambia la ventana de agrupamiento de los comandos manuales
+     * @param window Ventana (0 = cada comando se envía y se lee de inmediato)
+     */
+    void setCommandCoalesceWindow(std::chrono::milliseconds window);
+    
+    /**
+     * @brief Obtiene los contadores del agrupamiento de comandos manuales
+     * @return Comandos recibidos, lotes y llamadas a la API
+     */
+    CoalescerStats getCommandStats();
+    
+    /**
+     * @brief Obtiene la medición actual de un sensor
+     *
+     * Usa la caché de mediciones: si la última medición del sensor (de una
+     * consulta anterior o de takeReading/takeReadings) tiene menos que la
+     * vigencia configurada no consulta la API, y las consultas concurrentes
+     * comparten una sola petición.
+     * @param sensorId Identificador del sensor (0 = sensor por defecto)
+     * @return Medición, con valores NaN si la API no respondió
+     */
+    ClimateSnapshot getCurrentSnapshot(int sensorId = 0) const;
+    
+    /**
+     * @brief Obtiene la temperatura actual (ver getCurrentSnapshot)
      * @return Temperatura actual en grados Celsius
      */
     float getCurrentTemperature() const;
     
     /**
-     * @brief Obtiene la humedad actual
+     * @brief Obtiene la humedad actual (ver getCurrentSnapshot)
      * @return Humedad actual en porcentaje
      */
     float getCurrentHumidity() const;
     
+    /**
+     * @brief Cambia la vigencia de la caché de mediciones
+     * @param ttl Vigencia (0 = consultar la API en cada llamada)
+     */
+    void setSnapshotCacheTtl(std::chrono::milliseconds ttl);
+    
+    /**
+     * @brief Obtiene los contadores de la caché de mediciones
+     * @return Aciertos, consultas a la API y consultas compartidas
+     */
+    SnapshotCacheStats getSnapshotCacheStats() const;
+    
     /**
      * @brief Obtiene todas las lecturas históricas
      * @return Vector con todas las lecturas
@@ -103,6 +285,43 @@ public:
      */
     std::vector<Alert> getAllAlerts();
     
+    /**
+     * @brief Recorre las lecturas históricas en streaming
+     * @param visitor Función invocada por cada lectura; devolver false detiene el recorrido
+     * @param filter Rango de fechas a recorrer
+     * @return Cantidad de lecturas recorridas
+     */
+    size_t forEachReading(const ReadingVisitor& visitor, const ReadingFilter& filter = ReadingFilter());
+    
+    /**
+     * @brief Recorre las alertas históricas en streaming
+     * @param visitor Función invocada por cada alerta; devolver false detiene el recorrido
+     * @param filter Rango de fechas y severidad mínima
+     * @return Cantidad de alertas recorridas
+     */
+    size_t forEachAlert(const AlertVisitor& visitor, const AlertFilter& filter = AlertFilter());
+    
+    /**
+     * @brief Obtiene un resumen agregado de las lecturas de un rango
+     * @param startTime Timestamp de inicio
+     * @param endTime Timestamp de fin
+     * @param maxBuckets Cantidad máxima de puntos deseada
+     * @param tier Nivel de agregación utilizado (salida)
+     * @return Agregados min/max/media/cantidad ordenados por tiempo
+     */
+    std::vector<RollupBucket> getReadingSummary(time_t startTime, time_t endTime,
+                                                size_t maxBuckets, RollupTier& tier);
+    
+    /**
+     * @brief Obtiene las estadísticas en streaming de las lecturas
+     *
+     * Media, varianza, mínimo, máximo y cuantiles por sensor, por ventana de
+     * una hora y acumulados, actualizados con cada lectura ingresada desde
+     * el inicio del proceso. Consultarlas no recorre el historial.
+     * @return Estadísticas por sensor y métrica
+     */
+    const ReadingStatistics& getReadingStatistics() const;
+    
     /**
      * @brief Configura los umbrales de alerta
      * @param tempHigh Umbral alto de temperatura
@@ -123,6 +342,65 @@ public:
     void getAlertThresholds(float& tempHigh, float& tempLow, 
                            float& humidityHigh, float& humidityLow) const;
     
+    /**
+     * @brief Obtiene los umbrales de alerta actuales, incluidas las bandas críticas
+     * @return Umbrales listos para usar con AlertKernels
+     */
+    AlertThresholds getAlertThresholds() const;
+    
+    /**
+     * @brief Simula umbrales candidatos sobre el historial guardado
+     *
+     * Usa la política de alertas vigente. No guarda ni envía ninguna
+     * alerta y no modifica los umbrales configurados.
+     *
+     * @param candidate Umbrales a evaluar
+     * @param startTime Inicio del historial a reprocesar
+     * @param endTime Fin del historial a reprocesar
+     * @return Conteos y línea de tiempo de las alertas que se habrían generado
+     */
+    ReplayResult replayThresholds(const AlertThresholds& candidate, time_t startTime, time_t endTime);
+    
+    /**
+     * @brief Configura la histéresis, los recordatorios y el límite de notificaciones
+     * @param policy Nueva política de alertas
+     */
+    void setAlertPolicy(const AlertPolicy& policy);
+    
+    /**
+     * @brief Obtiene la política de alertas vigente
+     * @return Política de alertas
+     */
+    AlertPolicy getAlertPolicy() const;
+    
+    /**
+     * @brief Configura el pronóstico de cruces de umbral
+     * @param policy Nueva configuración (horizonSec = 0 desactiva las alertas pronosticadas)
+     */
+    void setForecastPolicy(const ForecastPolicy& policy);
+    
+    /**
+     * @brief Obtiene la configuración del pronóstico
+     * @return Configuración vigente
+     */
+    ForecastPolicy getForecastPolicy() const;
+    
+    /**
+     * @brief Pronostica una métrica de un sensor según su tendencia reciente
+     * @param sensorId Identificador del sensor
+     * @param metric Métrica a pronosticar
+     * @param aheadSec Segundos desde la última lectura del sensor
+     * @param value Valor pronosticado (salida)
+     * @return true si hay un pronóstico, false si el sensor no tiene lecturas
+     */
+    bool forecastMetric(int sensorId, AlertMetric metric, int aheadSec, float& value) const;
+    
+    /**
+     * @brief Obtiene los contadores del seguimiento de alertas
+     * @return Alertas notificadas, suprimidas y limitadas
+     */
+    AlertTrackerStats getAlertStats() const;
+    
     /**
      * @brief Verifica el estado del sistema
      * @return true si el sistema está funcionando correctamente, false en caso contrario
@@ -3,11 +3,84 @@
 
 #include <vector>
 #include <string>
+#include <mutex>
+#include <memory>
+#include <functional>
 #include "ClimateReading.h"
 #include "Alert.h"
+#include "ReadingRollups.h"
 
 // Forward declaration para evitar incluir sqlite3.h aquí
 struct sqlite3;
+struct sqlite3_stmt;
+class ColumnarReadingStore;
+struct SegmentView;
+class LatencyHistogram;
+
+/**
+ * @brief Motor de almacenamiento usado para las lecturas
+ */
+enum class StorageEngine {
+    SQLITE,     ///< Tabla climate_readings en SQLite
+    COLUMNAR    ///< Segmentos columnares de solo anexado mapeados en memoria
+};
+
+/**
+ * @brief Filtro aplicado al recorrer lecturas históricas
+ */
+struct ReadingFilter {
+    time_t startTime;           ///< Timestamp de inicio (inclusive)
+    time_t endTime;             ///< Timestamp de fin (inclusive)
+
+    /**
+     * @brief Constructor por defecto, sin restricción de fechas
+     */
+    ReadingFilter();
+
+    /**
+     * @brief Constructor con rango de fechas
+     * @param start Timestamp de inicio
+     * @param end Timestamp de fin
+     */
+    ReadingFilter(time_t start, time_t end);
+};
+
+/**
+ * @brief Filtro aplicado al recorrer alertas históricas
+ */
+struct AlertFilter {
+    time_t startTime;           ///< Timestamp de inicio (inclusive)
+    time_t endTime;             ///< Timestamp de fin (inclusive)
+    AlertSeverity minSeverity;  ///< Severidad mínima a incluir
+
+    /**
+     * @brief Constructor por defecto, sin restricciones
+     */
+    AlertFilter();
+
+    /**
+     * @brief Constructor con severidad mínima y rango opcional
+     * @param minSev Severidad mínima
+     * @param start Timestamp de inicio
+     * @param end Timestamp de fin
+     */
+    AlertFilter(AlertSeverity minSev, time_t start, time_t end);
+};
+
+/**
+ * @brief Función que recibe cada lectura; devolver false detiene el recorrido
+ */
+typedef std::function<bool(const ClimateReading&)> ReadingVisitor;
+
+/**
+ * @brief Función que recibe cada alerta; devolver false detiene el recorrido
+ */
+typedef std::function<bool(const Alert&)> AlertVisitor;
+
+/**
+ * @brief Función que recibe un tramo de columnas [begin, end); devolver false detiene el recorrido
+ */
+typedef std::function<bool(const SegmentView&, size_t, size_t)> ReadingColumnsVisitor;
 
 /**
  * @brief Clase para manejar la persistencia de datos del clima
@@ -15,11 +88,126 @@ struct sqlite3;
  * Esta clase implementa el patrón Data Mapper de Martin Fowler.
  * Se encarga de mapear los objetos de dominio (ClimateReading, Alert)
  * a la base de datos SQLite.
+ *
+ * La base de datos trabaja en modo WAL con dos conexiones: una de escritura
+ * y otra de solo lectura, de modo que las consultas por rango pueden
+ * ejecutarse en paralelo con la ingesta. Las sentencias preparadas se
+ * mantienen en caché durante toda la vida del gestor.
+ *
+ * Con StorageEngine::COLUMNAR las lecturas se guardan en un
+ * ColumnarReadingStore junto al archivo de base de datos, y las alertas
+ * siguen en SQLite.
+ *
+ * Cada inserción actualiza además los agregados por minuto, hora y día
+ * (ReadingRollups), que se persisten en la tabla reading_rollups cada vez
+ * que se cierra un minuto y se reconstruyen desde los datos crudos si no
+ * coinciden con ellos al abrir. Las lecturas de una transacción explícita
+ * se agregan recién al confirmarla.
  */
 class ClimateDataManager {
+public:
+    static const int STREAM_PAGE_SIZE = 1024; ///< Filas por página en los recorridos
+
 private:
-    sqlite3* db;                    ///< Conexión a la base de datos SQLite
+    sqlite3* db;                    ///< Conexión de escritura a la base de datos SQLite
+    sqlite3* readDb;                ///< Conexión de solo lectura (modo WAL)
     std::string dbPath;             ///< Ruta al archivo de base de datos
+    bool inTransaction;             ///< Indica si hay una transacción explícita abierta
+    StorageEngine storageEngine;    ///< Motor usado para las lecturas
+    std::unique_ptr<ColumnarReadingStore> columnStore; ///< Almacén columnar (sólo en modo COLUMNAR)
+    
+    // Sentencias preparadas en caché
+    sqlite3_stmt* insertReadingStmt;        ///< INSERT en climate_readings
+    sqlite3_stmt* insertAlertStmt;          ///< INSERT en alerts
+    sqlite3_stmt* selectAllReadingsStmt;    ///< SELECT de todas las lecturas
+    sqlite3_stmt* selectReadingsRangeStmt;  ///< SELECT de lecturas por rango de fechas
+    sqlite3_stmt* selectAllAlertsStmt;      ///< SELECT de todas las alertas
+    sqlite3_stmt* selectAlertsSeverityStmt; ///< SELECT de alertas por severidad
+    sqlite3_stmt* upsertRollupStmt;         ///< INSERT OR REPLACE en reading_rollups
+    sqlite3_stmt* readingsPageStmt;         ///< Página de lecturas para recorridos en streaming
+    sqlite3_stmt* alertsPageStmt;           ///< Página de alertas para recorridos en streaming
+    sqlite3_stmt* readingsAscPageStmt;      ///< Página ascendente de lecturas para recorridos por columnas
+    
+    ReadingRollups rollups;         ///< Agregados por minuto, hora y día
+    std::vector<ClimateReading> pendingRollupReadings; ///< Lecturas de la transacción explícita, agregadas al confirmarla
+    
+    std::mutex writeMutex;          ///< Serializa el acceso a la conexión de escritura
+    std::mutex readMutex;           ///< Serializa el acceso a la conexión de lectura
+    std::mutex rollupMutex;         ///< Protege los agregados (se toma antes que writeMutex)
+    
+    // Latencias publicadas en clima_storage_operation_duration_seconds
+    LatencyHistogram& insertReadingLatency;     ///< insertReading
+    LatencyHistogram& insertReadingsLatency;    ///< insertReadings (lote completo)
+    LatencyHistogram& insertAlertLatency;       ///< insertAlert
+    LatencyHistogram& rangeQueryLatency;        ///< getReadingsByDateRange
+    
+    /**
+     * @brief Abre las conexiones y configura el modo WAL
+     * @return true si se abrieron exitosamente, false en caso contrario
+     */
+    bool openConnections();
+    
+    /**
+     * @brief Prepara las sentencias SQL que se reutilizan
+     * @return true si se prepararon exitosamente, false en caso contrario
+     */
+    bool prepareStatements();
+    
+    /**
+     * @brief Inserta una lectura usando la sentencia en caché
+     * @param reading Lectura a insertar
+     * @return true si se insertó exitosamente, false en caso contrario
+     * @note Debe llamarse con writeMutex tomado
+     */
+    bool insertReadingLocked(const ClimateReading& reading);
+    
+    /**
+     * @brief Ejecuta una consulta de lecturas ya vinculada
+     * @param stmt Sentencia preparada sobre la conexión de lectura
+     * @return Vector con las lecturas obtenidas
+     * @note Debe llamarse con readMutex tomado
+     */
+    std::vector<ClimateReading> fetchReadings(sqlite3_stmt* stmt);
+    
+    /**
+     * @brief Ejecuta una consulta de alertas ya vinculada
+     * @param stmt Sentencia preparada sobre la conexión de lectura
+     * @return Vector con las alertas obtenidas
+     * @note Debe llamarse con readMutex tomado
+     */
+    std::vector<Alert> fetchAlerts(sqlite3_stmt* stmt);
+    
+    /**
+     * @brief Materializa lecturas del almacén columnar
+     * @param startTime Timestamp de inicio
+     * @param endTime Timestamp de fin
+     * @return Vector con las lecturas del rango, por timestamp descendente
+     */
+    std::vector<ClimateReading> fetchColumnarReadings(time_t startTime, time_t endTime) const;
+    
+    /**
+     * @brief Agrega lecturas recién insertadas a los niveles de rollup
+     * @param readings Lecturas insertadas
+     * @param count Cantidad de lecturas
+     */
+    void recordRollups(const ClimateReading* readings, size_t count);
+    
+    /**
+     * @brief Persiste los buckets modificados en reading_rollups
+     * @note Debe llamarse con rollupMutex tomado
+     */
+    void persistRollupsLocked();
+    
+    /**
+     * @brief Carga los agregados persistidos y los valida contra los datos crudos
+     */
+    void loadRollups();
+    
+    /**
+     * @brief Cuenta las lecturas crudas almacenadas
+     * @return Cantidad de lecturas en el motor configurado
+     */
+    uint64_t countReadings();
     
     /**
      * @brief Crea las tablas necesarias en la base de datos
@@ -33,13 +221,35 @@ private:
      * @return true si se ejecutó exitosamente, false en caso contrario
      */
     bool executeQuery(const std::string& sql);
+    
+    /**
+     * @brief Confirma la transacción abierta en la conexión de escritura
+     *
+     * Si COMMIT falla la transacción se revierte: de quedar abierta, todos
+     * los BEGIN posteriores fallarían.
+     * @return true si se confirmó, false si se revirtió
+     * @note Debe llamarse con writeMutex tomado
+     */
+    bool commitLocked();
+    
+    /**
+     * @brief Agrega una columna a una tabla existente si todavía no la tiene
+     * @param table Nombre de la tabla
+     * @param column Nombre de la columna
+     * @param definition Tipo y restricciones de la columna
+     * @return true si la columna existe al terminar, false en caso contrario
+     */
+    bool addColumnIfMissing(const std::string& table, const std::string& column,
+                            const std::string& definition);
 
 public:
     /**
      * @brief Constructor
      * @param databasePath Ruta al archivo de base de datos
+     * @param engine Motor de almacenamiento para las lecturas
      */
-    ClimateDataManager(const std::string& databasePath = "output/datacenter_climate.db");
+    ClimateDataManager(const std::string& databasePath = "output/datacenter_climate.db",
+                       StorageEngine engine = StorageEngine::SQLITE);
     
     /**
      * @brief Destructor
@@ -53,6 +263,31 @@ public:
      */
     bool insertReading(const ClimateReading& reading);
     
+    /**
+     * @brief Inserta un lote de lecturas en una única transacción
+     * @param readings Lecturas a insertar
+     * @return true si se insertaron todas, false si se revirtió el lote
+     */
+    bool insertReadings(const std::vector<ClimateReading>& readings);
+    
+    /**
+     * @brief Abre una transacción explícita para agrupar inserciones
+     * @return true si se abrió exitosamente, false en caso contrario
+     */
+    bool beginTransaction();
+    
+    /**
+     * @brief Confirma la transacción explícita abierta
+     * @return true si se confirmó exitosamente, false en caso contrario
+     */
+    bool commitTransaction();
+    
+    /**
+     * @brief Revierte la transacción explícita abierta
+     * @return true si se revirtió exitosamente, false en caso contrario
+     */
+    bool rollbackTransaction();
+    
     /**
      * @brief Inserta una alerta en la base de datos
      * @param alert Alerta a insertar
@@ -87,8 +322,77 @@ public:
      */
     std::vector<Alert> getAlertsBySeverity(AlertSeverity severity);
     
+    /**
+     * @brief Recorre las lecturas sin materializar el historial completo
+     *
+     * Las lecturas se entregan de la más reciente a la más antigua (en el
+     * motor columnar, en orden inverso de inserción). En SQLite se leen
+     * páginas de tamaño fijo y el visitante se invoca sin mantener ningún
+     * lock, por lo que la memoria usada no depende del tamaño del historial.
+     *
+     * @param visitor Función invocada por cada lectura
+     * @param filter Rango de fechas a recorrer
+     * @return Cantidad de lecturas entregadas al visitante
+     */
+    size_t forEachReading(const ReadingVisitor& visitor, const ReadingFilter& filter = ReadingFilter());
+    
+    /**
+     * @brief Recorre las alertas sin materializar el historial completo
+     * @param visitor Función invocada por cada alerta, de la más reciente a la más antigua
+     * @param filter Rango de fechas y severidad mínima
+     * @return Cantidad de alertas entregadas al visitante
+     */
+    size_t forEachAlert(const AlertVisitor& visitor, const AlertFilter& filter = AlertFilter());
+    
+    /**
+     * @brief Recorre las lecturas de un rango por columnas, en orden ascendente
+     *
+     * En el motor columnar los tramos apuntan directamente a los segmentos
+     * mapeados, sin copias; en segmentos con filas desordenadas un tramo
+     * puede incluir filas fuera del rango, por lo que el visitante debe
+     * verificar los timestamps. En SQLite cada página ascendente se copia a
+     * columnas temporales. Puede llamarse desde varios hilos a la vez.
+     *
+     * @param startTime Timestamp de inicio (inclusive)
+     * @param endTime Timestamp de fin (inclusive)
+     * @param visitor Función invocada por cada tramo
+     * @return Cantidad de filas entregadas al visitante
+     */
+    size_t forEachReadingColumns(time_t startTime, time_t endTime, const ReadingColumnsVisitor& visitor);
+    
+    /**
+     * @brief Obtiene los agregados de un nivel dentro de un rango
+     * @param tier Nivel de agregación
+     * @param startTime Timestamp de inicio
+     * @param endTime Timestamp de fin
+     * @return Buckets ordenados por inicio ascendente
+     */
+    std::vector<RollupBucket> getRollups(RollupTier tier, time_t startTime, time_t endTime);
+    
+    /**
+     * @brief Obtiene los agregados de un rango desde el nivel más adecuado
+     *
+     * Si el rango empieza antes de la retención del nivel por minuto se
+     * usa el nivel por hora.
+     * @param startTime Timestamp de inicio
+     * @param endTime Timestamp de fin
+     * @param maxBuckets Cantidad máxima de puntos deseada
+     * @param tier Nivel utilizado (salida)
+     * @return Buckets ordenados por inicio ascendente
+     */
+    std::vector<RollupBucket> getRollupsForRange(time_t startTime, time_t endTime,
+                                                 size_t maxBuckets, RollupTier& tier);
+    
+    /**
+     * @brief Reconstruye todos los agregados desde el historial crudo
+     * @return true si se reconstruyeron y persistieron, false en caso contrario
+     */
+    bool rebuildRollups();
+    
     /**
      * @brief Cierra la conexión a la base de datos
+     *
+     * Una transacción explícita todavía abierta se revierte.
      */
     void closeConnection();
     
@@ -97,6 +401,18 @@ public:
      * @return true si está conectado, false en caso contrario
      */
     bool isConnected() const;
+    
+    /**
+     * @brief Obtiene el motor de almacenamiento de las lecturas
+     * @return Motor configurado en el constructor
+     */
+    StorageEngine getStorageEngine() const;
+    
+    /**
+     * @brief Acceso directo a las columnas para recorridos históricos
+     * @return Almacén columnar, o nullptr si el motor es SQLITE
+     */
+    const ColumnarReadingStore* getColumnStore() const;
 };
 
 #endif // CLIMATEDATAMANAGER_H 
\ No newline at end of file
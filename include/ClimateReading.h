@@ -14,6 +14,7 @@
 class ClimateReading {
 private:
     int id;                 ///< Identificador único de la lectura
+    int sensorId;           ///< Identificador del sensor que tomó la lectura
     float temperature;      ///< Temperatura en grados Celsius
     float humidity;         ///< Humedad en porcentaje
     time_t timestamp;       ///< Timestamp de la lectura
@@ -37,17 +38,20 @@ public:
      * @param temp Temperatura en grados Celsius
      * @param hum Humedad en porcentaje
      * @param ts Timestamp de la lectura
+     * @param sensor Identificador del sensor (0 = sensor principal)
      */
-    ClimateReading(int id, float temp, float hum, time_t ts);
+    ClimateReading(int id, float temp, float hum, time_t ts, int sensor = 0);
     
     // Getters
     int getId() const;
+    int getSensorId() const;
     float getTemperature() const;
     float getHumidity() const;
     time_t getTimestamp() const;
     
     // Setters
     void setId(int id);
+    void setSensorId(int sensor);
     void setTemperature(float temp);
     void setHumidity(float hum);
     void setTimestamp(time_t ts);
@@ -0,0 +1,295 @@
+#ifndef COLUMNARREADINGSTORE_H
+#define COLUMNARREADINGSTORE_H
+
+#include <vector>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+#include "ClimateReading.h"
+
+/**
+ * @brief Vista de solo lectura sobre las columnas de un segmento
+ *
+ * En el segmento activo los punteros apuntan directamente a la memoria
+ * mapeada del archivo, por lo que recorrer una columna no requiere
+ * deserializar nada. En los segmentos sellados apuntan a un bloque recién
+ * descomprimido y sólo son válidos durante la llamada al visitante.
+ */
+struct SegmentView {
+    const int64_t* timestamps;  ///< Columna de timestamps (segundos)
+    const float* temperatures;  ///< Columna de temperaturas en °C
+    const float* humidities;    ///< Columna de humedades en %
+    const int32_t* sensorIds;   ///< Columna de sensores (nullptr en segmentos v1)
+    size_t count;               ///< Cantidad de filas válidas
+    uint64_t firstId;           ///< Identificador de la primera fila de la vista
+
+    /**
+     * @brief Sensor de una fila
+     * @param row Índice de la fila dentro del segmento
+     * @return Identificador del sensor (0 en segmentos sin columna de sensor)
+     */
+    int32_t sensorAt(size_t row) const { return sensorIds ? sensorIds[row] : 0; }
+};
+
+/**
+ * @brief Almacén columnar de lecturas en segmentos de solo anexado
+ *
+ * Cada segmento es un archivo de capacidad fija con una cabecera y cuatro
+ * columnas contiguas (timestamps, temperaturas, humedades, sensores) mapeado en
+ * memoria con mmap. Las lecturas se anexan al segmento activo y cuando
+ * éste se llena se crea uno nuevo. Reabrir el almacén sólo mapea los
+ * archivos existentes, sin leer su contenido.
+ *
+ * Las consultas por rango de tiempo usan un índice disperso con el
+ * timestamp mínimo y máximo de cada bloque de filas. La cabecera de cada
+ * segmento guarda su rango total, lo que permite descartar segmentos
+ * completos sin tocar sus columnas; el índice por bloques se construye
+ * la primera vez que una consulta alcanza el segmento y luego se mantiene
+ * en cada anexado.
+ *
+ * Cuando un segmento se llena se sella: se comprime en bloques de
+ * SEALED_BLOCK_ROWS filas con GorillaEncoder en un archivo .gor de solo
+ * lectura que reemplaza al .col. El sellado corre en un hilo de fondo y
+ * comprime y escribe el archivo fuera del mutex, así que el anexado que
+ * llena un segmento no espera a la compresión ni al fsync; mientras tanto
+ * el segmento lleno se sigue consultando sin comprimir. El archivo sellado guarda el rango de
+ * timestamps de cada bloque, y los recorridos descomprimen sólo los
+ * bloques que tocan, de a uno y en un buffer propio de cada recorrido.
+ */
+class ColumnarReadingStore {
+public:
+    static const size_t INDEX_BLOCK_ROWS = 4096; ///< Filas por bloque del índice temporal
+    static const size_t SEALED_BLOCK_ROWS = 1024; ///< Filas por bloque comprimido
+
+private:
+    /**
+     * @brief Rango de timestamps de un bloque del índice
+     */
+    struct BlockRange {
+        int64_t minTimestamp;   ///< Timestamp mínimo del bloque
+        int64_t maxTimestamp;   ///< Timestamp máximo del bloque
+    };
+
+    /**
+     * @brief Segmento mapeado en memoria
+     */
+    struct Segment {
+        std::string path;       ///< Ruta del archivo del segmento
+        int fd;                 ///< Descriptor del archivo (-1 en segmentos sellados)
+        void* base;             ///< Inicio de la región mapeada
+        size_t mappedSize;      ///< Tamaño de la región mapeada
+        uint64_t firstId;       ///< Identificador de la primera fila
+        bool sealed;            ///< Segmento comprimido de solo lectura (.gor)
+        bool sealFailed;        ///< No se pudo sellar; se reintenta al reabrir el almacén
+        bool indexBuilt;        ///< Indica si blockIndex está construido
+        std::vector<BlockRange> blockIndex; ///< Índice disperso por bloque (sólo segmentos .col)
+    };
+
+    /**
+     * @brief Mapeo de un segmento reemplazado que todavía puede estar en uso
+     */
+    struct RetiredMapping {
+        void* base;             ///< Inicio de la región mapeada
+        size_t size;            ///< Tamaño de la región mapeada
+    };
+
+    std::string directory;          ///< Directorio que contiene los segmentos
+    size_t segmentCapacity;         ///< Filas por segmento
+    std::vector<Segment> segments;  ///< Segmentos abiertos, en orden de creación
+    size_t nextSegmentIndex;        ///< Número del próximo archivo de segmento
+    uint64_t totalRows;             ///< Total de filas en todos los segmentos
+    mutable size_t activeScans;     ///< Recorridos en curso fuera del mutex
+    mutable std::vector<RetiredMapping> retired; ///< Mapeos a liberar cuando no haya recorridos
+    mutable std::mutex mutex;       ///< Protege la lista de segmentos y los anexados
+    std::condition_variable sealWake; ///< Avisa al hilo de sellado que hay un segmento lleno
+    bool stopping;                  ///< El destructor pidió terminar el hilo de sellado
+    std::thread sealer;             ///< Hilo que sella los segmentos llenos
+
+    /**
+     * @brief Abre y mapea un segmento existente
+     * @param path Ruta del archivo
+     * @param segment Segmento a completar
+     * @return true si se abrió exitosamente, false en caso contrario
+     */
+    bool openSegment(const std::string& path, Segment& segment);
+
+    /**
+     * @brief Abre y mapea un segmento sellado
+     * @param path Ruta del archivo .gor
+     * @param segment Segmento a completar
+     * @return true si se abrió exitosamente, false en caso contrario
+     */
+    bool openSealedSegment(const std::string& path, Segment& segment);
+
+    /**
+     * @brief Comprime un segmento lleno en su archivo sellado
+     *
+     * El archivo .gor se escribe completo y se renombra antes de borrar el
+     * .col, de modo que una caída deja siempre uno de los dos válido. No
+     * toca el estado del almacén y se llama sin el mutex tomado.
+     *
+     * @param segment Copia del segmento lleno (su mapeo ya no cambia)
+     * @param sealed Segmento sellado abierto (salida)
+     * @return true si se selló, false si sigue sin comprimir
+     */
+    bool compressSegment(const Segment& segment, Segment& sealed);
+
+    /**
+     * @brief Reemplaza un segmento por su versión sellada y borra el .col
+     *
+     * Si hay recorridos en curso el mapeo anterior se libera cuando terminan.
+     *
+     * @param segment Segmento sellado
+     * @param sealed Versión sellada abierta por compressSegment
+     * @note Debe llamarse con el mutex tomado
+     */
+    void replaceWithSealed(Segment& segment, const Segment& sealed);
+
+    /**
+     * @brief Bucle del hilo de sellado
+     *
+     * Sella de a uno los segmentos llenos que quedan detrás del activo.
+     * Al terminar el almacén sella los pendientes antes de salir.
+     */
+    void sealLoop();
+
+    /**
+     * @brief Registra el inicio de un recorrido fuera del mutex
+     * @note Debe llamarse con el mutex tomado
+     */
+    void beginScan() const;
+
+    /**
+     * @brief Registra el fin de un recorrido y libera los mapeos retirados
+     */
+    void endScan() const;
+
+    /**
+     * @brief Crea un nuevo segmento vacío al final del almacén
+     * @return true si se creó exitosamente, false en caso contrario
+     */
+    bool createSegment();
+
+    /**
+     * @brief Construye la vista de columnas de un segmento
+     * @param segment Segmento a consultar
+     * @return Vista con los punteros a cada columna
+     */
+    SegmentView makeView(const Segment& segment) const;
+
+    /**
+     * @brief Anexa una fila sin tomar el mutex
+     * @param reading Lectura a anexar
+     * @return true si se anexó exitosamente, false en caso contrario
+     */
+    bool appendLocked(const ClimateReading& reading);
+
+    /**
+     * @brief Construye el índice por bloques de un segmento si hace falta
+     * @param segment Segmento a indexar
+     * @note Debe llamarse con el mutex tomado
+     */
+    void ensureIndex(Segment& segment);
+
+public:
+    /**
+     * @brief Constructor
+     * @param dir Directorio de los segmentos (se crea si no existe)
+     * @param capacity Cantidad de filas por segmento
+     */
+    ColumnarReadingStore(const std::string& dir, size_t capacity = 1 << 20);
+
+    /**
+     * @brief Destructor, termina de sellar, desmapea y cierra todos los segmentos
+     */
+    ~ColumnarReadingStore();
+
+    ColumnarReadingStore(const ColumnarReadingStore&) = delete;
+    ColumnarReadingStore& operator=(const ColumnarReadingStore&) = delete;
+
+    /**
+     * @brief Anexa una lectura al segmento activo
+     * @param reading Lectura a anexar
+     * @return true si se anexó exitosamente, false en caso contrario
+     */
+    bool append(const ClimateReading& reading);
+
+    /**
+     * @brief Anexa un lote de lecturas tomando el mutex una sola vez
+     * @param readings Lecturas a anexar
+     * @return true si se anexaron todas, false en caso contrario
+     */
+    bool appendBatch(const std::vector<ClimateReading>& readings);
+
+    /**
+     * @brief Recorre los segmentos en orden de inserción
+     *
+     * Los segmentos sellados se entregan en varias vistas, una por bloque
+     * comprimido.
+     *
+     * @param visitor Función que recibe la vista de cada segmento; si
+     *        devuelve false se detiene el recorrido
+     */
+    void forEachSegment(const std::function<bool(const SegmentView&)>& visitor) const;
+
+    /**
+     * @brief Recorre las filas candidatas de un rango de tiempo
+     *
+     * El visitante recibe tramos [begin, end) de filas de un segmento. En
+     * segmentos ordenados por tiempo los tramos son exactos; en segmentos
+     * desordenados son los bloques que se solapan con el rango y el
+     * visitante debe filtrar por timestamp. Los bloques sellados se
+     * descomprimen recién al entregarlos.
+     *
+     * @param startTime Timestamp de inicio (inclusive)
+     * @param endTime Timestamp de fin (inclusive)
+     * @param visitor Función que recibe la vista y el tramo; si devuelve
+     *        false se detiene el recorrido
+     * @param newestFirst Entrega los tramos del más reciente al más antiguo
+     *        (las filas de cada tramo siguen en orden de inserción)
+     */
+    void forEachInRange(int64_t startTime, int64_t endTime,
+                        const std::function<bool(const SegmentView&, size_t, size_t)>& visitor,
+                        bool newestFirst = false);
+
+    /**
+     * @brief Sincroniza los segmentos con el disco (msync)
+     */
+    void flush();
+
+    /**
+     * @brief Obtiene la cantidad total de filas
+     * @return Total de lecturas almacenadas
+     */
+    uint64_t size() const;
+
+    /**
+     * @brief Obtiene la cantidad de segmentos
+     * @return Cantidad de archivos de segmento abiertos
+     */
+    size_t segmentCount() const;
+
+    /**
+     * @brief Obtiene la cantidad de segmentos sellados
+     * @return Segmentos comprimidos
+     */
+    size_t sealedSegmentCount() const;
+
+    /**
+     * @brief Obtiene el tamaño en disco de los segmentos sellados
+     * @return Bytes de los archivos .gor
+     */
+    uint64_t sealedBytes() const;
+
+    /**
+     * @brief Verifica si el almacén está operativo
+     * @return true si hay un segmento activo, false en caso contrario
+     */
+    bool isOpen() const;
+};
+
+#endif // COLUMNARREADINGSTORE_H
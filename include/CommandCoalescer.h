@@ -0,0 +1,114 @@
+#ifndef COMMANDCOALESCER_H
+#define COMMANDCOALESCER_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <functional>
+#include <cstdint>
+#include "IMSForecast.h"
+#include "AlertTracker.h"
+
+/**
+ * @brief Contadores del agrupamiento de comandos
+ */
+struct CoalescerStats {
+    uint64_t submitted;     ///< Comandos recibidos
+    uint64_t batches;       ///< Lotes cerrados
+    uint64_t apiCalls;      ///< Comandos enviados a la API (uno por sensor y métrica con delta neto)
+    uint64_t cancelled;     ///< Sensores y métricas cuyo delta neto fue cero
+    uint64_t failures;      ///< Comandos rechazados por la API
+};
+
+/**
+ * @brief Agrupa ráfagas de comandos de control en un delta neto
+ *
+ * El primer comando de una ráfaga abre un lote y espera la ventana; los
+ * comandos que llegan mientras tanto se suman al lote por sensor (cada
+ * IMSForecast) y métrica, de modo que "up 3" seguido de "down 1" se envía
+ * como un único upTemp(2) y los que se cancelan no se envían. Al cerrar el
+ * lote se envía un comando por delta neto distinto de cero y se invoca una
+ * sola vez onFlush (por ejemplo, para tomar la lectura posterior al
+ * control). Cada llamada a submit() espera su lote y devuelve el resultado
+ * del comando neto de su sensor y métrica, como si lo hubiera enviado ella.
+ *
+ * No usa un hilo propio: el hilo que abre el lote lo cierra. Los lotes se
+ * envían en orden de apertura. Con ventana cero cada comando se envía de
+ * inmediato. Es thread-safe.
+ */
+class CommandCoalescer {
+public:
+    typedef std::function<void()> FlushCallback;    ///< Acción posterior a un lote con comandos enviados
+
+private:
+    typedef std::pair<IMSForecast*, AlertMetric> Key;  ///< Sensor y métrica
+
+    /**
+     * @brief Lote de comandos abierto o en envío
+     */
+    struct Batch {
+        std::map<Key, int> deltas;      ///< Delta neto por sensor y métrica
+        std::map<Key, bool> results;    ///< Resultado por sensor y métrica
+        bool done;                      ///< Ya se envió
+
+        Batch() : done(false) {}
+    };
+
+    std::chrono::milliseconds window;           ///< Tiempo que un lote acepta comandos
+    FlushCallback onFlush;                      ///< Acción tras enviar un lote
+    std::shared_ptr<Batch> open;                ///< Lote que acepta comandos (nullptr = ninguno)
+    CoalescerStats stats;                       ///< Contadores
+    uint64_t sentBatches;                       ///< Lotes ya enviados (turno del próximo envío)
+    std::mutex mutex;                           ///< Protege el lote abierto y los contadores
+    std::condition_variable batchDone;          ///< Avisa que un lote se envió
+
+    /**
+     * @brief Envía los deltas netos de un lote cerrado e invoca onFlush
+     * @param batch Lote a enviar
+     * @param counters Contadores a actualizar (salida)
+     */
+    void send(Batch& batch, CoalescerStats& counters);
+
+public:
+    /**
+     * @brief Constructor
+     * @param coalesceWindow Ventana de agrupamiento (0 = sin agrupar)
+     * @param flushCallback Acción tras cada lote con comandos enviados (puede estar vacía)
+     */
+    explicit CommandCoalescer(std::chrono::milliseconds coalesceWindow = std::chrono::milliseconds(50),
+                              FlushCallback flushCallback = FlushCallback());
+
+    CommandCoalescer(const CommandCoalescer&) = delete;
+    CommandCoalescer& operator=(const CommandCoalescer&) = delete;
+
+    /**
+     * @brief Agrega un comando y espera a que se envíe su lote
+     * @param target API del sensor
+     * @param metric Métrica a controlar
+     * @param delta Cambio pedido (positivo = up, negativo = down)
+     * @return Resultado del comando neto del sensor y métrica (true si el delta neto fue cero)
+     */
+    bool submit(IMSForecast* target, AlertMetric metric, int delta);
+
+    /**
+     * @brief Obtiene los contadores
+     * @return Comandos recibidos, lotes y llamadas a la API
+     */
+    CoalescerStats getStats();
+
+    /**
+     * @brief Cambia la ventana de agrupamiento (rige desde el próximo lote)
+     * @param coalesceWindow Nueva ventana (0 = sin agrupar)
+     */
+    void setWindow(std::chrono::milliseconds coalesceWindow);
+
+    /**
+     * @brief Obtiene la ventana de agrupamiento
+     * @return Ventana
+     */
+    std::chrono::milliseconds getWindow();
+};
+
+#endif // COMMANDCOALESCER_H
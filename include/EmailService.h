@@ -3,14 +3,44 @@
 
 #include <string>
 #include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
 #include "Alert.h"
+#include "IEmailTransport.h"
+
+/**
+ * @brief Política ante una cola de envío llena
+ */
+enum class EmailOverflowPolicy {
+    DROP_LOWEST_SEVERITY,   ///< Descarta la alerta más antigua de menor severidad
+    BLOCK                   ///< Bloquea al llamador hasta que haya lugar
+};
+
+/**
+ * @brief Contadores del modo de envío asíncrono
+ */
+struct EmailQueueStats {
+    uint64_t enqueued;      ///< Alertas aceptadas en la cola
+    uint64_t sent;          ///< Alertas entregadas a todos los destinatarios
+    uint64_t failed;        ///< Alertas con al menos un envío fallido
+    uint64_t dropped;       ///< Alertas descartadas por cola llena
+    size_t pending;         ///< Alertas esperando en la cola
+};
 
 /**
  * @brief Clase para manejar el envío de alertas por email
  * 
  * Esta clase se encarga de enviar notificaciones por email
  * cuando se generan alertas en el sistema de control de clima.
- * En esta implementación se simula el envío de emails.
+ * El envío se delega en un IEmailTransport (por defecto SmtpTransportMock).
+ * En modo asíncrono las alertas se encolan en una cola acotada y los
+ * hilos de envío las entregan, de modo que un servidor SMTP lento no
+ * demora la lectura ni el control del clima.
  */
 class EmailService {
 private:
@@ -19,9 +49,46 @@ private:
     std::string senderEmail;        ///< Email del remitente
     std::string senderPassword;     ///< Contraseña del remitente
     std::vector<std::string> recipients; ///< Lista de destinatarios
+    mutable std::mutex recipientsMutex; ///< Protege la lista de destinatarios
+    std::unique_ptr<IEmailTransport> transport; ///< Transporte de los emails
+    
+    // Modo asíncrono
+    std::deque<Alert> pending[4];           ///< Alertas pendientes por severidad
+    size_t pendingCount;                    ///< Total de alertas pendientes
+    size_t queueCapacity;                   ///< Capacidad de la cola
+    EmailOverflowPolicy overflowPolicy;     ///< Política ante cola llena
+    std::vector<std::thread> senders;       ///< Hilos de envío
+    bool asyncRunning;                      ///< Indica si el modo asíncrono está activo
+    bool stopping;                          ///< Indica que los hilos deben terminar
+    mutable std::mutex queueMutex;          ///< Protege la cola
+    std::condition_variable notEmpty;       ///< Avisa a los hilos de envío
+    std::condition_variable notFull;        ///< Avisa a los llamadores bloqueados
+    std::atomic<uint64_t> enqueuedCount;    ///< Alertas aceptadas
+    std::atomic<uint64_t> sentCount;        ///< Alertas entregadas
+    std::atomic<uint64_t> failedCount;      ///< Alertas con envíos fallidos
+    std::atomic<uint64_t> droppedCount;     ///< Alertas descartadas
+    
+    /**
+     * @brief Arma el asunto del email de una alerta
+     * @param alert Alerta a enviar
+     * @return Asunto del email
+     */
+    static std::string buildSubject(const Alert& alert);
+    
+    /**
+     * @brief Arma el cuerpo del email de una alerta
+     * @param alert Alerta a enviar
+     * @return Cuerpo del email
+     */
+    static std::string buildBody(const Alert& alert);
+    
+    /**
+     * @brief Bucle de cada hilo de envío
+     */
+    void senderLoop();
     
     /**
-     * @brief Simula el envío de un email
+     * @brief Envía un email a través del transporte configurado
      * @param to Destinatario
      * @param subject Asunto del email
      * @param body Cuerpo del email
@@ -43,10 +110,57 @@ public:
                  const std::string& password = "password123");
     
     /**
-     * @brief Destructor
+     * @brief Destructor, vacía la cola si el modo asíncrono está activo
      */
     ~EmailService();
     
+    EmailService(const EmailService&) = delete;
+    EmailService& operator=(const EmailService&) = delete;
+    
+    /**
+     * @brief Reemplaza el transporte de los emails y toma posesión de él
+     * @param newTransport Transporte a utilizar
+     */
+    void setTransport(IEmailTransport* newTransport);
+    
+    /**
+     * @brief Inicia el modo asíncrono con una cola acotada
+     * @param workerCount Cantidad de hilos de envío
+     * @param capacity Máximo de alertas pendientes
+     * @param policy Política ante cola llena
+     * @return true si se inició, false si ya estaba activo o los parámetros son inválidos
+     */
+    bool startAsync(size_t workerCount = 1, size_t capacity = 1024,
+                    EmailOverflowPolicy policy = EmailOverflowPolicy::DROP_LOWEST_SEVERITY);
+    
+    /**
+     * @brief Detiene el modo asíncrono tras enviar las alertas pendientes
+     */
+    void stopAsync();
+    
+    /**
+     * @brief Verifica si el modo asíncrono está activo
+     * @return true si está activo, false en caso contrario
+     */
+    bool isAsync() const;
+    
+    /**
+     * @brief Encola una alerta para su envío a todos los destinatarios
+     * 
+     * En modo asíncrono retorna de inmediato sin esperar al transporte;
+     * las alertas de mayor severidad se envían primero. Sin modo
+     * asíncrono equivale a sendAlert().
+     * @param alert Alerta a enviar
+     * @return true si se encoló (o envió), false si fue descartada
+     */
+    bool enqueueAlert(const Alert& alert);
+    
+    /**
+     * @brief Obtiene los contadores del modo asíncrono
+     * @return Alertas encoladas, enviadas, fallidas, descartadas y pendientes
+     */
+    EmailQueueStats getQueueStats();
+    
     /**
      * @brief Envía una alerta por email a todos los destinatarios
      * @param alert Alerta a enviar
@@ -0,0 +1,105 @@
+#ifndef FORECASTPROTOCOL_H
+#define FORECASTPROTOCOL_H
+
+#include <cstdint>
+#include <cstddef>
+#include "IMSForecast.h"
+
+/**
+ * @brief Operación de una petición a la API MS-Forecast
+ */
+enum class ForecastOp : uint8_t {
+    UP_TEMP = 1,            ///< upTemp(arg)
+    DOWN_TEMP = 2,          ///< downTemp(arg)
+    UP_HUMIDITY = 3,        ///< upHumidity(arg)
+    DOWN_HUMIDITY = 4,      ///< downHumidity(arg)
+    READ_TEMP = 5,          ///< readTemp()
+    READ_HUMIDITY = 6,      ///< readHumidity()
+    READ_SNAPSHOT = 7       ///< Medición del sensor arg
+};
+
+/**
+ * @brief Resultado de una petición
+ */
+enum class ForecastStatus : uint8_t {
+    OK = 0,                 ///< Ejecutada
+    REJECTED = 1,           ///< La API rechazó la operación
+    BAD_REQUEST = 2         ///< Operación desconocida
+};
+
+/**
+ * @brief Petición a la API MS-Forecast
+ */
+struct ForecastRequest {
+    uint32_t id;            ///< Identificador elegido por el cliente (se repite en la respuesta)
+    ForecastOp op;          ///< Operación
+    int32_t arg;            ///< Cantidad de los comandos o sensor de READ_SNAPSHOT
+};
+
+/**
+ * @brief Respuesta de la API MS-Forecast
+ */
+struct ForecastResponse {
+    uint32_t id;            ///< Identificador de la petición
+    ForecastOp op;          ///< Operación de la petición
+    ForecastStatus status;  ///< Resultado
+    ClimateSnapshot snapshot; ///< Medición (las lecturas simples completan sólo su valor)
+};
+
+/**
+ * @brief Protocolo binario de petición y respuesta de la API MS-Forecast
+ *
+ * Los mensajes son de tamaño fijo, sin relleno y con enteros y flotantes
+ * little-endian, de modo que un lector recorta un flujo TCP sin buscar
+ * separadores:
+ *
+ *   Petición (12 bytes): id u32 | operación u8 | reservado u8 | reservado u16 | argumento i32
+ *   Respuesta (28 bytes): id u32 | operación u8 | resultado u8 | reservado u16 |
+ *             sensor i32 | temperatura f32 | humedad f32 | timestamp i64
+ *
+ * Las respuestas de una conexión pueden llegar en cualquier orden; el id
+ * las asocia a su petición, lo que permite encadenar peticiones sin
+ * esperar cada respuesta (pipelining).
+ */
+class ForecastProtocol {
+public:
+    static const size_t REQUEST_SIZE = 12;      ///< Bytes por petición
+    static const size_t RESPONSE_SIZE = 28;     ///< Bytes por respuesta
+
+    /**
+     * @brief Codifica una petición
+     * @param request Petición a codificar
+     * @param out Destino de REQUEST_SIZE bytes
+     */
+    static void encodeRequest(const ForecastRequest& request, uint8_t* out);
+
+    /**
+     * @brief Decodifica una petición
+     * @param in Mensaje de REQUEST_SIZE bytes
+     * @return Petición (la operación se valida al ejecutarla)
+     */
+    static ForecastRequest decodeRequest(const uint8_t* in);
+
+    /**
+     * @brief Codifica una respuesta
+     * @param response Respuesta a codificar
+     * @param out Destino de RESPONSE_SIZE bytes
+     */
+    static void encodeResponse(const ForecastResponse& response, uint8_t* out);
+
+    /**
+     * @brief Decodifica una respuesta
+     * @param in Mensaje de RESPONSE_SIZE bytes
+     * @return Respuesta
+     */
+    static ForecastResponse decodeResponse(const uint8_t* in);
+
+    /**
+     * @brief Indica si una operación es de lectura (idempotente)
+     * @param op Operación
+     * @return true para las lecturas, false para los comandos
+     */
+    static bool isRead(ForecastOp op);
+};
+
+#endif // FORECASTPROTOCOL_H
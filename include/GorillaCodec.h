@@ -0,0 +1,170 @@
+#ifndef GORILLACODEC_H
+#define GORILLACODEC_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Estado de compresión de la serie de un sensor
+ *
+ * Temperatura y humedad se comparan con el valor anterior del mismo
+ * sensor, no con la fila anterior: en un historial con varios sensores
+ * intercalados las filas vecinas son de series distintas.
+ */
+struct GorillaSeriesState {
+    uint32_t temperature;       ///< Bits del último valor de temperatura
+    uint32_t humidity;          ///< Bits del último valor de humedad
+    uint8_t temperatureLeading; ///< Ceros a la izquierda de la ventana de temperatura (0xFF = sin ventana)
+    uint8_t temperatureTrailing;///< Ceros a la derecha de la ventana de temperatura
+    uint8_t humidityLeading;    ///< Ceros a la izquierda de la ventana de humedad (0xFF = sin ventana)
+    uint8_t humidityTrailing;   ///< Ceros a la derecha de la ventana de humedad
+};
+
+/**
+ * @brief Compresor de lecturas al estilo Gorilla (Facebook, VLDB 2015)
+ *
+ * Escribe un flujo de bits con una fila por lectura:
+ *
+ *   - Timestamp: delta del delta respecto de la fila anterior, en zigzag.
+ *     '0' si es 0; '10' + 7 bits, '110' + 9 bits, '1110' + 12 bits,
+ *     '11110' + 32 bits o '11111' + 64 bits según su magnitud.
+ *   - Sensor: '0' si repite el salto de la fila anterior (un único sensor
+ *     o sensores en ronda); '10' + 8 bits con la diferencia en zigzag o
+ *     '11' + 32 bits con el valor.
+ *   - Temperatura y humedad: XOR con el valor anterior de la misma serie.
+ *     '0' si es igual; '10' + bits significativos si caben en la ventana
+ *     anterior; '11' + 5 bits de ceros a la izquierda + 5 bits de largo - 1
+ *     + bits significativos en otro caso.
+ *
+ * La compresión no tiene pérdida: se guardan los bits exactos de cada
+ * valor. Cada bloque empieza de cero (sin estado previo), así que los
+ * bloques se decodifican de forma independiente.
+ */
+class GorillaEncoder {
+public:
+    static const size_t SERIES_SLOTS = 256;     ///< Series distinguidas (sensor módulo SERIES_SLOTS)
+
+private:
+    std::vector<uint8_t>& out;      ///< Destino (se agrega al final)
+    uint64_t bitBuffer;             ///< Bits pendientes de escribir (los más recientes abajo)
+    unsigned bitCount;              ///< Cantidad de bits pendientes (< 8 entre llamadas)
+    size_t rows;                    ///< Filas escritas
+    int64_t previousTimestamp;      ///< Timestamp de la fila anterior
+    int64_t previousDelta;          ///< Delta de timestamp de la fila anterior
+    int32_t previousSensor;         ///< Sensor de la fila anterior
+    int32_t sensorStride;           ///< Salto de sensor de la fila anterior
+    GorillaSeriesState series[SERIES_SLOTS]; ///< Estado por serie
+
+    /**
+     * @brief Escribe los n bits bajos de value (n <= 32)
+     */
+    void writeBits(uint64_t value, unsigned n);
+
+    /**
+     * @brief Escribe un valor comprimido con XOR
+     */
+    void writeValue(uint32_t bits, uint32_t& previous, uint8_t& leading, uint8_t& trailing);
+
+public:
+    /**
+     * @brief Constructor
+     * @param output Buffer donde se agrega el flujo comprimido
+     */
+    explicit GorillaEncoder(std::vector<uint8_t>& output);
+
+    /**
+     * @brief Agrega una lectura al flujo
+     * @param timestamp Timestamp en segundos
+     * @param temperature Temperatura en °C
+     * @param humidity Humedad en %
+     * @param sensorId Sensor de la lectura
+     */
+    void append(int64_t timestamp, float temperature, float humidity, int32_t sensorId);
+
+    /**
+     * @brief Completa el último byte con ceros
+     *
+     * Debe llamarse una vez, después de la última fila.
+     */
+    void finish();
+
+    /**
+     * @brief Obtiene la cantidad de filas escritas
+     * @return Filas agregadas desde la construcción
+     */
+    size_t size() const { return rows; }
+};
+
+/**
+ * @brief Descompresor en streaming de un flujo de GorillaEncoder
+ *
+ * Decodifica de a tramos de filas sobre columnas provistas por el
+ * llamador, sin reservar memoria. Un flujo truncado o dañado no lee fuera
+ * del buffer: los bits faltantes se leen como ceros e isValid() devuelve
+ * false.
+ */
+class GorillaDecoder {
+private:
+    const uint8_t* data;            ///< Flujo comprimido
+    size_t dataSize;                ///< Bytes del flujo
+    size_t position;                ///< Próximo byte a cargar en cache (puede superar dataSize)
+    uint64_t cache;                 ///< Bits cargados, alineados a la izquierda
+    unsigned available;             ///< Bits válidos en cache
+    size_t rowsLeft;                ///< Filas que faltan decodificar
+    int64_t previousTimestamp;      ///< Timestamp de la fila anterior
+    int64_t previousDelta;          ///< Delta de timestamp de la fila anterior
+    int32_t previousSensor;         ///< Sensor de la fila anterior
+    int32_t sensorStride;           ///< Salto de sensor de la fila anterior
+    GorillaSeriesState series[GorillaEncoder::SERIES_SLOTS]; ///< Estado por serie
+
+    /**
+     * @brief Carga bytes hasta tener al menos 56 bits en cache
+     */
+    void refill();
+
+    /**
+     * @brief Lee n bits (1 <= n <= 56, requiere refill previo)
+     */
+    uint64_t readBits(unsigned n);
+
+    /**
+     * @brief Decodifica un valor comprimido con XOR
+     */
+    uint32_t readValue(uint32_t& previous, uint8_t& leading, uint8_t& trailing);
+
+public:
+    /**
+     * @brief Constructor
+     * @param stream Flujo comprimido
+     * @param size Bytes del flujo
+     * @param rows Filas que contiene el flujo
+     */
+    GorillaDecoder(const uint8_t* stream, size_t size, size_t rows);
+
+    /**
+     * @brief Decodifica las próximas filas
+     * @param timestamps Columna de destino de timestamps
+     * @param temperatures Columna de destino de temperaturas
+     * @param humidities Columna de destino de humedades
+     * @param sensorIds Columna de destino de sensores
+     * @param maxRows Capacidad de las columnas
+     * @return Filas decodificadas (0 al llegar al final)
+     */
+    size_t read(int64_t* timestamps, float* temperatures, float* humidities, int32_t* sensorIds,
+                size_t maxRows);
+
+    /**
+     * @brief Obtiene las filas que faltan decodificar
+     * @return Filas restantes
+     */
+    size_t remaining() const { return rowsLeft; }
+
+    /**
+     * @brief Indica si los bits leídos hasta ahora estaban dentro del flujo
+     * @return false si el flujo resultó más corto que sus filas
+     */
+    bool isValid() const;
+};
+
+#endif // GORILLACODEC_H
@@ -0,0 +1,33 @@
+#ifndef IEMAILTRANSPORT_H
+#define IEMAILTRANSPORT_H
+
+#include <string>
+
+/**
+ * @brief Interfaz para el transporte de emails
+ * 
+ * Esta interfaz abstrae la entrega de un email ya armado (por ejemplo
+ * a través de un servidor SMTP), de modo que EmailService no dependa
+ * de un transporte concreto. Aplica el principio de inversión de
+ * dependencias (SOLID).
+ */
+class IEmailTransport {
+public:
+    /**
+     * @brief Entrega un email
+     * @param from Remitente
+     * @param to Destinatario
+     * @param subject Asunto del email
+     * @param body Cuerpo del email
+     * @return true si se entregó exitosamente, false en caso contrario
+     */
+    virtual bool send(const std::string& from, const std::string& to,
+                      const std::string& subject, const std::string& body) = 0;
+    
+    /**
+     * @brief Destructor virtual
+     */
+    virtual ~IEmailTransport() {}
+};
+
+#endif // IEMAILTRANSPORT_H
@@ -1,6 +1,21 @@
 #ifndef IMSFORECAST_H
 #define IMSFORECAST_H
 
+#include <vector>
+#include <ctime>
+
+/**
+ * @brief Medición instantánea de un sensor devuelta por la API MS-Forecast
+ * 
+ * Temperatura y humedad se toman en el mismo instante de origen.
+ */
+struct ClimateSnapshot {
+    int sensorId;           ///< Identificador del sensor (0 = sensor por defecto)
+    float temperature;      ///< Temperatura en grados Celsius
+    float humidity;         ///< Humedad en porcentaje
+    time_t timestamp;       ///< Instante de la medición en el origen
+};
+
 /**
  * @brief Interfaz para la API MS-Forecast
  * 
@@ -50,6 +65,38 @@ public:
      */
     virtual float readHumidity() const = 0;
     
+    /**
+     * @brief Lee temperatura y humedad en una sola llamada
+     * 
+     * La implementación por defecto combina readTemp() y readHumidity();
+     * las implementaciones que hablan con la API real deberían hacerlo en
+     * una única petición para que ambos valores sean del mismo instante.
+     * @return Medición del sensor por defecto
+     */
+    virtual ClimateSnapshot readSnapshot() const {
+        ClimateSnapshot snapshot;
+        snapshot.sensorId = 0;
+        snapshot.temperature = readTemp();
+        snapshot.humidity = readHumidity();
+        snapshot.timestamp = time(nullptr);
+        return snapshot;
+    }
+    
+    /**
+     * @brief Lee varios sensores en una sola petición
+     * @param sensorIds Identificadores de los sensores a leer
+     * @param snapshots Mediciones en el mismo orden que sensorIds (salida); un
+     *        sensor que no se pudo leer queda con temperatura y humedad NaN
+     * @return true si el lote fue respondido, false si la API no soporta lecturas
+     *         por lote o la llamada completa falló
+     */
+    virtual bool readSnapshots(const std::vector<int>& sensorIds,
+                               std::vector<ClimateSnapshot>& snapshots) const {
+        (void)sensorIds;
+        snapshots.clear();
+        return false;
+    }
+    
     /**
      * @brief Destructor virtual
      */
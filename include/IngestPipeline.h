@@ -0,0 +1,211 @@
+#ifndef INGESTPIPELINE_H
+#define INGESTPIPELINE_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <cstdint>
+#include "ClimateReading.h"
+#include "MpscRingBuffer.h"
+#include "LatencyHistogram.h"
+
+/**
+ * @brief Pipeline de ingesta por etapas para las lecturas de los sensores
+ * 
+ * Los productores (lectores de sensores) encolan lecturas en una cola sin
+ * locks hacia la etapa de almacenamiento, que las guarda por lotes y las
+ * reenvía a la etapa de evaluación de alertas por una segunda cola. Cada
+ * etapa corre en su propio hilo y procesa todo lo disponible como un lote.
+ * Si una cola se llena, el paso anterior espera (backpressure) en lugar de
+ * descartar lecturas. Las etapas se reciben como funciones, de modo que
+ * pueden medirse por separado.
+ *
+ * Si la etapa de almacenamiento falla, el lote se reintenta con espera
+ * creciente; si sigue fallando se descarta con un error en el log y no
+ * llega a la etapa de alertas, que sólo evalúa lecturas guardadas. La
+ * latencia desde submit hasta el guardado se registra en el histograma
+ * clima_ingest_sensor_to_disk_seconds del MetricsRegistry.
+ */
+class IngestPipeline {
+public:
+    static const int STORAGE_ATTEMPTS = 3;      ///< Intentos de guardar un lote antes de descartarlo
+
+    typedef std::function<bool(const std::vector<ClimateReading>&)> StorageStage; ///< Guarda un lote
+    typedef std::function<void(const std::vector<ClimateReading>&)> AlertStage;   ///< Evalúa un lote
+
+    /**
+     * @brief Estadísticas acumuladas del pipeline
+     */
+    struct Stats {
+        uint64_t submitted;             ///< Lecturas aceptadas
+        uint64_t rejected;              ///< Lecturas rechazadas (cola llena o pipeline detenido)
+        uint64_t backpressureWaits;     ///< Veces que un paso esperó por una cola llena
+        uint64_t stored;                ///< Lecturas guardadas por la etapa de almacenamiento
+        uint64_t storageRetries;        ///< Reintentos de lotes que la etapa no pudo guardar
+        uint64_t storageFailures;       ///< Lotes descartados tras agotar los intentos
+        uint64_t dropped;               ///< Lecturas de los lotes descartados
+        uint64_t storageBatches;        ///< Lotes de almacenamiento
+        uint64_t evaluated;             ///< Lecturas procesadas por la etapa de alertas
+        uint64_t alertBatches;          ///< Lotes de alertas
+        size_t storageQueueDepth;       ///< Lecturas esperando almacenamiento
+        size_t alertQueueDepth;         ///< Lecturas esperando evaluación de alertas
+        double meanStorageBatch;        ///< Tamaño medio de lote guardado
+        double meanSensorToDiskMs;      ///< Latencia media desde submit hasta el guardado
+        double maxSensorToDiskMs;       ///< Latencia máxima desde submit hasta el guardado
+    };
+
+private:
+    /**
+     * @brief Lectura en tránsito hacia la etapa de almacenamiento
+     */
+    struct Entry {
+        ClimateReading reading;                             ///< Lectura
+        std::chrono::steady_clock::time_point submittedAt;  ///< Instante de ingreso
+    };
+
+    /**
+     * @brief Señal para despertar a una etapa ociosa
+     */
+    struct StageSignal {
+        std::mutex mutex;               ///< Protege la espera
+        std::condition_variable ready;  ///< Avisa que hay trabajo
+        std::atomic<bool> sleeping;     ///< Indica que la etapa está dormida
+    };
+
+    StorageStage storageStage;                  ///< Función de almacenamiento
+    AlertStage alertStage;                      ///< Función de evaluación de alertas
+    MpscRingBuffer<Entry> storageQueue;         ///< Productores -> almacenamiento
+    MpscRingBuffer<ClimateReading> alertQueue;  ///< Almacenamiento -> alertas
+    size_t maxBatch;                            ///< Tamaño máximo de lote
+    StageSignal storageSignal;                  ///< Despierta la etapa de almacenamiento
+    StageSignal alertSignal;                    ///< Despierta la etapa de alertas
+
+    std::thread storageThread;                  ///< Hilo de almacenamiento
+    std::thread alertThread;                    ///< Hilo de alertas
+    std::atomic<bool> running;                  ///< Indica si acepta lecturas
+    std::atomic<bool> storageDone;              ///< La etapa de almacenamiento terminó
+    std::atomic<int> activeSubmits;             ///< Productores encolando en este momento
+
+    std::atomic<uint64_t> submittedCount;       ///< Lecturas aceptadas
+    std::atomic<uint64_t> rejectedCount;        ///< Lecturas rechazadas
+    std::atomic<uint64_t> backpressureCount;    ///< Esperas por cola llena
+    std::atomic<uint64_t> storedCount;          ///< Lecturas almacenadas
+    std::atomic<uint64_t> storageRetryCount;    ///< Reintentos de lotes
+    std::atomic<uint64_t> storageFailureCount;  ///< Lotes descartados
+    std::atomic<uint64_t> droppedCount;         ///< Lecturas descartadas
+    std::atomic<uint64_t> storageBatchCount;    ///< Lotes de almacenamiento
+    std::atomic<uint64_t> evaluatedCount;       ///< Lecturas evaluadas
+    std::atomic<uint64_t> alertBatchCount;      ///< Lotes de alertas
+    std::atomic<uint64_t> latencySumMicros;     ///< Suma de latencias submit -> guardado
+    std::atomic<uint64_t> latencyMaxMicros;     ///< Latencia máxima submit -> guardado
+    LatencyHistogram& sensorToDiskLatency;      ///< Distribución de la latencia submit -> guardado
+
+    /**
+     * @brief Bucle de la etapa de almacenamiento
+     */
+    void storageLoop();
+
+    /**
+     * @brief Guarda un lote reintentando con espera creciente si falla
+     * @param batch Lote a guardar
+     * @return true si se guardó, false si se agotaron los intentos
+     */
+    bool storeWithRetry(const std::vector<ClimateReading>& batch);
+
+    /**
+     * @brief Encola una lectura registrándose como productor en curso
+     * @param reading Lectura a encolar
+     * @param wait true para esperar si la cola está llena
+     * @return true si se encoló, false si la cola está llena o el pipeline detenido
+     */
+    bool enqueue(const ClimateReading& reading, bool wait);
+
+    /**
+     * @brief Bucle de la etapa de evaluación de alertas
+     */
+    void alertLoop();
+
+    /**
+     * @brief Duerme la etapa hasta que haya trabajo o pase un intervalo corto
+     * @param signal Señal de la etapa
+     */
+    static void waitForWork(StageSignal& signal);
+
+    /**
+     * @brief Despierta la etapa si está dormida
+     * @param signal Señal de la etapa
+     */
+    static void wake(StageSignal& signal);
+
+public:
+    /**
+     * @brief Constructor
+     * @param storage Función que guarda un lote de lecturas
+     * @param alerts Función que evalúa las alertas de un lote (puede ser vacía)
+     * @param capacity Capacidad de cada cola
+     * @param batchSize Tamaño máximo de lote por etapa
+     */
+    IngestPipeline(StorageStage storage, AlertStage alerts,
+                   size_t capacity = 65536, size_t batchSize = 1024);
+
+    /**
+     * @brief Destructor, procesa las lecturas pendientes y detiene las etapas
+     */
+    ~IngestPipeline();
+
+    IngestPipeline(const IngestPipeline&) = delete;
+    IngestPipeline& operator=(const IngestPipeline&) = delete;
+
+    /**
+     * @brief Inicia los hilos de las etapas
+     */
+    void start();
+
+    /**
+     * @brief Deja de aceptar lecturas, procesa las pendientes y detiene las etapas
+     * 
+     * Una lectura que submit() aceptó en paralelo con stop() se procesa
+     * igual antes de que termine la etapa de almacenamiento.
+     */
+    void stop();
+
+    /**
+     * @brief Verifica si el pipeline acepta lecturas
+     * @return true si está activo, false en caso contrario
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Encola una lectura, esperando si la cola está llena (thread-safe)
+     * @param reading Lectura a procesar
+     * @return true si se encoló, false si el pipeline está detenido
+     */
+    bool submit(const ClimateReading& reading);
+
+    /**
+     * @brief Encola una lectura sin esperar (thread-safe)
+     * @param reading Lectura a procesar
+     * @return true si se encoló, false si la cola está llena o el pipeline detenido
+     */
+    bool trySubmit(const ClimateReading& reading);
+
+    /**
+     * @brief Espera a que las lecturas encoladas hasta ahora pasen por todas las etapas
+     * 
+     * Permite leer lo recién ingresado (por ejemplo antes de consultar el
+     * historial) sin detener el pipeline.
+     */
+    void drain();
+
+    /**
+     * @brief Obtiene las estadísticas acumuladas
+     * @return Contadores, profundidad de colas y latencia submit -> guardado
+     */
+    Stats getStats() const;
+};
+
+#endif // INGESTPIPELINE_H
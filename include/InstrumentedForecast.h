@@ -0,0 +1,50 @@
+#ifndef INSTRUMENTEDFORECAST_H
+#define INSTRUMENTEDFORECAST_H
+
+#include "IMSForecast.h"
+#include "MetricsRegistry.h"
+
+/**
+ * @brief Decorador de IMSForecast que mide cada llamada a la API
+ *
+ * Delega en otra implementación y registra la duración de cada llamada en
+ * el histograma clima_forecast_request_duration_seconds{op="..."} y los
+ * fallos (comandos de control rechazados y lecturas por lote no
+ * soportadas o fallidas) en clima_forecast_errors_total{op="..."}.
+ * No toma posesión de la implementación decorada.
+ */
+class InstrumentedForecast : public IMSForecast {
+private:
+    IMSForecast* inner;                     ///< Implementación decorada
+    LatencyHistogram& upTempLatency;        ///< Duración de upTemp
+    LatencyHistogram& downTempLatency;      ///< Duración de downTemp
+    LatencyHistogram& upHumidityLatency;    ///< Duración de upHumidity
+    LatencyHistogram& downHumidityLatency;  ///< Duración de downHumidity
+    LatencyHistogram& readTempLatency;      ///< Duración de readTemp
+    LatencyHistogram& readHumidityLatency;  ///< Duración de readHumidity
+    LatencyHistogram& readSnapshotLatency;  ///< Duración de readSnapshot
+    LatencyHistogram& readSnapshotsLatency; ///< Duración de readSnapshots
+    MetricCounter& controlErrors;           ///< Comandos de control fallidos
+    MetricCounter& batchErrors;             ///< Lecturas por lote fallidas
+
+public:
+    /**
+     * @brief Constructor
+     * @param forecast Implementación a decorar
+     * @param metrics Registro donde se publican las métricas
+     */
+    explicit InstrumentedForecast(IMSForecast* forecast,
+                                  MetricsRegistry& metrics = MetricsRegistry::instance());
+
+    bool upTemp(int x) override;
+    bool downTemp(int x) override;
+    bool upHumidity(int x) override;
+    bool downHumidity(int x) override;
+    float readTemp() const override;
+    float readHumidity() const override;
+    ClimateSnapshot readSnapshot() const override;
+    bool readSnapshots(const std::vector<int>& sensorIds,
+                       std::vector<ClimateSnapshot>& snapshots) const override;
+};
+
+#endif // INSTRUMENTEDFORECAST_H
@@ -0,0 +1,191 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Copia consolidada de un LatencyHistogram
+ */
+struct HistogramSnapshot {
+    std::vector<uint64_t> counts;   ///< Muestras por bucket (índice = LatencyHistogram::bucketIndex)
+    uint64_t count;                 ///< Total de muestras
+    uint64_t sumNanos;              ///< Suma de las latencias registradas
+    uint64_t maxNanos;              ///< Latencia máxima registrada
+
+    HistogramSnapshot() : count(0), sumNanos(0), maxNanos(0) {}
+
+    /**
+     * @brief Estima un percentil
+     * @param quantile Cuantil entre 0 y 1 (por ejemplo 0.99)
+     * @return Cota superior del bucket que contiene el cuantil, en nanosegundos (0 si no hay muestras)
+     */
+    uint64_t percentile(double quantile) const;
+
+    /**
+     * @brief Calcula la latencia media
+     * @return Media en nanosegundos (0 si no hay muestras)
+     */
+    double meanNanos() const { return count ? static_cast<double>(sumNanos) / count : 0.0; }
+
+    /**
+     * @brief Acumula otro snapshot
+     * @param other Snapshot a sumar
+     */
+    void merge(const HistogramSnapshot& other);
+};
+
+/**
+ * @brief Histograma de latencias log-lineal al estilo HDR
+ *
+ * Los valores se guardan en nanosegundos en buckets de ancho creciente:
+ * cada potencia de dos se divide en SUB_BUCKETS partes iguales, lo que da
+ * un error relativo menor al 3,2% desde 1 ns hasta MAX_TRACKABLE_NANOS
+ * (los valores mayores se cuentan en el último bucket).
+ *
+ * Cada hilo registra en su propio juego de contadores, creado en su primer
+ * uso igual que los buffers del Logger, por lo que record() no toma locks
+ * ni compite por líneas de caché con otros hilos. snapshot() suma los
+ * contadores de todos los hilos, incluidos los que ya terminaron.
+ */
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 5;                       ///< Bits de precisión por potencia de dos
+    static const size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;     ///< Buckets por potencia de dos
+    static const int MAX_EXPONENT = 40;                         ///< Mayor potencia de dos registrable
+    static const uint64_t MAX_TRACKABLE_NANOS = (uint64_t(1) << (MAX_EXPONENT + 1)) - 1; ///< ~36 minutos
+    static const size_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS; ///< Total de buckets
+
+private:
+    /**
+     * @brief Contadores de un hilo (un único escritor)
+     */
+    struct Shard {
+        std::atomic<uint64_t> counts[BUCKET_COUNT]; ///< Muestras por bucket
+        std::atomic<uint64_t> sumNanos;             ///< Suma de las latencias
+        std::atomic<uint64_t> maxNanos;             ///< Latencia máxima
+        Shard();
+    };
+
+    const uint64_t id;                              ///< Identificador único (nunca se reutiliza)
+    std::vector<std::shared_ptr<Shard>> shards;     ///< Contadores de todos los hilos
+    mutable std::mutex shardsMutex;                 ///< Protege la lista de contadores
+
+    /**
+     * @brief Obtiene los contadores del hilo actual, creándolos en el primer uso
+     * @return Contadores del hilo
+     */
+    Shard& localShard();
+
+    /**
+     * @brief Incrementa un contador con un solo escritor sin instrucciones atómicas de lectura-escritura
+     */
+    static void bump(std::atomic<uint64_t>& counter, uint64_t delta) {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+public:
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief Calcula el bucket de un valor
+     * @param nanos Latencia en nanosegundos
+     * @return Índice del bucket
+     */
+    static size_t bucketIndex(uint64_t nanos) {
+        if (nanos < SUB_BUCKETS) {
+            return static_cast<size_t>(nanos);
+        }
+        if (nanos > MAX_TRACKABLE_NANOS) {
+            return BUCKET_COUNT - 1;
+        }
+        const int exponent = 63 - __builtin_clzll(nanos);
+        const int shift = exponent - SUB_BUCKET_BITS;
+        return static_cast<size_t>(shift + 1) * SUB_BUCKETS + static_cast<size_t>((nanos >> shift) - SUB_BUCKETS);
+    }
+
+    /**
+     * @brief Obtiene el mayor valor que cae en un bucket
+     * @param index Índice del bucket
+     * @return Cota superior del bucket en nanosegundos
+     */
+    static uint64_t bucketUpperBound(size_t index);
+
+    /**
+     * @brief Registra una latencia
+     * @param nanos Latencia en nanosegundos
+     */
+    void record(uint64_t nanos) {
+        Shard& shard = localShard();
+        bump(shard.counts[bucketIndex(nanos)], 1);
+        bump(shard.sumNanos, nanos);
+        if (nanos > shard.maxNanos.load(std::memory_order_relaxed)) {
+            shard.maxNanos.store(nanos, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Suma los contadores de todos los hilos
+     * @return Copia consolidada del histograma
+     */
+    HistogramSnapshot snapshot() const;
+};
+
+/**
+ * @brief Contador monotónico
+ */
+class MetricCounter {
+private:
+    std::atomic<uint64_t> value;    ///< Valor acumulado
+
+public:
+    MetricCounter() : value(0) {}
+
+    MetricCounter(const MetricCounter&) = delete;
+    MetricCounter& operator=(const MetricCounter&) = delete;
+
+    /**
+     * @brief Incrementa el contador
+     * @param delta Cantidad a sumar
+     */
+    void increment(uint64_t delta = 1) { value.fetch_add(delta, std::memory_order_relaxed); }
+
+    /**
+     * @brief Obtiene el valor acumulado
+     * @return Valor del contador
+     */
+    uint64_t get() const { return value.load(std::memory_order_relaxed); }
+};
+
+/**
+ * @brief Registra en un histograma la duración del ámbito en que se declara
+ *
+ * Uso: { ScopedLatency timer(histograma); operacion(); }
+ */
+class ScopedLatency {
+private:
+    LatencyHistogram& histogram;                            ///< Histograma de destino
+    std::chrono::steady_clock::time_point start;           ///< Inicio de la medición
+
+public:
+    explicit ScopedLatency(LatencyHistogram& target)
+        : histogram(target), start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedLatency() {
+        histogram.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+    }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+};
+
+#endif // LATENCYHISTOGRAM_H
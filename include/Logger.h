@@ -0,0 +1,307 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+
+// Niveles de log utilizables en el preprocesador
+#define CLIMA_LOG_LEVEL_TRACE 0
+#define CLIMA_LOG_LEVEL_DEBUG 1
+#define CLIMA_LOG_LEVEL_INFO  2
+#define CLIMA_LOG_LEVEL_WARN  3
+#define CLIMA_LOG_LEVEL_ERROR 4
+#define CLIMA_LOG_LEVEL_OFF   5
+
+/**
+ * Nivel mínimo compilado. Las llamadas de niveles inferiores se eliminan
+ * en compilación (ni siquiera se evalúan sus argumentos). Se puede cambiar
+ * con -DCLIMA_LOG_MIN_LEVEL=<n> (make LOG_LEVEL=<n>).
+ */
+#ifndef CLIMA_LOG_MIN_LEVEL
+#define CLIMA_LOG_MIN_LEVEL CLIMA_LOG_LEVEL_INFO
+#endif
+
+/**
+ * @brief Nivel de severidad de un mensaje de log
+ */
+enum class LogLevel {
+    TRACE = CLIMA_LOG_LEVEL_TRACE,  ///< Detalle fino
+    DEBUG = CLIMA_LOG_LEVEL_DEBUG,  ///< Operaciones individuales
+    INFO = CLIMA_LOG_LEVEL_INFO,    ///< Ciclo de vida de los componentes
+    WARN = CLIMA_LOG_LEVEL_WARN,    ///< Situaciones anómalas recuperables
+    ERROR = CLIMA_LOG_LEVEL_ERROR   ///< Errores
+};
+
+/**
+ * @brief Formato de salida de los registros
+ */
+enum class LogFormat {
+    KEY_VALUE,  ///< ts=... level=INFO component=... msg="..." clave=valor
+    JSON        ///< Un objeto JSON por línea
+};
+
+/**
+ * @brief Escribe los campos de un registro en un buffer de tamaño fijo
+ * 
+ * Trunca el registro si no entra en el buffer; nunca reserva memoria.
+ */
+class LogRecordWriter {
+private:
+    char* data;         ///< Buffer de destino
+    size_t capacity;    ///< Tamaño del buffer
+    size_t length;      ///< Bytes escritos
+    bool json;          ///< Formato JSON en lugar de clave=valor
+
+    void appendRaw(const char* text, size_t size);
+    void appendChar(char c);
+    void appendQuoted(const char* text, size_t size);
+    void appendString(const char* text, size_t size);
+    void appendKey(const char* key);
+
+    void appendValue(const char* value);
+    void appendValue(const std::string& value);
+    void appendValue(bool value);
+    void appendValue(int value);
+    void appendValue(long value);
+    void appendValue(long long value);
+    void appendValue(unsigned int value);
+    void appendValue(unsigned long value);
+    void appendValue(unsigned long long value);
+    void appendValue(float value);
+    void appendValue(double value);
+
+public:
+    /**
+     * @brief Constructor
+     * @param buffer Buffer de destino
+     * @param size Tamaño del buffer
+     * @param jsonFormat true para JSON, false para clave=valor
+     */
+    LogRecordWriter(char* buffer, size_t size, bool jsonFormat);
+
+    /**
+     * @brief Agrega un campo clave/valor
+     * @param key Nombre del campo
+     * @param value Valor (texto, número o booleano)
+     */
+    template <typename V>
+    void field(const char* key, const V& value) {
+        appendKey(key);
+        appendValue(value);
+    }
+
+    /**
+     * @brief Obtiene la cantidad de bytes escritos
+     * @return Bytes escritos
+     */
+    size_t size() const { return length; }
+};
+
+/**
+ * @brief Logger asíncrono con niveles y salida estructurada
+ * 
+ * Cada hilo escribe en su propio buffer circular (un productor, un
+ * consumidor) sin tomar locks; un hilo de fondo vacía periódicamente
+ * todos los buffers, ordena los registros por tiempo y los escribe en la
+ * salida con un único flush por vuelta. Si el buffer de un hilo se llena
+ * el registro se descarta y se cuenta, de modo que el log nunca bloquea
+ * el camino caliente. Se usa a través de las macros LOG_*.
+ */
+class Logger {
+public:
+    static const size_t RECORD_SIZE = 256;      ///< Bytes por registro (incluye cabecera)
+    static const size_t BUFFER_RECORDS = 1024;  ///< Registros por hilo
+
+private:
+    /**
+     * @brief Registro pendiente de escritura
+     */
+    struct Record {
+        int64_t timestampMicros;                ///< Instante del registro (UTC)
+        uint8_t level;                          ///< Nivel
+        uint8_t json;                           ///< Formato con el que se escribió el texto
+        uint16_t length;                        ///< Bytes válidos en text
+        char text[RECORD_SIZE - 12];            ///< Campos ya formateados
+    };
+
+    /**
+     * @brief Buffer circular de un hilo
+     */
+    struct ThreadBuffer {
+        Record records[BUFFER_RECORDS];         ///< Registros
+        std::atomic<size_t> head;               ///< Próximo registro a escribir (productor)
+        std::atomic<size_t> tail;               ///< Próximo registro a leer (hilo de fondo)
+        ThreadBuffer() : head(0), tail(0) {}
+    };
+
+    static std::atomic<int> runtimeLevel;       ///< Nivel mínimo en ejecución
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers; ///< Buffers de todos los hilos
+    std::mutex registryMutex;                   ///< Protege la lista de buffers
+    std::mutex flushMutex;                      ///< Serializa los vaciados
+    FILE* output;                               ///< Salida actual
+    bool ownsOutput;                            ///< Indica si hay que cerrar la salida
+    std::atomic<int> format;                    ///< Formato de los nuevos registros
+    std::atomic<uint64_t> droppedCount;         ///< Registros descartados
+    std::atomic<bool> flushRequested;           ///< Un buffer pasó la mitad de su capacidad
+    std::atomic<bool> stopping;                 ///< Indica que el hilo de fondo debe terminar
+    std::mutex wakeMutex;                       ///< Protege la espera del hilo de fondo
+    std::condition_variable wakeUp;             ///< Despierta al hilo de fondo
+    std::thread flusher;                        ///< Hilo de fondo
+
+    Logger();
+    ~Logger();
+
+    /**
+     * @brief Obtiene el buffer del hilo actual, registrándolo en el primer uso
+     * @return Buffer del hilo
+     */
+    ThreadBuffer& localBuffer();
+
+    /**
+     * @brief Reserva el próximo registro del buffer del hilo
+     * @param buffer Buffer del hilo
+     * @return Registro a completar, o nullptr si el buffer está lleno
+     */
+    Record* reserve(ThreadBuffer& buffer);
+
+    /**
+     * @brief Publica el registro reservado para el hilo de fondo
+     * @param buffer Buffer del hilo
+     */
+    void publish(ThreadBuffer& buffer);
+
+    /**
+     * @brief Vacía todos los buffers en la salida (requiere flushMutex)
+     */
+    void drainLocked();
+
+    /**
+     * @brief Bucle del hilo de fondo
+     */
+    void flusherLoop();
+
+    static void appendFields(LogRecordWriter&) {}
+
+    template <typename V, typename... Rest>
+    static void appendFields(LogRecordWriter& writer, const char* key, const V& value, const Rest&... rest) {
+        writer.field(key, value);
+        appendFields(writer, rest...);
+    }
+
+public:
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    /**
+     * @brief Obtiene la instancia única del logger
+     * @return Logger del proceso
+     */
+    static Logger& instance();
+
+    /**
+     * @brief Verifica si un nivel está habilitado en ejecución
+     * @param level Nivel a verificar
+     * @return true si los mensajes de ese nivel se registran
+     */
+    static bool isEnabled(LogLevel level) {
+        return static_cast<int>(level) >= runtimeLevel.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Configura el nivel mínimo en ejecución (no puede bajar del compilado)
+     * @param level Nivel mínimo
+     */
+    static void setLevel(LogLevel level);
+
+    /**
+     * @brief Obtiene el nivel mínimo en ejecución
+     * @return Nivel mínimo
+     */
+    static LogLevel getLevel();
+
+    /**
+     * @brief Configura el formato de los registros
+     * @param logFormat Clave=valor o JSON por línea
+     */
+    void setFormat(LogFormat logFormat);
+
+    /**
+     * @brief Redirige la salida a un archivo (modo append)
+     * @param path Ruta del archivo, o cadena vacía para volver a stderr
+     * @return true si se abrió el archivo, false en caso contrario
+     */
+    bool setOutputFile(const std::string& path);
+
+    /**
+     * @brief Escribe de inmediato todos los registros pendientes
+     */
+    void flush();
+
+    /**
+     * @brief Obtiene la cantidad de registros descartados por buffers llenos
+     * @return Registros descartados
+     */
+    uint64_t getDroppedCount() const;
+
+    /**
+     * @brief Registra un mensaje con campos clave/valor
+     * @param level Nivel del mensaje
+     * @param component Componente que registra (por ejemplo "EmailService")
+     * @param message Mensaje descriptivo
+     * @param fields Pares clave, valor adicionales
+     */
+    template <typename... Fields>
+    void log(LogLevel level, const char* component, const char* message, const Fields&... fields) {
+        ThreadBuffer& buffer = localBuffer();
+        Record* record = reserve(buffer);
+        if (record == nullptr) {
+            ++droppedCount;
+            return;
+        }
+
+        bool json = format.load(std::memory_order_relaxed) == static_cast<int>(LogFormat::JSON);
+        record->timestampMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        record->level = static_cast<uint8_t>(level);
+        record->json = json;
+
+        LogRecordWriter writer(record->text, sizeof(record->text), json);
+        writer.field("component", component);
+        writer.field("msg", message);
+        appendFields(writer, fields...);
+        record->length = static_cast<uint16_t>(writer.size());
+
+        publish(buffer);
+    }
+};
+
+/**
+ * Macros de log. El nivel se descarta en compilación si está por debajo de
+ * CLIMA_LOG_MIN_LEVEL y en ejecución con una sola lectura atómica; en ambos
+ * casos los argumentos no se evalúan.
+ *
+ * Uso: LOG_INFO("EmailService", "Email enviado", "to", destinatario, "ms", 12);
+ */
+#define CLIMA_LOG(levelValue, level, ...)                                          \
+    do {                                                                           \
+        if ((levelValue) >= CLIMA_LOG_MIN_LEVEL && Logger::isEnabled(level)) {     \
+            Logger::instance().log(level, __VA_ARGS__);                            \
+        }                                                                          \
+    } while (0)
+
+#define LOG_TRACE(...) CLIMA_LOG(CLIMA_LOG_LEVEL_TRACE, LogLevel::TRACE, __VA_ARGS__)
+#define LOG_DEBUG(...) CLIMA_LOG(CLIMA_LOG_LEVEL_DEBUG, LogLevel::DEBUG, __VA_ARGS__)
+#define LOG_INFO(...)  CLIMA_LOG(CLIMA_LOG_LEVEL_INFO, LogLevel::INFO, __VA_ARGS__)
+#define LOG_WARN(...)  CLIMA_LOG(CLIMA_LOG_LEVEL_WARN, LogLevel::WARN, __VA_ARGS__)
+#define LOG_ERROR(...) CLIMA_LOG(CLIMA_LOG_LEVEL_ERROR, LogLevel::ERROR, __VA_ARGS__)
+
+#endif // LOGGER_H
@@ -0,0 +1,234 @@
+#ifndef MSFORECASTCLIENT_H
+#define MSFORECASTCLIENT_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "IMSForecast.h"
+#include "ForecastProtocol.h"
+
+/**
+ * @brief Configuración del cliente de red de la API MS-Forecast
+ */
+struct ForecastClientConfig {
+    std::string host;                           ///< Dirección IPv4 del servidor
+    uint16_t port;                              ///< Puerto TCP del servidor
+    size_t poolSize;                            ///< Conexiones persistentes
+    std::chrono::milliseconds connectTimeout;   ///< Tiempo máximo para conectar
+    std::chrono::milliseconds attemptTimeout;   ///< Tiempo máximo de espera de cada intento
+    std::chrono::milliseconds deadline;         ///< Tiempo máximo de una llamada, reintentos incluidos
+    int maxRetries;                             ///< Reintentos por llamada como máximo
+    std::chrono::milliseconds backoffBase;      ///< Espera base entre reintentos (se duplica en cada uno)
+    std::chrono::milliseconds backoffMax;       ///< Espera máxima entre reintentos
+
+    /**
+     * @brief Constructor con los valores por defecto (servidor local en el puerto 7070)
+     */
+    ForecastClientConfig();
+};
+
+/**
+ * @brief Contadores del cliente de red
+ */
+struct ForecastClientStats {
+    uint64_t calls;             ///< Llamadas a la interfaz
+    uint64_t requests;          ///< Peticiones enviadas (intentos incluidos)
+    uint64_t retries;           ///< Reintentos
+    uint64_t timeouts;          ///< Intentos sin respuesta a tiempo
+    uint64_t failures;          ///< Llamadas que fallaron tras agotar los reintentos o el deadline
+    uint64_t connects;          ///< Conexiones abiertas (la primera de cada ranura y las reconexiones)
+};
+
+/**
+ * @brief Cliente de red de la API MS-Forecast
+ *
+ * Implementa IMSForecast sobre el protocolo de ForecastProtocol con un
+ * pool de conexiones TCP persistentes que se abren a demanda y se
+ * reabren si se pierden. Las llamadas se reparten entre las conexiones y
+ * comparten cada una sin esperar turno: cada petición lleva un id y un
+ * hilo lector por conexión entrega cada respuesta a quien la espera, de
+ * modo que muchas llamadas concurrentes viajan encadenadas (pipelining).
+ * readSnapshots() envía la petición de cada sensor en una sola escritura.
+ *
+ * Cada llamada tiene un deadline total y cada intento un timeout propio.
+ * Las lecturas son idempotentes y se reintentan ante un timeout o una
+ * conexión perdida; los comandos (upTemp, etc.) sólo se reintentan si la
+ * petición no llegó a enviarse, para no aplicar dos veces un cambio que
+ * el servidor pudo haber ejecutado. Entre reintentos se espera un tiempo
+ * aleatorio entre 0 y un máximo que se duplica en cada intento (full
+ * jitter), para que los clientes no reintenten todos a la vez.
+ *
+ * Si una lectura falla, readTemp() y readHumidity() devuelven NaN y
+ * readSnapshot() una medición con valores NaN. Es thread-safe.
+ */
+class MSForecastClient : public IMSForecast {
+private:
+    /**
+     * @brief Llamada en espera de sus respuestas
+     */
+    struct Call {
+        std::condition_variable completed;  ///< Avisa que llegaron todas las respuestas o se perdió la conexión
+        size_t remaining;                   ///< Respuestas pendientes
+        bool lost;                          ///< La conexión se perdió antes de completarla
+    };
+
+    /**
+     * @brief Respuesta esperada
+     */
+    struct Pending {
+        Call* call;                         ///< Llamada a la que pertenece
+        ForecastResponse* response;         ///< Destino de la respuesta
+    };
+
+    /**
+     * @brief Conexión del pool
+     */
+    struct Connection {
+        int fd;                                         ///< Socket (-1 = cerrada)
+        bool broken;                                    ///< El lector detectó un error; hay que reconectar
+        uint64_t generation;                            ///< Cambia en cada reconexión
+        uint32_t nextId;                                ///< Próximo id de petición
+        std::unordered_map<uint32_t, Pending> pending;  ///< Respuestas esperadas por id
+        std::thread reader;                             ///< Hilo lector
+        std::mutex mutex;                               ///< Protege el estado y las respuestas esperadas
+        std::mutex writeMutex;                          ///< Serializa las escrituras en el socket
+        std::mutex connectMutex;                        ///< Serializa las reconexiones
+
+        Connection() : fd(-1), broken(false), generation(0), nextId(1) {}
+    };
+
+    /**
+     * @brief Resultado de un intento
+     */
+    enum class AttemptResult {
+        OK,             ///< Llegaron todas las respuestas
+        NOT_SENT,       ///< No se pudo conectar o enviar; el servidor no recibió nada
+        LOST,           ///< La conexión se perdió con la petición enviada
+        TIMEOUT         ///< No llegaron las respuestas a tiempo
+    };
+
+    ForecastClientConfig config;                            ///< Configuración
+    std::vector<std::unique_ptr<Connection>> pool;          ///< Conexiones
+    mutable std::atomic<size_t> nextConnection;             ///< Reparto de las llamadas (round robin)
+
+    mutable std::atomic<uint64_t> callCount;                ///< Llamadas
+    mutable std::atomic<uint64_t> requestCount;             ///< Peticiones enviadas
+    mutable std::atomic<uint64_t> retryCount;               ///< Reintentos
+    mutable std::atomic<uint64_t> timeoutCount;             ///< Intentos vencidos
+    mutable std::atomic<uint64_t> failureCount;             ///< Llamadas fallidas
+    mutable std::atomic<uint64_t> connectCount;             ///< Conexiones abiertas
+
+    /**
+     * @brief Abre la conexión si está cerrada o rota
+     * @param connection Conexión del pool
+     * @return true si quedó conectada, false si no se pudo conectar
+     */
+    bool ensureConnected(Connection& connection) const;
+
+    /**
+     * @brief Abre un socket al servidor con el timeout de conexión
+     * @return Socket conectado, o -1 si falló
+     */
+    int openSocket() const;
+
+    /**
+     * @brief Bucle del hilo lector de una conexión
+     * @param connection Conexión leída
+     * @param fd Socket de la conexión
+     */
+    static void readLoop(Connection* connection, int fd);
+
+    /**
+     * @brief Cierra la conexión y espera a su hilo lector
+     */
+    static void closeConnection(Connection& connection);
+
+    /**
+     * @brief Envía peticiones por una conexión y espera sus respuestas
+     * @param connection Conexión a usar
+     * @param requests Peticiones (se completa su id)
+     * @param responses Respuestas en el mismo orden (salida)
+     * @param count Cantidad de peticiones
+     * @param until Instante límite del intento
+     * @return Resultado del intento
+     */
+    AttemptResult attempt(Connection& connection, ForecastRequest* requests, ForecastResponse* responses,
+                          size_t count, std::chrono::steady_clock::time_point until) const;
+
+    /**
+     * @brief Ejecuta peticiones con deadline y reintentos
+     * @param requests Peticiones
+     * @param responses Respuestas en el mismo orden (salida)
+     * @param count Cantidad de peticiones
+     * @return true si llegaron todas las respuestas, false en caso contrario
+     */
+    bool execute(ForecastRequest* requests, ForecastResponse* responses, size_t count) const;
+
+    /**
+     * @brief Ejecuta un comando
+     * @return true si el servidor lo ejecutó y la API lo aceptó
+     */
+    bool command(ForecastOp op, int amount);
+
+    /**
+     * @brief Ejecuta una lectura del sensor por defecto
+     * @param op Operación de lectura
+     * @param snapshot Medición (salida; NaN si falló)
+     * @return true si se leyó, false en caso contrario
+     */
+    bool read(ForecastOp op, ClimateSnapshot& snapshot) const;
+
+public:
+    /**
+     * @brief Constructor (no conecta hasta la primera llamada)
+     * @param clientConfig Servidor, pool, timeouts y reintentos
+     */
+    explicit MSForecastClient(const ForecastClientConfig& clientConfig = ForecastClientConfig());
+
+    /**
+     * @brief Destructor, cierra las conexiones
+     */
+    ~MSForecastClient();
+
+    MSForecastClient(const MSForecastClient&) = delete;
+    MSForecastClient& operator=(const MSForecastClient&) = delete;
+
+    bool upTemp(int x) override;
+    bool downTemp(int x) override;
+    bool upHumidity(int x) override;
+    bool downHumidity(int x) override;
+    float readTemp() const override;
+    float readHumidity() const override;
+    ClimateSnapshot readSnapshot() const override;
+
+    /**
+     * @brief Lee varios sensores encadenando una petición por sensor en una sola escritura
+     * @param sensorIds Identificadores de los sensores a leer
+     * @param snapshots Mediciones en el mismo orden que sensorIds (salida); los
+     *        sensores que fallaron quedan con temperatura y humedad NaN
+     * @return true si el lote fue respondido, false si la llamada completa falló
+     */
+    bool readSnapshots(const std::vector<int>& sensorIds,
+                       std::vector<ClimateSnapshot>& snapshots) const override;
+
+    /**
+     * @brief Obtiene los contadores
+     * @return Llamadas, peticiones, reintentos, timeouts, fallas y conexiones
+     */
+    ForecastClientStats getStats() const;
+
+    /**
+     * @brief Obtiene la configuración
+     * @return Configuración
+     */
+    const ForecastClientConfig& getConfig() const { return config; }
+};
+
+#endif // MSFORECASTCLIENT_H
@@ -1,19 +1,76 @@
 #ifndef MSFORECASTMOCK_H
 #define MSFORECASTMOCK_H
 
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include "IMSForecast.h"
 
+/**
+ * @brief Parámetros de la planta térmica simulada
+ *
+ * Con la planta activa, los comandos no cambian la temperatura de
+ * inmediato: mueven un actuador (potencia de calefacción/refrigeración y
+ * de humidificación, en pasos enteros) y la sala se acerca a su nuevo
+ * equilibrio con una respuesta de primer orden.
+ */
+struct ThermalPlant {
+    float ambientTemperature;           ///< Equilibrio sin actuación (carga de IT incluida), °C
+    float ambientHumidity;              ///< Equilibrio de humedad sin actuación, %
+    float degreesPerStep;               ///< Cambio del equilibrio por paso de upTemp/downTemp, °C
+    float humidityPerStep;              ///< Cambio del equilibrio por paso de upHumidity/downHumidity, %
+    float temperatureTimeConstantSec;   ///< Constante de tiempo térmica
+    float humidityTimeConstantSec;      ///< Constante de tiempo de la humedad
+    double timeScale;                   ///< Segundos simulados por segundo real (0 = sólo advancePlant)
+
+    /**
+     * @brief Constructor con una sala típica
+     */
+    ThermalPlant();
+};
+
 /**
  * @brief Implementación mock de la API MS-Forecast
  * 
  * Esta clase simula el comportamiento de la API MS-Forecast
- * para propósitos de desarrollo y testing.
+ * para propósitos de desarrollo y testing. Simula una fila de racks:
+ * cada sensor devuelve el clima base con un pequeño desvío fijo según
+ * su ID (el sensor 0 devuelve exactamente el clima base).
  * Implementa la interfaz IMSForecast.
  */
 class MSForecastMock : public IMSForecast {
 private:
-    float currentTemp;      ///< Temperatura actual simulada
-    float currentHumidity;  ///< Humedad actual simulada
+    mutable float currentTemp;      ///< Temperatura actual simulada
+    mutable float currentHumidity;  ///< Humedad actual simulada
+    mutable std::mutex stateMutex;              ///< Hace consistentes las mediciones
+    mutable std::atomic<uint64_t> requestCount; ///< Peticiones atendidas
+    
+    bool plantEnabled;              ///< Indica si se simula la planta térmica
+    ThermalPlant plant;             ///< Parámetros de la planta
+    int heatingSteps;               ///< Actuador de temperatura (positivo = calefacción)
+    int humidifierSteps;            ///< Actuador de humedad (positivo = humidificación)
+    float heatLoad;                 ///< Perturbación sobre el equilibrio de temperatura, °C
+    mutable std::chrono::steady_clock::time_point plantClock; ///< Último avance en tiempo real
+    
+    /**
+     * @brief Avanza la planta el tiempo simulado indicado (requiere stateMutex)
+     * @param seconds Segundos simulados
+     */
+    void advanceLocked(double seconds) const;
+    
+    /**
+     * @brief Avanza la planta según el tiempo real transcurrido (requiere stateMutex)
+     */
+    void syncPlantLocked() const;
+    
+    /**
+     * @brief Arma la medición de un sensor (requiere stateMutex)
+     * @param sensorId Identificador del sensor
+     * @param now Instante de la medición
+     * @return Medición simulada
+     */
+    ClimateSnapshot snapshotLocked(int sensorId, time_t now) const;
 
 public:
     /**
@@ -61,6 +118,48 @@ public:
      * @return Humedad actual en porcentaje
      */
     float readHumidity() const override;
+    
+    /**
+     * @brief Lee temperatura y humedad simuladas en una sola petición
+     * @return Medición del sensor por defecto
+     */
+    ClimateSnapshot readSnapshot() const override;
+    
+    /**
+     * @brief Lee varios sensores simulados en una sola petición
+     * @param sensorIds Identificadores de los sensores a leer
+     * @param snapshots Mediciones en el mismo orden que sensorIds (salida)
+     * @return true siempre (simulación exitosa)
+     */
+    bool readSnapshots(const std::vector<int>& sensorIds,
+                       std::vector<ClimateSnapshot>& snapshots) const override;
+    
+    /**
+     * @brief Activa la planta térmica simulada
+     *
+     * Parte del clima actual con los actuadores en cero. Desde entonces
+     * upTemp/downTemp y upHumidity/downHumidity mueven los actuadores.
+     * @param thermalPlant Parámetros de la planta
+     */
+    void enableThermalPlant(const ThermalPlant& thermalPlant = ThermalPlant());
+    
+    /**
+     * @brief Avanza la planta térmica sin esperar (para simulaciones fuera de línea)
+     * @param seconds Segundos simulados
+     */
+    void advancePlant(double seconds);
+    
+    /**
+     * @brief Cambia la perturbación de la planta (por ejemplo, más carga de IT)
+     * @param degrees Desplazamiento del equilibrio de temperatura, °C
+     */
+    void setHeatLoad(float degrees);
+    
+    /**
+     * @brief Obtiene la cantidad de peticiones atendidas
+     * @return Peticiones desde la creación (cada lectura o control cuenta una)
+     */
+    uint64_t getRequestCount() const;
 };
 
 #endif // MSFORECASTMOCK_H 
\ No newline at end of file
@@ -0,0 +1,154 @@
+#ifndef MSFORECASTSERVER_H
+#define MSFORECASTSERVER_H
+
+#include <string>
+#include <list>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "IMSForecast.h"
+#include "ForecastProtocol.h"
+
+/**
+ * @brief Fallas simuladas por el servidor local
+ */
+struct ServerFaults {
+    std::chrono::microseconds responseDelay;    ///< Demora antes de responder cada tanda de peticiones
+    uint32_t dropEvery;                         ///< Una de cada N peticiones queda sin respuesta (0 = ninguna)
+
+    /**
+     * @brief Constructor sin fallas
+     */
+    ServerFaults();
+};
+
+/**
+ * @brief Contadores del servidor local
+ */
+struct ForecastServerStats {
+    uint64_t connections;       ///< Conexiones aceptadas
+    uint64_t requests;          ///< Peticiones recibidas
+    uint64_t dropped;           ///< Peticiones descartadas sin respuesta (fallas simuladas)
+};
+
+/**
+ * @brief Servidor local del protocolo MS-Forecast
+ *
+ * Reemplaza a la API real en pruebas y benchmarks: atiende el protocolo
+ * de ForecastProtocol sobre TCP y ejecuta cada petición contra un
+ * IMSForecast (normalmente MSForecastMock), que debe ser thread-safe.
+ *
+ * Un hilo acepta conexiones y cada conexión tiene su propio hilo, que lee
+ * todas las peticiones disponibles de una vez, agrupa las lecturas
+ * consecutivas de mediciones en una sola llamada a readSnapshots() y
+ * envía las respuestas de la tanda juntas. Con setFaults() se pueden
+ * simular demoras y peticiones perdidas para ejercitar los timeouts y
+ * reintentos del cliente.
+ */
+class MSForecastServer {
+private:
+    /**
+     * @brief Conexión atendida
+     */
+    struct Session {
+        int fd;                         ///< Socket del cliente (lo cierra quien une el hilo)
+        std::thread worker;             ///< Hilo de la conexión
+        std::atomic<bool> finished;     ///< El hilo terminó y puede unirse
+
+        Session() : fd(-1), finished(false) {}
+    };
+
+    IMSForecast* backend;                       ///< API que ejecuta las peticiones (no se libera)
+    int listenFd;                               ///< Socket de escucha (-1 = detenido)
+    uint16_t listenPort;                        ///< Puerto efectivo
+    std::atomic<bool> stopping;                 ///< Indica que los hilos deben terminar
+    std::thread acceptThread;                   ///< Hilo que acepta conexiones
+    std::list<Session> sessions;                ///< Conexiones abiertas
+    std::mutex sessionsMutex;                   ///< Protege las conexiones
+    ServerFaults faults;                        ///< Fallas simuladas vigentes
+    std::mutex faultsMutex;                     ///< Protege las fallas simuladas
+
+    std::atomic<uint64_t> connectionCount;      ///< Conexiones aceptadas
+    std::atomic<uint64_t> requestCount;         ///< Peticiones recibidas
+    std::atomic<uint64_t> droppedCount;         ///< Peticiones descartadas
+
+    /**
+     * @brief Bucle del hilo que acepta conexiones
+     */
+    void acceptLoop();
+
+    /**
+     * @brief Atiende una conexión hasta que el cliente la cierra o el servidor se detiene
+     * @param session Conexión a atender
+     */
+    void serve(Session& session);
+
+    /**
+     * @brief Une y cierra las conexiones terminadas
+     * @param all true para cerrar también las activas (al detener)
+     */
+    void reapSessions(bool all);
+
+    /**
+     * @brief Ejecuta una tanda de peticiones y codifica sus respuestas
+     * @param in Peticiones codificadas
+     * @param count Cantidad de peticiones
+     * @param dropEvery Una de cada N peticiones queda sin respuesta (0 = ninguna)
+     * @param sensorIds Memoria de trabajo para las lecturas agrupadas
+     * @param snapshots Memoria de trabajo para las lecturas agrupadas
+     * @param out Respuestas codificadas (se agregan al final)
+     */
+    void execute(const uint8_t* in, size_t count, uint32_t dropEvery, std::vector<int>& sensorIds,
+                 std::vector<ClimateSnapshot>& snapshots, std::vector<uint8_t>& out);
+
+public:
+    /**
+     * @brief Constructor
+     * @param forecast API que ejecuta las peticiones (no se libera)
+     */
+    explicit MSForecastServer(IMSForecast* forecast);
+
+    /**
+     * @brief Destructor (detiene el servidor)
+     */
+    ~MSForecastServer();
+
+    MSForecastServer(const MSForecastServer&) = delete;
+    MSForecastServer& operator=(const MSForecastServer&) = delete;
+
+    /**
+     * @brief Inicia el servidor
+     * @param port Puerto TCP (0 = elegir uno libre; ver getPort)
+     * @param address Dirección IPv4 donde escuchar (por defecto sólo local)
+     * @return true si se inició, false si ya estaba activo o no se pudo abrir el puerto
+     */
+    bool start(uint16_t port, const std::string& address = "127.0.0.1");
+
+    /**
+     * @brief Obtiene el puerto en el que escucha
+     * @return Puerto, o 0 si el servidor no está activo
+     */
+    uint16_t getPort() const;
+
+    /**
+     * @brief Detiene el servidor y cierra todas las conexiones
+     */
+    void stop();
+
+    /**
+     * @brief Cambia las fallas simuladas (rige desde la próxima tanda de peticiones)
+     * @param serverFaults Fallas a simular
+     */
+    void setFaults(const ServerFaults& serverFaults);
+
+    /**
+     * @brief Obtiene los contadores
+     * @return Conexiones, peticiones y peticiones descartadas
+     */
+    ForecastServerStats getStats() const;
+};
+
+#endif // MSFORECASTSERVER_H
@@ -0,0 +1,103 @@
+#ifndef METRICSEXPORTER_H
+#define METRICSEXPORTER_H
+
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+#include "MetricsRegistry.h"
+
+/**
+ * @brief Exporta periódicamente un MetricsRegistry en formato Prometheus
+ *
+ * Puede escribir el texto de exposición en un archivo cada cierto
+ * intervalo (reemplazándolo de forma atómica, apto para el textfile
+ * collector de node_exporter) y/o servirlo por HTTP en GET /metrics en
+ * una dirección local. Cada salida usa su propio hilo de fondo; ninguna
+ * interviene en el registro de las mediciones.
+ */
+class MetricsExporter {
+private:
+    MetricsRegistry& registry;                  ///< Métricas a exportar
+    std::string filePath;                       ///< Archivo de destino
+    unsigned fileIntervalMs;                    ///< Intervalo entre escrituras
+    int listenFd;                               ///< Socket del servidor HTTP (-1 = detenido)
+    uint16_t httpPort;                          ///< Puerto efectivo del servidor HTTP
+    std::atomic<bool> stopping;                 ///< Indica que los hilos deben terminar
+    std::mutex wakeMutex;                       ///< Protege la espera del hilo de archivo
+    std::condition_variable wakeUp;             ///< Despierta al hilo de archivo
+    std::thread fileThread;                     ///< Hilo de escritura del archivo
+    std::thread httpThread;                     ///< Hilo del servidor HTTP
+
+    /**
+     * @brief Bucle del hilo de archivo
+     */
+    void fileLoop();
+
+    /**
+     * @brief Bucle del servidor HTTP
+     */
+    void httpLoop();
+
+    /**
+     * @brief Atiende una conexión HTTP y la cierra
+     * @param clientFd Socket del cliente
+     */
+    void serveClient(int clientFd);
+
+public:
+    /**
+     * @brief Constructor
+     * @param metrics Registro a exportar
+     */
+    explicit MetricsExporter(MetricsRegistry& metrics = MetricsRegistry::instance());
+
+    /**
+     * @brief Destructor (detiene las exportaciones)
+     */
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    /**
+     * @brief Escribe una vez el texto de exposición en un archivo
+     *
+     * Escribe en <path>.tmp y lo renombra, de modo que un lector nunca ve
+     * un archivo a medio escribir.
+     * @param path Ruta del archivo
+     * @return true si se escribió, false en caso contrario
+     */
+    bool writeFile(const std::string& path) const;
+
+    /**
+     * @brief Inicia la escritura periódica a un archivo
+     * @param path Ruta del archivo
+     * @param intervalMs Intervalo entre escrituras en milisegundos
+     * @return true si se inició, false si ya estaba activa o los parámetros son inválidos
+     */
+    bool startFileExport(const std::string& path, unsigned intervalMs = 10000);
+
+    /**
+     * @brief Inicia el servidor HTTP de métricas
+     * @param port Puerto TCP (0 = elegir uno libre; ver getHttpPort)
+     * @param address Dirección IPv4 donde escuchar (por defecto sólo local)
+     * @return true si se inició, false si ya estaba activo o no se pudo abrir el puerto
+     */
+    bool startHttpServer(uint16_t port, const std::string& address = "127.0.0.1");
+
+    /**
+     * @brief Obtiene el puerto en el que escucha el servidor HTTP
+     * @return Puerto, o 0 si el servidor no está activo
+     */
+    uint16_t getHttpPort() const;
+
+    /**
+     * @brief Detiene las exportaciones; el archivo se escribe una última vez
+     */
+    void stop();
+};
+
+#endif // METRICSEXPORTER_H
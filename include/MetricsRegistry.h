@@ -0,0 +1,91 @@
+#ifndef METRICSREGISTRY_H
+#define METRICSREGISTRY_H
+
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "LatencyHistogram.h"
+
+/**
+ * @brief Registro de las métricas del proceso
+ *
+ * Agrupa histogramas de latencia y contadores por nombre y etiquetas, y
+ * los exporta en el formato de texto de Prometheus. Las métricas se crean
+ * en su primer uso y viven hasta el final del proceso, por lo que las
+ * referencias devueltas pueden guardarse (por ejemplo en una variable
+ * static local) y usarse desde cualquier hilo.
+ *
+ * Uso:
+ *   static LatencyHistogram& latencia = MetricsRegistry::instance().histogram(
+ *       "clima_storage_operation_duration_seconds", "Duración de las operaciones", "op=\"insertReading\"");
+ *   ScopedLatency timer(latencia);
+ */
+class MetricsRegistry {
+private:
+    /**
+     * @brief Métricas de un mismo nombre
+     */
+    struct Family {
+        std::string help;                                               ///< Descripción
+        std::map<std::string, std::unique_ptr<LatencyHistogram>> histograms; ///< Histogramas por etiquetas
+        std::map<std::string, std::unique_ptr<MetricCounter>> counters;      ///< Contadores por etiquetas
+    };
+
+    std::map<std::string, Family> families;     ///< Familias ordenadas por nombre
+    mutable std::mutex familiesMutex;           ///< Protege el registro (no las mediciones)
+
+public:
+    MetricsRegistry() {}
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    /**
+     * @brief Obtiene el registro del proceso
+     * @return Registro único
+     */
+    static MetricsRegistry& instance();
+
+    /**
+     * @brief Obtiene o crea un histograma de latencias
+     * @param name Nombre de la métrica (se exporta en segundos, por convención terminado en _seconds)
+     * @param help Descripción de la métrica
+     * @param labels Etiquetas ya formateadas, por ejemplo op="readSnapshot" (vacío = sin etiquetas)
+     * @return Histograma, válido mientras exista el registro
+     */
+    LatencyHistogram& histogram(const std::string& name, const std::string& help,
+                                const std::string& labels = "");
+
+    /**
+     * @brief Obtiene o crea un contador
+     * @param name Nombre de la métrica (por convención terminado en _total)
+     * @param help Descripción de la métrica
+     * @param labels Etiquetas ya formateadas (vacío = sin etiquetas)
+     * @return Contador, válido mientras exista el registro
+     */
+    MetricCounter& counter(const std::string& name, const std::string& help,
+                           const std::string& labels = "");
+
+    /**
+     * @brief Busca un histograma existente sin crearlo
+     * @param name Nombre de la métrica
+     * @param labels Etiquetas ya formateadas
+     * @param snapshot Copia consolidada del histograma (salida)
+     * @return true si el histograma existe, false en caso contrario
+     */
+    bool getHistogram(const std::string& name, const std::string& labels, HistogramSnapshot& snapshot) const;
+
+    /**
+     * @brief Genera el texto de exposición de Prometheus
+     *
+     * Cada histograma se exporta como summary (cuantiles 0.5, 0.9, 0.99 y
+     * 0.999, _sum y _count, en segundos) más un gauge <nombre>_max con la
+     * latencia máxima; los contadores se exportan como counter. Los valores
+     * son acumulados desde el inicio del proceso.
+     * @return Texto en formato de exposición 0.0.4
+     */
+    std::string renderPrometheus() const;
+};
+
+#endif // METRICSREGISTRY_H
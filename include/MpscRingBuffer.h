@@ -0,0 +1,145 @@
+#ifndef MPSCRINGBUFFER_H
+#define MPSCRINGBUFFER_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Cola circular acotada sin locks para varios productores y un consumidor
+ * 
+ * Cada celda lleva un número de secuencia que indica si está libre para
+ * el productor de la vuelta actual o lista para el consumidor. Los
+ * productores reservan una posición con un compare-and-swap y publican el
+ * valor con un store release; el consumidor único no necesita operaciones
+ * atómicas de lectura-modificación-escritura. La capacidad se redondea a
+ * la siguiente potencia de dos.
+ * 
+ * @tparam T Tipo de los elementos (copiable o movible)
+ */
+template <typename T>
+class MpscRingBuffer {
+private:
+    /**
+     * @brief Celda de la cola
+     */
+    struct Cell {
+        std::atomic<size_t> sequence;   ///< Secuencia de la celda
+        T value;                        ///< Valor almacenado
+    };
+
+    std::unique_ptr<Cell[]> cells;                  ///< Celdas de la cola
+    size_t mask;                                    ///< Capacidad - 1
+    char padding0[64];                              ///< Separa las posiciones en líneas de caché distintas
+    std::atomic<size_t> enqueuePos;                 ///< Próxima posición de escritura
+    char padding1[64];                              ///< Separa las posiciones en líneas de caché distintas
+    std::atomic<size_t> dequeuePos;                 ///< Próxima posición de lectura (escrita solo por el consumidor)
+
+    static size_t roundUpPowerOfTwo(size_t value) {
+        size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Capacidad mínima de la cola
+     */
+    explicit MpscRingBuffer(size_t capacity)
+        : cells(new Cell[roundUpPowerOfTwo(capacity)]),
+          mask(roundUpPowerOfTwo(capacity) - 1), enqueuePos(0), dequeuePos(0) {
+        for (size_t i = 0; i <= mask; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    /**
+     * @brief Intenta encolar un valor (seguro desde varios hilos)
+     * @param value Valor a encolar
+     * @return true si se encoló, false si la cola está llena
+     */
+    bool tryPush(const T& value) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Intenta desencolar un valor (solo desde el hilo consumidor)
+     * @param value Valor desencolado (salida)
+     * @return true si había un valor, false si la cola está vacía
+     */
+    bool tryPop(T& value) {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Cell& cell = cells[pos & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+            return false;
+        }
+
+        value = std::move(cell.value);
+        cell.sequence.store(pos + mask + 1, std::memory_order_release);
+        dequeuePos.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Desencola hasta maxItems valores disponibles (solo desde el hilo consumidor)
+     * @param out Vector al que se agregan los valores
+     * @param maxItems Cantidad máxima a desencolar
+     * @return Cantidad de valores desencolados
+     */
+    size_t popBatch(std::vector<T>& out, size_t maxItems) {
+        size_t popped = 0;
+        T value;
+        while (popped < maxItems && tryPop(value)) {
+            out.push_back(std::move(value));
+            ++popped;
+        }
+        return popped;
+    }
+
+    /**
+     * @brief Obtiene la capacidad de la cola
+     * @return Capacidad (potencia de dos)
+     */
+    size_t capacity() const {
+        return mask + 1;
+    }
+
+    /**
+     * @brief Obtiene una estimación de la cantidad de elementos encolados
+     * @return Elementos encolados (aproximado si hay productores activos)
+     */
+    size_t sizeApprox() const {
+        size_t enqueued = enqueuePos.load(std::memory_order_relaxed);
+        size_t dequeued = dequeuePos.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+};
+
+#endif // MPSCRINGBUFFER_H
@@ -0,0 +1,185 @@
+#ifndef READINGROLLUPS_H
+#define READINGROLLUPS_H
+
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <ctime>
+#include <cstdint>
+
+/**
+ * @brief Resoluciones de agregación disponibles
+ */
+enum class RollupTier {
+    MINUTE,     ///< Buckets de 1 minuto
+    HOUR,       ///< Buckets de 1 hora
+    DAY         ///< Buckets de 1 día (UTC)
+};
+
+/**
+ * @brief Agregado de lecturas de un intervalo
+ */
+struct RollupBucket {
+    time_t start;               ///< Inicio del intervalo (alineado al ancho del nivel)
+    uint64_t count;             ///< Cantidad de lecturas agregadas
+    float minTemperature;       ///< Temperatura mínima
+    float maxTemperature;       ///< Temperatura máxima
+    double sumTemperature;      ///< Suma de temperaturas
+    float minHumidity;          ///< Humedad mínima
+    float maxHumidity;          ///< Humedad máxima
+    double sumHumidity;         ///< Suma de humedades
+
+    /**
+     * @brief Temperatura media del intervalo
+     * @return Media en grados Celsius, 0 si no hay lecturas
+     */
+    float meanTemperature() const;
+
+    /**
+     * @brief Humedad media del intervalo
+     * @return Media en porcentaje, 0 si no hay lecturas
+     */
+    float meanHumidity() const;
+};
+
+/**
+ * @brief Agregados min/max/media/cantidad en varios niveles de resolución
+ *
+ * Cada lectura actualiza en O(1) el bucket correspondiente de cada nivel
+ * (minuto, hora y día). Los buckets modificados quedan marcados para que
+ * ClimateDataManager los persista junto a los datos crudos.
+ *
+ * Un watermark (la lectura más reciente menos ALLOWED_LATENESS) indica
+ * cuándo un minuto se da por cerrado: las lecturas de varios sensores
+ * llegan algo desordenadas, así que los pendientes se persisten una vez
+ * por minuto cerrado y no en cada cambio de minuto. Los buckets por
+ * minuto más viejos que MINUTE_RETENTION respecto del watermark se
+ * descartan; los niveles por hora y por día se conservan completos.
+ * Esta clase no es thread-safe; el gestor de datos la protege con su
+ * propio mutex.
+ */
+class ReadingRollups {
+public:
+    static const int TIER_COUNT = 3; ///< Cantidad de niveles
+    static const time_t ALLOWED_LATENESS = 60;          ///< Segundos de espera por lecturas atrasadas
+    static const time_t MINUTE_RETENTION = 7 * 86400;   ///< Antigüedad máxima de los buckets por minuto
+
+private:
+    /**
+     * @brief Estado de un nivel de agregación
+     */
+    struct Tier {
+        std::unordered_map<time_t, RollupBucket> buckets; ///< Buckets por inicio de intervalo
+        std::unordered_set<time_t> dirty;                 ///< Buckets pendientes de persistir
+        time_t firstStart;                                 ///< Primer bucket existente
+        time_t lastStart;                                  ///< Último bucket existente
+    };
+
+    Tier tiers[TIER_COUNT]; ///< Un estado por nivel
+    time_t latestTimestamp; ///< Lectura más reciente agregada
+    time_t flushedMinute;   ///< Inicio del primer minuto aún no cerrado en la última extracción
+    time_t minuteCutoff;    ///< Los buckets por minuto anteriores se descartaron
+
+    /**
+     * @brief Obtiene el bucket de un nivel, creándolo si no existe
+     * @param tier Nivel de agregación
+     * @param start Inicio del intervalo
+     * @return Referencia al bucket
+     */
+    RollupBucket& bucketFor(Tier& tier, time_t start);
+
+public:
+    /**
+     * @brief Constructor, todos los niveles vacíos
+     */
+    ReadingRollups();
+
+    /**
+     * @brief Ancho en segundos de los buckets de un nivel
+     * @param tier Nivel de agregación
+     * @return Segundos por bucket
+     */
+    static time_t tierWidth(RollupTier tier);
+
+    /**
+     * @brief Nombre legible de un nivel
+     * @param tier Nivel de agregación
+     * @return "minuto", "hora" o "día"
+     */
+    static const char* tierName(RollupTier tier);
+
+    /**
+     * @brief Agrega una lectura a todos los niveles en O(1)
+     * @param timestamp Timestamp de la lectura
+     * @param temperature Temperatura en grados Celsius
+     * @param humidity Humedad en porcentaje
+     */
+    void add(time_t timestamp, float temperature, float humidity);
+
+    /**
+     * @brief Carga un bucket persistido sin marcarlo como pendiente
+     * @param tier Nivel de agregación
+     * @param bucket Bucket leído de la base de datos
+     */
+    void load(RollupTier tier, const RollupBucket& bucket);
+
+    /**
+     * @brief Obtiene los buckets de un nivel dentro de un rango
+     * @param tier Nivel de agregación
+     * @param startTime Timestamp de inicio
+     * @param endTime Timestamp de fin
+     * @return Buckets no vacíos ordenados por inicio ascendente
+     */
+    std::vector<RollupBucket> getBuckets(RollupTier tier, time_t startTime, time_t endTime) const;
+
+    /**
+     * @brief Elige el nivel más fino cuya cantidad de buckets entra en el límite
+     *
+     * Devuelve el nivel más fino cuyo número de buckets en el rango no supera
+     * maxBuckets; si ninguno cumple, el nivel diario.
+     *
+     * @param startTime Timestamp de inicio
+     * @param endTime Timestamp de fin
+     * @param maxBuckets Cantidad máxima de puntos deseada
+     * @return Nivel a consultar
+     */
+    static RollupTier selectTier(time_t startTime, time_t endTime, size_t maxBuckets);
+
+    /**
+     * @brief Extrae los buckets modificados desde la última llamada
+     * @return Pares nivel/bucket pendientes de persistir
+     */
+    std::vector<std::pair<RollupTier, RollupBucket>> takeDirtyBuckets();
+
+    /**
+     * @brief Indica si el watermark cerró un minuto desde la última extracción
+     * @return true si conviene persistir los pendientes
+     */
+    bool hasClosedMinute() const;
+
+    /**
+     * @brief Descarta los buckets por minuto más viejos que MINUTE_RETENTION
+     * @return Cantidad de buckets descartados
+     */
+    size_t evictExpiredMinutes();
+
+    /**
+     * @brief Inicio del bucket por minuto más viejo que se conserva
+     * @return Límite de retención del nivel por minuto
+     */
+    time_t getMinuteCutoff() const;
+
+    /**
+     * @brief Cantidad total de lecturas agregadas
+     * @return Suma de las cantidades del nivel diario
+     */
+    uint64_t totalCount() const;
+
+    /**
+     * @brief Elimina todos los buckets de todos los niveles
+     */
+    void clear();
+};
+
+#endif // READINGROLLUPS_H
@@ -0,0 +1,144 @@
+#ifndef SENSORPOLLINGENGINE_H
+#define SENSORPOLLINGENGINE_H
+
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <cstdint>
+#include "IMSForecast.h"
+#include "ClimateReading.h"
+#include "WorkStealingThreadPool.h"
+
+/**
+ * @brief Motor de sondeo paralelo de muchos sensores MS-Forecast
+ *
+ * Administra un IMSForecast por sensor, identificado por su ID, y los lee
+ * periódicamente repartiendo las lecturas en un WorkStealingThreadPool.
+ * Los sensores se distribuyen en una rueda de ranuras dentro del período
+ * para que la carga sea pareja, y cada lectura se entrega a un único
+ * sumidero compartido (por ejemplo ClimateControlService::ingestReading).
+ */
+class SensorPollingEngine {
+public:
+    typedef std::function<void(const ClimateReading&)> ReadingSink; ///< Destino de las lecturas
+
+    static const size_t SLOTS_PER_PERIOD = 100; ///< Ranuras de la rueda de planificación
+    static const size_t SENSORS_PER_TASK = 32;  ///< Sensores leídos por cada tarea del pool
+
+    /**
+     * @brief Estadísticas acumuladas del motor
+     */
+    struct Stats {
+        uint64_t polls;         ///< Lecturas entregadas al sumidero
+        uint64_t overruns;      ///< Sondeos omitidos porque el anterior no había terminado
+        double meanLagMs;       ///< Atraso medio entre el instante planificado y la entrega
+        double maxLagMs;        ///< Atraso máximo observado
+    };
+
+private:
+    /**
+     * @brief Sensor registrado en el motor
+     */
+    struct SensorSlot {
+        int sensorId;                           ///< Identificador del sensor
+        std::unique_ptr<IMSForecast> forecast;  ///< Interfaz de la API para este sensor
+        std::atomic<bool> busy;                 ///< Indica que hay un sondeo en curso
+    };
+
+    ReadingSink sink;                                        ///< Sumidero compartido
+    std::chrono::milliseconds period;                        ///< Período de sondeo por sensor
+    WorkStealingThreadPool pool;                             ///< Hilos que ejecutan las lecturas
+    std::vector<std::unique_ptr<SensorSlot>> sensors;        ///< Sensores en orden de alta
+    std::unordered_map<int, SensorSlot*> sensorsById;        ///< Índice por ID
+    std::vector<std::vector<SensorSlot*>> wheel;             ///< Sensores de cada ranura
+    mutable std::mutex sensorsMutex;                         ///< Protege sensores y rueda
+
+    std::thread scheduler;                                   ///< Hilo planificador
+    std::atomic<bool> running;                               ///< Indica si el motor está activo
+
+    std::atomic<uint64_t> pollCount;                         ///< Lecturas entregadas
+    std::atomic<uint64_t> overrunCount;                      ///< Sondeos omitidos
+    std::atomic<uint64_t> lagSumMicros;                      ///< Suma de atrasos
+    std::atomic<uint64_t> lagMaxMicros;                      ///< Atraso máximo
+
+    /**
+     * @brief Bucle del hilo planificador
+     */
+    void schedulerLoop();
+
+    /**
+     * @brief Lee un grupo de sensores y entrega las lecturas
+     * @param group Sensores a leer
+     * @param scheduledAt Instante planificado del sondeo
+     */
+    void pollGroup(const std::vector<SensorSlot*>& group,
+                   std::chrono::steady_clock::time_point scheduledAt);
+
+public:
+    /**
+     * @brief Constructor
+     * @param readingSink Función que recibe cada lectura (debe ser thread-safe)
+     * @param threadCount Hilos del pool (0 = núcleos disponibles)
+     * @param pollPeriod Período de sondeo de cada sensor
+     */
+    SensorPollingEngine(ReadingSink readingSink, size_t threadCount = 0,
+                        std::chrono::milliseconds pollPeriod = std::chrono::milliseconds(1000));
+
+    /**
+     * @brief Destructor, detiene el planificador y espera las lecturas en curso
+     */
+    ~SensorPollingEngine();
+
+    SensorPollingEngine(const SensorPollingEngine&) = delete;
+    SensorPollingEngine& operator=(const SensorPollingEngine&) = delete;
+
+    /**
+     * @brief Registra un sensor y toma posesión de su interfaz
+     * @param sensorId Identificador del sensor
+     * @param forecast Interfaz de la API para el sensor (el motor la libera)
+     * @return true si se registró, false si el ID ya existía
+     */
+    bool addSensor(int sensorId, IMSForecast* forecast);
+
+    /**
+     * @brief Obtiene la interfaz de un sensor registrado
+     * @param sensorId Identificador del sensor
+     * @return Interfaz del sensor, o nullptr si no existe
+     */
+    IMSForecast* getSensor(int sensorId) const;
+
+    /**
+     * @brief Obtiene la cantidad de sensores registrados
+     * @return Cantidad de sensores
+     */
+    size_t getSensorCount() const;
+
+    /**
+     * @brief Inicia el sondeo periódico
+     */
+    void start();
+
+    /**
+     * @brief Detiene el sondeo y espera las lecturas en curso
+     */
+    void stop();
+
+    /**
+     * @brief Verifica si el motor está sondeando
+     * @return true si está activo, false en caso contrario
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Obtiene las estadísticas acumuladas
+     * @return Lecturas, sondeos omitidos y atraso de entrega
+     */
+    Stats getStats() const;
+};
+
+#endif // SENSORPOLLINGENGINE_H
@@ -0,0 +1,48 @@
+#ifndef SMTPTRANSPORTMOCK_H
+#define SMTPTRANSPORTMOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include "IEmailTransport.h"
+
+/**
+ * @brief Implementación mock del transporte SMTP
+ * 
+ * Esta clase simula un servidor SMTP local para propósitos de
+ * desarrollo y testing: puede registrar cada email en el log y
+ * simular la latencia de un servidor lento.
+ * Implementa la interfaz IEmailTransport.
+ */
+class SmtpTransportMock : public IEmailTransport {
+private:
+    int latencyMillis;                  ///< Latencia simulada por email
+    bool echo;                          ///< Registra cada email en el log
+    std::atomic<uint64_t> sentCount;    ///< Emails entregados
+
+public:
+    /**
+     * @brief Constructor
+     * @param latencyMs Latencia simulada por email en milisegundos
+     * @param echoToConsole Indica si se registra cada email en el log
+     */
+    SmtpTransportMock(int latencyMs = 0, bool echoToConsole = true);
+    
+    /**
+     * @brief Simula la entrega de un email
+     * @param from Remitente
+     * @param to Destinatario
+     * @param subject Asunto del email
+     * @param body Cuerpo del email
+     * @return true siempre (simulación exitosa)
+     */
+    bool send(const std::string& from, const std::string& to,
+              const std::string& subject, const std::string& body) override;
+    
+    /**
+     * @brief Obtiene la cantidad de emails entregados
+     * @return Emails entregados desde la creación
+     */
+    uint64_t getSentCount() const;
+};
+
+#endif // SMTPTRANSPORTMOCK_H
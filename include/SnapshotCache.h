@@ -0,0 +1,113 @@
+#ifndef SNAPSHOTCACHE_H
+#define SNAPSHOTCACHE_H
+
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+#include "IMSForecast.h"
+
+/**
+ * @brief Contadores de la caché de mediciones
+ */
+struct SnapshotCacheStats {
+    uint64_t hits;          ///< Consultas resueltas con una medición vigente
+    uint64_t loads;         ///< Consultas a la API
+    uint64_t shared;        ///< Consultas que esperaron una consulta a la API ya en curso
+    uint64_t stores;        ///< Mediciones guardadas por lecturas tomadas
+    uint64_t failures;      ///< Consultas a la API fallidas
+};
+
+/**
+ * @brief Caché por sensor de la última medición, con vencimiento y carga única
+ *
+ * get() devuelve la medición guardada si tiene menos de ttl; si no, la
+ * pide a la API con el loader. Mientras una consulta está en curso, las
+ * demás consultas del mismo sensor esperan y comparten su resultado en
+ * lugar de pedir otra (single-flight). store() guarda una medición
+ * obtenida por otra vía (por ejemplo, takeReading) sin consultar la API.
+ *
+ * Las fallas no se guardan: la próxima consulta vuelve a intentar. El
+ * vencimiento usa el reloj monótono del momento en que se obtuvo la
+ * medición. Con ttl cero cada consulta va a la API, pero las concurrentes
+ * siguen compartiendo la consulta en curso. Es thread-safe.
+ */
+class SnapshotCache {
+public:
+    typedef std::function<bool(int, ClimateSnapshot&)> Loader;  ///< Consulta un sensor a la API
+
+private:
+    /**
+     * @brief Medición guardada de un sensor
+     */
+    struct Entry {
+        ClimateSnapshot snapshot;                       ///< Última medición
+        std::chrono::steady_clock::time_point fetched;  ///< Cuándo se obtuvo
+        bool valid;                                     ///< Hay medición guardada
+        bool loading;                                   ///< Hay una consulta a la API en curso
+        bool lastLoadOk;                                ///< Resultado de la última consulta
+        uint64_t loadGeneration;                        ///< Consultas terminadas
+
+        Entry() : valid(false), loading(false), lastLoadOk(false), loadGeneration(0) {}
+    };
+
+    Loader loader;                              ///< Consulta a la API
+    std::chrono::milliseconds ttl;              ///< Vigencia de una medición
+    std::unordered_map<int, Entry> entries;     ///< Mediciones por sensor
+    SnapshotCacheStats stats;                   ///< Contadores
+    std::mutex mutex;                           ///< Protege las mediciones y los contadores
+    std::condition_variable loaded;             ///< Avisa que terminó una consulta
+
+public:
+    /**
+     * @brief Constructor
+     * @param snapshotLoader Consulta de un sensor a la API (true si se obtuvo la medición)
+     * @param timeToLive Vigencia de una medición
+     */
+    explicit SnapshotCache(Loader snapshotLoader,
+                           std::chrono::milliseconds timeToLive = std::chrono::milliseconds(2000));
+
+    SnapshotCache(const SnapshotCache&) = delete;
+    SnapshotCache& operator=(const SnapshotCache&) = delete;
+
+    /**
+     * @brief Obtiene la medición de un sensor, de la caché o de la API
+     * @param sensorId Identificador del sensor
+     * @param snapshot Medición (salida; sin cambios si falló)
+     * @return true si hay medición, false si la consulta a la API falló
+     */
+    bool get(int sensorId, ClimateSnapshot& snapshot);
+
+    /**
+     * @brief Guarda una medición obtenida sin pasar por la caché
+     * @param snapshot Medición (su sensorId indica el sensor)
+     */
+    void store(const ClimateSnapshot& snapshot);
+
+    /**
+     * @brief Descarta las mediciones guardadas
+     */
+    void invalidate();
+
+    /**
+     * @brief Cambia la vigencia de las mediciones
+     * @param timeToLive Nueva vigencia (0 = consultar siempre)
+     */
+    void setTtl(std::chrono::milliseconds timeToLive);
+
+    /**
+     * @brief Obtiene la vigencia de las mediciones
+     * @return Vigencia
+     */
+    std::chrono::milliseconds getTtl();
+
+    /**
+     * @brief Obtiene los contadores
+     * @return Aciertos, consultas, consultas compartidas y fallas
+     */
+    SnapshotCacheStats getStats();
+};
+
+#endif // SNAPSHOTCACHE_H
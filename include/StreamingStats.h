@@ -0,0 +1,308 @@
+#ifndef STREAMINGSTATS_H
+#define STREAMINGSTATS_H
+
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+#include <ctime>
+#include "ClimateReading.h"
+#include "AlertTracker.h"
+
+/**
+ * @brief Media, varianza, mínimo y máximo en una pasada (Welford)
+ *
+ * Se actualiza en O(1) por valor sin guardar los valores, y dos
+ * instancias se combinan en O(1) con la fórmula de Chan et al.
+ */
+struct RunningStats {
+    uint64_t count;     ///< Cantidad de valores
+    double mean;        ///< Media
+    double m2;          ///< Suma de cuadrados de las diferencias con la media
+    float min;          ///< Valor mínimo (sólo válido si count > 0)
+    float max;          ///< Valor máximo (sólo válido si count > 0)
+
+    /**
+     * @brief Constructor, sin valores
+     */
+    RunningStats();
+
+    /**
+     * @brief Agrega un valor
+     * @param value Valor a agregar
+     */
+    void add(float value);
+
+    /**
+     * @brief Combina con otras estadísticas (como si se hubieran agregado sus valores)
+     * @param other Estadísticas a combinar
+     */
+    void merge(const RunningStats& other);
+
+    /**
+     * @brief Varianza poblacional
+     * @return Varianza, 0 si hay menos de dos valores
+     */
+    double variance() const;
+
+    /**
+     * @brief Desvío estándar poblacional
+     * @return Raíz de variance()
+     */
+    double stddev() const;
+};
+
+/**
+ * @brief Sketch de cuantiles KLL (Karnin, Lang y Liberty, 2016)
+ *
+ * Guarda una muestra jerárquica de los valores: el nivel h contiene
+ * elementos que representan 2^h valores cada uno. Cuando un nivel se
+ * llena se ordena y se conserva un elemento de cada par (el par o el impar
+ * al azar), que pasa al nivel siguiente. La capacidad de cada nivel decrece
+ * geométricamente hacia abajo, de modo que la memoria queda acotada en
+ * unos 3k valores sin importar cuántos se agreguen.
+ *
+ * El error del rango es de alrededor de 1,7% con k = 200. Dos sketches se
+ * combinan uniendo sus niveles y compactando.
+ */
+class QuantileSketch {
+public:
+    static const uint32_t DEFAULT_K = 200;   ///< Capacidad del nivel superior
+
+private:
+    uint32_t k;                             ///< Capacidad del nivel superior
+    uint64_t n;                             ///< Valores agregados
+    uint64_t random;                        ///< Estado del generador de las compactaciones
+    size_t retained;                        ///< Elementos guardados en todos los niveles
+    size_t retainedLimit;                   ///< Suma de las capacidades de los niveles
+    std::vector<std::vector<float>> levels; ///< Elementos por nivel (peso 2^nivel)
+    std::vector<size_t> capacities;         ///< Capacidad de cada nivel con la altura actual
+
+    /**
+     * @brief Recalcula las capacidades y retainedLimit tras agregar niveles
+     */
+    void updateLimit();
+
+    /**
+     * @brief Compacta el nivel más bajo que excede su capacidad
+     */
+    void compress();
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Capacidad del nivel superior (mayor = más preciso y más memoria)
+     */
+    explicit QuantileSketch(uint32_t capacity = DEFAULT_K);
+
+    /**
+     * @brief Agrega un valor en O(1) amortizado
+     * @param value Valor a agregar
+     */
+    void add(float value);
+
+    /**
+     * @brief Combina con otro sketch
+     * @param other Sketch a combinar
+     */
+    void merge(const QuantileSketch& other);
+
+    /**
+     * @brief Estima un cuantil
+     * @param q Fracción en [0, 1] (0.5 = mediana)
+     * @return Valor estimado, NaN si el sketch está vacío
+     */
+    float quantile(double q) const;
+
+    /**
+     * @brief Obtiene la cantidad de valores agregados
+     * @return Valores agregados
+     */
+    uint64_t size() const { return n; }
+
+    /**
+     * @brief Obtiene la cantidad de elementos guardados
+     * @return Elementos en memoria (acotado por unos 3k)
+     */
+    size_t retainedItems() const { return retained; }
+};
+
+/**
+ * @brief Estadísticas de una métrica: momentos exactos y cuantiles aproximados
+ */
+class MetricStatistics {
+private:
+    RunningStats running;       ///< Cantidad, media, varianza, mínimo y máximo
+    QuantileSketch sketch;      ///< Cuantiles
+
+public:
+    /**
+     * @brief Constructor, sin valores
+     * @param sketchCapacity Capacidad del sketch de cuantiles
+     */
+    explicit MetricStatistics(uint32_t sketchCapacity = QuantileSketch::DEFAULT_K);
+
+    /**
+     * @brief Agrega un valor
+     * @param value Valor a agregar
+     */
+    void add(float value);
+
+    /**
+     * @brief Combina con las estadísticas de otro sensor o ventana
+     * @param other Estadísticas a combinar
+     */
+    void merge(const MetricStatistics& other);
+
+    uint64_t count() const { return running.count; }
+    double mean() const { return running.mean; }
+    double variance() const { return running.variance(); }
+    double stddev() const { return running.stddev(); }
+    float min() const { return running.min; }
+    float max() const { return running.max; }
+
+    /**
+     * @brief Estima un cuantil
+     *
+     * Los extremos (q = 0 y q = 1) son exactos.
+     * @param q Fracción en [0, 1]
+     * @return Valor estimado, NaN si no hay valores
+     */
+    float quantile(double q) const;
+};
+
+/**
+ * @brief Estadísticas en streaming por sensor y por métrica
+ *
+ * Cada lectura actualiza el total acumulado de su sensor y, para el
+ * conjunto de todos los sensores, el total y la ventana de tiempo que le
+ * corresponde. Se conservan las últimas retainedWindows ventanas; las
+ * lecturas más antiguas sólo cuentan en el total. Las consultas combinan
+ * ventanas ya calculadas y nunca recorren el historial, así que su costo no
+ * depende de la cantidad de lecturas. Las estadísticas empiezan vacías con
+ * cada proceso. Es thread-safe.
+ *
+ * Las ventanas existen sólo para el conjunto de todos los sensores: cada
+ * sensor guarda únicamente sus dos totales (temperatura y humedad). Con la
+ * capacidad por defecto son unos 30 KiB por sensor tras un día de lecturas
+ * cada 5 s, es decir unos 30 MiB cada 1000 sensores; con 24 ventanas por
+ * sensor serían 25 veces más sketches.
+ */
+class ReadingStatistics {
+public:
+    static const int ALL_SENSORS = -1;      ///< Identificador del conjunto de todos los sensores
+
+private:
+    static const size_t METRIC_COUNT = 2;   ///< Temperatura y humedad
+
+    /**
+     * @brief Estadísticas de un intervalo de tiempo
+     */
+    struct Window {
+        time_t start;                               ///< Inicio (alineado a windowSeconds)
+        std::vector<MetricStatistics> metrics;      ///< Una por AlertMetric
+    };
+
+    typedef std::vector<MetricStatistics> Totals;   ///< Una por AlertMetric, desde el inicio del proceso
+
+    time_t windowSeconds;                           ///< Ancho de cada ventana
+    size_t retainedWindows;                         ///< Ventanas conservadas
+    uint32_t sketchCapacity;                        ///< Capacidad de los sketches
+    std::unordered_map<int, Totals> sensors;        ///< Totales por sensor
+    Totals allTotal;                                ///< Total de todos los sensores
+    std::deque<Window> allWindows;                  ///< Ventanas de todos los sensores, en orden de tiempo
+    mutable std::mutex mutex;                       ///< Protege los totales y las ventanas
+
+    /**
+     * @brief Crea los totales vacíos de una serie
+     */
+    Totals makeTotals() const;
+
+    /**
+     * @brief Agrega una lectura a su sensor, al total y a su ventana
+     * @note Debe llamarse con el mutex tomado
+     */
+    void addLocked(const ClimateReading& reading);
+
+    /**
+     * @brief Agrega los valores de una lectura a la ventana que le corresponde
+     * @param timestamp Momento de la lectura
+     * @param values Un valor por AlertMetric
+     * @note Debe llamarse con el mutex tomado
+     */
+    void addToWindow(time_t timestamp, const float* values);
+
+    /**
+     * @brief Busca los totales de un sensor
+     * @return nullptr si el sensor no tiene lecturas
+     * @note Debe llamarse con el mutex tomado
+     */
+    const Totals* findTotals(int sensorId) const;
+
+public:
+    /**
+     * @brief Constructor
+     * @param windowWidth Ancho de cada ventana en segundos
+     * @param windowCount Ventanas conservadas
+     * @param capacity Capacidad de los sketches de cuantiles
+     */
+    ReadingStatistics(time_t windowWidth = 3600, size_t windowCount = 24,
+                      uint32_t capacity = QuantileSketch::DEFAULT_K);
+
+    /**
+     * @brief Agrega una lectura
+     * @param reading Lectura a agregar
+     */
+    void add(const ClimateReading& reading);
+
+    /**
+     * @brief Agrega un lote de lecturas tomando el mutex una sola vez
+     * @param readings Lecturas a agregar
+     */
+    void addBatch(const std::vector<ClimateReading>& readings);
+
+    /**
+     * @brief Obtiene las estadísticas acumuladas desde el inicio del proceso
+     * @param metric Métrica a consultar
+     * @param sensorId Sensor, o ALL_SENSORS
+     * @return Estadísticas (vacías si no hay lecturas)
+     */
+    MetricStatistics total(AlertMetric metric, int sensorId = ALL_SENSORS) const;
+
+    /**
+     * @brief Obtiene las estadísticas de todos los sensores en un rango de tiempo
+     *
+     * Combina las ventanas retenidas que se solapan con el rango, por lo que
+     * los bordes se redondean a ventanas completas. Por sensor sólo hay
+     * totales (ver total()).
+     * @param metric Métrica a consultar
+     * @param startTime Inicio del rango
+     * @param endTime Fin del rango (inclusive)
+     * @return Estadísticas (vacías si no hay lecturas en el rango)
+     */
+    MetricStatistics range(AlertMetric metric, time_t startTime, time_t endTime) const;
+
+    /**
+     * @brief Combina las estadísticas de varios sensores desde el inicio del proceso
+     * @param metric Métrica a consultar
+     * @param sensorIds Sensores a combinar
+     * @return Estadísticas del conjunto
+     */
+    MetricStatistics combine(AlertMetric metric, const std::vector<int>& sensorIds) const;
+
+    /**
+     * @brief Obtiene los sensores con lecturas
+     * @return Identificadores de sensor, ordenados
+     */
+    std::vector<int> sensorIds() const;
+
+    /**
+     * @brief Obtiene el ancho de las ventanas
+     * @return Segundos por ventana
+     */
+    time_t getWindowSeconds() const { return windowSeconds; }
+};
+
+#endif // STREAMINGSTATS_H
@@ -0,0 +1,117 @@
+#ifndef THRESHOLDREPLAYENGINE_H
+#define THRESHOLDREPLAYENGINE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <ctime>
+#include "AlertKernels.h"
+#include "AlertTracker.h"
+#include "ClimateDataManager.h"
+#include "WorkStealingThreadPool.h"
+
+/**
+ * @brief Parámetros de una simulación de umbrales
+ */
+struct ReplayRequest {
+    AlertThresholds thresholds; ///< Umbrales candidatos
+    AlertPolicy policy;         ///< Histéresis, recordatorios y límite de notificaciones
+    bool applyPolicy;           ///< false = solo contar lecturas fuera de rango
+    time_t startTime;           ///< Inicio del historial a reprocesar (inclusive)
+    time_t endTime;             ///< Fin del historial a reprocesar (inclusive)
+    int bucketSeconds;          ///< Ancho de cada punto de la línea de tiempo (se ensancha si hay demasiados)
+    int warmupSeconds;          ///< Historial previo a cada partición usado para reconstruir el estado
+    size_t partitions;          ///< Particiones de tiempo (0 = cuatro por hilo)
+
+    /**
+     * @brief Constructor con los valores por defecto
+     *
+     * Umbrales y política por defecto, buckets de una hora y un
+     * precalentamiento igual al intervalo de recordatorio.
+     */
+    ReplayRequest();
+};
+
+/**
+ * @brief Punto de la línea de tiempo de una simulación
+ */
+struct ReplayBucket {
+    time_t bucketStart;         ///< Inicio del bucket
+    uint64_t readings;          ///< Lecturas reprocesadas
+    uint64_t thresholdHits;     ///< Métricas fuera de rango
+    uint64_t notifications;     ///< Alertas que se habrían guardado y enviado
+};
+
+/**
+ * @brief Resultado de una simulación de umbrales
+ */
+struct ReplayResult {
+    uint64_t readings;              ///< Lecturas reprocesadas
+    uint64_t readingsOutOfRange;    ///< Lecturas con alguna métrica fuera de rango
+    uint64_t hitsBySeverity[4];     ///< Métricas fuera de rango por severidad (índice = AlertSeverity)
+    uint64_t notifications;         ///< Alertas que se habrían guardado y enviado
+    uint64_t notificationsBySeverity[4]; ///< Alertas notificadas por severidad (normalizaciones = LOW)
+    AlertTrackerStats transitions;  ///< Detalle de las transiciones del seguimiento de alertas
+    std::vector<ReplayBucket> timeline; ///< Línea de tiempo ordenada por bucketStart
+    size_t partitions;              ///< Particiones procesadas
+    double elapsedMs;               ///< Duración de la simulación
+};
+
+/**
+ * @brief Simulación de umbrales candidatos sobre el historial guardado
+ *
+ * Recorre las lecturas guardadas por columnas, las clasifica con
+ * AlertKernels y, si se pide, las pasa por un AlertTracker con la política
+ * indicada para contar las alertas que se habrían notificado. No guarda
+ * ni envía nada.
+ *
+ * El rango se divide en particiones de tiempo que se procesan en paralelo
+ * en un WorkStealingThreadPool. Cada partición tiene su propio
+ * AlertTracker, cuyo estado se reconstruye recorriendo sin contar los
+ * warmupSeconds anteriores a la partición; una alerta activa desde antes
+ * de esa ventana puede desplazar un recordatorio, pero no cambia las
+ * alertas nuevas ni las normalizaciones.
+ */
+class ThresholdReplayEngine {
+private:
+    ClimateDataManager* dataManager;    ///< Origen del historial
+    WorkStealingThreadPool pool;        ///< Hilos que procesan las particiones
+
+    /**
+     * @brief Procesa una partición
+     * @param request Parámetros de la simulación
+     * @param partStart Inicio de la partición (inclusive)
+     * @param partEnd Fin de la partición (inclusive)
+     * @param result Resultado parcial de la partición (salida)
+     */
+    void replayPartition(const ReplayRequest& request, time_t partStart, time_t partEnd,
+                         ReplayResult& result);
+
+    /**
+     * @brief Acumula un resultado parcial en el total
+     * @param total Resultado total
+     * @param partial Resultado de una partición
+     * @param bucketSeconds Ancho de los buckets de ambas líneas de tiempo
+     */
+    static void merge(ReplayResult& total, const ReplayResult& partial, int bucketSeconds);
+
+public:
+    /**
+     * @brief Constructor
+     * @param dataMgr Gestor de datos con el historial
+     * @param threadCount Cantidad de hilos (0 = núcleos disponibles)
+     */
+    explicit ThresholdReplayEngine(ClimateDataManager* dataMgr, size_t threadCount = 0);
+
+    ThresholdReplayEngine(const ThresholdReplayEngine&) = delete;
+    ThresholdReplayEngine& operator=(const ThresholdReplayEngine&) = delete;
+
+    /**
+     * @brief Ejecuta una simulación
+     * @param request Umbrales, política y rango a reprocesar
+     * @return Conteos y línea de tiempo de las alertas simuladas
+     */
+    ReplayResult replay(const ReplayRequest& request);
+};
+
+#endif // THRESHOLDREPLAYENGINE_H
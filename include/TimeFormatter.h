@@ -0,0 +1,49 @@
+#ifndef TIMEFORMATTER_H
+#define TIMEFORMATTER_H
+
+#include <string>
+#include <ctime>
+#include <cstddef>
+
+/**
+ * @brief Formateo de fechas en hora local con caché por hilo
+ *
+ * Produce "YYYY-MM-DD HH:MM:SS" (el mismo texto que
+ * std::put_time(localtime(...), "%Y-%m-%d %H:%M:%S")) sin reservar
+ * memoria y sin el lock global de localtime. Cada hilo guarda el prefijo
+ * "YYYY-MM-DD HH:MM:" del último minuto formateado; dentro de ese minuto
+ * sólo se escriben los segundos, y al cambiar de minuto se llama una vez
+ * a localtime_r. Los cambios de horario de verano ocurren en límites de
+ * minuto, por lo que el resultado coincide con localtime_r. Los cambios de
+ * la variable TZ en ejecución no se aplican a los minutos ya cacheados.
+ */
+class TimeFormatter {
+public:
+    static const size_t DATETIME_LENGTH = 19;   ///< Largo de "YYYY-MM-DD HH:MM:SS"
+    static const size_t MINUTE_LENGTH = 16;     ///< Largo de "YYYY-MM-DD HH:MM" (prefijo del anterior)
+    static const size_t BUFFER_SIZE = DATETIME_LENGTH + 1; ///< Tamaño mínimo de buffer (incluye '\0')
+
+    /**
+     * @brief Escribe la fecha y hora local en un buffer
+     * @param timestamp Instante a formatear
+     * @param buffer Buffer de destino de al menos BUFFER_SIZE bytes (queda terminado en '\0')
+     * @return Caracteres escritos sin contar el '\0' (DATETIME_LENGTH, o 0 si la fecha no es representable)
+     */
+    static size_t formatDateTime(time_t timestamp, char* buffer);
+
+    /**
+     * @brief Obtiene la fecha y hora local como string
+     * @param timestamp Instante a formatear
+     * @return "YYYY-MM-DD HH:MM:SS", o cadena vacía si la fecha no es representable
+     */
+    static std::string dateTime(time_t timestamp);
+
+    /**
+     * @brief Agrega la fecha y hora local al final de un string
+     * @param timestamp Instante a formatear
+     * @param out String de destino
+     */
+    static void appendDateTime(time_t timestamp, std::string& out);
+};
+
+#endif // TIMEFORMATTER_H
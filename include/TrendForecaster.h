@@ -0,0 +1,151 @@
+#ifndef TRENDFORECASTER_H
+#define TRENDFORECASTER_H
+
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+#include <ctime>
+#include "ClimateReading.h"
+#include "AlertTracker.h"
+#include "AlertKernels.h"
+
+/**
+ * @brief Configuración del pronóstico de tendencia
+ *
+ * Las constantes de tiempo reemplazan a los factores de suavizado de Holt
+ * para que el modelo no dependa de la frecuencia de lectura: con un
+ * intervalo dt, el factor usado es 1 - exp(-dt / constante).
+ */
+struct ForecastPolicy {
+    float levelTimeConstantSec;     ///< Suavizado del nivel (mayor = menos ruido, más retraso)
+    float trendTimeConstantSec;     ///< Suavizado de la pendiente
+    int horizonSec;                 ///< Anticipación máxima de un cruce pronosticado (0 = sin pronóstico)
+    int warmupSec;                  ///< Segundos de lecturas antes de pronosticar
+
+    /**
+     * @brief Constructor con los valores por defecto
+     */
+    ForecastPolicy();
+};
+
+/**
+ * @brief Cruce de umbral pronosticado
+ */
+struct ThresholdCrossing {
+    AlertMetric metric;         ///< Métrica que cruzará el umbral
+    int direction;              ///< +1 umbral alto, -1 umbral bajo
+    float minutes;              ///< Minutos estimados hasta el cruce
+};
+
+/**
+ * @brief Pronóstico en línea de cruces de umbral (Holt con tiempo irregular)
+ *
+ * Mantiene por sensor y por métrica un nivel y una pendiente suavizados
+ * exponencialmente, actualizados en O(1) por lectura sin guardar lecturas
+ * anteriores (40 bytes de modelo por sensor, unos 100 con la tabla). Si
+ * la recta nivel + pendiente cruza un umbral dentro del horizonte, el
+ * cruce queda vigente y update() lo informa en cada lectura; deja de
+ * estarlo cuando el pronóstico se aleja (a más del doble del horizonte o
+ * con la pendiente en contra) o cuando el valor ya cruzó, en cuyo caso la
+ * alerta normal del umbral toma el relevo. Qué cruces se notifican y
+ * cuándo lo decide AlertTracker. Es thread-safe.
+ */
+class TrendForecaster {
+public:
+    static const size_t MAX_CROSSINGS = 2;  ///< Cruces por lectura como máximo (uno por métrica)
+
+private:
+    static const size_t METRIC_COUNT = 2;   ///< Temperatura y humedad
+
+    /**
+     * @brief Modelo de un sensor
+     */
+    struct SensorModel {
+        time_t firstTimestamp;          ///< Primera lectura
+        time_t lastTimestamp;           ///< Última lectura
+        float level[METRIC_COUNT];      ///< Nivel suavizado por métrica
+        float trend[METRIC_COUNT];      ///< Pendiente suavizada por segundo
+        int8_t predicted[METRIC_COUNT]; ///< Cruce ya informado (+1 alto, -1 bajo, 0 ninguno)
+    };
+
+    ForecastPolicy policy;                              ///< Configuración vigente
+    std::unordered_map<int, SensorModel> models;        ///< Modelos por sensor
+    time_t cachedInterval;                              ///< Intervalo de los factores en caché
+    float cachedLevelFactor;                            ///< Factor del nivel para cachedInterval
+    float cachedTrendFactor;                            ///< Factor de la pendiente para cachedInterval
+    mutable std::mutex mutex;                           ///< Protege los modelos
+
+    /**
+     * @brief Actualiza el nivel y la pendiente de una métrica
+     */
+    static void smooth(SensorModel& model, size_t metric, float value, float dt,
+                       float levelFactor, float trendFactor);
+
+    /**
+     * @brief Actualiza el cruce vigente de una métrica según la lectura
+     */
+    void evaluate(SensorModel& model, size_t metric, float value, float high, float low) const;
+
+    /**
+     * @brief Describe el cruce vigente de una métrica
+     * @return true si la métrica tiene un cruce vigente
+     */
+    bool describe(const SensorModel& model, size_t metric, float high, float low,
+                  ThresholdCrossing& crossing) const;
+
+public:
+    /**
+     * @brief Constructor
+     * @param forecastPolicy Configuración inicial
+     */
+    explicit TrendForecaster(const ForecastPolicy& forecastPolicy = ForecastPolicy());
+
+    /**
+     * @brief Incorpora una lectura e informa los cruces pronosticados vigentes
+     *
+     * Las lecturas más antiguas que la última del sensor no cambian el
+     * modelo, pero igual informan los cruces vigentes.
+     * @param reading Lectura a incorporar
+     * @param thresholds Umbrales vigentes
+     * @param crossings Cruces vigentes (salida, hasta MAX_CROSSINGS)
+     * @return Cantidad de cruces escritos en crossings
+     */
+    size_t update(const ClimateReading& reading, const AlertThresholds& thresholds,
+                  ThresholdCrossing* crossings);
+
+    /**
+     * @brief Pronostica el valor de una métrica
+     * @param sensorId Identificador del sensor
+     * @param metric Métrica a pronosticar
+     * @param aheadSec Segundos desde la última lectura del sensor
+     * @param value Valor pronosticado (salida)
+     * @return true si el sensor tiene un modelo, false en caso contrario
+     */
+    bool forecast(int sensorId, AlertMetric metric, int aheadSec, float& value) const;
+
+    /**
+     * @brief Reemplaza la configuración
+     * @param forecastPolicy Nueva configuración
+     */
+    void setPolicy(const ForecastPolicy& forecastPolicy);
+
+    /**
+     * @brief Obtiene la configuración vigente
+     * @return Configuración
+     */
+    ForecastPolicy getPolicy() const;
+
+    /**
+     * @brief Obtiene la cantidad de sensores con modelo
+     * @return Sensores
+     */
+    size_t getSensorCount() const;
+
+    /**
+     * @brief Olvida todos los modelos
+     */
+    void reset();
+};
+
+#endif // TRENDFORECASTER_H
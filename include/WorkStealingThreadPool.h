@@ -0,0 +1,108 @@
+#ifndef WORKSTEALINGTHREADPOOL_H
+#define WORKSTEALINGTHREADPOOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <cstdint>
+
+/**
+ * @brief Pool de hilos con colas por hilo y robo de trabajo
+ *
+ * Cada hilo trabajador tiene su propia cola. Las tareas enviadas desde un
+ * trabajador van a su cola local (LIFO, mejor localidad); las enviadas
+ * desde fuera se reparten en round-robin. Un trabajador sin tareas roba
+ * del extremo opuesto de las colas de los demás, de modo que la carga se
+ * equilibra sin una cola global compartida.
+ */
+class WorkStealingThreadPool {
+public:
+    typedef std::function<void()> Task; ///< Unidad de trabajo
+
+private:
+    /**
+     * @brief Cola de tareas de un trabajador
+     */
+    struct WorkerQueue {
+        std::mutex mutex;           ///< Protege la cola
+        std::deque<Task> tasks;     ///< Tareas pendientes
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues; ///< Una cola por trabajador
+    std::vector<std::thread> workers;                 ///< Hilos trabajadores
+    std::atomic<size_t> nextQueue;                    ///< Próxima cola para envíos externos
+    std::atomic<size_t> queuedTasks;                  ///< Tareas en colas
+    std::atomic<size_t> activeTasks;                  ///< Tareas encoladas o en ejecución
+    std::atomic<uint64_t> stealCount;                 ///< Tareas obtenidas por robo
+    std::atomic<bool> stopping;                       ///< Indica que el pool se está cerrando
+    std::mutex sleepMutex;                            ///< Protege las esperas
+    std::condition_variable wakeUp;                   ///< Despierta trabajadores ociosos
+    std::condition_variable idle;                     ///< Notifica cuando no quedan tareas
+
+    /**
+     * @brief Toma una tarea de la cola propia
+     * @param index Índice del trabajador
+     * @param task Tarea obtenida (salida)
+     * @return true si había una tarea, false en caso contrario
+     */
+    bool popLocal(size_t index, Task& task);
+
+    /**
+     * @brief Roba una tarea de la cola de otro trabajador
+     * @param thief Índice del trabajador que roba
+     * @param task Tarea obtenida (salida)
+     * @return true si se robó una tarea, false en caso contrario
+     */
+    bool steal(size_t thief, Task& task);
+
+    /**
+     * @brief Bucle principal de cada trabajador
+     * @param index Índice del trabajador
+     */
+    void workerLoop(size_t index);
+
+public:
+    /**
+     * @brief Constructor
+     * @param threadCount Cantidad de hilos (0 = núcleos disponibles)
+     */
+    explicit WorkStealingThreadPool(size_t threadCount = 0);
+
+    /**
+     * @brief Destructor, ejecuta las tareas pendientes y detiene los hilos
+     */
+    ~WorkStealingThreadPool();
+
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+    /**
+     * @brief Encola una tarea
+     * @param task Tarea a ejecutar
+     */
+    void submit(Task task);
+
+    /**
+     * @brief Bloquea hasta que no quedan tareas encoladas ni en ejecución
+     */
+    void waitIdle();
+
+    /**
+     * @brief Obtiene la cantidad de hilos trabajadores
+     * @return Cantidad de hilos
+     */
+    size_t getThreadCount() const;
+
+    /**
+     * @brief Obtiene la cantidad de tareas robadas entre trabajadores
+     * @return Total de robos desde la creación del pool
+     */
+    uint64_t getStealCount() const;
+};
+
+#endif // WORKSTEALINGTHREADPOOL_H
@@ -0,0 +1,254 @@
+#ifndef ZONECONTROLLER_H
+#define ZONECONTROLLER_H
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "IMSForecast.h"
+#include "LatencyHistogram.h"
+
+/**
+ * @brief Algoritmo de control de una zona
+ */
+enum class ControlMode {
+    PID,        ///< Proporcional, integral y derivativo
+    BANG_BANG   ///< Todo o nada con banda muerta alrededor del setpoint
+};
+
+/**
+ * @brief Ganancias de un lazo PID
+ *
+ * La salida se expresa en pasos del actuador (las unidades de upTemp o
+ * upHumidity); el error es setpoint - medición.
+ */
+struct PidGains {
+    float kp;   ///< Pasos por unidad de error
+    float ki;   ///< Pasos por unidad de error y segundo
+    float kd;   ///< Pasos por unidad de cambio por segundo de la medición
+};
+
+/**
+ * @brief Configuración de una zona controlada
+ */
+struct ZoneConfig {
+    std::string name;               ///< Nombre de la zona
+    IMSForecast* forecast;          ///< API de la zona (no se libera)
+    float temperatureSetpoint;      ///< Temperatura deseada, °C
+    float humiditySetpoint;         ///< Humedad deseada, %
+    ControlMode mode;               ///< Algoritmo de control
+    PidGains temperatureGains;      ///< Ganancias del lazo de temperatura
+    PidGains humidityGains;         ///< Ganancias del lazo de humedad
+    float temperatureDeadband;      ///< Banda muerta de BANG_BANG, °C
+    float humidityDeadband;         ///< Banda muerta de BANG_BANG, %
+    int maxOutput;                  ///< Rango del actuador en pasos (±maxOutput)
+    int maxStepPerIteration;        ///< Pasos que puede mover un comando
+
+    /**
+     * @brief Constructor con ganancias para una sala con constante de tiempo de minutos
+     */
+    ZoneConfig();
+};
+
+/**
+ * @brief Estado de una zona
+ */
+struct ZoneStatus {
+    std::string name;               ///< Nombre de la zona
+    float temperature;              ///< Última temperatura medida
+    float humidity;                 ///< Última humedad medida
+    float temperatureSetpoint;      ///< Setpoint de temperatura vigente
+    float humiditySetpoint;         ///< Setpoint de humedad vigente
+    int temperatureOutput;          ///< Pasos del actuador de temperatura comandados
+    int humidityOutput;             ///< Pasos del actuador de humedad comandados
+    uint64_t commands;              ///< Comandos enviados
+    uint64_t commandFailures;       ///< Comandos rechazados por la API
+    uint64_t invalidReadings;       ///< Mediciones no finitas descartadas (sin actualizar el lazo)
+};
+
+/**
+ * @brief Configuración del lazo periódico
+ */
+struct ControlLoopConfig {
+    std::chrono::milliseconds period;   ///< Período del lazo
+    std::chrono::microseconds spin;     ///< Espera activa antes de cada iteración para acotar el jitter
+    double timeScale;                   ///< Segundos de proceso por segundo real (1 salvo simulaciones aceleradas)
+
+    /**
+     * @brief Constructor con un lazo de 1 Hz
+     */
+    ControlLoopConfig();
+};
+
+/**
+ * @brief Estadísticas del lazo periódico
+ */
+struct ControlLoopStats {
+    uint64_t iterations;        ///< Iteraciones ejecutadas
+    uint64_t overruns;          ///< Períodos perdidos porque una iteración se demoró
+    double meanJitterUs;        ///< Atraso medio del inicio respecto del instante planificado
+    double maxJitterUs;         ///< Atraso máximo del inicio
+    double meanIterationUs;     ///< Duración media de una iteración (lectura, cálculo y comandos)
+    double maxIterationUs;      ///< Duración máxima de una iteración
+};
+
+/**
+ * @brief Control automático en lazo cerrado de una o varias zonas
+ *
+ * Un hilo propio ejecuta el lazo a período fijo sobre un reloj absoluto:
+ * en cada iteración lee cada zona con readSnapshot(), calcula la salida de
+ * temperatura y de humedad y envía la diferencia con lo ya comandado como
+ * upTemp/downTemp y upHumidity/downHumidity. El PID usa derivada sobre la
+ * medición (sin saltos al cambiar el setpoint) e integración condicional
+ * para no acumular error mientras el actuador está saturado.
+ *
+ * El hilo duerme hasta poco antes de cada instante planificado y espera
+ * el resto activamente (ControlLoopConfig::spin), lo que acota el jitter
+ * al de la espera activa en lugar del del planificador del sistema. Si
+ * una iteración se pasa de su período, los períodos perdidos se omiten y
+ * se cuentan como overruns. La duración de cada iteración y el jitter se
+ * registran en MetricsRegistry.
+ */
+class ZoneController {
+private:
+    /**
+     * @brief Estado de un lazo de una variable
+     */
+    struct Loop {
+        float integral;             ///< Integral del error
+        float lastMeasurement;      ///< Medición anterior (para la derivada)
+        bool primed;                ///< Hay medición anterior
+        int output;                 ///< Pasos comandados
+        int bangBangDirection;      ///< Último sentido de BANG_BANG (+1, -1 o 0)
+    };
+
+    /**
+     * @brief Zona registrada
+     */
+    struct Zone {
+        ZoneConfig config;          ///< Configuración
+        Loop temperature;           ///< Lazo de temperatura
+        Loop humidity;              ///< Lazo de humedad
+        ClimateSnapshot last;       ///< Última medición
+        uint64_t commands;          ///< Comandos enviados
+        uint64_t commandFailures;   ///< Comandos rechazados
+        uint64_t invalidReadings;   ///< Mediciones no finitas descartadas
+    };
+
+    ControlLoopConfig loopConfig;               ///< Configuración del lazo
+    std::vector<Zone> zones;                    ///< Zonas en orden de alta
+    mutable std::mutex zonesMutex;              ///< Protege las zonas
+
+    std::thread worker;                         ///< Hilo del lazo
+    std::atomic<bool> running;                  ///< Indica si el lazo está activo
+
+    std::atomic<uint64_t> iterationCount;       ///< Iteraciones ejecutadas
+    std::atomic<uint64_t> overrunCount;         ///< Períodos perdidos
+    std::atomic<uint64_t> jitterSumNanos;       ///< Suma de los atrasos de inicio
+    std::atomic<uint64_t> jitterMaxNanos;       ///< Atraso de inicio máximo
+    std::atomic<uint64_t> iterationSumNanos;    ///< Suma de las duraciones
+    std::atomic<uint64_t> iterationMaxNanos;    ///< Duración máxima
+
+    LatencyHistogram& iterationLatency;         ///< Duración de las iteraciones (MetricsRegistry)
+    LatencyHistogram& jitterLatency;            ///< Atraso de inicio (MetricsRegistry)
+
+    /**
+     * @brief Bucle del hilo del lazo
+     */
+    void loop();
+
+    /**
+     * @brief Calcula la salida de un lazo
+     *
+     * Una medición no finita no actualiza el lazo: se mantiene la salida
+     * actual, y la integral nunca guarda un valor no finito.
+     * @return Pasos del actuador deseados, dentro de ±maxOutput
+     */
+    static int computeOutput(Loop& state, const PidGains& gains, ControlMode mode, float deadband,
+                             float setpoint, float measurement, float dt, int maxOutput);
+
+    /**
+     * @brief Envía la diferencia entre la salida deseada y la comandada
+     * @return false si la API rechazó el comando
+     */
+    static bool actuate(Zone& zone, Loop& state, int target, bool temperature);
+
+public:
+    /**
+     * @brief Constructor
+     * @param config Período, espera activa y escala de tiempo del lazo
+     */
+    explicit ZoneController(const ControlLoopConfig& config = ControlLoopConfig());
+
+    /**
+     * @brief Destructor, detiene el lazo
+     */
+    ~ZoneController();
+
+    ZoneController(const ZoneController&) = delete;
+    ZoneController& operator=(const ZoneController&) = delete;
+
+    /**
+     * @brief Agrega una zona
+     * @param config Configuración de la zona
+     * @return true si se agregó, false si no tiene API o el nombre ya existe
+     */
+    bool addZone(const ZoneConfig& config);
+
+    /**
+     * @brief Cambia los setpoints de una zona
+     * @param name Nombre de la zona
+     * @param temperature Temperatura deseada, °C
+     * @param humidity Humedad deseada, %
+     * @return true si la zona existe, false en caso contrario
+     */
+    bool setSetpoints(const std::string& name, float temperature, float humidity);
+
+    /**
+     * @brief Ejecuta una iteración del lazo sobre todas las zonas
+     *
+     * La usa el hilo del lazo; llamada directamente (con el lazo detenido)
+     * permite simular fuera de línea con un paso de tiempo fijo.
+     * @param dtSeconds Segundos de proceso desde la iteración anterior
+     */
+    void runOnce(float dtSeconds);
+
+    /**
+     * @brief Inicia el lazo en su hilo
+     */
+    void start();
+
+    /**
+     * @brief Detiene el lazo y espera la iteración en curso
+     */
+    void stop();
+
+    /**
+     * @brief Verifica si el lazo está activo
+     * @return true si está activo, false en caso contrario
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Obtiene el estado de las zonas
+     * @return Mediciones, setpoints y salidas por zona
+     */
+    std::vector<ZoneStatus> getZoneStatus() const;
+
+    /**
+     * @brief Obtiene las estadísticas del lazo
+     * @return Iteraciones, overruns, jitter y duración
+     */
+    ControlLoopStats getStats() const;
+
+    /**
+     * @brief Obtiene la configuración del lazo
+     * @return Configuración
+     */
+    const ControlLoopConfig& getLoopConfig() const { return loopConfig; }
+};
+
+#endif // ZONECONTROLLER_H
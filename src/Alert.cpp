@@ -1,25 +1,43 @@
 #include "../include/Alert.h"
-#include <sstream>
-#include <iomanip>
+#include "../include/TimeFormatter.h"
+#include "../include/AlertTemplates.h"
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
 #include <ctime>
 
-Alert::Alert() : id(0), message(""), severity(AlertSeverity::LOW), timestamp(time(nullptr)) {}
+Alert::Alert()
+    : message(""), timestamp(time(nullptr)), id(0), sensorId(0), value(0.0f),
+      severity(AlertSeverity::LOW), code(AlertCode::CUSTOM), note(AlertNote::NONE) {}
 
 Alert::Alert(const std::string& msg, AlertSeverity sev) 
-    : id(0), message(msg), severity(sev), timestamp(time(nullptr)) {}
+    : message(msg), timestamp(time(nullptr)), id(0), sensorId(0), value(0.0f),
+      severity(sev), code(AlertCode::CUSTOM), note(AlertNote::NONE) {}
 
 Alert::Alert(int id, const std::string& msg, AlertSeverity sev, time_t ts) 
-    : id(id), message(msg), severity(sev), timestamp(ts) {}
+    : message(msg), timestamp(ts), id(id), sensorId(0), value(0.0f),
+      severity(sev), code(AlertCode::CUSTOM), note(AlertNote::NONE) {}
+
+Alert::Alert(AlertCode alertCode, float measured, int sensor, AlertSeverity sev, time_t ts,
+             AlertNote alertNote)
+    : timestamp(ts), id(0), sensorId(sensor), value(measured),
+      severity(sev), code(alertCode), note(alertNote) {}
 
 // Getters
 int Alert::getId() const { return id; }
-std::string Alert::getMessage() const { return message; }
 AlertSeverity Alert::getSeverity() const { return severity; }
 time_t Alert::getTimestamp() const { return timestamp; }
+AlertCode Alert::getCode() const { return code; }
+AlertNote Alert::getNote() const { return note; }
+int Alert::getSensorId() const { return sensorId; }
+float Alert::getValue() const { return value; }
 
 // Setters
 void Alert::setId(int id) { this->id = id; }
-void Alert::setMessage(const std::string& msg) { message = msg; }
+void Alert::setMessage(const std::string& msg) {
+    message = msg;
+    code = AlertCode::CUSTOM;
+}
 void Alert::setSeverity(AlertSeverity sev) { severity = sev; }
 void Alert::setTimestamp(time_t ts) { timestamp = ts; }
 
@@ -33,18 +51,57 @@ std::string Alert::getSeverityString() const {
     }
 }
 
+std::string Alert::getMessage() const {
+    if (code == AlertCode::CUSTOM) {
+        return message;
+    }
+    char text[160];
+    size_t length = renderMessage(text, sizeof(text));
+    if (length < sizeof(text)) {
+        return std::string(text, length);
+    }
+    std::string longText(length + 1, '\0');
+    renderMessage(&longText[0], longText.size());
+    longText.resize(length);
+    return longText;
+}
+
+size_t Alert::renderMessage(char* buffer, size_t size) const {
+    if (code != AlertCode::CUSTOM) {
+        return AlertTemplates::render(code, value, sensorId, note, buffer, size);
+    }
+    if (size > 0) {
+        const size_t copied = std::min(message.size(), size - 1);
+        memcpy(buffer, message.data(), copied);
+        buffer[copied] = '\0';
+    }
+    return message.size();
+}
+
 std::string Alert::toString() const {
-    std::ostringstream oss;
-    oss << "ID: " << id 
-        << " | Severidad: " << getSeverityString()
-        << " | Mensaje: " << message
-        << " | Fecha: " << getDateTimeString();
-    return oss.str();
+    std::string severityText = getSeverityString();
+    char idText[16];
+    int idLength = snprintf(idText, sizeof(idText), "%d", id);
+
+    std::string text;
+    text.reserve(112 + static_cast<size_t>(idLength) + severityText.size() + message.size() +
+                 TimeFormatter::DATETIME_LENGTH);
+    text += "ID: ";
+    text.append(idText, static_cast<size_t>(idLength));
+    text += " | Severidad: ";
+    text += severityText;
+    text += " | Mensaje: ";
+    text += getMessage();
+    text += " | Fecha: ";
+    TimeFormatter::appendDateTime(timestamp, text);
+    return text;
 }
 
 std::string Alert::getDateTimeString() const {
-    std::ostringstream oss;
-    struct tm* timeinfo = localtime(&timestamp);
-    oss << std::put_time(timeinfo, "%Y-%m-%d %H:%M:%S");
-    return oss.str();
-} 
\ No newline at end of file
+    // TimeFormatter usa localtime_r: las alertas se formatean desde los hilos de envío de email
+    return TimeFormatter::dateTime(timestamp);
+}
+
+std::string Alert::renderMessage(AlertCode alertCode, float measured, int sensor, AlertNote alertNote) {
+    return Alert(alertCode, measured, sensor, AlertSeverity::LOW, 0, alertNote).getMessage();
+}
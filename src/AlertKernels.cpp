@@ -0,0 +1,271 @@
+#include "../include/AlertKernels.h"
+#include <cstring>
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CLIMA_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const size_t COLLECT_CHUNK_ROWS = 4096; ///< Filas clasificadas por vuelta en collectAlerts
+
+/**
+ * @brief Código de una métrica (3 bits) con la misma lógica que los kernels SIMD
+ */
+inline uint8_t classifyMetric(float value, float high, float low, float criticalHigh, float criticalLow) {
+    const bool above = value > high;
+    const bool below = !above && value < low;
+    uint8_t level = 0;
+    if (above) {
+        level = static_cast<uint8_t>(1 + (value > criticalHigh ? 1 : 0));
+    } else if (below) {
+        level = static_cast<uint8_t>(1 + (value < criticalLow ? 1 : 0));
+    }
+    return static_cast<uint8_t>(level | (above ? AlertKernels::ABOVE_BIT : 0));
+}
+
+size_t evaluateScalar(const float* temperatures, const float* humidities, size_t count,
+                      const AlertThresholds& t, uint8_t* codes) {
+    size_t hits = 0;
+    for (size_t i = 0; i < count; ++i) {
+        codes[i] = AlertKernels::classify(temperatures[i], humidities[i], t);
+        hits += codes[i] != 0;
+    }
+    return hits;
+}
+
+#ifdef CLIMA_KERNELS_X86
+
+__attribute__((target("sse2")))
+inline __m128i classifyMetricSse2(__m128 value, __m128 high, __m128 low,
+                                  __m128 criticalHigh, __m128 criticalLow) {
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i above = _mm_castps_si128(_mm_cmpgt_ps(value, high));
+    const __m128i below = _mm_andnot_si128(above, _mm_castps_si128(_mm_cmplt_ps(value, low)));
+    const __m128i overCritical = _mm_castps_si128(_mm_cmpgt_ps(value, criticalHigh));
+    const __m128i underCritical = _mm_castps_si128(_mm_cmplt_ps(value, criticalLow));
+
+    __m128i code = _mm_and_si128(above, _mm_add_epi32(one, _mm_and_si128(overCritical, one)));
+    code = _mm_or_si128(code, _mm_and_si128(below, _mm_add_epi32(one, _mm_and_si128(underCritical, one))));
+    return _mm_or_si128(code, _mm_and_si128(above, _mm_set1_epi32(AlertKernels::ABOVE_BIT)));
+}
+
+__attribute__((target("sse2")))
+size_t evaluateSse2(const float* temperatures, const float* humidities, size_t count,
+                    const AlertThresholds& t, uint8_t* codes) {
+    const __m128 tempHigh = _mm_set1_ps(t.tempHigh);
+    const __m128 tempLow = _mm_set1_ps(t.tempLow);
+    const __m128 tempCriticalHigh = _mm_set1_ps(t.tempCriticalHigh);
+    const __m128 tempCriticalLow = _mm_set1_ps(t.tempCriticalLow);
+    const __m128 humHigh = _mm_set1_ps(t.humidityHigh);
+    const __m128 humLow = _mm_set1_ps(t.humidityLow);
+    const __m128 humCriticalHigh = _mm_set1_ps(t.humidityCriticalHigh);
+    const __m128 humCriticalLow = _mm_set1_ps(t.humidityCriticalLow);
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t hits = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i temp = classifyMetricSse2(_mm_loadu_ps(temperatures + i),
+                                          tempHigh, tempLow, tempCriticalHigh, tempCriticalLow);
+        __m128i hum = classifyMetricSse2(_mm_loadu_ps(humidities + i),
+                                         humHigh, humLow, humCriticalHigh, humCriticalLow);
+        __m128i code = _mm_or_si128(temp, _mm_slli_epi32(hum, AlertKernels::HUMIDITY_SHIFT));
+
+        // Empaquetar los 4 códigos de 32 bits en 4 bytes
+        __m128i packed = _mm_packus_epi16(_mm_packs_epi32(code, zero), zero);
+        int32_t word = _mm_cvtsi128_si32(packed);
+        std::memcpy(codes + i, &word, sizeof(word));
+
+        int inRange = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(code, zero)));
+        hits += 4 - __builtin_popcount(static_cast<unsigned>(inRange));
+    }
+    return hits + evaluateScalar(temperatures + i, humidities + i, count - i, t, codes + i);
+}
+
+__attribute__((target("avx2")))
+inline __m256i classifyMetricAvx2(__m256 value, __m256 high, __m256 low,
+                                  __m256 criticalHigh, __m256 criticalLow) {
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i above = _mm256_castps_si256(_mm256_cmp_ps(value, high, _CMP_GT_OQ));
+    const __m256i below = _mm256_andnot_si256(above, _mm256_castps_si256(_mm256_cmp_ps(value, low, _CMP_LT_OQ)));
+    const __m256i overCritical = _mm256_castps_si256(_mm256_cmp_ps(value, criticalHigh, _CMP_GT_OQ));
+    const __m256i underCritical = _mm256_castps_si256(_mm256_cmp_ps(value, criticalLow, _CMP_LT_OQ));
+
+    __m256i code = _mm256_and_si256(above, _mm256_add_epi32(one, _mm256_and_si256(overCritical, one)));
+    code = _mm256_or_si256(code, _mm256_and_si256(below, _mm256_add_epi32(one, _mm256_and_si256(underCritical, one))));
+    return _mm256_or_si256(code, _mm256_and_si256(above, _mm256_set1_epi32(AlertKernels::ABOVE_BIT)));
+}
+
+__attribute__((target("avx2")))
+size_t evaluateAvx2(const float* temperatures, const float* humidities, size_t count,
+                    const AlertThresholds& t, uint8_t* codes) {
+    const __m256 tempHigh = _mm256_set1_ps(t.tempHigh);
+    const __m256 tempLow = _mm256_set1_ps(t.tempLow);
+    const __m256 tempCriticalHigh = _mm256_set1_ps(t.tempCriticalHigh);
+    const __m256 tempCriticalLow = _mm256_set1_ps(t.tempCriticalLow);
+    const __m256 humHigh = _mm256_set1_ps(t.humidityHigh);
+    const __m256 humLow = _mm256_set1_ps(t.humidityLow);
+    const __m256 humCriticalHigh = _mm256_set1_ps(t.humidityCriticalHigh);
+    const __m256 humCriticalLow = _mm256_set1_ps(t.humidityCriticalLow);
+    const __m256i zero = _mm256_setzero_si256();
+
+    size_t hits = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i temp = classifyMetricAvx2(_mm256_loadu_ps(temperatures + i),
+                                          tempHigh, tempLow, tempCriticalHigh, tempCriticalLow);
+        __m256i hum = classifyMetricAvx2(_mm256_loadu_ps(humidities + i),
+                                         humHigh, humLow, humCriticalHigh, humCriticalLow);
+        __m256i code = _mm256_or_si256(temp, _mm256_slli_epi32(hum, AlertKernels::HUMIDITY_SHIFT));
+
+        // Empaquetar los 8 códigos de 32 bits en 8 bytes (las mitades se empaquetan por separado)
+        __m128i low = _mm256_castsi256_si128(code);
+        __m128i high = _mm256_extracti128_si256(code, 1);
+        __m128i packed = _mm_packus_epi16(_mm_packs_epi32(low, high), _mm_setzero_si128());
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(codes + i), packed);
+
+        int inRange = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(code, zero)));
+        hits += 8 - __builtin_popcount(static_cast<unsigned>(inRange));
+    }
+    return hits + evaluateScalar(temperatures + i, humidities + i, count - i, t, codes + i);
+}
+
+#endif // CLIMA_KERNELS_X86
+
+void appendAlert(std::vector<Alert>& alerts, bool isTemperature, int direction, float value,
+                 AlertSeverity severity, int64_t timestamp, int32_t sensorId) {
+    AlertCode code;
+    if (isTemperature) {
+        code = direction > 0 ? AlertCode::TEMPERATURE_HIGH : AlertCode::TEMPERATURE_LOW;
+    } else {
+        code = direction > 0 ? AlertCode::HUMIDITY_HIGH : AlertCode::HUMIDITY_LOW;
+    }
+    alerts.push_back(Alert(code, value, sensorId, severity, static_cast<time_t>(timestamp)));
+}
+
+} // namespace
+
+const uint8_t AlertKernels::LEVEL_MASK;
+const uint8_t AlertKernels::ABOVE_BIT;
+const int AlertKernels::HUMIDITY_SHIFT;
+
+AlertThresholds::AlertThresholds()
+    : tempHigh(30.0f), tempLow(15.0f), tempCriticalHigh(35.0f), tempCriticalLow(10.0f),
+      humidityHigh(80.0f), humidityLow(20.0f), humidityCriticalHigh(90.0f), humidityCriticalLow(10.0f) {
+}
+
+KernelIsa AlertKernels::detectIsa() {
+#ifdef CLIMA_KERNELS_X86
+    static const KernelIsa detected = __builtin_cpu_supports("avx2") ? KernelIsa::AVX2
+                                    : __builtin_cpu_supports("sse2") ? KernelIsa::SSE2
+                                    : KernelIsa::SCALAR;
+    return detected;
+#else
+    return KernelIsa::SCALAR;
+#endif
+}
+
+const char* AlertKernels::isaName(KernelIsa isa) {
+    switch (isa) {
+        case KernelIsa::AVX2: return "avx2";
+        case KernelIsa::SSE2: return "sse2";
+        default: return "scalar";
+    }
+}
+
+uint8_t AlertKernels::classify(float temperature, float humidity, const AlertThresholds& t) {
+    uint8_t temp = classifyMetric(temperature, t.tempHigh, t.tempLow, t.tempCriticalHigh, t.tempCriticalLow);
+    uint8_t hum = classifyMetric(humidity, t.humidityHigh, t.humidityLow,
+                                 t.humidityCriticalHigh, t.humidityCriticalLow);
+    return static_cast<uint8_t>(temp | (hum << HUMIDITY_SHIFT));
+}
+
+size_t AlertKernels::evaluate(const float* temperatures, const float* humidities, size_t count,
+                              const AlertThresholds& thresholds, uint8_t* codes) {
+    return evaluateWith(detectIsa(), temperatures, humidities, count, thresholds, codes);
+}
+
+size_t AlertKernels::evaluateWith(KernelIsa isa, const float* temperatures, const float* humidities,
+                                  size_t count, const AlertThresholds& thresholds, uint8_t* codes) {
+    const KernelIsa available = detectIsa();
+    if (static_cast<int>(isa) > static_cast<int>(available)) {
+        isa = available;
+    }
+
+#ifdef CLIMA_KERNELS_X86
+    if (isa == KernelIsa::AVX2) {
+        return evaluateAvx2(temperatures, humidities, count, thresholds, codes);
+    }
+    if (isa == KernelIsa::SSE2) {
+        return evaluateSse2(temperatures, humidities, count, thresholds, codes);
+    }
+#endif
+    return evaluateScalar(temperatures, humidities, count, thresholds, codes);
+}
+
+size_t AlertKernels::collectAlerts(const float* temperatures, const float* humidities,
+                                   const int64_t* timestamps, const int32_t* sensorIds, size_t count,
+                                   const AlertThresholds& thresholds, std::vector<Alert>& alerts) {
+    const size_t before = alerts.size();
+    uint8_t codes[COLLECT_CHUNK_ROWS];
+
+    for (size_t base = 0; base < count; base += COLLECT_CHUNK_ROWS) {
+        const size_t rows = std::min(COLLECT_CHUNK_ROWS, count - base);
+        if (evaluate(temperatures + base, humidities + base, rows, thresholds, codes) == 0) {
+            continue;
+        }
+
+        for (size_t row = 0; row < rows; ++row) {
+            // Saltar de a 8 filas mientras estén todas en rango
+            if ((row & 7) == 0 && row + 8 <= rows) {
+                uint64_t word;
+                std::memcpy(&word, codes + row, sizeof(word));
+                if (word == 0) {
+                    row += 7;
+                    continue;
+                }
+            }
+
+            const uint8_t code = codes[row];
+            if (code == 0) {
+                continue;
+            }
+            const size_t i = base + row;
+            const int32_t sensorId = sensorIds ? sensorIds[i] : 0;
+            if (temperatureLevel(code) != 0) {
+                appendAlert(alerts, true, temperatureDirection(code), temperatures[i],
+                            temperatureSeverity(code), timestamps[i], sensorId);
+            }
+            if (humidityLevel(code) != 0) {
+                appendAlert(alerts, false, humidityDirection(code), humidities[i],
+                            humiditySeverity(code), timestamps[i], sensorId);
+            }
+        }
+    }
+    return alerts.size() - before;
+}
+
+int AlertKernels::temperatureDirection(uint8_t code) {
+    if (temperatureLevel(code) == 0) {
+        return 0;
+    }
+    return (code & ABOVE_BIT) ? 1 : -1;
+}
+
+int AlertKernels::humidityDirection(uint8_t code) {
+    if (humidityLevel(code) == 0) {
+        return 0;
+    }
+    return ((code >> HUMIDITY_SHIFT) & ABOVE_BIT) ? 1 : -1;
+}
+
+AlertSeverity AlertKernels::temperatureSeverity(uint8_t code) {
+    return temperatureLevel(code) >= 2 ? AlertSeverity::CRITICAL : AlertSeverity::HIGH;
+}
+
+AlertSeverity AlertKernels::humiditySeverity(uint8_t code) {
+    return humidityLevel(code) >= 2 ? AlertSeverity::HIGH : AlertSeverity::MEDIUM;
+}
@@ -0,0 +1,144 @@
+#include "../include/AlertTemplates.h"
+#include <atomic>
+#include <mutex>
+#include <deque>
+#include <unordered_map>
+#include <cstdio>
+#include <cstring>
+
+const uint16_t AlertTemplates::FIRST_INTERNED_CODE;
+const size_t AlertTemplates::MAX_TEMPLATES;
+
+namespace {
+
+const char* const VALUE_MARKER = "{value}";
+const size_t VALUE_MARKER_LENGTH = 7;
+
+/**
+ * @brief Plantillas del sistema, indexadas por AlertCode
+ */
+const char* const BUILTIN_TEMPLATES[] = {
+    nullptr,                                // CUSTOM
+    "Temperatura crítica: {value}°C",       // TEMPERATURE_HIGH
+    "Temperatura muy baja: {value}°C",      // TEMPERATURE_LOW
+    "Temperatura normalizada: {value}°C",   // TEMPERATURE_NORMAL
+    "Humedad muy alta: {value}%",           // HUMIDITY_HIGH
+    "Humedad muy baja: {value}%",           // HUMIDITY_LOW
+    "Humedad normalizada: {value}%",        // HUMIDITY_NORMAL
+    "Pronóstico: la temperatura superará el umbral alto en {value} min",   // TEMPERATURE_HIGH_PREDICTED
+    "Pronóstico: la temperatura bajará del umbral bajo en {value} min",    // TEMPERATURE_LOW_PREDICTED
+    "Pronóstico: la humedad superará el umbral alto en {value} min",       // HUMIDITY_HIGH_PREDICTED
+    "Pronóstico: la humedad bajará del umbral bajo en {value} min"         // HUMIDITY_LOW_PREDICTED
+};
+const size_t BUILTIN_COUNT = sizeof(BUILTIN_TEMPLATES) / sizeof(BUILTIN_TEMPLATES[0]);
+
+/**
+ * @brief Plantillas agregadas en ejecución
+ *
+ * Los textos viven en un deque (sus direcciones no cambian al crecer) y se
+ * publican en un arreglo de punteros atómicos para que find() no tome locks.
+ */
+struct InternedTemplates {
+    std::atomic<const char*> texts[AlertTemplates::MAX_TEMPLATES - AlertTemplates::FIRST_INTERNED_CODE];
+    std::deque<std::string> storage;                    ///< Textos registrados
+    std::unordered_map<std::string, uint16_t> codes;    ///< Código de cada texto
+    std::mutex mutex;                                   ///< Serializa los registros
+
+    InternedTemplates() {
+        for (std::atomic<const char*>& text : texts) {
+            text.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+};
+
+InternedTemplates& interned() {
+    static InternedTemplates instance;
+    return instance;
+}
+
+/**
+ * @brief Copia texto al buffer sin desbordarlo y cuenta el largo total
+ */
+inline void append(char* buffer, size_t size, size_t& length, const char* text, size_t textLength) {
+    if (length < size) {
+        const size_t room = size - length - 1;
+        memcpy(buffer + length, text, textLength < room ? textLength : room);
+    }
+    length += textLength;
+}
+
+} // namespace
+
+const char* AlertTemplates::find(AlertCode code) {
+    const size_t index = static_cast<size_t>(code);
+    if (index < BUILTIN_COUNT) {
+        return BUILTIN_TEMPLATES[index];
+    }
+    if (index >= FIRST_INTERNED_CODE && index < MAX_TEMPLATES) {
+        return interned().texts[index - FIRST_INTERNED_CODE].load(std::memory_order_acquire);
+    }
+    return nullptr;
+}
+
+bool AlertTemplates::isBuiltin(AlertCode code) {
+    const size_t index = static_cast<size_t>(code);
+    return index > 0 && index < BUILTIN_COUNT;
+}
+
+AlertCode AlertTemplates::intern(const std::string& text) {
+    for (size_t i = 1; i < BUILTIN_COUNT; ++i) {
+        if (text == BUILTIN_TEMPLATES[i]) {
+            return static_cast<AlertCode>(i);
+        }
+    }
+
+    InternedTemplates& pool = interned();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    std::unordered_map<std::string, uint16_t>::const_iterator existing = pool.codes.find(text);
+    if (existing != pool.codes.end()) {
+        return static_cast<AlertCode>(existing->second);
+    }
+    if (pool.storage.size() >= MAX_TEMPLATES - FIRST_INTERNED_CODE) {
+        return AlertCode::CUSTOM;
+    }
+
+    const uint16_t code = static_cast<uint16_t>(FIRST_INTERNED_CODE + pool.storage.size());
+    pool.storage.push_back(text);
+    pool.codes[text] = code;
+    pool.texts[code - FIRST_INTERNED_CODE].store(pool.storage.back().c_str(), std::memory_order_release);
+    return static_cast<AlertCode>(code);
+}
+
+size_t AlertTemplates::render(AlertCode code, float value, int sensor, AlertNote note, char* buffer, size_t size) {
+    size_t length = 0;
+    const char* text = find(code);
+    if (text != nullptr) {
+        const char* marker = strstr(text, VALUE_MARKER);
+        if (marker == nullptr) {
+            append(buffer, size, length, text, strlen(text));
+        } else {
+            char number[32];
+            int numberLength = snprintf(number, sizeof(number), "%g", value);
+            append(buffer, size, length, text, static_cast<size_t>(marker - text));
+            append(buffer, size, length, number, numberLength > 0 ? static_cast<size_t>(numberLength) : 0);
+            const char* rest = marker + VALUE_MARKER_LENGTH;
+            append(buffer, size, length, rest, strlen(rest));
+        }
+
+        if (note == AlertNote::ESCALATED) {
+            append(buffer, size, length, " (escalada)", 11);
+        } else if (note == AlertNote::PERSISTENT) {
+            append(buffer, size, length, " (persistente)", 14);
+        }
+        if (sensor != 0) {
+            char suffix[32];
+            int suffixLength = snprintf(suffix, sizeof(suffix), " [sensor %d]", sensor);
+            append(buffer, size, length, suffix, suffixLength > 0 ? static_cast<size_t>(suffixLength) : 0);
+        }
+    }
+
+    if (size > 0) {
+        buffer[length < size ? length : size - 1] = '\0';
+    }
+    return length;
+}
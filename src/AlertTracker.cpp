@@ -0,0 +1,141 @@
+#include "../include/AlertTracker.h"
+#include <algorithm>
+
+AlertPolicy::AlertPolicy()
+    : temperatureHysteresis(1.0f), humidityHysteresis(3.0f), renotifyIntervalSec(1800),
+      notificationsPerMinute(12.0), notificationBurst(20) {}
+
+AlertTracker::AlertTracker(const AlertPolicy& alertPolicy)
+    : policy(alertPolicy), tokens(alertPolicy.notificationBurst), lastRefill(0), stats() {}
+
+uint64_t AlertTracker::key(int sensorId, AlertMetric metric) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(sensorId)) << 8) |
+           static_cast<uint64_t>(metric);
+}
+
+bool AlertTracker::takeToken(time_t now) {
+    if (policy.notificationsPerMinute <= 0.0) {
+        return true;
+    }
+
+    // Solo se repone hacia adelante: lecturas de varios sensores pueden llegar desordenadas
+    if (now > lastRefill) {
+        if (lastRefill != 0) {
+            tokens += (now - lastRefill) * policy.notificationsPerMinute / 60.0;
+            tokens = std::min(tokens, static_cast<double>(policy.notificationBurst));
+        }
+        lastRefill = now;
+    }
+
+    if (tokens < 1.0) {
+        return false;
+    }
+    tokens -= 1.0;
+    return true;
+}
+
+AlertTransition AlertTracker::evaluate(int sensorId, AlertMetric metric, int direction,
+                                       AlertSeverity severity, bool cleared, time_t now) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const uint64_t k = key(sensorId, metric);
+    auto it = states.find(k);
+
+    // La transición se decide sin tocar el estado: si el token bucket la
+    // limita queda pendiente y la próxima lectura la vuelve a intentar
+    AlertTransition transition = AlertTransition::NONE;
+    if (direction == 0) {
+        if (it == states.end()) {
+            return AlertTransition::NONE;
+        }
+        if (!cleared) {
+            // Dentro del rango pero aún en la banda de histéresis: sigue activa
+            return AlertTransition::NONE;
+        }
+        severity = it->second.severity;
+        transition = AlertTransition::CLEAR;
+    } else if (it == states.end()) {
+        transition = AlertTransition::RAISE;
+    } else if (direction != it->second.direction || severity > it->second.severity) {
+        transition = AlertTransition::ESCALATE;
+    } else if (policy.renotifyIntervalSec > 0 &&
+               now - it->second.lastNotified >= policy.renotifyIntervalSec) {
+        // Una severidad menor no des-escala: se recuerda la mayor notificada
+        severity = it->second.severity;
+        transition = AlertTransition::RENOTIFY;
+    } else {
+        ++stats.suppressed;
+        return AlertTransition::NONE;
+    }
+
+    if (severity != AlertSeverity::CRITICAL && !takeToken(now)) {
+        ++stats.rateLimited;
+        return AlertTransition::NONE;
+    }
+
+    switch (transition) {
+        case AlertTransition::RAISE: {
+            MetricState state;
+            state.direction = direction;
+            state.severity = severity;
+            state.lastNotified = now;
+            states.insert(std::make_pair(k, state));
+            ++stats.raised;
+            break;
+        }
+        case AlertTransition::ESCALATE:
+            it->second.direction = direction;
+            it->second.severity = severity;
+            it->second.lastNotified = now;
+            ++stats.escalated;
+            break;
+        case AlertTransition::RENOTIFY:
+            it->second.lastNotified = now;
+            ++stats.renotified;
+            break;
+        case AlertTransition::CLEAR:
+            states.erase(it);
+            ++stats.cleared;
+            break;
+        default:
+            break;
+    }
+    return transition;
+}
+
+bool AlertTracker::dismiss(int sensorId, AlertMetric metric) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return states.erase(key(sensorId, metric)) > 0;
+}
+
+bool AlertTracker::isActive(int sensorId, AlertMetric metric) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return states.find(key(sensorId, metric)) != states.end();
+}
+
+void AlertTracker::setPolicy(const AlertPolicy& alertPolicy) {
+    std::lock_guard<std::mutex> lock(mutex);
+    policy = alertPolicy;
+    tokens = std::min(tokens, static_cast<double>(policy.notificationBurst));
+}
+
+AlertPolicy AlertTracker::getPolicy() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return policy;
+}
+
+AlertTrackerStats AlertTracker::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+size_t AlertTracker::getActiveCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return states.size();
+}
+
+void AlertTracker::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    states.clear();
+    tokens = policy.notificationBurst;
+    lastRefill = 0;
+}
@@ -0,0 +1,205 @@
+#include "../include/BinaryRecordCodec.h"
+#include "../include/AlertTemplates.h"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+const uint8_t BinaryRecordCodec::FORMAT_VERSION;
+const size_t BinaryRecordCodec::HEADER_SIZE;
+const size_t BinaryRecordCodec::READING_SIZE;
+const size_t BinaryRecordCodec::ALERT_SIZE;
+
+namespace {
+
+const uint8_t MAGIC[4] = { 'C', 'L', 'R', 'B' };
+
+// Lectura y escritura little-endian byte a byte: independiente de la
+// alineación y del orden de bytes del procesador (en x86 el compilador
+// las reduce a un único mov)
+inline void put16(uint8_t* out, uint16_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+inline void put32(uint8_t* out, uint32_t value) {
+    put16(out, static_cast<uint16_t>(value));
+    put16(out + 2, static_cast<uint16_t>(value >> 16));
+}
+
+inline void put64(uint8_t* out, uint64_t value) {
+    put32(out, static_cast<uint32_t>(value));
+    put32(out + 4, static_cast<uint32_t>(value >> 32));
+}
+
+inline uint16_t get16(const uint8_t* in) {
+    return static_cast<uint16_t>(in[0] | (in[1] << 8));
+}
+
+inline uint32_t get32(const uint8_t* in) {
+    return get16(in) | (static_cast<uint32_t>(get16(in + 2)) << 16);
+}
+
+inline uint64_t get64(const uint8_t* in) {
+    return get32(in) | (static_cast<uint64_t>(get32(in + 4)) << 32);
+}
+
+/**
+ * @brief Convierte un valor a centésimas si entra en [minimum, maximum]
+ */
+inline bool toCenti(float value, long minimum, long maximum, long& centi) {
+    if (std::isnan(value)) {
+        return false;
+    }
+    const double scaled = std::floor(static_cast<double>(value) * 100.0 + 0.5);
+    if (scaled < minimum || scaled > maximum) {
+        return false;
+    }
+    centi = static_cast<long>(scaled);
+    return true;
+}
+
+/**
+ * @brief Calcula el delta de tiempo de un registro si entra en u32
+ */
+inline bool toDelta(time_t timestamp, time_t baseTime, uint32_t& delta) {
+    const int64_t diff = static_cast<int64_t>(timestamp) - static_cast<int64_t>(baseTime);
+    if (diff < 0 || diff > static_cast<int64_t>(UINT32_MAX)) {
+        return false;
+    }
+    delta = static_cast<uint32_t>(diff);
+    return true;
+}
+
+template <typename Record, typename Encode>
+bool appendBlock(RecordType type, size_t recordSize, const Record* records, size_t count,
+                 std::vector<uint8_t>& out, Encode encode) {
+    if (count > UINT32_MAX) {
+        return false;
+    }
+    time_t baseTime = 0;
+    for (size_t i = 0; i < count; ++i) {
+        baseTime = i == 0 ? records[i].getTimestamp() : std::min(baseTime, records[i].getTimestamp());
+    }
+
+    const size_t start = out.size();
+    out.resize(start + BinaryRecordCodec::HEADER_SIZE + count * recordSize);
+    uint8_t* cursor = out.data() + start;
+    BinaryRecordCodec::writeHeader(type, static_cast<uint32_t>(count), baseTime, cursor);
+    cursor += BinaryRecordCodec::HEADER_SIZE;
+
+    for (size_t i = 0; i < count; ++i, cursor += recordSize) {
+        if (!encode(records[i], baseTime, cursor)) {
+            out.resize(start);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool BinaryRecordCodec::encodeReading(const ClimateReading& reading, time_t baseTime, uint8_t* out) {
+    uint32_t delta;
+    long temperature;
+    long humidity;
+    const int sensorId = reading.getSensorId();
+    if (!toDelta(reading.getTimestamp(), baseTime, delta) ||
+        !toCenti(reading.getTemperature(), INT16_MIN, INT16_MAX, temperature) ||
+        !toCenti(reading.getHumidity(), 0, UINT16_MAX, humidity) ||
+        sensorId < 0 || sensorId > UINT16_MAX) {
+        return false;
+    }
+
+    put32(out, delta);
+    put16(out + 4, static_cast<uint16_t>(static_cast<int16_t>(temperature)));
+    put16(out + 6, static_cast<uint16_t>(humidity));
+    put16(out + 8, static_cast<uint16_t>(sensorId));
+    return true;
+}
+
+ClimateReading BinaryRecordCodec::decodeReading(const uint8_t* in, time_t baseTime) {
+    return ClimateReading(0,
+                          static_cast<int16_t>(get16(in + 4)) / 100.0f,
+                          get16(in + 6) / 100.0f,
+                          baseTime + static_cast<time_t>(get32(in)),
+                          get16(in + 8));
+}
+
+bool BinaryRecordCodec::encodeAlert(const Alert& alert, time_t baseTime, uint8_t* out) {
+    uint32_t delta;
+    long value;
+    const int sensorId = alert.getSensorId();
+    if (!AlertTemplates::isBuiltin(alert.getCode()) ||
+        !toDelta(alert.getTimestamp(), baseTime, delta) ||
+        !toCenti(alert.getValue(), INT16_MIN, INT16_MAX, value) ||
+        sensorId < 0 || sensorId > UINT16_MAX) {
+        return false;
+    }
+
+    put32(out, delta);
+    put16(out + 4, static_cast<uint16_t>(sensorId));
+    put16(out + 6, static_cast<uint16_t>(alert.getCode()));
+    out[8] = static_cast<uint8_t>(alert.getSeverity());
+    out[9] = static_cast<uint8_t>(alert.getNote());
+    put16(out + 10, static_cast<uint16_t>(static_cast<int16_t>(value)));
+    return true;
+}
+
+Alert BinaryRecordCodec::decodeAlert(const uint8_t* in, time_t baseTime) {
+    return Alert(static_cast<AlertCode>(get16(in + 6)),
+                 static_cast<int16_t>(get16(in + 10)) / 100.0f,
+                 get16(in + 4),
+                 static_cast<AlertSeverity>(std::min<uint8_t>(in[8], static_cast<uint8_t>(AlertSeverity::CRITICAL))),
+                 baseTime + static_cast<time_t>(get32(in)),
+                 static_cast<AlertNote>(in[9]));
+}
+
+void BinaryRecordCodec::writeHeader(RecordType type, uint32_t count, time_t baseTime, uint8_t* out) {
+    memcpy(out, MAGIC, sizeof(MAGIC));
+    out[4] = FORMAT_VERSION;
+    out[5] = static_cast<uint8_t>(type);
+    put16(out + 6, static_cast<uint16_t>(type == RecordType::READING ? READING_SIZE : ALERT_SIZE));
+    put32(out + 8, count);
+    put32(out + 12, 0);
+    put64(out + 16, static_cast<uint64_t>(static_cast<int64_t>(baseTime)));
+}
+
+bool BinaryRecordCodec::appendReadings(const ClimateReading* readings, size_t count, std::vector<uint8_t>& out) {
+    return appendBlock(RecordType::READING, READING_SIZE, readings, count, out, encodeReading);
+}
+
+bool BinaryRecordCodec::appendAlerts(const Alert* alerts, size_t count, std::vector<uint8_t>& out) {
+    return appendBlock(RecordType::ALERT, ALERT_SIZE, alerts, count, out, encodeAlert);
+}
+
+RecordBlockReader::RecordBlockReader(const uint8_t* data, size_t size)
+    : records(nullptr), recordCount(0), recordSize(0), baseTime(0),
+      recordType(RecordType::READING), valid(false) {
+    if (data == nullptr || size < BinaryRecordCodec::HEADER_SIZE || memcmp(data, MAGIC, sizeof(MAGIC)) != 0 ||
+        data[4] == 0 || data[4] > BinaryRecordCodec::FORMAT_VERSION) {
+        return;
+    }
+
+    const uint8_t type = data[5];
+    size_t minimumSize;
+    if (type == static_cast<uint8_t>(RecordType::READING)) {
+        minimumSize = BinaryRecordCodec::READING_SIZE;
+    } else if (type == static_cast<uint8_t>(RecordType::ALERT)) {
+        minimumSize = BinaryRecordCodec::ALERT_SIZE;
+    } else {
+        return;
+    }
+
+    const size_t stride = get16(data + 6);
+    const size_t count = get32(data + 8);
+    if (stride < minimumSize || count > (size - BinaryRecordCodec::HEADER_SIZE) / stride) {
+        return;
+    }
+
+    records = data + BinaryRecordCodec::HEADER_SIZE;
+    recordCount = count;
+    recordSize = stride;
+    baseTime = static_cast<time_t>(static_cast<int64_t>(get64(data + 16)));
+    recordType = static_cast<RecordType>(type);
+    valid = true;
+}
@@ -1,175 +1,513 @@
 #include "../include/ClimateControlService.h"
-#include <iostream>
-#include <sstream>
+#include "../include/Logger.h"
+#include "../include/MetricsRegistry.h"
+#include <cmath>
+#include <limits>
 
 ClimateControlService::ClimateControlService(IMSForecast* forecast, 
                                            ClimateDataManager* dataMgr, 
                                            EmailService* emailSvc)
     : msForecast(forecast), dataManager(dataMgr), emailService(emailSvc),
-      tempHighThreshold(30.0), tempLowThreshold(15.0),
-      humidityHighThreshold(80.0), humidityLowThreshold(20.0) {
+      commandCoalescer(std::chrono::milliseconds(50), [this]() { takeReading(); }),
+      snapshotCache([this](int sensorId, ClimateSnapshot& snapshot) { return fetchSnapshot(sensorId, snapshot); }) {
     
-    std::cout << "ClimateControlService: Inicializando servicio de control de clima" << std::endl;
-    std::cout << "  Umbrales de temperatura: " << tempLowThreshold << "°C - " << tempHighThreshold << "°C" << std::endl;
-    std::cout << "  Umbrales de humedad: " << humidityLowThreshold << "% - " << humidityHighThreshold << "%" << std::endl;
+    LOG_INFO("ClimateControlService", "Inicializando servicio de control de clima",
+             "temp_low", alertThresholds.tempLow, "temp_high", alertThresholds.tempHigh,
+             "humidity_low", alertThresholds.humidityLow, "humidity_high", alertThresholds.humidityHigh);
 }
 
 ClimateControlService::~ClimateControlService() {
-    std::cout << "ClimateControlService: Destruyendo servicio de control de clima" << std::endl;
+    disableAutomaticControl();
+    disableIngestPipeline();
+    LOG_INFO("ClimateControlService", "Destruyendo servicio de control de clima");
 }
 
 ClimateReading ClimateControlService::takeReading() {
-    std::cout << "ClimateControlService: Tomando lectura del clima..." << std::endl;
+    static LatencyHistogram& latency = MetricsRegistry::instance().histogram(
+        "clima_control_loop_duration_seconds", "Duración de una lectura del lazo de control, desde la petición hasta el guardado o el encolado",
+        "op=\"takeReading\"");
+    ScopedLatency timer(latency);
+    LOG_DEBUG("ClimateControlService", "Tomando lectura del clima");
     
-    // Obtener lecturas actuales
-    float temperature = msForecast->readTemp();
-    float humidity = msForecast->readHumidity();
+    // Obtener temperatura y humedad del mismo instante en una sola petición
+    ClimateSnapshot snapshot = msForecast->readSnapshot();
     
     // Crear objeto de lectura
-    ClimateReading reading(temperature, humidity);
+    ClimateReading reading(0, snapshot.temperature, snapshot.humidity,
+                           snapshot.timestamp, snapshot.sensorId);
+    if (!isValidSnapshot(snapshot)) {
+        // La API no respondió: no se guarda ni se evalúa nada
+        LOG_WARN("ClimateControlService", "Lectura descartada: la API no devolvió valores válidos",
+                 "sensor", snapshot.sensorId);
+        return reading;
+    }
+    snapshotCache.store(snapshot);
+    ingestReading(reading);
+    
+    return reading;
+}
+
+std::vector<ClimateReading> ClimateControlService::takeReadings(const std::vector<int>& sensorIds) {
+    std::vector<ClimateReading> readings;
+    std::vector<ClimateSnapshot> snapshots;
+    
+    if (!msForecast->readSnapshots(sensorIds, snapshots)) {
+        LOG_WARN("ClimateControlService", "La API no soporta lecturas por lote",
+                 "sensors", sensorIds.size());
+        return readings;
+    }
+    
+    readings.reserve(snapshots.size());
+    for (const ClimateSnapshot& snapshot : snapshots) {
+        if (!isValidSnapshot(snapshot)) {
+            LOG_WARN("ClimateControlService", "Lectura descartada: la API no devolvió valores válidos",
+                     "sensor", snapshot.sensorId);
+            continue;
+        }
+        snapshotCache.store(snapshot);
+        readings.push_back(ClimateReading(0, snapshot.temperature, snapshot.humidity,
+                                          snapshot.timestamp, snapshot.sensorId));
+        ingestReading(readings.back());
+    }
+    
+    LOG_DEBUG("ClimateControlService", "Lectura por lote tomada", "sensors", readings.size());
+    return readings;
+}
+
+bool ClimateControlService::isValidSnapshot(const ClimateSnapshot& snapshot) {
+    return std::isfinite(snapshot.temperature) && std::isfinite(snapshot.humidity);
+}
+
+bool ClimateControlService::ingestReading(const ClimateReading& reading) {
+    // Un NaN haría fallar el lote completo en la base y contaminaría para
+    // siempre las estadísticas en streaming y el pronóstico
+    if (!std::isfinite(reading.getTemperature()) || !std::isfinite(reading.getHumidity())) {
+        LOG_WARN("ClimateControlService", "Lectura con valores no finitos descartada",
+                 "sensor", reading.getSensorId());
+        return false;
+    }
+    
+    if (ingestPipeline) {
+        return ingestPipeline->submit(reading);
+    }
     
     // Guardar en base de datos
-    if (dataManager->insertReading(reading)) {
-        std::cout << "ClimateControlService: Lectura guardada exitosamente" << std::endl;
+    const bool stored = dataManager->insertReading(reading);
+    if (stored) {
+        LOG_DEBUG("ClimateControlService", "Lectura guardada exitosamente", "sensor", reading.getSensorId());
     } else {
-        std::cout << "ClimateControlService: Error al guardar la lectura" << std::endl;
+        LOG_ERROR("ClimateControlService", "Error al guardar la lectura", "sensor", reading.getSensorId());
     }
     
+    readingStats.add(reading);
+    
     // Verificar alertas
-    std::vector<Alert> alerts = checkAlerts(temperature, humidity);
+    std::vector<Alert> alerts = checkAlerts(reading);
     processAlerts(alerts);
+    return stored;
+}
+
+bool ClimateControlService::enableIngestPipeline(size_t capacity, size_t batchSize) {
+    if (ingestPipeline) {
+        return false;
+    }
     
-    return reading;
+    ingestPipeline.reset(new IngestPipeline(
+        [this](const std::vector<ClimateReading>& batch) {
+            return dataManager->insertReadings(batch);
+        },
+        [this](const std::vector<ClimateReading>& batch) {
+            readingStats.addBatch(batch);
+            for (const auto& reading : batch) {
+                processAlerts(checkAlerts(reading));
+            }
+        },
+        capacity, batchSize));
+    ingestPipeline->start();
+    return true;
+}
+
+void ClimateControlService::disableIngestPipeline() {
+    if (ingestPipeline) {
+        ingestPipeline->stop();
+        ingestPipeline.reset();
+    }
+}
+
+IngestPipeline* ClimateControlService::getIngestPipeline() {
+    return ingestPipeline.get();
+}
+
+void ClimateControlService::drainIngest() {
+    // Las consultas de historial ven las lecturas ya ingresadas
+    if (ingestPipeline) {
+        ingestPipeline->drain();
+    }
+}
+
+bool ClimateControlService::enableAutomaticControl(float temperatureSetpoint, float humiditySetpoint,
+                                                   const ControlLoopConfig& config) {
+    if (zoneController) {
+        return false;
+    }
+    
+    ZoneConfig zone;
+    zone.forecast = msForecast;
+    zone.temperatureSetpoint = temperatureSetpoint;
+    zone.humiditySetpoint = humiditySetpoint;
+    zoneController.reset(new ZoneController(config));
+    zoneController->addZone(zone);
+    zoneController->start();
+    return true;
+}
+
+void ClimateControlService::disableAutomaticControl() {
+    if (zoneController) {
+        zoneController->stop();
+        zoneController.reset();
+    }
+}
+
+ZoneController* ClimateControlService::getZoneController() {
+    return zoneController.get();
 }
 
 bool ClimateControlService::controlTemperature(const std::string& action, int amount) {
-    std::cout << "ClimateControlService: Controlando temperatura - " << action << " " << amount << "°C" << std::endl;
+    LOG_INFO("ClimateControlService", "Controlando temperatura", "action", action, "amount", amount);
     
-    bool success = false;
+    if (zoneController) {
+        LOG_WARN("ClimateControlService", "Control manual rechazado: el control automático está activo");
+        return false;
+    }
+    
+    int delta;
     if (action == "up") {
-        success = msForecast->upTemp(amount);
+        delta = amount;
     } else if (action == "down") {
-        success = msForecast->downTemp(amount);
+        delta = -amount;
     } else {
-        std::cout << "ClimateControlService: Acción de temperatura inválida: " << action << std::endl;
+        LOG_WARN("ClimateControlService", "Acción de temperatura inválida", "action", action);
         return false;
     }
     
+    // La lectura posterior al control se toma una vez por lote agrupado
+    const bool success = commandCoalescer.submit(msForecast, AlertMetric::TEMPERATURE, delta);
     if (success) {
-        // Tomar nueva lectura después del control
-        takeReading();
-        std::cout << "ClimateControlService: Control de temperatura exitoso" << std::endl;
+        LOG_INFO("ClimateControlService", "Control de temperatura exitoso");
     } else {
-        std::cout << "ClimateControlService: Error en el control de temperatura" << std::endl;
+        LOG_ERROR("ClimateControlService", "Error en el control de temperatura", "action", action);
     }
     
     return success;
 }
 
 bool ClimateControlService::controlHumidity(const std::string& action, int amount) {
-    std::cout << "ClimateControlService: Controlando humedad - " << action << " " << amount << "%" << std::endl;
+    LOG_INFO("ClimateControlService", "Controlando humedad", "action", action, "amount", amount);
+    
+    if (zoneController) {
+        LOG_WARN("ClimateControlService", "Control manual rechazado: el control automático está activo");
+        return false;
+    }
     
-    bool success = false;
+    int delta;
     if (action == "up") {
-        success = msForecast->upHumidity(amount);
+        delta = amount;
     } else if (action == "down") {
-        success = msForecast->downHumidity(amount);
+        delta = -amount;
     } else {
-        std::cout << "ClimateControlService: Acción de humedad inválida: " << action << std::endl;
+        LOG_WARN("ClimateControlService", "Acción de humedad inválida", "action", action);
         return false;
     }
     
+    // La lectura posterior al control se toma una vez por lote agrupado
+    const bool success = commandCoalescer.submit(msForecast, AlertMetric::HUMIDITY, delta);
     if (success) {
-        // Tomar nueva lectura después del control
-        takeReading();
-        std::cout << "ClimateControlService: Control de humedad exitoso" << std::endl;
+        LOG_INFO("ClimateControlService", "Control de humedad exitoso");
     } else {
-        std::cout << "ClimateControlService: Error en el control de humedad" << std::endl;
+        LOG_ERROR("ClimateControlService", "Error en el control de humedad", "action", action);
     }
     
     return success;
 }
 
+void ClimateControlService::setCommandCoalesceWindow(std::chrono::milliseconds window) {
+    commandCoalescer.setWindow(window);
+    LOG_INFO("ClimateControlService", "Ventana de agrupamiento de comandos actualizada",
+             "window_ms", static_cast<long long>(window.count()));
+}
+
+CoalescerStats ClimateControlService::getCommandStats() {
+    return commandCoalescer.getStats();
+}
+
+bool ClimateControlService::fetchSnapshot(int sensorId, ClimateSnapshot& snapshot) const {
+    if (sensorId == 0) {
+        snapshot = msForecast->readSnapshot();
+        return isValidSnapshot(snapshot);
+    }
+    std::vector<ClimateSnapshot> snapshots;
+    if (!msForecast->readSnapshots(std::vector<int>(1, sensorId), snapshots) || snapshots.size() != 1) {
+        return false;
+    }
+    snapshot = snapshots[0];
+    return isValidSnapshot(snapshot);
+}
+
+ClimateSnapshot ClimateControlService::getCurrentSnapshot(int sensorId) const {
+    ClimateSnapshot snapshot;
+    if (!snapshotCache.get(sensorId, snapshot)) {
+        LOG_WARN("ClimateControlService", "No se pudo obtener la medición actual", "sensor", sensorId);
+        snapshot.sensorId = sensorId;
+        snapshot.temperature = std::numeric_limits<float>::quiet_NaN();
+        snapshot.humidity = std::numeric_limits<float>::quiet_NaN();
+        snapshot.timestamp = time(nullptr);
+    }
+    return snapshot;
+}
+
 float ClimateControlService::getCurrentTemperature() const {
-    return msForecast->readTemp();
+    return getCurrentSnapshot().temperature;
 }
 
 float ClimateControlService::getCurrentHumidity() const {
-    return msForecast->readHumidity();
+    return getCurrentSnapshot().humidity;
+}
+
+void ClimateControlService::setSnapshotCacheTtl(std::chrono::milliseconds ttl) {
+    snapshotCache.setTtl(ttl);
+    LOG_INFO("ClimateControlService", "Vigencia de la caché de mediciones actualizada",
+             "ttl_ms", static_cast<long long>(ttl.count()));
+}
+
+SnapshotCacheStats ClimateControlService::getSnapshotCacheStats() const {
+    return snapshotCache.getStats();
 }
 
 std::vector<ClimateReading> ClimateControlService::getAllReadings() {
+    drainIngest();
     return dataManager->getAllReadings();
 }
 
 std::vector<Alert> ClimateControlService::getAllAlerts() {
+    drainIngest();
     return dataManager->getAllAlerts();
 }
 
+size_t ClimateControlService::forEachReading(const ReadingVisitor& visitor, const ReadingFilter& filter) {
+    drainIngest();
+    return dataManager->forEachReading(visitor, filter);
+}
+
+size_t ClimateControlService::forEachAlert(const AlertVisitor& visitor, const AlertFilter& filter) {
+    drainIngest();
+    return dataManager->forEachAlert(visitor, filter);
+}
+
+std::vector<RollupBucket> ClimateControlService::getReadingSummary(time_t startTime, time_t endTime,
+                                                                   size_t maxBuckets, RollupTier& tier) {
+    drainIngest();
+    return dataManager->getRollupsForRange(startTime, endTime, maxBuckets, tier);
+}
+
 void ClimateControlService::setAlertThresholds(float tempHigh, float tempLow, 
                                               float humidityHigh, float humidityLow) {
-    tempHighThreshold = tempHigh;
-    tempLowThreshold = tempLow;
-    humidityHighThreshold = humidityHigh;
-    humidityLowThreshold = humidityLow;
+    {
+        std::lock_guard<std::mutex> lock(thresholdsMutex);
+        alertThresholds.tempHigh = tempHigh;
+        alertThresholds.tempLow = tempLow;
+        alertThresholds.humidityHigh = humidityHigh;
+        alertThresholds.humidityLow = humidityLow;
+    }
     
-    std::cout << "ClimateControlService: Umbrales actualizados" << std::endl;
-    std::cout << "  Temperatura: " << tempLow << "°C - " << tempHigh << "°C" << std::endl;
-    std::cout << "  Humedad: " << humidityLow << "% - " << humidityHigh << "%" << std::endl;
+    LOG_INFO("ClimateControlService", "Umbrales actualizados", "temp_low", tempLow, "temp_high", tempHigh,
+             "humidity_low", humidityLow, "humidity_high", humidityHigh);
 }
 
 void ClimateControlService::getAlertThresholds(float& tempHigh, float& tempLow, 
                                               float& humidityHigh, float& humidityLow) const {
-    tempHigh = tempHighThreshold;
-    tempLow = tempLowThreshold;
-    humidityHigh = humidityHighThreshold;
-    humidityLow = humidityLowThreshold;
+    const AlertThresholds thresholds = getAlertThresholds();
+    tempHigh = thresholds.tempHigh;
+    tempLow = thresholds.tempLow;
+    humidityHigh = thresholds.humidityHigh;
+    humidityLow = thresholds.humidityLow;
+}
+
+AlertThresholds ClimateControlService::getAlertThresholds() const {
+    // Las bandas críticas son fijas; solo los umbrales principales son configurables
+    std::lock_guard<std::mutex> lock(thresholdsMutex);
+    return alertThresholds;
+}
+
+ReplayResult ClimateControlService::replayThresholds(const AlertThresholds& candidate,
+                                                     time_t startTime, time_t endTime) {
+    drainIngest();
+    
+    ReplayRequest request;
+    request.thresholds = candidate;
+    request.policy = alertTracker.getPolicy();
+    request.warmupSeconds = request.policy.renotifyIntervalSec;
+    request.startTime = startTime;
+    request.endTime = endTime;
+    
+    ThresholdReplayEngine engine(dataManager);
+    return engine.replay(request);
+}
+
+void ClimateControlService::setAlertPolicy(const AlertPolicy& policy) {
+    alertTracker.setPolicy(policy);
+    LOG_INFO("ClimateControlService", "Política de alertas actualizada",
+             "temp_hysteresis", policy.temperatureHysteresis, "humidity_hysteresis", policy.humidityHysteresis,
+             "renotify_s", policy.renotifyIntervalSec, "per_minute", policy.notificationsPerMinute);
+}
+
+AlertPolicy ClimateControlService::getAlertPolicy() const {
+    return alertTracker.getPolicy();
+}
+
+void ClimateControlService::setForecastPolicy(const ForecastPolicy& policy) {
+    forecaster.setPolicy(policy);
+    LOG_INFO("ClimateControlService", "Pronóstico de umbrales actualizado",
+             "horizon_s", policy.horizonSec, "level_tau_s", policy.levelTimeConstantSec,
+             "trend_tau_s", policy.trendTimeConstantSec);
+}
+
+ForecastPolicy ClimateControlService::getForecastPolicy() const {
+    return forecaster.getPolicy();
+}
+
+bool ClimateControlService::forecastMetric(int sensorId, AlertMetric metric, int aheadSec, float& value) const {
+    return forecaster.forecast(sensorId, metric, aheadSec, value);
+}
+
+AlertTrackerStats ClimateControlService::getAlertStats() const {
+    return alertTracker.getStats();
+}
+
+const ReadingStatistics& ClimateControlService::getReadingStatistics() const {
+    return readingStats;
 }
 
 bool ClimateControlService::isSystemHealthy() const {
     return msForecast != nullptr && dataManager != nullptr && emailService != nullptr;
 }
 
-std::vector<Alert> ClimateControlService::checkAlerts(float temperature, float humidity) {
+void ClimateControlService::trackMetric(std::vector<Alert>& alerts, const ClimateReading& reading,
+                                        AlertMetric metric, float value, int direction,
+                                        AlertSeverity severity, bool cleared) {
+    AlertTransition transition = alertTracker.evaluate(reading.getSensorId(), metric, direction,
+                                                       severity, cleared, reading.getTimestamp());
+    if (transition == AlertTransition::NONE) {
+        return;
+    }
+    
+    const bool isTemperature = (metric == AlertMetric::TEMPERATURE);
+    AlertCode code;
+    if (transition == AlertTransition::CLEAR) {
+        code = isTemperature ? AlertCode::TEMPERATURE_NORMAL : AlertCode::HUMIDITY_NORMAL;
+        severity = AlertSeverity::LOW;
+    } else if (isTemperature) {
+        code = direction > 0 ? AlertCode::TEMPERATURE_HIGH : AlertCode::TEMPERATURE_LOW;
+    } else {
+        code = direction > 0 ? AlertCode::HUMIDITY_HIGH : AlertCode::HUMIDITY_LOW;
+    }
+    
+    AlertNote note = AlertNote::NONE;
+    if (transition == AlertTransition::ESCALATE) {
+        note = AlertNote::ESCALATED;
+    } else if (transition == AlertTransition::RENOTIFY) {
+        note = AlertNote::PERSISTENT;
+    }
+    
+    alerts.push_back(Alert(code, value, reading.getSensorId(), severity, reading.getTimestamp(), note));
+}
+
+void ClimateControlService::trackForecast(std::vector<Alert>& alerts, const ClimateReading& reading,
+                                          AlertMetric metric, const ThresholdCrossing* crossings, size_t count) {
+    const bool isTemperature = (metric == AlertMetric::TEMPERATURE);
+    const AlertMetric trackedMetric = isTemperature ? AlertMetric::TEMPERATURE_FORECAST
+                                                    : AlertMetric::HUMIDITY_FORECAST;
+    const ThresholdCrossing* crossing = nullptr;
+    for (size_t i = 0; i < count; ++i) {
+        if (crossings[i].metric == metric) {
+            crossing = &crossings[i];
+        }
+    }
+    if (!crossing || alertTracker.isActive(reading.getSensorId(), metric)) {
+        // El cruce dejó de estar vigente o la alerta del umbral ya tomó el
+        // relevo (también dentro de su banda de histéresis): no hay nada que avisar
+        alertTracker.dismiss(reading.getSensorId(), trackedMetric);
+        return;
+    }
+    
+    // Los pronósticos pasan por el token bucket y los recordatorios como las demás alertas
+    AlertTransition transition = alertTracker.evaluate(reading.getSensorId(), trackedMetric, crossing->direction,
+                                                       AlertSeverity::MEDIUM, false, reading.getTimestamp());
+    if (transition == AlertTransition::NONE) {
+        return;
+    }
+    
+    AlertCode code;
+    if (isTemperature) {
+        code = crossing->direction > 0 ? AlertCode::TEMPERATURE_HIGH_PREDICTED
+                                       : AlertCode::TEMPERATURE_LOW_PREDICTED;
+    } else {
+        code = crossing->direction > 0 ? AlertCode::HUMIDITY_HIGH_PREDICTED
+                                       : AlertCode::HUMIDITY_LOW_PREDICTED;
+    }
+    AlertNote note = AlertNote::NONE;
+    if (transition == AlertTransition::ESCALATE) {
+        note = AlertNote::ESCALATED;
+    } else if (transition == AlertTransition::RENOTIFY) {
+        note = AlertNote::PERSISTENT;
+    }
+    
+    alerts.push_back(Alert(code, crossing->minutes, reading.getSensorId(), AlertSeverity::MEDIUM,
+                           reading.getTimestamp(), note));
+}
+
+std::vector<Alert> ClimateControlService::checkAlerts(const ClimateReading& reading) {
     std::vector<Alert> alerts;
+    const AlertPolicy policy = alertTracker.getPolicy();
+    
+    // Clasificar ambas métricas con la misma lógica que los kernels por lote
+    float temperature = reading.getTemperature();
+    float humidity = reading.getHumidity();
+    // Una sola copia de los umbrales para clasificar, la histéresis y el pronóstico
+    const AlertThresholds thresholds = getAlertThresholds();
+    uint8_t code = AlertKernels::classify(temperature, humidity, thresholds);
     
     // Verificar temperatura
-    if (temperature > tempHighThreshold) {
-        AlertSeverity severity = (temperature > 35.0) ? AlertSeverity::CRITICAL : AlertSeverity::HIGH;
-        std::ostringstream msg;
-        msg << "Temperatura crítica: " << temperature << "°C";
-        alerts.push_back(Alert(msg.str(), severity));
-    } else if (temperature < tempLowThreshold) {
-        AlertSeverity severity = (temperature < 10.0) ? AlertSeverity::CRITICAL : AlertSeverity::HIGH;
-        std::ostringstream msg;
-        msg << "Temperatura muy baja: " << temperature << "°C";
-        alerts.push_back(Alert(msg.str(), severity));
-    }
+    int direction = AlertKernels::temperatureDirection(code);
+    AlertSeverity severity = direction != 0 ? AlertKernels::temperatureSeverity(code) : AlertSeverity::LOW;
+    bool cleared = temperature <= thresholds.tempHigh - policy.temperatureHysteresis &&
+                   temperature >= thresholds.tempLow + policy.temperatureHysteresis;
+    trackMetric(alerts, reading, AlertMetric::TEMPERATURE, temperature, direction, severity, cleared);
     
     // Verificar humedad
-    if (humidity > humidityHighThreshold) {
-        AlertSeverity severity = (humidity > 90.0) ? AlertSeverity::HIGH : AlertSeverity::MEDIUM;
-        std::ostringstream msg;
-        msg << "Humedad muy alta: " << humidity << "%";
-        alerts.push_back(Alert(msg.str(), severity));
-    } else if (humidity < humidityLowThreshold) {
-        AlertSeverity severity = (humidity < 10.0) ? AlertSeverity::HIGH : AlertSeverity::MEDIUM;
-        std::ostringstream msg;
-        msg << "Humedad muy baja: " << humidity << "%";
-        alerts.push_back(Alert(msg.str(), severity));
-    }
+    direction = AlertKernels::humidityDirection(code);
+    severity = direction != 0 ? AlertKernels::humiditySeverity(code) : AlertSeverity::LOW;
+    cleared = humidity <= thresholds.humidityHigh - policy.humidityHysteresis &&
+              humidity >= thresholds.humidityLow + policy.humidityHysteresis;
+    trackMetric(alerts, reading, AlertMetric::HUMIDITY, humidity, direction, severity, cleared);
+    
+    // Avisar antes del cruce si la tendencia lo alcanza dentro del horizonte
+    ThresholdCrossing crossings[TrendForecaster::MAX_CROSSINGS];
+    size_t predicted = forecaster.update(reading, thresholds, crossings);
+    trackForecast(alerts, reading, AlertMetric::TEMPERATURE, crossings, predicted);
+    trackForecast(alerts, reading, AlertMetric::HUMIDITY, crossings, predicted);
     
     return alerts;
 }
 
 void ClimateControlService::processAlerts(const std::vector<Alert>& alerts) {
     for (const auto& alert : alerts) {
-        std::cout << "ClimateControlService: Procesando alerta - " << alert.toString() << std::endl;
+        LOG_WARN("ClimateControlService", "Procesando alerta", "severity", alert.getSeverityString(),
+                 "message", alert.getMessage());
         
         // Guardar alerta en base de datos
         dataManager->insertAlert(alert);
         
-        // Enviar alerta por email
-        emailService->sendAlert(alert);
+        // Encolar alerta para envío por email (inmediato si no hay modo asíncrono)
+        emailService->enqueueAlert(alert);
     }
 } 
\ No newline at end of file
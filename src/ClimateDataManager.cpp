@@ -1,19 +1,90 @@
 #include "../include/ClimateDataManager.h"
-#include <iostream>
-#include <fstream>
-
-// Simulación de SQLite para este ejemplo
-// En un proyecto real, incluirías #include <sqlite3.h>
-
-ClimateDataManager::ClimateDataManager(const std::string& databasePath) 
-    : db(nullptr), dbPath(databasePath) {
-    std::cout << "ClimateDataManager: Inicializando conexión a " << dbPath << std::endl;
-    
-    // Simular conexión a base de datos
-    if (createTables()) {
-        std::cout << "ClimateDataManager: Base de datos inicializada correctamente" << std::endl;
+#include "../include/ColumnarReadingStore.h"
+#include "../include/Logger.h"
+#include "../include/MetricsRegistry.h"
+#include "../include/AlertTemplates.h"
+#include <sqlite3.h>
+#include <algorithm>
+#include <limits>
+#include <sys/stat.h>
+
+namespace {
+
+/**
+ * @brief Obtiene el histograma de latencia de una operación de almacenamiento
+ * @param op Nombre de la operación
+ * @param engine Motor de las lecturas
+ * @return Histograma del registro de métricas del proceso
+ */
+LatencyHistogram& storageLatency(const char* op, StorageEngine engine) {
+    return MetricsRegistry::instance().histogram(
+        "clima_storage_operation_duration_seconds", "Duración de las operaciones de ClimateDataManager",
+        std::string("op=\"") + op + "\",engine=\"" +
+        (engine == StorageEngine::COLUMNAR ? "columnar" : "sqlite") + "\"");
+}
+
+/**
+ * @brief Crea el directorio que contiene la base de datos si no existe
+ * @param path Ruta al archivo de base de datos
+ */
+void ensureParentDirectory(const std::string& path) {
+    std::string::size_type pos = path.find_last_of('/');
+    if (pos == std::string::npos || pos == 0) {
+        return;
+    }
+    mkdir(path.substr(0, pos).c_str(), 0755);
+}
+
+/**
+ * @brief Libera una sentencia preparada y deja el puntero en nulo
+ * @param stmt Sentencia a liberar
+ */
+void finalizeStatement(sqlite3_stmt*& stmt) {
+    if (stmt) {
+        sqlite3_finalize(stmt);
+        stmt = nullptr;
+    }
+}
+
+} // namespace
+
+const int ClimateDataManager::STREAM_PAGE_SIZE;
+
+ReadingFilter::ReadingFilter()
+    : startTime(std::numeric_limits<time_t>::min()), endTime(std::numeric_limits<time_t>::max()) {}
+
+ReadingFilter::ReadingFilter(time_t start, time_t end) : startTime(start), endTime(end) {}
+
+AlertFilter::AlertFilter()
+    : startTime(std::numeric_limits<time_t>::min()), endTime(std::numeric_limits<time_t>::max()),
+      minSeverity(AlertSeverity::LOW) {}
+
+AlertFilter::AlertFilter(AlertSeverity minSev, time_t start, time_t end)
+    : startTime(start), endTime(end), minSeverity(minSev) {}
+
+ClimateDataManager::ClimateDataManager(const std::string& databasePath, StorageEngine engine)
+    : db(nullptr), readDb(nullptr), dbPath(databasePath), inTransaction(false),
+      storageEngine(engine),
+      insertReadingStmt(nullptr), insertAlertStmt(nullptr),
+      selectAllReadingsStmt(nullptr), selectReadingsRangeStmt(nullptr),
+      selectAllAlertsStmt(nullptr), selectAlertsSeverityStmt(nullptr),
+      upsertRollupStmt(nullptr), readingsPageStmt(nullptr), alertsPageStmt(nullptr),
+      readingsAscPageStmt(nullptr),
+      insertReadingLatency(storageLatency("insertReading", engine)),
+      insertReadingsLatency(storageLatency("insertReadings", engine)),
+      insertAlertLatency(storageLatency("insertAlert", engine)),
+      rangeQueryLatency(storageLatency("getReadingsByDateRange", engine)) {
+    LOG_INFO("ClimateDataManager", "Inicializando conexión", "path", dbPath);
+
+    if (openConnections() && createTables() && prepareStatements()) {
+        if (storageEngine == StorageEngine::COLUMNAR) {
+            columnStore.reset(new ColumnarReadingStore(dbPath + ".columns"));
+        }
+        loadRollups();
+        LOG_INFO("ClimateDataManager", "Base de datos inicializada correctamente");
     } else {
-        std::cout << "ClimateDataManager: Error al inicializar la base de datos" << std::endl;
+        LOG_ERROR("ClimateDataManager", "Error al inicializar la base de datos", "path", dbPath);
+        closeConnection();
     }
 }
 
@@ -21,105 +92,853 @@ ClimateDataManager::~ClimateDataManager() {
     closeConnection();
 }
 
+bool ClimateDataManager::openConnections() {
+    ensureParentDirectory(dbPath);
+
+    // Las conexiones se protegen con mutex propios, por eso se abren sin mutex interno
+    int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX;
+    if (sqlite3_open_v2(dbPath.c_str(), &db, flags, nullptr) != SQLITE_OK) {
+        LOG_ERROR("ClimateDataManager", "No se pudo abrir la base de datos", "path", dbPath,
+                  "error", sqlite3_errmsg(db));
+        return false;
+    }
+    sqlite3_busy_timeout(db, 5000);
+
+    // WAL permite lectores concurrentes con un escritor; NORMAL evita un fsync por commit
+    if (!executeQuery("PRAGMA journal_mode=WAL") ||
+        !executeQuery("PRAGMA synchronous=NORMAL")) {
+        return false;
+    }
+
+    flags = SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX;
+    if (sqlite3_open_v2(dbPath.c_str(), &readDb, flags, nullptr) != SQLITE_OK) {
+        LOG_ERROR("ClimateDataManager", "No se pudo abrir la conexión de lectura",
+                  "error", sqlite3_errmsg(readDb));
+        return false;
+    }
+    sqlite3_busy_timeout(readDb, 5000);
+
+    return true;
+}
+
 bool ClimateDataManager::createTables() {
-    // Simular creación de tablas
-    std::cout << "ClimateDataManager: Creando tablas..." << std::endl;
-    
-    // En un proyecto real, aquí ejecutarías las consultas SQL
-    // CREATE TABLE IF NOT EXISTS climate_readings (...)
-    // CREATE TABLE IF NOT EXISTS alerts (...)
-    
+    LOG_DEBUG("ClimateDataManager", "Creando tablas");
+
+    return executeQuery(
+               "CREATE TABLE IF NOT EXISTS climate_readings ("
+               "id INTEGER PRIMARY KEY, "
+               "temperature REAL NOT NULL, "
+               "humidity REAL NOT NULL, "
+               "timestamp INTEGER NOT NULL, "
+               "sensor_id INTEGER NOT NULL DEFAULT 0)") &&
+           addColumnIfMissing("climate_readings", "sensor_id", "INTEGER NOT NULL DEFAULT 0") &&
+           executeQuery(
+               "CREATE INDEX IF NOT EXISTS idx_climate_readings_timestamp "
+               "ON climate_readings(timestamp)") &&
+           executeQuery(
+               "CREATE TABLE IF NOT EXISTS alerts ("
+               "id INTEGER PRIMARY KEY, "
+               "message TEXT NOT NULL, "
+               "severity INTEGER NOT NULL, "
+               "timestamp INTEGER NOT NULL, "
+               "code INTEGER NOT NULL DEFAULT 0, "
+               "note INTEGER NOT NULL DEFAULT 0, "
+               "sensor_id INTEGER NOT NULL DEFAULT 0, "
+               "value REAL NOT NULL DEFAULT 0)") &&
+           addColumnIfMissing("alerts", "code", "INTEGER NOT NULL DEFAULT 0") &&
+           addColumnIfMissing("alerts", "note", "INTEGER NOT NULL DEFAULT 0") &&
+           addColumnIfMissing("alerts", "sensor_id", "INTEGER NOT NULL DEFAULT 0") &&
+           addColumnIfMissing("alerts", "value", "REAL NOT NULL DEFAULT 0") &&
+           executeQuery(
+               "CREATE INDEX IF NOT EXISTS idx_alerts_timestamp "
+               "ON alerts(timestamp)") &&
+           executeQuery(
+               "CREATE TABLE IF NOT EXISTS reading_rollups ("
+               "tier INTEGER NOT NULL, "
+               "bucket_start INTEGER NOT NULL, "
+               "count INTEGER NOT NULL, "
+               "temp_min REAL, temp_max REAL, temp_sum REAL, "
+               "hum_min REAL, hum_max REAL, hum_sum REAL, "
+               "PRIMARY KEY (tier, bucket_start)) WITHOUT ROWID");
+}
+
+bool ClimateDataManager::addColumnIfMissing(const std::string& table, const std::string& column,
+                                            const std::string& definition) {
+    sqlite3_stmt* stmt = nullptr;
+    std::string pragma = "PRAGMA table_info(" + table + ")";
+    if (sqlite3_prepare_v2(db, pragma.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        return false;
+    }
+
+    bool found = false;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        const unsigned char* name = sqlite3_column_text(stmt, 1);
+        if (name && column == reinterpret_cast<const char*>(name)) {
+            found = true;
+        }
+    }
+    sqlite3_finalize(stmt);
+
+    return found || executeQuery("ALTER TABLE " + table + " ADD COLUMN " + column + " " + definition);
+}
+
+bool ClimateDataManager::prepareStatements() {
+    struct StatementSpec {
+        sqlite3* conn;
+        const char* sql;
+        sqlite3_stmt** stmt;
+    };
+
+    const StatementSpec specs[] = {
+        { db, "INSERT INTO climate_readings (temperature, humidity, timestamp, sensor_id) VALUES (?, ?, ?, ?)",
+          &insertReadingStmt },
+        { db, "INSERT INTO alerts (message, severity, timestamp, code, note, sensor_id, value) "
+              "VALUES (?, ?, ?, ?, ?, ?, ?)",
+          &insertAlertStmt },
+        { db, "INSERT OR REPLACE INTO reading_rollups (tier, bucket_start, count, temp_min, temp_max, "
+              "temp_sum, hum_min, hum_max, hum_sum) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)",
+          &upsertRollupStmt },
+        { readDb, "SELECT id, temperature, humidity, timestamp, sensor_id FROM climate_readings "
+                  "ORDER BY timestamp DESC",
+          &selectAllReadingsStmt },
+        { readDb, "SELECT id, temperature, humidity, timestamp, sensor_id FROM climate_readings "
+                  "WHERE timestamp BETWEEN ? AND ? ORDER BY timestamp DESC",
+          &selectReadingsRangeStmt },
+        { readDb, "SELECT id, message, severity, timestamp, code, note, sensor_id, value FROM alerts "
+                  "ORDER BY timestamp DESC",
+          &selectAllAlertsStmt },
+        { readDb, "SELECT id, message, severity, timestamp, code, note, sensor_id, value FROM alerts "
+                  "WHERE severity = ? ORDER BY timestamp DESC",
+          &selectAlertsSeverityStmt },
+        // Paginación por clave (timestamp, id): cada página retoma donde terminó la anterior
+        { readDb, "SELECT id, temperature, humidity, timestamp, sensor_id FROM climate_readings "
+                  "WHERE timestamp BETWEEN ?1 AND ?2 AND (timestamp, id) < (?3, ?4) "
+                  "ORDER BY timestamp DESC, id DESC LIMIT ?5",
+          &readingsPageStmt },
+        { readDb, "SELECT id, message, severity, timestamp, code, note, sensor_id, value FROM alerts "
+                  "WHERE timestamp BETWEEN ?1 AND ?2 AND severity >= ?3 AND (timestamp, id) < (?4, ?5) "
+                  "ORDER BY timestamp DESC, id DESC LIMIT ?6",
+          &alertsPageStmt },
+        { readDb, "SELECT id, temperature, humidity, timestamp, sensor_id FROM climate_readings "
+                  "WHERE timestamp BETWEEN ?1 AND ?2 AND (timestamp, id) > (?3, ?4) "
+                  "ORDER BY timestamp ASC, id ASC LIMIT ?5",
+          &readingsAscPageStmt }
+    };
+
+    for (const auto& spec : specs) {
+        if (sqlite3_prepare_v2(spec.conn, spec.sql, -1, spec.stmt, nullptr) != SQLITE_OK) {
+            LOG_ERROR("ClimateDataManager", "Error al preparar consulta", "error", sqlite3_errmsg(spec.conn));
+            return false;
+        }
+    }
+
     return true;
 }
 
 bool ClimateDataManager::executeQuery(const std::string& sql) {
-    // Simular ejecución de consulta
-    std::cout << "ClimateDataManager: Ejecutando consulta: " << sql << std::endl;
+    if (!db) {
+        return false;
+    }
+
+    char* errorMessage = nullptr;
+    if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &errorMessage) != SQLITE_OK) {
+        LOG_ERROR("ClimateDataManager", "Error al ejecutar consulta", "sql", sql,
+                  "error", errorMessage ? errorMessage : "desconocido");
+        sqlite3_free(errorMessage);
+        return false;
+    }
     return true;
 }
 
+bool ClimateDataManager::insertReadingLocked(const ClimateReading& reading) {
+    sqlite3_bind_double(insertReadingStmt, 1, reading.getTemperature());
+    sqlite3_bind_double(insertReadingStmt, 2, reading.getHumidity());
+    sqlite3_bind_int64(insertReadingStmt, 3, static_cast<sqlite3_int64>(reading.getTimestamp()));
+    sqlite3_bind_int(insertReadingStmt, 4, reading.getSensorId());
+
+    bool ok = sqlite3_step(insertReadingStmt) == SQLITE_DONE;
+    sqlite3_reset(insertReadingStmt);
+    return ok;
+}
+
 bool ClimateDataManager::insertReading(const ClimateReading& reading) {
-    std::cout << "ClimateDataManager: Insertando lectura - " << reading.toString() << std::endl;
-    
-    // Simular inserción en base de datos
-    // En un proyecto real, aquí ejecutarías INSERT INTO climate_readings (...)
-    
+    ScopedLatency timer(insertReadingLatency);
+    LOG_DEBUG("ClimateDataManager", "Insertando lectura", "sensor", reading.getSensorId(),
+              "temperature", reading.getTemperature(), "humidity", reading.getHumidity(),
+              "timestamp", reading.getTimestamp());
+
+    bool ok = false;
+    bool deferred = false;
+    if (columnStore) {
+        ok = columnStore->append(reading);
+    } else {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (!insertReadingStmt) {
+            return false;
+        }
+
+        ok = insertReadingLocked(reading);
+        if (!ok) {
+            LOG_ERROR("ClimateDataManager", "Error al insertar lectura", "error", sqlite3_errmsg(db));
+        } else if (inTransaction) {
+            pendingRollupReadings.push_back(reading);
+            deferred = true;
+        }
+    }
+
+    if (ok && !deferred) {
+        recordRollups(&reading, 1);
+    }
+    return ok;
+}
+
+bool ClimateDataManager::insertReadings(const std::vector<ClimateReading>& readings) {
+    ScopedLatency timer(insertReadingsLatency);
+    if (columnStore) {
+        if (!columnStore->appendBatch(readings)) {
+            return false;
+        }
+        recordRollups(readings.data(), readings.size());
+        return true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (!insertReadingStmt) {
+            return false;
+        }
+
+        // Si ya hay una transacción explícita el lote se suma a ella
+        bool ownTransaction = !inTransaction;
+        if (ownTransaction && !executeQuery("BEGIN IMMEDIATE")) {
+            return false;
+        }
+
+        for (const auto& reading : readings) {
+            if (!insertReadingLocked(reading)) {
+                LOG_ERROR("ClimateDataManager", "Error al insertar lote de lecturas",
+                          "batch", readings.size(), "error", sqlite3_errmsg(db));
+                if (ownTransaction) {
+                    executeQuery("ROLLBACK");
+                }
+                return false;
+            }
+        }
+
+        if (!ownTransaction) {
+            // Los agregados esperan a que se confirme la transacción explícita
+            pendingRollupReadings.insert(pendingRollupReadings.end(), readings.begin(), readings.end());
+            return true;
+        }
+        if (!commitLocked()) {
+            return false;
+        }
+    }
+
+    recordRollups(readings.data(), readings.size());
     return true;
 }
 
-bool ClimateDataManager::insertAlert(const Alert& alert) {
-    std::cout << "ClimateDataManager: Insertando alerta - " << alert.toString() << std::endl;
-    
-    // Simular inserción en base de datos
-    // En un proyecto real, aquí ejecutarías INSERT INTO alerts (...)
-    
+void ClimateDataManager::recordRollups(const ClimateReading* readings, size_t count) {
+    std::lock_guard<std::mutex> lock(rollupMutex);
+
+    for (size_t i = 0; i < count; ++i) {
+        rollups.add(readings[i].getTimestamp(), readings[i].getTemperature(), readings[i].getHumidity());
+    }
+
+    // Se persiste una vez por minuto cerrado según el watermark: una caída pierde
+    // como mucho los minutos abiertos, que loadRollups() detecta y reconstruye
+    if (rollups.hasClosedMinute()) {
+        persistRollupsLocked();
+    }
+}
+
+void ClimateDataManager::persistRollupsLocked() {
+    const bool evicted = rollups.evictExpiredMinutes() > 0;
+    std::vector<std::pair<RollupTier, RollupBucket>> dirty = rollups.takeDirtyBuckets();
+    if (dirty.empty() && !evicted) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(writeMutex);
+    if (!upsertRollupStmt) {
+        return;
+    }
+
+    if (evicted) {
+        executeQuery("DELETE FROM reading_rollups WHERE tier = " +
+                     std::to_string(static_cast<int>(RollupTier::MINUTE)) + " AND bucket_start < " +
+                     std::to_string(static_cast<long long>(rollups.getMinuteCutoff())));
+    }
+
+    bool ownTransaction = !inTransaction && dirty.size() > 1;
+    if (ownTransaction && !executeQuery("BEGIN IMMEDIATE")) {
+        return;
+    }
+
+    for (const auto& entry : dirty) {
+        const RollupBucket& bucket = entry.second;
+        sqlite3_bind_int(upsertRollupStmt, 1, static_cast<int>(entry.first));
+        sqlite3_bind_int64(upsertRollupStmt, 2, static_cast<sqlite3_int64>(bucket.start));
+        sqlite3_bind_int64(upsertRollupStmt, 3, static_cast<sqlite3_int64>(bucket.count));
+        sqlite3_bind_double(upsertRollupStmt, 4, bucket.minTemperature);
+        sqlite3_bind_double(upsertRollupStmt, 5, bucket.maxTemperature);
+        sqlite3_bind_double(upsertRollupStmt, 6, bucket.sumTemperature);
+        sqlite3_bind_double(upsertRollupStmt, 7, bucket.minHumidity);
+        sqlite3_bind_double(upsertRollupStmt, 8, bucket.maxHumidity);
+        sqlite3_bind_double(upsertRollupStmt, 9, bucket.sumHumidity);
+
+        if (sqlite3_step(upsertRollupStmt) != SQLITE_DONE) {
+            LOG_ERROR("ClimateDataManager", "Error al guardar agregados", "error", sqlite3_errmsg(db));
+        }
+        sqlite3_reset(upsertRollupStmt);
+    }
+
+    if (ownTransaction) {
+        commitLocked();
+    }
+}
+
+bool ClimateDataManager::commitLocked() {
+    if (executeQuery("COMMIT")) {
+        return true;
+    }
+    // Algunos errores ya revierten la transacción; si sigue abierta se revierte acá
+    if (db && !sqlite3_get_autocommit(db)) {
+        executeQuery("ROLLBACK");
+    }
+    return false;
+}
+
+uint64_t ClimateDataManager::countReadings() {
+    if (columnStore) {
+        return columnStore->size();
+    }
+
+    std::lock_guard<std::mutex> lock(readMutex);
+    uint64_t count = 0;
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(readDb, "SELECT COUNT(*) FROM climate_readings", -1, &stmt, nullptr) == SQLITE_OK &&
+        sqlite3_step(stmt) == SQLITE_ROW) {
+        count = static_cast<uint64_t>(sqlite3_column_int64(stmt, 0));
+    }
+    sqlite3_finalize(stmt);
+    return count;
+}
+
+void ClimateDataManager::loadRollups() {
+    {
+        std::lock_guard<std::mutex> rollupLock(rollupMutex);
+        std::lock_guard<std::mutex> lock(readMutex);
+
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(readDb,
+                               "SELECT tier, bucket_start, count, temp_min, temp_max, temp_sum, "
+                               "hum_min, hum_max, hum_sum FROM reading_rollups",
+                               -1, &stmt, nullptr) == SQLITE_OK) {
+            while (sqlite3_step(stmt) == SQLITE_ROW) {
+                int tier = sqlite3_column_int(stmt, 0);
+                if (tier < 0 || tier >= ReadingRollups::TIER_COUNT) {
+                    continue;
+                }
+                RollupBucket bucket;
+                bucket.start = static_cast<time_t>(sqlite3_column_int64(stmt, 1));
+                bucket.count = static_cast<uint64_t>(sqlite3_column_int64(stmt, 2));
+                bucket.minTemperature = static_cast<float>(sqlite3_column_double(stmt, 3));
+                bucket.maxTemperature = static_cast<float>(sqlite3_column_double(stmt, 4));
+                bucket.sumTemperature = sqlite3_column_double(stmt, 5);
+                bucket.minHumidity = static_cast<float>(sqlite3_column_double(stmt, 6));
+                bucket.maxHumidity = static_cast<float>(sqlite3_column_double(stmt, 7));
+                bucket.sumHumidity = sqlite3_column_double(stmt, 8);
+                rollups.load(static_cast<RollupTier>(tier), bucket);
+            }
+        }
+        sqlite3_finalize(stmt);
+    }
+
+    uint64_t aggregated = 0;
+    {
+        std::lock_guard<std::mutex> rollupLock(rollupMutex);
+        aggregated = rollups.totalCount();
+    }
+
+    uint64_t raw = countReadings();
+    if (aggregated != raw) {
+        LOG_WARN("ClimateDataManager", "Agregados desactualizados, reconstruyendo",
+                 "aggregated", aggregated, "readings", raw);
+        rebuildRollups();
+    }
+}
+
+bool ClimateDataManager::rebuildRollups() {
+    std::lock_guard<std::mutex> rollupLock(rollupMutex);
+    rollups.clear();
+
+    if (columnStore) {
+        columnStore->forEachSegment([&](const SegmentView& view) {
+            for (size_t i = 0; i < view.count; ++i) {
+                rollups.add(static_cast<time_t>(view.timestamps[i]), view.temperatures[i], view.humidities[i]);
+            }
+            return true;
+        });
+    } else {
+        std::lock_guard<std::mutex> lock(readMutex);
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(readDb, "SELECT timestamp, temperature, humidity FROM climate_readings",
+                               -1, &stmt, nullptr) != SQLITE_OK) {
+            return false;
+        }
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            rollups.add(static_cast<time_t>(sqlite3_column_int64(stmt, 0)),
+                        static_cast<float>(sqlite3_column_double(stmt, 1)),
+                        static_cast<float>(sqlite3_column_double(stmt, 2)));
+        }
+        sqlite3_finalize(stmt);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (!executeQuery("DELETE FROM reading_rollups")) {
+            return false;
+        }
+    }
+    persistRollupsLocked();
     return true;
 }
 
-std::vector<ClimateReading> ClimateDataManager::getAllReadings() {
-    std::cout << "ClimateDataManager: Obteniendo todas las lecturas" << std::endl;
-    
-    // Simular consulta de base de datos
-    // En un proyecto real, aquí ejecutarías SELECT * FROM climate_readings ORDER BY timestamp DESC
-    
+std::vector<RollupBucket> ClimateDataManager::getRollups(RollupTier tier, time_t startTime, time_t endTime) {
+    std::lock_guard<std::mutex> lock(rollupMutex);
+    return rollups.getBuckets(tier, startTime, endTime);
+}
+
+std::vector<RollupBucket> ClimateDataManager::getRollupsForRange(time_t startTime, time_t endTime,
+                                                                size_t maxBuckets, RollupTier& tier) {
+    tier = ReadingRollups::selectTier(startTime, endTime, maxBuckets);
+    std::lock_guard<std::mutex> lock(rollupMutex);
+    if (tier == RollupTier::MINUTE && startTime < rollups.getMinuteCutoff()) {
+        tier = RollupTier::HOUR;
+    }
+    return rollups.getBuckets(tier, startTime, endTime);
+}
+
+bool ClimateDataManager::beginTransaction() {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    if (inTransaction || !executeQuery("BEGIN IMMEDIATE")) {
+        return false;
+    }
+    inTransaction = true;
+    return true;
+}
+
+bool ClimateDataManager::commitTransaction() {
+    std::vector<ClimateReading> committed;
+    bool ok;
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (!inTransaction) {
+            return false;
+        }
+        // Confirmada o revertida, la transacción termina acá
+        inTransaction = false;
+        committed.swap(pendingRollupReadings);
+        ok = commitLocked();
+    }
+
+    // Fuera de writeMutex: recordRollups toma rollupMutex, que va antes
+    if (ok && !committed.empty()) {
+        recordRollups(committed.data(), committed.size());
+    }
+    return ok;
+}
+
+bool ClimateDataManager::rollbackTransaction() {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    if (!inTransaction) {
+        return false;
+    }
+    inTransaction = false;
+    pendingRollupReadings.clear();
+    return executeQuery("ROLLBACK");
+}
+
+bool ClimateDataManager::insertAlert(const Alert& alert) {
+    ScopedLatency timer(insertAlertLatency);
+    LOG_DEBUG("ClimateDataManager", "Insertando alerta", "severity", alert.getSeverityString(),
+              "message", alert.getMessage());
+
+    std::lock_guard<std::mutex> lock(writeMutex);
+    if (!insertAlertStmt) {
+        return false;
+    }
+
+    // Las plantillas del sistema se guardan por código y el texto se arma al leer;
+    // las registradas en ejecución no valen en otro proceso y se guardan como texto
+    const bool builtin = AlertTemplates::isBuiltin(alert.getCode());
+    std::string message = builtin ? std::string() : alert.getMessage();
+    sqlite3_bind_text(insertAlertStmt, 1, message.c_str(), static_cast<int>(message.size()), SQLITE_STATIC);
+    sqlite3_bind_int(insertAlertStmt, 2, static_cast<int>(alert.getSeverity()));
+    sqlite3_bind_int64(insertAlertStmt, 3, static_cast<sqlite3_int64>(alert.getTimestamp()));
+    sqlite3_bind_int(insertAlertStmt, 4, builtin ? static_cast<int>(alert.getCode()) : 0);
+    sqlite3_bind_int(insertAlertStmt, 5, static_cast<int>(alert.getNote()));
+    sqlite3_bind_int(insertAlertStmt, 6, alert.getSensorId());
+    sqlite3_bind_double(insertAlertStmt, 7, alert.getValue());
+
+    bool ok = sqlite3_step(insertAlertStmt) == SQLITE_DONE;
+    sqlite3_reset(insertAlertStmt);
+    sqlite3_clear_bindings(insertAlertStmt);
+
+    if (!ok) {
+        LOG_ERROR("ClimateDataManager", "Error al insertar alerta", "error", sqlite3_errmsg(db));
+    }
+    return ok;
+}
+
+std::vector<ClimateReading> ClimateDataManager::fetchReadings(sqlite3_stmt* stmt) {
     std::vector<ClimateReading> readings;
-    // Agregar algunas lecturas de ejemplo
-    readings.push_back(ClimateReading(1, 22.5, 45.0, time(nullptr) - 3600));
-    readings.push_back(ClimateReading(2, 23.1, 46.2, time(nullptr) - 1800));
-    readings.push_back(ClimateReading(3, 22.8, 44.8, time(nullptr)));
-    
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        readings.push_back(ClimateReading(
+            sqlite3_column_int(stmt, 0),
+            static_cast<float>(sqlite3_column_double(stmt, 1)),
+            static_cast<float>(sqlite3_column_double(stmt, 2)),
+            static_cast<time_t>(sqlite3_column_int64(stmt, 3)),
+            sqlite3_column_int(stmt, 4)));
+    }
+    sqlite3_reset(stmt);
+
     return readings;
 }
 
-std::vector<Alert> ClimateDataManager::getAllAlerts() {
-    std::cout << "ClimateDataManager: Obteniendo todas las alertas" << std::endl;
-    
-    // Simular consulta de base de datos
-    // En un proyecto real, aquí ejecutarías SELECT * FROM alerts ORDER BY timestamp DESC
-    
+std::vector<Alert> ClimateDataManager::fetchAlerts(sqlite3_stmt* stmt) {
     std::vector<Alert> alerts;
-    // Agregar algunas alertas de ejemplo
-    alerts.push_back(Alert(1, "Temperatura alta detectada", AlertSeverity::HIGH, time(nullptr) - 7200));
-    alerts.push_back(Alert(2, "Humedad normal", AlertSeverity::LOW, time(nullptr) - 3600));
-    
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        const AlertCode code = static_cast<AlertCode>(sqlite3_column_int(stmt, 4));
+        const AlertSeverity severity = static_cast<AlertSeverity>(sqlite3_column_int(stmt, 2));
+        const time_t timestamp = static_cast<time_t>(sqlite3_column_int64(stmt, 3));
+        if (AlertTemplates::isBuiltin(code)) {
+            Alert alert(code,
+                        static_cast<float>(sqlite3_column_double(stmt, 7)),
+                        sqlite3_column_int(stmt, 6),
+                        severity,
+                        timestamp,
+                        static_cast<AlertNote>(sqlite3_column_int(stmt, 5)));
+            alert.setId(sqlite3_column_int(stmt, 0));
+            alerts.push_back(alert);
+        } else {
+            const unsigned char* text = sqlite3_column_text(stmt, 1);
+            alerts.push_back(Alert(
+                sqlite3_column_int(stmt, 0),
+                text ? reinterpret_cast<const char*>(text) : "",
+                severity,
+                timestamp));
+        }
+    }
+    sqlite3_reset(stmt);
+
     return alerts;
 }
 
+std::vector<ClimateReading> ClimateDataManager::fetchColumnarReadings(time_t startTime, time_t endTime) const {
+    std::vector<ClimateReading> readings;
+
+    columnStore->forEachInRange(startTime, endTime, [&](const SegmentView& view, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            int64_t ts = view.timestamps[i];
+            if (ts >= startTime && ts <= endTime) {
+                readings.push_back(ClimateReading(static_cast<int>(view.firstId + i),
+                                                  view.temperatures[i], view.humidities[i],
+                                                  static_cast<time_t>(ts), view.sensorAt(i)));
+            }
+        }
+        return true;
+    });
+
+    // Los tramos llegan en orden de inserción; el caso habitual sólo necesita invertirse
+    std::reverse(readings.begin(), readings.end());
+    if (!std::is_sorted(readings.begin(), readings.end(),
+                        [](const ClimateReading& a, const ClimateReading& b) {
+                            return a.getTimestamp() > b.getTimestamp();
+                        })) {
+        std::stable_sort(readings.begin(), readings.end(),
+                         [](const ClimateReading& a, const ClimateReading& b) {
+                             return a.getTimestamp() > b.getTimestamp();
+                         });
+    }
+    return readings;
+}
+
+std::vector<ClimateReading> ClimateDataManager::getAllReadings() {
+    LOG_DEBUG("ClimateDataManager", "Obteniendo todas las lecturas");
+
+    if (columnStore) {
+        return fetchColumnarReadings(std::numeric_limits<time_t>::min(),
+                                     std::numeric_limits<time_t>::max());
+    }
+
+    std::lock_guard<std::mutex> lock(readMutex);
+    if (!selectAllReadingsStmt) {
+        return std::vector<ClimateReading>();
+    }
+    return fetchReadings(selectAllReadingsStmt);
+}
+
+std::vector<Alert> ClimateDataManager::getAllAlerts() {
+    LOG_DEBUG("ClimateDataManager", "Obteniendo todas las alertas");
+
+    std::lock_guard<std::mutex> lock(readMutex);
+    if (!selectAllAlertsStmt) {
+        return std::vector<Alert>();
+    }
+    return fetchAlerts(selectAllAlertsStmt);
+}
+
 std::vector<ClimateReading> ClimateDataManager::getReadingsByDateRange(time_t startTime, time_t endTime) {
-    std::cout << "ClimateDataManager: Obteniendo lecturas por rango de fechas" << std::endl;
-    
-    // Simular consulta con filtro de fechas
-    // En un proyecto real, aquí ejecutarías SELECT * FROM climate_readings WHERE timestamp BETWEEN ? AND ?
-    
-    return getAllReadings(); // Por simplicidad, retornamos todas las lecturas
+    ScopedLatency timer(rangeQueryLatency);
+    if (columnStore) {
+        return fetchColumnarReadings(startTime, endTime);
+    }
+
+    std::lock_guard<std::mutex> lock(readMutex);
+    if (!selectReadingsRangeStmt) {
+        return std::vector<ClimateReading>();
+    }
+
+    sqlite3_bind_int64(selectReadingsRangeStmt, 1, static_cast<sqlite3_int64>(startTime));
+    sqlite3_bind_int64(selectReadingsRangeStmt, 2, static_cast<sqlite3_int64>(endTime));
+    return fetchReadings(selectReadingsRangeStmt);
 }
 
 std::vector<Alert> ClimateDataManager::getAlertsBySeverity(AlertSeverity severity) {
-    std::cout << "ClimateDataManager: Obteniendo alertas por severidad" << std::endl;
-    
-    // Simular consulta con filtro de severidad
-    // En un proyecto real, aquí ejecutarías SELECT * FROM alerts WHERE severity = ?
-    
-    std::vector<Alert> allAlerts = getAllAlerts();
-    std::vector<Alert> filteredAlerts;
-    
-    for (const auto& alert : allAlerts) {
-        if (alert.getSeverity() == severity) {
-            filteredAlerts.push_back(alert);
+    LOG_DEBUG("ClimateDataManager", "Obteniendo alertas por severidad");
+
+    std::lock_guard<std::mutex> lock(readMutex);
+    if (!selectAlertsSeverityStmt) {
+        return std::vector<Alert>();
+    }
+
+    sqlite3_bind_int(selectAlertsSeverityStmt, 1, static_cast<int>(severity));
+    return fetchAlerts(selectAlertsSeverityStmt);
+}
+
+size_t ClimateDataManager::forEachReading(const ReadingVisitor& visitor, const ReadingFilter& filter) {
+    size_t visited = 0;
+
+    if (columnStore) {
+        // Los tramos llegan del más reciente al más antiguo y se recorren hacia atrás;
+        // los bloques sellados se descomprimen de a uno, sin materializar el rango
+        columnStore->forEachInRange(filter.startTime, filter.endTime,
+                                    [&](const SegmentView& view, size_t begin, size_t end) {
+                                        for (size_t i = end; i > begin; --i) {
+                                            int64_t ts = view.timestamps[i - 1];
+                                            if (ts < filter.startTime || ts > filter.endTime) {
+                                                continue;
+                                            }
+                                            ++visited;
+                                            if (!visitor(ClimateReading(static_cast<int>(view.firstId + i - 1),
+                                                                        view.temperatures[i - 1],
+                                                                        view.humidities[i - 1],
+                                                                        static_cast<time_t>(ts),
+                                                                        view.sensorAt(i - 1)))) {
+                                                return false;
+                                            }
+                                        }
+                                        return true;
+                                    },
+                                    true);
+        return visited;
+    }
+
+    sqlite3_int64 cursorTimestamp = static_cast<sqlite3_int64>(filter.endTime);
+    sqlite3_int64 cursorId = std::numeric_limits<sqlite3_int64>::max();
+    std::vector<ClimateReading> page;
+    page.reserve(STREAM_PAGE_SIZE);
+
+    while (true) {
+        page.clear();
+        {
+            std::lock_guard<std::mutex> lock(readMutex);
+            if (!readingsPageStmt) {
+                return visited;
+            }
+            sqlite3_bind_int64(readingsPageStmt, 1, static_cast<sqlite3_int64>(filter.startTime));
+            sqlite3_bind_int64(readingsPageStmt, 2, static_cast<sqlite3_int64>(filter.endTime));
+            sqlite3_bind_int64(readingsPageStmt, 3, cursorTimestamp);
+            sqlite3_bind_int64(readingsPageStmt, 4, cursorId);
+            sqlite3_bind_int(readingsPageStmt, 5, STREAM_PAGE_SIZE);
+            page = fetchReadings(readingsPageStmt);
+        }
+
+        // El visitante se ejecuta sin locks: puede volver a llamar al gestor
+        for (const auto& reading : page) {
+            ++visited;
+            if (!visitor(reading)) {
+                return visited;
+            }
         }
+
+        if (page.size() < static_cast<size_t>(STREAM_PAGE_SIZE)) {
+            return visited;
+        }
+        cursorTimestamp = static_cast<sqlite3_int64>(page.back().getTimestamp());
+        cursorId = page.back().getId();
+    }
+}
+
+size_t ClimateDataManager::forEachReadingColumns(time_t startTime, time_t endTime,
+                                                 const ReadingColumnsVisitor& visitor) {
+    size_t visited = 0;
+
+    if (columnStore) {
+        columnStore->forEachInRange(startTime, endTime,
+                                    [&](const SegmentView& view, size_t begin, size_t end) {
+                                        visited += end - begin;
+                                        return visitor(view, begin, end);
+                                    });
+        return visited;
+    }
+
+    sqlite3_int64 cursorTimestamp = static_cast<sqlite3_int64>(startTime);
+    sqlite3_int64 cursorId = std::numeric_limits<sqlite3_int64>::min();
+    std::vector<ClimateReading> page;
+    std::vector<int64_t> timestamps;
+    std::vector<float> temperatures;
+    std::vector<float> humidities;
+    std::vector<int32_t> sensorIds;
+
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(readMutex);
+            if (!readingsAscPageStmt) {
+                return visited;
+            }
+            sqlite3_bind_int64(readingsAscPageStmt, 1, static_cast<sqlite3_int64>(startTime));
+            sqlite3_bind_int64(readingsAscPageStmt, 2, static_cast<sqlite3_int64>(endTime));
+            sqlite3_bind_int64(readingsAscPageStmt, 3, cursorTimestamp);
+            sqlite3_bind_int64(readingsAscPageStmt, 4, cursorId);
+            sqlite3_bind_int(readingsAscPageStmt, 5, STREAM_PAGE_SIZE);
+            page = fetchReadings(readingsAscPageStmt);
+        }
+        if (page.empty()) {
+            return visited;
+        }
+
+        timestamps.resize(page.size());
+        temperatures.resize(page.size());
+        humidities.resize(page.size());
+        sensorIds.resize(page.size());
+        for (size_t i = 0; i < page.size(); ++i) {
+            timestamps[i] = static_cast<int64_t>(page[i].getTimestamp());
+            temperatures[i] = page[i].getTemperature();
+            humidities[i] = page[i].getHumidity();
+            sensorIds[i] = page[i].getSensorId();
+        }
+
+        // Los ids de SQLite no son contiguos, así que el tramo no tiene firstId
+        SegmentView view = { timestamps.data(), temperatures.data(), humidities.data(),
+                             sensorIds.data(), page.size(), 0 };
+        visited += page.size();
+        if (!visitor(view, 0, page.size())) {
+            return visited;
+        }
+
+        if (page.size() < static_cast<size_t>(STREAM_PAGE_SIZE)) {
+            return visited;
+        }
+        cursorTimestamp = static_cast<sqlite3_int64>(page.back().getTimestamp());
+        cursorId = page.back().getId();
+    }
+}
+
+size_t ClimateDataManager::forEachAlert(const AlertVisitor& visitor, const AlertFilter& filter) {
+    size_t visited = 0;
+    sqlite3_int64 cursorTimestamp = static_cast<sqlite3_int64>(filter.endTime);
+    sqlite3_int64 cursorId = std::numeric_limits<sqlite3_int64>::max();
+    std::vector<Alert> page;
+
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(readMutex);
+            if (!alertsPageStmt) {
+                return visited;
+            }
+            sqlite3_bind_int64(alertsPageStmt, 1, static_cast<sqlite3_int64>(filter.startTime));
+            sqlite3_bind_int64(alertsPageStmt, 2, static_cast<sqlite3_int64>(filter.endTime));
+            sqlite3_bind_int(alertsPageStmt, 3, static_cast<int>(filter.minSeverity));
+            sqlite3_bind_int64(alertsPageStmt, 4, cursorTimestamp);
+            sqlite3_bind_int64(alertsPageStmt, 5, cursorId);
+            sqlite3_bind_int(alertsPageStmt, 6, STREAM_PAGE_SIZE);
+            page = fetchAlerts(alertsPageStmt);
+        }
+
+        for (const auto& alert : page) {
+            ++visited;
+            if (!visitor(alert)) {
+                return visited;
+            }
+        }
+
+        if (page.size() < static_cast<size_t>(STREAM_PAGE_SIZE)) {
+            return visited;
+        }
+        cursorTimestamp = static_cast<sqlite3_int64>(page.back().getTimestamp());
+        cursorId = page.back().getId();
     }
-    
-    return filteredAlerts;
 }
 
 void ClimateDataManager::closeConnection() {
+    {
+        // Una transacción explícita que nadie confirmó no se da por buena al
+        // cerrar; se revierte antes de persistir los agregados para no
+        // incluirlos en ella
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (inTransaction) {
+            LOG_WARN("ClimateDataManager", "Transacción abierta al cerrar, se revierte");
+            executeQuery("ROLLBACK");
+            inTransaction = false;
+            pendingRollupReadings.clear();
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(rollupMutex);
+        persistRollupsLocked();
+    }
+    columnStore.reset();
+
+    std::lock_guard<std::mutex> writeLock(writeMutex);
+    std::lock_guard<std::mutex> readLock(readMutex);
+
+    finalizeStatement(insertReadingStmt);
+    finalizeStatement(insertAlertStmt);
+    finalizeStatement(selectAllReadingsStmt);
+    finalizeStatement(selectReadingsRangeStmt);
+    finalizeStatement(selectAllAlertsStmt);
+    finalizeStatement(selectAlertsSeverityStmt);
+    finalizeStatement(upsertRollupStmt);
+    finalizeStatement(readingsPageStmt);
+    finalizeStatement(alertsPageStmt);
+    finalizeStatement(readingsAscPageStmt);
+
+    if (readDb) {
+        sqlite3_close(readDb);
+        readDb = nullptr;
+    }
+
     if (db) {
-        std::cout << "ClimateDataManager: Cerrando conexión a la base de datos" << std::endl;
-        // En un proyecto real, aquí ejecutarías sqlite3_close(db)
+        LOG_INFO("ClimateDataManager", "Cerrando conexión a la base de datos");
+        sqlite3_close(db);
         db = nullptr;
     }
 }
 
 bool ClimateDataManager::isConnected() const {
     return db != nullptr;
-} 
\ No newline at end of file
+}
+
+StorageEngine ClimateDataManager::getStorageEngine() const {
+    return storageEngine;
+}
+
+const ColumnarReadingStore* ClimateDataManager::getColumnStore() const {
+    return columnStore.get();
+}
@@ -1,40 +1,52 @@
 #include "../include/ClimateReading.h"
-#include <sstream>
-#include <iomanip>
+#include "../include/TimeFormatter.h"
+#include <cstdio>
+#include <algorithm>
 #include <ctime>
 
-ClimateReading::ClimateReading() : id(0), temperature(0.0), humidity(0.0), timestamp(time(nullptr)) {}
+ClimateReading::ClimateReading() : id(0), sensorId(0), temperature(0.0), humidity(0.0), timestamp(time(nullptr)) {}
 
 ClimateReading::ClimateReading(float temp, float hum) 
-    : id(0), temperature(temp), humidity(hum), timestamp(time(nullptr)) {}
+    : id(0), sensorId(0), temperature(temp), humidity(hum), timestamp(time(nullptr)) {}
 
-ClimateReading::ClimateReading(int id, float temp, float hum, time_t ts) 
-    : id(id), temperature(temp), humidity(hum), timestamp(ts) {}
+ClimateReading::ClimateReading(int id, float temp, float hum, time_t ts, int sensor) 
+    : id(id), sensorId(sensor), temperature(temp), humidity(hum), timestamp(ts) {}
 
 // Getters
 int ClimateReading::getId() const { return id; }
+int ClimateReading::getSensorId() const { return sensorId; }
 float ClimateReading::getTemperature() const { return temperature; }
 float ClimateReading::getHumidity() const { return humidity; }
 time_t ClimateReading::getTimestamp() const { return timestamp; }
 
 // Setters
 void ClimateReading::setId(int id) { this->id = id; }
+void ClimateReading::setSensorId(int sensor) { sensorId = sensor; }
 void ClimateReading::setTemperature(float temp) { temperature = temp; }
 void ClimateReading::setHumidity(float hum) { humidity = hum; }
 void ClimateReading::setTimestamp(time_t ts) { timestamp = ts; }
 
 std::string ClimateReading::toString() const {
-    std::ostringstream oss;
-    oss << "ID: " << id 
-        << " | Temperatura: " << std::fixed << std::setprecision(1) << temperature << "°C"
-        << " | Humedad: " << std::fixed << std::setprecision(1) << humidity << "%"
-        << " | Fecha: " << getDateTimeString();
-    return oss.str();
+    // snprintf en lugar de ostringstream: se llama por cada lectura al listar el historial
+    char values[192];
+    int length;
+    if (sensorId != 0) {
+        length = snprintf(values, sizeof(values), "ID: %d | Sensor: %d | Temperatura: %.1f°C | Humedad: %.1f%% | Fecha: ",
+                          id, sensorId, temperature, humidity);
+    } else {
+        length = snprintf(values, sizeof(values), "ID: %d | Temperatura: %.1f°C | Humedad: %.1f%% | Fecha: ",
+                          id, temperature, humidity);
+    }
+
+    size_t valuesLength = length < 0 ? 0 : std::min(static_cast<size_t>(length), sizeof(values) - 1);
+
+    std::string text;
+    text.reserve(valuesLength + TimeFormatter::DATETIME_LENGTH);
+    text.append(values, valuesLength);
+    TimeFormatter::appendDateTime(timestamp, text);
+    return text;
 }
 
 std::string ClimateReading::getDateTimeString() const {
-    std::ostringstream oss;
-    struct tm* timeinfo = localtime(&timestamp);
-    oss << std::put_time(timeinfo, "%Y-%m-%d %H:%M:%S");
-    return oss.str();
-} 
\ No newline at end of file
+    return TimeFormatter::dateTime(timestamp);
+}
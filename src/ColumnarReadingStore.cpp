@@ -0,0 +1,847 @@
+#include "../include/ColumnarReadingStore.h"
+#include "../include/GorillaCodec.h"
+#include "../include/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <limits>
+
+namespace {
+
+const char SEGMENT_MAGIC[8] = { 'C', 'L', 'I', 'M', 'C', 'O', 'L', '1' };
+const uint32_t SEGMENT_VERSION = 2;         ///< Versión con columna de sensores
+const uint32_t SEGMENT_VERSION_NO_SENSOR = 1; ///< Versión anterior, sólo lectura
+const char* SEGMENT_PREFIX = "seg-";
+const char* SEGMENT_SUFFIX = ".col";
+const char SEALED_MAGIC[8] = { 'C', 'L', 'I', 'M', 'G', 'O', 'R', '1' };
+const uint32_t SEALED_VERSION = 1;
+const char* SEALED_SUFFIX = ".gor";
+const char* TEMP_SUFFIX = ".tmp";
+
+/**
+ * @brief Cabecera de 64 bytes al inicio de cada archivo de segmento
+ */
+struct SegmentHeader {
+    char magic[8];          ///< Identificador del formato
+    uint32_t version;       ///< Versión del formato
+    uint32_t capacity;      ///< Filas reservadas en cada columna
+    uint64_t count;         ///< Filas escritas (se actualiza después de los datos)
+    int64_t minTimestamp;   ///< Timestamp mínimo del segmento
+    int64_t maxTimestamp;   ///< Timestamp máximo del segmento
+    uint32_t flags;         ///< Combinación de SEGMENT_STATS_VALID y SEGMENT_UNSORTED
+    uint32_t padding;       ///< Relleno de alineación
+    uint64_t reserved[2];   ///< Reservado para versiones futuras
+};
+
+const uint32_t SEGMENT_STATS_VALID = 1u << 0; ///< minTimestamp/maxTimestamp están calculados
+const uint32_t SEGMENT_UNSORTED = 1u << 1;    ///< Hay filas fuera de orden temporal
+
+/**
+ * @brief Cabecera de 64 bytes al inicio de cada segmento sellado
+ *
+ * Le sigue el directorio de bloques (blockCount entradas SealedBlock) y
+ * luego los flujos comprimidos de cada bloque.
+ */
+struct SealedHeader {
+    char magic[8];          ///< Identificador del formato
+    uint32_t version;       ///< Versión del formato
+    uint32_t blockRows;     ///< Filas por bloque (el último puede tener menos)
+    uint64_t count;         ///< Filas del segmento
+    int64_t minTimestamp;   ///< Timestamp mínimo del segmento
+    int64_t maxTimestamp;   ///< Timestamp máximo del segmento
+    uint32_t flags;         ///< SEGMENT_UNSORTED si hay filas fuera de orden
+    uint32_t blockCount;    ///< Entradas del directorio de bloques
+    uint64_t reserved[2];   ///< Reservado para versiones futuras
+};
+
+/**
+ * @brief Entrada del directorio de bloques de un segmento sellado
+ */
+struct SealedBlock {
+    uint64_t offset;        ///< Inicio del flujo comprimido desde el comienzo del archivo
+    uint32_t rows;          ///< Filas del bloque
+    uint32_t size;          ///< Bytes del flujo comprimido
+    int64_t minTimestamp;   ///< Timestamp mínimo del bloque
+    int64_t maxTimestamp;   ///< Timestamp máximo del bloque
+};
+
+/**
+ * @brief Tramo de filas que un recorrido entrega al visitante
+ *
+ * En los segmentos sellados el tramo es un bloque comprimido que se
+ * descomprime recién al entregarlo.
+ */
+struct ScanSpan {
+    SegmentView view;       ///< Columnas del segmento (en bloques sellados sólo count y firstId)
+    size_t begin;           ///< Primera fila del tramo
+    size_t end;             ///< Fin del tramo (exclusivo)
+    const uint8_t* packed;  ///< Flujo comprimido (nullptr en segmentos .col)
+    size_t packedSize;      ///< Bytes del flujo comprimido
+    bool trim;              ///< Recortar el bloque al rango pedido tras descomprimirlo
+};
+
+/**
+ * @brief Columnas donde un recorrido descomprime los bloques sellados
+ */
+class BlockBuffer {
+private:
+    std::vector<int64_t> timestamps;
+    std::vector<float> temperatures;
+    std::vector<float> humidities;
+    std::vector<int32_t> sensorIds;
+
+public:
+    /**
+     * @brief Descomprime el bloque de un tramo
+     * @param span Tramo con el bloque comprimido
+     * @param view Vista a completar con las columnas descomprimidas
+     * @return false si el bloque está dañado
+     */
+    bool decode(const ScanSpan& span, SegmentView& view) {
+        const size_t rows = span.view.count;
+        if (timestamps.size() < rows) {
+            timestamps.resize(rows);
+            temperatures.resize(rows);
+            humidities.resize(rows);
+            sensorIds.resize(rows);
+        }
+
+        GorillaDecoder decoder(span.packed, span.packedSize, rows);
+        if (decoder.read(timestamps.data(), temperatures.data(), humidities.data(), sensorIds.data(), rows) != rows ||
+            !decoder.isValid()) {
+            return false;
+        }
+
+        view.timestamps = timestamps.data();
+        view.temperatures = temperatures.data();
+        view.humidities = humidities.data();
+        view.sensorIds = sensorIds.data();
+        view.count = rows;
+        view.firstId = span.view.firstId;
+        return true;
+    }
+};
+
+/**
+ * @brief Verifica si un nombre tiene el prefijo de segmento y un sufijo dado
+ */
+bool hasSegmentName(const std::string& name, const char* suffix) {
+    const size_t prefixLength = std::strlen(SEGMENT_PREFIX);
+    const size_t suffixLength = std::strlen(suffix);
+    return name.size() > prefixLength + suffixLength &&
+           name.compare(0, prefixLength, SEGMENT_PREFIX) == 0 &&
+           name.compare(name.size() - suffixLength, std::string::npos, suffix) == 0;
+}
+
+/**
+ * @brief Escribe un archivo completo y lo sincroniza con el disco
+ * @return true si se escribió todo, false en caso contrario
+ */
+bool writeFileDurably(const std::string& path, const std::vector<uint8_t>& content) {
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    size_t written = 0;
+    while (written < content.size()) {
+        ssize_t n = write(fd, content.data() + written, content.size() - written);
+        if (n <= 0) {
+            close(fd);
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+    bool ok = fsync(fd) == 0;
+    return close(fd) == 0 && ok;
+}
+
+/**
+ * @brief Calcula el tamaño del archivo para una capacidad dada
+ * @param capacity Filas por segmento
+ * @param version Versión del formato
+ * @return Tamaño en bytes de cabecera y columnas
+ */
+size_t segmentFileSize(size_t capacity, uint32_t version) {
+    size_t rowSize = sizeof(int64_t) + 2 * sizeof(float);
+    if (version >= SEGMENT_VERSION) {
+        rowSize += sizeof(int32_t);
+    }
+    return sizeof(SegmentHeader) + capacity * rowSize;
+}
+
+/**
+ * @brief Arma el nombre de archivo de un segmento
+ * @param index Número de segmento
+ * @return Nombre con formato seg-NNNNNN.col
+ */
+std::string segmentFileName(size_t index) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%s%06zu%s", SEGMENT_PREFIX, index, SEGMENT_SUFFIX);
+    return name;
+}
+
+SegmentHeader* headerOf(void* base) {
+    return static_cast<SegmentHeader*>(base);
+}
+
+const SegmentHeader* headerOf(const void* base) {
+    return static_cast<const SegmentHeader*>(base);
+}
+
+/**
+ * @brief Recalcula el rango temporal de un segmento escrito sin estadísticas
+ * @param header Cabecera del segmento
+ * @param timestamps Columna de timestamps
+ */
+void computeSegmentStats(SegmentHeader* header, const int64_t* timestamps) {
+    header->minTimestamp = std::numeric_limits<int64_t>::max();
+    header->maxTimestamp = std::numeric_limits<int64_t>::min();
+    header->flags = SEGMENT_STATS_VALID;
+
+    for (uint64_t i = 0; i < header->count; ++i) {
+        if (timestamps[i] < header->maxTimestamp) {
+            header->flags |= SEGMENT_UNSORTED;
+        }
+        header->minTimestamp = std::min(header->minTimestamp, timestamps[i]);
+        header->maxTimestamp = std::max(header->maxTimestamp, timestamps[i]);
+    }
+}
+
+} // namespace
+
+const size_t ColumnarReadingStore::INDEX_BLOCK_ROWS;
+const size_t ColumnarReadingStore::SEALED_BLOCK_ROWS;
+
+ColumnarReadingStore::ColumnarReadingStore(const std::string& dir, size_t capacity)
+    : directory(dir), segmentCapacity(capacity), nextSegmentIndex(0), totalRows(0), activeScans(0),
+      stopping(false) {
+    mkdir(directory.c_str(), 0755);
+
+    // Listar los segmentos existentes; el nombre con ceros a la izquierda da el orden
+    std::vector<std::string> names;
+    DIR* handle = opendir(directory.c_str());
+    if (handle) {
+        while (struct dirent* entry = readdir(handle)) {
+            std::string name = entry->d_name;
+            if (hasSegmentName(name, TEMP_SUFFIX)) {
+                // Sellado interrumpido: el .col sigue siendo el original
+                unlink((directory + "/" + name).c_str());
+            } else if (hasSegmentName(name, SEGMENT_SUFFIX) || hasSegmentName(name, SEALED_SUFFIX)) {
+                names.push_back(name);
+            }
+        }
+        closedir(handle);
+    }
+    std::sort(names.begin(), names.end());
+    if (!names.empty()) {
+        nextSegmentIndex = std::strtoul(names.back().c_str() + std::strlen(SEGMENT_PREFIX), nullptr, 10) + 1;
+    }
+
+    for (size_t i = 0; i < names.size(); ++i) {
+        const std::string& name = names[i];
+        const std::string path = directory + "/" + name;
+        bool sealed = hasSegmentName(name, SEALED_SUFFIX);
+        Segment segment;
+        bool opened;
+        // Con el mismo número, seg-N.col se ordena antes que seg-N.gor: si el
+        // sellado llegó a renombrar el .gor, el .col quedó de una caída
+        const size_t stem = name.size() - std::strlen(SEGMENT_SUFFIX);
+        if (!sealed && i + 1 < names.size() && names[i + 1].compare(0, stem, name, 0, stem) == 0 &&
+            openSealedSegment(directory + "/" + names[i + 1], segment)) {
+            unlink(path.c_str());
+            sealed = true;
+            opened = true;
+            ++i;
+        } else {
+            opened = sealed ? openSealedSegment(path, segment) : openSegment(path, segment);
+        }
+        if (!opened) {
+            LOG_WARN("ColumnarReadingStore", "Segmento inválido ignorado", "segment", name);
+            continue;
+        }
+        segment.firstId = totalRows + 1;
+        totalRows += sealed ? static_cast<const SealedHeader*>(segment.base)->count
+                            : headerOf(segment.base)->count;
+        segments.push_back(segment);
+    }
+
+    if (segments.empty() || segments.back().sealed) {
+        createSegment();
+    }
+
+    // Los segmentos sin sellar detrás del activo (por ejemplo, tras una caída)
+    // los toma el hilo de sellado apenas arranca
+    sealer = std::thread(&ColumnarReadingStore::sealLoop, this);
+
+    LOG_INFO("ColumnarReadingStore", "Almacén abierto", "segments", segments.size(),
+             "readings", totalRows, "directory", directory);
+}
+
+ColumnarReadingStore::~ColumnarReadingStore() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    sealWake.notify_one();
+    sealer.join();
+
+    flush();
+    for (auto& segment : segments) {
+        munmap(segment.base, segment.mappedSize);
+        if (segment.fd >= 0) {
+            close(segment.fd);
+        }
+    }
+    for (const auto& mapping : retired) {
+        munmap(mapping.base, mapping.size);
+    }
+}
+
+bool ColumnarReadingStore::openSegment(const std::string& path, Segment& segment) {
+    int fd = open(path.c_str(), O_RDWR);
+    if (fd < 0) {
+        return false;
+    }
+
+    SegmentHeader header;
+    if (pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+        std::memcmp(header.magic, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC)) != 0 ||
+        (header.version != SEGMENT_VERSION && header.version != SEGMENT_VERSION_NO_SENSOR) ||
+        header.count > header.capacity) {
+        close(fd);
+        return false;
+    }
+
+    size_t size = segmentFileSize(header.capacity, header.version);
+    void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+
+    segment.path = path;
+    segment.fd = fd;
+    segment.base = base;
+    segment.mappedSize = size;
+    segment.sealed = false;
+    segment.sealFailed = false;
+    segment.indexBuilt = false;
+
+    SegmentHeader* mapped = headerOf(base);
+    if (!(mapped->flags & SEGMENT_STATS_VALID)) {
+        computeSegmentStats(mapped, makeView(segment).timestamps);
+    }
+    return true;
+}
+
+bool ColumnarReadingStore::openSealedSegment(const std::string& path, Segment& segment) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SealedHeader)) {
+        close(fd);
+        return false;
+    }
+    const size_t size = static_cast<size_t>(info.st_size);
+    void* base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return false;
+    }
+
+    // Se valida el directorio completo una vez: los recorridos confían en él
+    const SealedHeader* header = static_cast<const SealedHeader*>(base);
+    const SealedBlock* blocks = reinterpret_cast<const SealedBlock*>(header + 1);
+    bool valid = std::memcmp(header->magic, SEALED_MAGIC, sizeof(SEALED_MAGIC)) == 0 &&
+                 header->version == SEALED_VERSION &&
+                 header->blockCount <= (size - sizeof(SealedHeader)) / sizeof(SealedBlock);
+    uint64_t rows = 0;
+    for (uint32_t b = 0; valid && b < header->blockCount; ++b) {
+        valid = blocks[b].rows > 0 && blocks[b].rows <= header->blockRows &&
+                blocks[b].offset <= size && blocks[b].size <= size - blocks[b].offset;
+        rows += blocks[b].rows;
+    }
+    if (!valid || rows != header->count) {
+        munmap(base, size);
+        return false;
+    }
+
+    segment.path = path;
+    segment.fd = -1;
+    segment.base = base;
+    segment.mappedSize = size;
+    segment.sealed = true;
+    segment.sealFailed = false;
+    segment.indexBuilt = false;
+    segment.blockIndex.clear();
+    return true;
+}
+
+bool ColumnarReadingStore::compressSegment(const Segment& segment, Segment& sealed) {
+    const SegmentHeader* header = headerOf(static_cast<const void*>(segment.base));
+    const SegmentView view = makeView(segment);
+    const size_t blockCount = (view.count + SEALED_BLOCK_ROWS - 1) / SEALED_BLOCK_ROWS;
+
+    std::vector<uint8_t> file(sizeof(SealedHeader) + blockCount * sizeof(SealedBlock));
+    file.reserve(file.size() + view.count * 4);
+    std::vector<SealedBlock> blocks(blockCount);
+    for (size_t b = 0; b < blockCount; ++b) {
+        const size_t begin = b * SEALED_BLOCK_ROWS;
+        const size_t end = std::min(view.count, begin + SEALED_BLOCK_ROWS);
+        SealedBlock& block = blocks[b];
+        block.offset = file.size();
+        block.rows = static_cast<uint32_t>(end - begin);
+        block.minTimestamp = std::numeric_limits<int64_t>::max();
+        block.maxTimestamp = std::numeric_limits<int64_t>::min();
+
+        GorillaEncoder encoder(file);
+        for (size_t i = begin; i < end; ++i) {
+            encoder.append(view.timestamps[i], view.temperatures[i], view.humidities[i], view.sensorAt(i));
+            block.minTimestamp = std::min(block.minTimestamp, view.timestamps[i]);
+            block.maxTimestamp = std::max(block.maxTimestamp, view.timestamps[i]);
+        }
+        encoder.finish();
+        block.size = static_cast<uint32_t>(file.size() - block.offset);
+    }
+
+    SealedHeader sealedHeader;
+    std::memset(&sealedHeader, 0, sizeof(sealedHeader));
+    std::memcpy(sealedHeader.magic, SEALED_MAGIC, sizeof(SEALED_MAGIC));
+    sealedHeader.version = SEALED_VERSION;
+    sealedHeader.blockRows = static_cast<uint32_t>(SEALED_BLOCK_ROWS);
+    sealedHeader.count = view.count;
+    sealedHeader.minTimestamp = header->minTimestamp;
+    sealedHeader.maxTimestamp = header->maxTimestamp;
+    sealedHeader.flags = header->flags & SEGMENT_UNSORTED;
+    sealedHeader.blockCount = static_cast<uint32_t>(blockCount);
+    std::memcpy(file.data(), &sealedHeader, sizeof(sealedHeader));
+    if (blockCount > 0) {
+        std::memcpy(file.data() + sizeof(sealedHeader), blocks.data(), blockCount * sizeof(SealedBlock));
+    }
+
+    const std::string base = segment.path.substr(0, segment.path.size() - std::strlen(SEGMENT_SUFFIX));
+    const std::string sealedPath = base + SEALED_SUFFIX;
+    const std::string tempPath = sealedPath + TEMP_SUFFIX;
+    if (!writeFileDurably(tempPath, file) || rename(tempPath.c_str(), sealedPath.c_str()) != 0) {
+        unlink(tempPath.c_str());
+        LOG_ERROR("ColumnarReadingStore", "No se pudo sellar el segmento", "segment", segment.path);
+        return false;
+    }
+    if (!openSealedSegment(sealedPath, sealed)) {
+        unlink(sealedPath.c_str());
+        LOG_ERROR("ColumnarReadingStore", "Segmento sellado inválido", "segment", sealedPath);
+        return false;
+    }
+
+    LOG_DEBUG("ColumnarReadingStore", "Segmento sellado", "segment", sealedPath, "readings", view.count,
+              "bytes", file.size());
+    sealed.firstId = segment.firstId;
+    return true;
+}
+
+void ColumnarReadingStore::replaceWithSealed(Segment& segment, const Segment& sealed) {
+    // Los recorridos en curso pueden tener vistas sobre el mapeo anterior
+    if (activeScans == 0) {
+        munmap(segment.base, segment.mappedSize);
+    } else {
+        RetiredMapping mapping = { segment.base, segment.mappedSize };
+        retired.push_back(mapping);
+    }
+    close(segment.fd);
+    unlink(segment.path.c_str());
+    segment = sealed;
+}
+
+void ColumnarReadingStore::sealLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        // Sólo el último segmento recibe anexados; los anteriores se sellan
+        size_t index = segments.size();
+        for (size_t i = 0; i + 1 < segments.size(); ++i) {
+            if (!segments[i].sealed && !segments[i].sealFailed) {
+                index = i;
+                break;
+            }
+        }
+        if (index == segments.size()) {
+            if (stopping) {
+                return;
+            }
+            sealWake.wait(lock);
+            continue;
+        }
+
+        // El mapeo del segmento lleno sólo lo libera este hilo, así que se
+        // puede comprimir y escribir sin el mutex mientras siguen los anexados
+        const Segment full = segments[index];
+        lock.unlock();
+        Segment sealed;
+        const bool ok = compressSegment(full, sealed);
+        lock.lock();
+
+        // Los segmentos sólo se agregan al final: el índice sigue siendo válido
+        if (ok) {
+            replaceWithSealed(segments[index], sealed);
+        } else {
+            segments[index].sealFailed = true;
+        }
+    }
+}
+
+void ColumnarReadingStore::beginScan() const {
+    ++activeScans;
+}
+
+void ColumnarReadingStore::endScan() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (--activeScans == 0) {
+        for (const auto& mapping : retired) {
+            munmap(mapping.base, mapping.size);
+        }
+        retired.clear();
+    }
+}
+
+bool ColumnarReadingStore::createSegment() {
+    std::string path = directory + "/" + segmentFileName(nextSegmentIndex++);
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        LOG_ERROR("ColumnarReadingStore", "No se pudo crear el segmento", "path", path);
+        return false;
+    }
+
+    // El archivo queda disperso: sólo ocupa disco a medida que se escriben filas
+    size_t size = segmentFileSize(segmentCapacity, SEGMENT_VERSION);
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        return false;
+    }
+
+    SegmentHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC));
+    header.version = SEGMENT_VERSION;
+    header.capacity = static_cast<uint32_t>(segmentCapacity);
+    header.minTimestamp = std::numeric_limits<int64_t>::max();
+    header.maxTimestamp = std::numeric_limits<int64_t>::min();
+    header.flags = SEGMENT_STATS_VALID;
+    if (pwrite(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+        close(fd);
+        return false;
+    }
+    close(fd);
+
+    Segment segment;
+    if (!openSegment(path, segment)) {
+        return false;
+    }
+    segment.firstId = totalRows + 1;
+    segment.indexBuilt = true; // vacío: el índice se mantiene desde el primer anexado
+    segments.push_back(segment);
+    return true;
+}
+
+SegmentView ColumnarReadingStore::makeView(const Segment& segment) const {
+    const SegmentHeader* header = headerOf(static_cast<const void*>(segment.base));
+    const char* data = static_cast<const char*>(segment.base) + sizeof(SegmentHeader);
+
+    SegmentView view;
+    view.timestamps = reinterpret_cast<const int64_t*>(data);
+    view.temperatures = reinterpret_cast<const float*>(data + header->capacity * sizeof(int64_t));
+    view.humidities = view.temperatures + header->capacity;
+    view.sensorIds = header->version >= SEGMENT_VERSION
+                         ? reinterpret_cast<const int32_t*>(view.humidities + header->capacity)
+                         : nullptr;
+    view.count = static_cast<size_t>(header->count);
+    view.firstId = segment.firstId;
+    return view;
+}
+
+bool ColumnarReadingStore::appendLocked(const ClimateReading& reading) {
+    if (segments.empty()) {
+        return false;
+    }
+
+    // Los segmentos v1 no tienen columna de sensores: se continúa en uno nuevo
+    SegmentHeader* header = headerOf(segments.back().base);
+    if (header->count == header->capacity || header->version != SEGMENT_VERSION) {
+        if (!createSegment()) {
+            return false;
+        }
+        // El segmento lleno se sella en el hilo de fondo, fuera de este anexado
+        sealWake.notify_one();
+        header = headerOf(segments.back().base);
+    }
+
+    char* data = static_cast<char*>(segments.back().base) + sizeof(SegmentHeader);
+    int64_t* timestamps = reinterpret_cast<int64_t*>(data);
+    float* temperatures = reinterpret_cast<float*>(data + header->capacity * sizeof(int64_t));
+    float* humidities = temperatures + header->capacity;
+    int32_t* sensorIds = reinterpret_cast<int32_t*>(humidities + header->capacity);
+
+    size_t row = static_cast<size_t>(header->count);
+    int64_t ts = static_cast<int64_t>(reading.getTimestamp());
+    timestamps[row] = ts;
+    temperatures[row] = reading.getTemperature();
+    humidities[row] = reading.getHumidity();
+    sensorIds[row] = reading.getSensorId();
+
+    if (ts < header->maxTimestamp) {
+        header->flags |= SEGMENT_UNSORTED;
+    }
+    header->minTimestamp = std::min(header->minTimestamp, ts);
+    header->maxTimestamp = std::max(header->maxTimestamp, ts);
+
+    Segment& active = segments.back();
+    if (active.indexBuilt) {
+        if (row % INDEX_BLOCK_ROWS == 0) {
+            BlockRange block = { ts, ts };
+            active.blockIndex.push_back(block);
+        } else {
+            BlockRange& block = active.blockIndex.back();
+            block.minTimestamp = std::min(block.minTimestamp, ts);
+            block.maxTimestamp = std::max(block.maxTimestamp, ts);
+        }
+    }
+
+    // El contador se publica después de los datos para que una caída no deje filas a medias
+    header->count = row + 1;
+    ++totalRows;
+    return true;
+}
+
+bool ColumnarReadingStore::append(const ClimateReading& reading) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return appendLocked(reading);
+}
+
+bool ColumnarReadingStore::appendBatch(const std::vector<ClimateReading>& readings) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& reading : readings) {
+        if (!appendLocked(reading)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ColumnarReadingStore::forEachSegment(const std::function<bool(const SegmentView&)>& visitor) const {
+    // Se toma una instantánea de las vistas: los mapeos no se liberan mientras
+    // haya recorridos en curso, así que el recorrido no bloquea a los anexados
+    std::vector<ScanSpan> spans;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& segment : segments) {
+            if (!segment.sealed) {
+                SegmentView view = makeView(segment);
+                ScanSpan span = { view, 0, view.count, nullptr, 0, false };
+                spans.push_back(span);
+                continue;
+            }
+            const SealedHeader* header = static_cast<const SealedHeader*>(segment.base);
+            const SealedBlock* blocks = reinterpret_cast<const SealedBlock*>(header + 1);
+            uint64_t firstId = segment.firstId;
+            for (uint32_t b = 0; b < header->blockCount; ++b) {
+                ScanSpan span = { SegmentView(), 0, blocks[b].rows,
+                                  static_cast<const uint8_t*>(segment.base) + blocks[b].offset, blocks[b].size, false };
+                span.view.count = blocks[b].rows;
+                span.view.firstId = firstId;
+                firstId += blocks[b].rows;
+                spans.push_back(span);
+            }
+        }
+        beginScan();
+    }
+
+    BlockBuffer buffer;
+    for (const auto& span : spans) {
+        SegmentView view = span.view;
+        if (span.packed && !buffer.decode(span, view)) {
+            LOG_ERROR("ColumnarReadingStore", "Bloque comprimido dañado", "firstId", span.view.firstId);
+            continue;
+        }
+        if (view.count > 0 && !visitor(view)) {
+            break;
+        }
+    }
+    endScan();
+}
+
+void ColumnarReadingStore::ensureIndex(Segment& segment) {
+    if (segment.indexBuilt) {
+        return;
+    }
+
+    const SegmentHeader* header = headerOf(static_cast<const void*>(segment.base));
+    const int64_t* timestamps = makeView(segment).timestamps;
+    size_t count = static_cast<size_t>(header->count);
+    bool sorted = !(header->flags & SEGMENT_UNSORTED);
+
+    segment.blockIndex.clear();
+    segment.blockIndex.reserve((count + INDEX_BLOCK_ROWS - 1) / INDEX_BLOCK_ROWS);
+    for (size_t begin = 0; begin < count; begin += INDEX_BLOCK_ROWS) {
+        size_t end = std::min(count, begin + INDEX_BLOCK_ROWS);
+        BlockRange block = { timestamps[begin], timestamps[end - 1] };
+        if (!sorted) {
+            // Sin orden hay que recorrer el bloque; ordenado bastan los extremos
+            for (size_t i = begin; i < end; ++i) {
+                block.minTimestamp = std::min(block.minTimestamp, timestamps[i]);
+                block.maxTimestamp = std::max(block.maxTimestamp, timestamps[i]);
+            }
+        }
+        segment.blockIndex.push_back(block);
+    }
+    segment.indexBuilt = true;
+}
+
+void ColumnarReadingStore::forEachInRange(int64_t startTime, int64_t endTime,
+                                          const std::function<bool(const SegmentView&, size_t, size_t)>& visitor,
+                                          bool newestFirst) {
+    std::vector<ScanSpan> spans;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& segment : segments) {
+            if (segment.sealed) {
+                const SealedHeader* header = static_cast<const SealedHeader*>(segment.base);
+                if (header->count == 0 || header->maxTimestamp < startTime || header->minTimestamp > endTime) {
+                    continue;
+                }
+                // El directorio guarda el rango de cada bloque: sólo se descomprimen los que se solapan
+                const SealedBlock* blocks = reinterpret_cast<const SealedBlock*>(header + 1);
+                const bool sorted = !(header->flags & SEGMENT_UNSORTED);
+                uint64_t firstId = segment.firstId;
+                for (uint32_t b = 0; b < header->blockCount; ++b) {
+                    if (blocks[b].maxTimestamp >= startTime && blocks[b].minTimestamp <= endTime) {
+                        ScanSpan span = { SegmentView(), 0, blocks[b].rows,
+                                          static_cast<const uint8_t*>(segment.base) + blocks[b].offset,
+                                          blocks[b].size, sorted };
+                        span.view.count = blocks[b].rows;
+                        span.view.firstId = firstId;
+                        spans.push_back(span);
+                    }
+                    firstId += blocks[b].rows;
+                }
+                continue;
+            }
+
+            const SegmentHeader* header = headerOf(static_cast<const void*>(segment.base));
+            if (header->count == 0 || header->maxTimestamp < startTime || header->minTimestamp > endTime) {
+                continue;
+            }
+
+            ensureIndex(segment);
+            SegmentView view = makeView(segment);
+            const std::vector<BlockRange>& blocks = segment.blockIndex;
+
+            if (!(header->flags & SEGMENT_UNSORTED)) {
+                // Búsqueda binaria sobre los bloques y luego dentro del bloque
+                size_t firstBlock = std::lower_bound(blocks.begin(), blocks.end(), startTime,
+                    [](const BlockRange& b, int64_t t) { return b.maxTimestamp < t; }) - blocks.begin();
+                size_t lastBlock = std::upper_bound(blocks.begin(), blocks.end(), endTime,
+                    [](int64_t t, const BlockRange& b) { return t < b.minTimestamp; }) - blocks.begin();
+                if (firstBlock >= lastBlock) {
+                    continue;
+                }
+
+                size_t lo = firstBlock * INDEX_BLOCK_ROWS;
+                size_t hi = std::min(view.count, lastBlock * INDEX_BLOCK_ROWS);
+                size_t begin = std::lower_bound(view.timestamps + lo,
+                                                view.timestamps + std::min(hi, lo + INDEX_BLOCK_ROWS),
+                                                startTime) - view.timestamps;
+                size_t endLo = std::max(begin, (lastBlock - 1) * INDEX_BLOCK_ROWS);
+                size_t end = std::upper_bound(view.timestamps + endLo, view.timestamps + hi,
+                                              endTime) - view.timestamps;
+                if (begin < end) {
+                    ScanSpan span = { view, begin, end, nullptr, 0, false };
+                    spans.push_back(span);
+                }
+            } else {
+                for (size_t b = 0; b < blocks.size(); ++b) {
+                    if (blocks[b].maxTimestamp < startTime || blocks[b].minTimestamp > endTime) {
+                        continue;
+                    }
+                    ScanSpan span = { view, b * INDEX_BLOCK_ROWS,
+                                      std::min(view.count, (b + 1) * INDEX_BLOCK_ROWS), nullptr, 0, false };
+                    spans.push_back(span);
+                }
+            }
+        }
+        beginScan();
+    }
+
+    BlockBuffer buffer;
+    for (size_t n = 0; n < spans.size(); ++n) {
+        const ScanSpan& span = spans[newestFirst ? spans.size() - 1 - n : n];
+        SegmentView view = span.view;
+        size_t begin = span.begin;
+        size_t end = span.end;
+        if (span.packed) {
+            if (!buffer.decode(span, view)) {
+                LOG_ERROR("ColumnarReadingStore", "Bloque comprimido dañado", "firstId", span.view.firstId);
+                continue;
+            }
+            if (span.trim) {
+                begin = std::lower_bound(view.timestamps, view.timestamps + end, startTime) - view.timestamps;
+                end = std::upper_bound(view.timestamps + begin, view.timestamps + end, endTime) - view.timestamps;
+                if (begin >= end) {
+                    continue;
+                }
+            }
+        }
+        if (!visitor(view, begin, end)) {
+            break;
+        }
+    }
+    endScan();
+}
+
+void ColumnarReadingStore::flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& segment : segments) {
+        if (!segment.sealed) {
+            msync(segment.base, segment.mappedSize, MS_ASYNC);
+        }
+    }
+}
+
+uint64_t ColumnarReadingStore::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return totalRows;
+}
+
+size_t ColumnarReadingStore::segmentCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return segments.size();
+}
+
+bool ColumnarReadingStore::isOpen() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !segments.empty();
+}
+
+size_t ColumnarReadingStore::sealedSegmentCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t count = 0;
+    for (const auto& segment : segments) {
+        count += segment.sealed ? 1 : 0;
+    }
+    return count;
+}
+
+uint64_t ColumnarReadingStore::sealedBytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t bytes = 0;
+    for (const auto& segment : segments) {
+        bytes += segment.sealed ? segment.mappedSize : 0;
+    }
+    return bytes;
+}
@@ -0,0 +1,93 @@
+#include "../include/CommandCoalescer.h"
+#include "../include/Logger.h"
+
+CommandCoalescer::CommandCoalescer(std::chrono::milliseconds coalesceWindow, FlushCallback flushCallback)
+    : window(coalesceWindow), onFlush(flushCallback), stats(), sentBatches(0) {}
+
+void CommandCoalescer::send(Batch& batch, CoalescerStats& counters) {
+    bool sent = false;
+    for (const auto& entry : batch.deltas) {
+        IMSForecast* target = entry.first.first;
+        const int net = entry.second;
+        bool accepted = true;
+        if (net == 0) {
+            ++counters.cancelled;
+        } else {
+            if (entry.first.second == AlertMetric::TEMPERATURE) {
+                accepted = net > 0 ? target->upTemp(net) : target->downTemp(-net);
+            } else {
+                accepted = net > 0 ? target->upHumidity(net) : target->downHumidity(-net);
+            }
+            ++counters.apiCalls;
+            if (accepted) {
+                sent = true;
+            } else {
+                ++counters.failures;
+            }
+        }
+        batch.results[entry.first] = accepted;
+    }
+
+    if (sent && onFlush) {
+        onFlush();
+    }
+}
+
+bool CommandCoalescer::submit(IMSForecast* target, AlertMetric metric, int delta) {
+    const Key key(target, metric);
+    std::unique_lock<std::mutex> lock(mutex);
+    ++stats.submitted;
+
+    if (open) {
+        // Se suma al lote abierto y espera a que lo envíe quien lo abrió
+        std::shared_ptr<Batch> batch = open;
+        batch->deltas[key] += delta;
+        batchDone.wait(lock, [&batch]() { return batch->done; });
+        return batch->results.at(key);
+    }
+
+    std::shared_ptr<Batch> batch = std::make_shared<Batch>();
+    batch->deltas[key] = delta;
+    open = batch;
+
+    // Quien abre el lote espera la ventana mientras llegan otros comandos
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + window;
+    while (std::chrono::steady_clock::now() < deadline) {
+        batchDone.wait_until(lock, deadline);
+    }
+    open.reset();
+    const uint64_t turn = stats.batches++;
+
+    // Los lotes se envían en el orden en que se cerraron
+    batchDone.wait(lock, [this, turn]() { return sentBatches == turn; });
+    lock.unlock();
+
+    CoalescerStats counters = CoalescerStats();
+    send(*batch, counters);
+    LOG_DEBUG("CommandCoalescer", "Lote enviado", "keys", batch->deltas.size(), "api_calls", counters.apiCalls);
+
+    lock.lock();
+    stats.apiCalls += counters.apiCalls;
+    stats.cancelled += counters.cancelled;
+    stats.failures += counters.failures;
+    ++sentBatches;
+    batch->done = true;
+    lock.unlock();
+    batchDone.notify_all();
+    return batch->results.at(key);
+}
+
+CoalescerStats CommandCoalescer::getStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void CommandCoalescer::setWindow(std::chrono::milliseconds coalesceWindow) {
+    std::lock_guard<std::mutex> lock(mutex);
+    window = coalesceWindow.count() > 0 ? coalesceWindow : std::chrono::milliseconds(0);
+}
+
+std::chrono::milliseconds CommandCoalescer::getWindow() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return window;
+}
@@ -1,42 +1,76 @@
 #include "../include/EmailService.h"
-#include <iostream>
+#include "../include/SmtpTransportMock.h"
+#include "../include/Logger.h"
+#include "../include/MetricsRegistry.h"
 #include <sstream>
 
 EmailService::EmailService(const std::string& server, int port, 
                           const std::string& email, const std::string& password)
     : smtpServer(server), smtpPort(port), senderEmail(email), 
-      senderPassword(password) {
+      senderPassword(password), transport(new SmtpTransportMock()),
+      pendingCount(0), queueCapacity(0),
+      overflowPolicy(EmailOverflowPolicy::DROP_LOWEST_SEVERITY),
+      asyncRunning(false), stopping(false), enqueuedCount(0), sentCount(0),
+      failedCount(0), droppedCount(0) {
     
     // Agregar destinatarios por defecto
     recipients.push_back("admin@empresa.com");
     recipients.push_back("tech@empresa.com");
     
-    std::cout << "EmailService: Inicializado con servidor " << smtpServer 
-              << ":" << smtpPort << std::endl;
+    LOG_INFO("EmailService", "Inicializado", "server", smtpServer, "port", smtpPort);
 }
 
 EmailService::~EmailService() {
-    std::cout << "EmailService: Destruyendo servicio de email" << std::endl;
+    stopAsync();
+    LOG_INFO("EmailService", "Destruyendo servicio de email");
+}
+
+void EmailService::setTransport(IEmailTransport* newTransport) {
+    if (newTransport != nullptr) {
+        transport.reset(newTransport);
+    }
+}
+
+std::string EmailService::buildSubject(const Alert& alert) {
+    return "ALERTA DATACENTER - " + alert.getSeverityString();
+}
+
+std::string EmailService::buildBody(const Alert& alert) {
+    std::ostringstream body;
+    body << "ALERTA DEL SISTEMA DE CLIMA DEL DATACENTER\n\n";
+    body << "Severidad: " << alert.getSeverityString() << "\n";
+    body << "Mensaje: " << alert.getMessage() << "\n";
+    body << "Timestamp: " << alert.getDateTimeString() << "\n\n";
+    body << "Este es un mensaje automático del sistema de control de clima.\n";
+    return body.str();
 }
 
 bool EmailService::sendEmail(const std::string& to, const std::string& subject, const std::string& body) {
-    // Simular envío de email
-    std::cout << "EmailService: Enviando email..." << std::endl;
-    std::cout << "  De: " << senderEmail << std::endl;
-    std::cout << "  Para: " << to << std::endl;
-    std::cout << "  Asunto: " << subject << std::endl;
-    std::cout << "  Cuerpo: " << body << std::endl;
-    std::cout << "EmailService: Email enviado exitosamente (simulado)" << std::endl;
-    
-    return true;
+    static LatencyHistogram& latency = MetricsRegistry::instance().histogram(
+        "clima_email_send_duration_seconds", "Duración del envío de un email por el transporte SMTP");
+    static MetricCounter& failures = MetricsRegistry::instance().counter(
+        "clima_email_send_failures_total", "Emails que el transporte SMTP no pudo enviar");
+
+    ScopedLatency timer(latency);
+    bool sent = transport->send(senderEmail, to, subject, body);
+    if (!sent) {
+        failures.increment();
+    }
+    return sent;
 }
 
 bool EmailService::sendAlert(const Alert& alert) {
-    std::cout << "EmailService: Enviando alerta a todos los destinatarios" << std::endl;
+    std::vector<std::string> targets = getRecipients();
+    LOG_DEBUG("EmailService", "Enviando alerta a todos los destinatarios", "recipients", targets.size(),
+              "severity", alert.getSeverityString());
+    
+    // El email se arma una sola vez para todos los destinatarios
+    std::string subject = buildSubject(alert);
+    std::string body = buildBody(alert);
     
     bool allSent = true;
-    for (const auto& recipient : recipients) {
-        if (!sendAlert(alert, recipient)) {
+    for (const auto& recipient : targets) {
+        if (!sendEmail(recipient, subject, body)) {
             allSent = false;
         }
     }
@@ -45,53 +79,188 @@ bool EmailService::sendAlert(const Alert& alert) {
 }
 
 bool EmailService::sendAlert(const Alert& alert, const std::string& recipientEmail) {
-    std::string subject = "ALERTA DATACENTER - " + alert.getSeverityString();
+    return sendEmail(recipientEmail, buildSubject(alert), buildBody(alert));
+}
+
+bool EmailService::startAsync(size_t workerCount, size_t capacity, EmailOverflowPolicy policy) {
+    if (workerCount == 0 || capacity == 0) {
+        LOG_ERROR("EmailService", "Parámetros inválidos para el modo asíncrono",
+                  "workers", workerCount, "capacity", capacity);
+        return false;
+    }
     
-    std::ostringstream body;
-    body << "ALERTA DEL SISTEMA DE CLIMA DEL DATACENTER\n\n";
-    body << "Severidad: " << alert.getSeverityString() << "\n";
-    body << "Mensaje: " << alert.getMessage() << "\n";
-    body << "Timestamp: " << alert.getDateTimeString() << "\n\n";
-    body << "Este es un mensaje automático del sistema de control de clima.\n";
+    std::lock_guard<std::mutex> lock(queueMutex);
+    if (asyncRunning) {
+        return false;
+    }
+    
+    queueCapacity = capacity;
+    overflowPolicy = policy;
+    stopping = false;
+    asyncRunning = true;
+    for (size_t i = 0; i < workerCount; ++i) {
+        senders.push_back(std::thread(&EmailService::senderLoop, this));
+    }
     
-    return sendEmail(recipientEmail, subject, body.str());
+    LOG_INFO("EmailService", "Modo asíncrono iniciado", "workers", workerCount, "capacity", capacity,
+             "policy", policy == EmailOverflowPolicy::BLOCK ? "BLOCK" : "DROP_LOWEST_SEVERITY");
+    return true;
+}
+
+void EmailService::stopAsync() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (!asyncRunning) {
+            return;
+        }
+        stopping = true;
+    }
+    notEmpty.notify_all();
+    notFull.notify_all();
+    
+    // Los hilos terminan recién cuando la cola queda vacía
+    for (auto& sender : senders) {
+        sender.join();
+    }
+    senders.clear();
+    
+    std::lock_guard<std::mutex> lock(queueMutex);
+    asyncRunning = false;
+    LOG_INFO("EmailService", "Modo asíncrono detenido", "sent", sentCount.load(),
+             "dropped", droppedCount.load());
+}
+
+bool EmailService::isAsync() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return asyncRunning;
+}
+
+bool EmailService::enqueueAlert(const Alert& alert) {
+    const size_t level = static_cast<size_t>(alert.getSeverity());
+    
+    std::unique_lock<std::mutex> lock(queueMutex);
+    if (!asyncRunning || stopping) {
+        lock.unlock();
+        return sendAlert(alert);
+    }
+    
+    if (pendingCount >= queueCapacity) {
+        if (overflowPolicy == EmailOverflowPolicy::BLOCK) {
+            notFull.wait(lock, [this]() { return pendingCount < queueCapacity || stopping; });
+            if (pendingCount >= queueCapacity) {
+                ++droppedCount;
+                return false;
+            }
+        } else {
+            // Se descarta la alerta más antigua de menor severidad; la nueva
+            // solo se descarta si es de menor severidad que todas las encoladas
+            size_t lowest = 0;
+            while (pending[lowest].empty()) {
+                ++lowest;
+            }
+            ++droppedCount;
+            if (level < lowest) {
+                return false;
+            }
+            pending[lowest].pop_front();
+            --pendingCount;
+        }
+    }
+    
+    pending[level].push_back(alert);
+    ++pendingCount;
+    ++enqueuedCount;
+    lock.unlock();
+    
+    notEmpty.notify_one();
+    return true;
+}
+
+void EmailService::senderLoop() {
+    const size_t levels = sizeof(pending) / sizeof(pending[0]);
+    
+    while (true) {
+        Alert alert;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            notEmpty.wait(lock, [this]() { return pendingCount > 0 || stopping; });
+            if (pendingCount == 0) {
+                return;
+            }
+            
+            // Primero las alertas de mayor severidad, en orden de llegada
+            size_t level = levels - 1;
+            while (pending[level].empty()) {
+                --level;
+            }
+            alert = pending[level].front();
+            pending[level].pop_front();
+            --pendingCount;
+        }
+        notFull.notify_one();
+        
+        if (sendAlert(alert)) {
+            ++sentCount;
+        } else {
+            ++failedCount;
+        }
+    }
+}
+
+EmailQueueStats EmailService::getQueueStats() {
+    EmailQueueStats stats;
+    stats.enqueued = enqueuedCount.load();
+    stats.sent = sentCount.load();
+    stats.failed = failedCount.load();
+    stats.dropped = droppedCount.load();
+    
+    std::lock_guard<std::mutex> lock(queueMutex);
+    stats.pending = pendingCount;
+    return stats;
 }
 
 void EmailService::addRecipient(const std::string& email) {
+    std::lock_guard<std::mutex> lock(recipientsMutex);
     // Verificar si el email ya existe
     for (const auto& recipient : recipients) {
         if (recipient == email) {
-            std::cout << "EmailService: El email " << email << " ya está en la lista" << std::endl;
+            LOG_WARN("EmailService", "El email ya está en la lista", "email", email);
             return;
         }
     }
     
     recipients.push_back(email);
-    std::cout << "EmailService: Agregado destinatario " << email << std::endl;
+    LOG_INFO("EmailService", "Agregado destinatario", "email", email);
 }
 
 void EmailService::removeRecipient(const std::string& email) {
+    std::lock_guard<std::mutex> lock(recipientsMutex);
     for (auto it = recipients.begin(); it != recipients.end(); ++it) {
         if (*it == email) {
             recipients.erase(it);
-            std::cout << "EmailService: Eliminado destinatario " << email << std::endl;
+            LOG_INFO("EmailService", "Eliminado destinatario", "email", email);
             return;
         }
     }
     
-    std::cout << "EmailService: El email " << email << " no se encontró en la lista" << std::endl;
+    LOG_WARN("EmailService", "El email no se encontró en la lista", "email", email);
 }
 
 std::vector<std::string> EmailService::getRecipients() const {
+    std::lock_guard<std::mutex> lock(recipientsMutex);
     return recipients;
 }
 
 void EmailService::setRecipients(const std::vector<std::string>& newRecipients) {
-    recipients = newRecipients;
-    std::cout << "EmailService: Lista de destinatarios actualizada" << std::endl;
+    {
+        std::lock_guard<std::mutex> lock(recipientsMutex);
+        recipients = newRecipients;
+    }
+    LOG_INFO("EmailService", "Lista de destinatarios actualizada", "recipients", newRecipients.size());
 }
 
 bool EmailService::isValidConfiguration() const {
+    std::lock_guard<std::mutex> lock(recipientsMutex);
     return !smtpServer.empty() && smtpPort > 0 && 
            !senderEmail.empty() && !senderPassword.empty() && 
            !recipients.empty();
@@ -0,0 +1,88 @@
+#include "../include/ForecastProtocol.h"
+#include <cstring>
+
+const size_t ForecastProtocol::REQUEST_SIZE;
+const size_t ForecastProtocol::RESPONSE_SIZE;
+
+namespace {
+
+// Little-endian byte a byte, como en BinaryRecordCodec
+inline void put32(uint8_t* out, uint32_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+    out[2] = static_cast<uint8_t>(value >> 16);
+    out[3] = static_cast<uint8_t>(value >> 24);
+}
+
+inline void put64(uint8_t* out, uint64_t value) {
+    put32(out, static_cast<uint32_t>(value));
+    put32(out + 4, static_cast<uint32_t>(value >> 32));
+}
+
+inline uint32_t get32(const uint8_t* in) {
+    return in[0] | (in[1] << 8) | (in[2] << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+inline uint64_t get64(const uint8_t* in) {
+    return get32(in) | (static_cast<uint64_t>(get32(in + 4)) << 32);
+}
+
+inline void putFloat(uint8_t* out, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    put32(out, bits);
+}
+
+inline float getFloat(const uint8_t* in) {
+    const uint32_t bits = get32(in);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+void ForecastProtocol::encodeRequest(const ForecastRequest& request, uint8_t* out) {
+    put32(out, request.id);
+    out[4] = static_cast<uint8_t>(request.op);
+    out[5] = 0;
+    out[6] = 0;
+    out[7] = 0;
+    put32(out + 8, static_cast<uint32_t>(request.arg));
+}
+
+ForecastRequest ForecastProtocol::decodeRequest(const uint8_t* in) {
+    ForecastRequest request;
+    request.id = get32(in);
+    request.op = static_cast<ForecastOp>(in[4]);
+    request.arg = static_cast<int32_t>(get32(in + 8));
+    return request;
+}
+
+void ForecastProtocol::encodeResponse(const ForecastResponse& response, uint8_t* out) {
+    put32(out, response.id);
+    out[4] = static_cast<uint8_t>(response.op);
+    out[5] = static_cast<uint8_t>(response.status);
+    out[6] = 0;
+    out[7] = 0;
+    put32(out + 8, static_cast<uint32_t>(response.snapshot.sensorId));
+    putFloat(out + 12, response.snapshot.temperature);
+    putFloat(out + 16, response.snapshot.humidity);
+    put64(out + 20, static_cast<uint64_t>(static_cast<int64_t>(response.snapshot.timestamp)));
+}
+
+ForecastResponse ForecastProtocol::decodeResponse(const uint8_t* in) {
+    ForecastResponse response;
+    response.id = get32(in);
+    response.op = static_cast<ForecastOp>(in[4]);
+    response.status = static_cast<ForecastStatus>(in[5]);
+    response.snapshot.sensorId = static_cast<int32_t>(get32(in + 8));
+    response.snapshot.temperature = getFloat(in + 12);
+    response.snapshot.humidity = getFloat(in + 16);
+    response.snapshot.timestamp = static_cast<time_t>(static_cast<int64_t>(get64(in + 20)));
+    return response;
+}
+
+bool ForecastProtocol::isRead(ForecastOp op) {
+    return op == ForecastOp::READ_TEMP || op == ForecastOp::READ_HUMIDITY || op == ForecastOp::READ_SNAPSHOT;
+}
@@ -0,0 +1,257 @@
+#include "../include/GorillaCodec.h"
+#include <cstring>
+#include <endian.h>
+
+const size_t GorillaEncoder::SERIES_SLOTS;
+
+namespace {
+
+/// Bits del prefijo del delta del delta según la cantidad de unos iniciales
+const unsigned TIMESTAMP_PREFIX_BITS[6] = { 1, 2, 3, 4, 5, 5 };
+/// Bits del valor según la cantidad de unos iniciales del prefijo
+const unsigned TIMESTAMP_PAYLOAD_BITS[6] = { 0, 7, 9, 12, 32, 64 };
+
+const uint8_t NO_WINDOW = 0xFF;
+
+inline uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+inline uint32_t floatBits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline float bitsFloat(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Las restas se hacen sin signo: un historial desordenado puede tener
+// deltas que desbordan int64
+inline int64_t wrappingSub(int64_t a, int64_t b) {
+    return static_cast<int64_t>(static_cast<uint64_t>(a) - static_cast<uint64_t>(b));
+}
+
+inline int64_t wrappingAdd(int64_t a, int64_t b) {
+    return static_cast<int64_t>(static_cast<uint64_t>(a) + static_cast<uint64_t>(b));
+}
+
+inline size_t seriesSlot(int32_t sensorId) {
+    return static_cast<uint32_t>(sensorId) & (GorillaEncoder::SERIES_SLOTS - 1);
+}
+
+void resetSeries(GorillaSeriesState* series) {
+    for (size_t i = 0; i < GorillaEncoder::SERIES_SLOTS; ++i) {
+        series[i].temperature = 0;
+        series[i].humidity = 0;
+        series[i].temperatureLeading = NO_WINDOW;
+        series[i].temperatureTrailing = 0;
+        series[i].humidityLeading = NO_WINDOW;
+        series[i].humidityTrailing = 0;
+    }
+}
+
+} // namespace
+
+GorillaEncoder::GorillaEncoder(std::vector<uint8_t>& output)
+    : out(output), bitBuffer(0), bitCount(0), rows(0), previousTimestamp(0), previousDelta(0),
+      previousSensor(0), sensorStride(0) {
+    resetSeries(series);
+}
+
+void GorillaEncoder::writeBits(uint64_t value, unsigned n) {
+    bitBuffer = (bitBuffer << n) | (value & ((1ULL << n) - 1));
+    bitCount += n;
+    while (bitCount >= 8) {
+        bitCount -= 8;
+        out.push_back(static_cast<uint8_t>(bitBuffer >> bitCount));
+    }
+}
+
+void GorillaEncoder::writeValue(uint32_t bits, uint32_t& previous, uint8_t& leading, uint8_t& trailing) {
+    const uint32_t x = bits ^ previous;
+    previous = bits;
+    if (x == 0) {
+        writeBits(0, 1);
+        return;
+    }
+
+    const unsigned lead = static_cast<unsigned>(__builtin_clz(x));
+    const unsigned trail = static_cast<unsigned>(__builtin_ctz(x));
+    if (leading != NO_WINDOW && lead >= leading && trail >= trailing) {
+        writeBits(2, 2);
+        writeBits(x >> trailing, 32 - leading - trailing);
+    } else {
+        const unsigned length = 32 - lead - trail;
+        writeBits(3, 2);
+        writeBits(lead, 5);
+        writeBits(length - 1, 5);
+        writeBits(x >> trail, length);
+        leading = static_cast<uint8_t>(lead);
+        trailing = static_cast<uint8_t>(trail);
+    }
+}
+
+void GorillaEncoder::append(int64_t timestamp, float temperature, float humidity, int32_t sensorId) {
+    const int64_t delta = wrappingSub(timestamp, previousTimestamp);
+    const uint64_t dod = zigzag(wrappingSub(delta, previousDelta));
+    previousTimestamp = timestamp;
+    previousDelta = delta;
+    if (dod == 0) {
+        writeBits(0, 1);
+    } else if (dod < (1ULL << 7)) {
+        writeBits(2, 2);
+        writeBits(dod, 7);
+    } else if (dod < (1ULL << 9)) {
+        writeBits(6, 3);
+        writeBits(dod, 9);
+    } else if (dod < (1ULL << 12)) {
+        writeBits(14, 4);
+        writeBits(dod, 12);
+    } else if (dod < (1ULL << 32)) {
+        writeBits(30, 5);
+        writeBits(dod, 32);
+    } else {
+        writeBits(31, 5);
+        writeBits(dod >> 32, 32);
+        writeBits(dod, 32);
+    }
+
+    const int32_t stride = static_cast<int32_t>(static_cast<uint32_t>(sensorId) - static_cast<uint32_t>(previousSensor));
+    if (stride == sensorStride) {
+        writeBits(0, 1);
+    } else {
+        const uint64_t zz = zigzag(stride);
+        if (zz < (1ULL << 8)) {
+            writeBits(2, 2);
+            writeBits(zz, 8);
+        } else {
+            writeBits(3, 2);
+            writeBits(static_cast<uint32_t>(sensorId), 32);
+        }
+        sensorStride = stride;
+    }
+    previousSensor = sensorId;
+
+    GorillaSeriesState& state = series[seriesSlot(sensorId)];
+    writeValue(floatBits(temperature), state.temperature, state.temperatureLeading, state.temperatureTrailing);
+    writeValue(floatBits(humidity), state.humidity, state.humidityLeading, state.humidityTrailing);
+    ++rows;
+}
+
+void GorillaEncoder::finish() {
+    if (bitCount > 0) {
+        writeBits(0, 8 - bitCount);
+    }
+}
+
+GorillaDecoder::GorillaDecoder(const uint8_t* stream, size_t size, size_t rows)
+    : data(stream), dataSize(size), position(0), cache(0), available(0), rowsLeft(rows),
+      previousTimestamp(0), previousDelta(0), previousSensor(0), sensorStride(0) {
+    resetSeries(series);
+}
+
+void GorillaDecoder::refill() {
+    if (position + 8 <= dataSize) {
+        // Carga 8 bytes de una vez; los bits que sobran ya son los correctos
+        // y la próxima carga los vuelve a escribir iguales
+        uint64_t word;
+        memcpy(&word, data + position, sizeof(word));
+        cache |= be64toh(word) >> available;
+        const unsigned bytes = (63 - available) >> 3;
+        position += bytes;
+        available += bytes << 3;
+        return;
+    }
+    while (available <= 56) {
+        const uint64_t byte = position < dataSize ? data[position] : 0;
+        cache |= byte << (56 - available);
+        ++position;
+        available += 8;
+    }
+}
+
+inline uint64_t GorillaDecoder::readBits(unsigned n) {
+    const uint64_t value = cache >> (64 - n);
+    cache <<= n;
+    available -= n;
+    return value;
+}
+
+inline uint32_t GorillaDecoder::readValue(uint32_t& previous, uint8_t& leading, uint8_t& trailing) {
+    if ((cache >> 63) == 0) {
+        readBits(1);
+        return previous;
+    }
+    if (readBits(2) == 3) {
+        leading = static_cast<uint8_t>(readBits(5));
+        const unsigned length = static_cast<unsigned>(readBits(5)) + 1;
+        // Un flujo dañado puede declarar una ventana de más de 32 bits
+        trailing = static_cast<uint8_t>(leading + length <= 32 ? 32 - leading - length : 0);
+        previous ^= static_cast<uint32_t>(readBits(length)) << trailing;
+    } else {
+        const unsigned length = leading != NO_WINDOW && leading + trailing < 32 ? 32 - leading - trailing : 32;
+        previous ^= static_cast<uint32_t>(readBits(length)) << (length < 32 ? trailing : 0);
+    }
+    return previous;
+}
+
+size_t GorillaDecoder::read(int64_t* timestamps, float* temperatures, float* humidities, int32_t* sensorIds,
+                            size_t maxRows) {
+    const size_t count = maxRows < rowsLeft ? maxRows : rowsLeft;
+
+    for (size_t i = 0; i < count; ++i) {
+        refill();
+        if ((cache >> 63) == 0) {
+            readBits(1);
+        } else {
+            // Cantidad de unos iniciales del prefijo, como máximo 5
+            const unsigned ones = static_cast<unsigned>(__builtin_clzll(~cache | (1ULL << 58)));
+            readBits(TIMESTAMP_PREFIX_BITS[ones]);
+            uint64_t dod;
+            if (ones < 5) {
+                dod = readBits(TIMESTAMP_PAYLOAD_BITS[ones]);
+            } else {
+                dod = readBits(32) << 32;
+                refill();
+                dod |= readBits(32);
+            }
+            previousDelta = wrappingAdd(previousDelta, unzigzag(dod));
+        }
+        previousTimestamp = wrappingAdd(previousTimestamp, previousDelta);
+        timestamps[i] = previousTimestamp;
+
+        refill();
+        if ((cache >> 63) == 0) {
+            readBits(1);
+        } else if (readBits(2) == 2) {
+            sensorStride = static_cast<int32_t>(unzigzag(readBits(8)));
+        } else {
+            const int32_t sensor = static_cast<int32_t>(static_cast<uint32_t>(readBits(32)));
+            sensorStride = static_cast<int32_t>(static_cast<uint32_t>(sensor) - static_cast<uint32_t>(previousSensor));
+        }
+        previousSensor = static_cast<int32_t>(static_cast<uint32_t>(previousSensor) + static_cast<uint32_t>(sensorStride));
+        sensorIds[i] = previousSensor;
+
+        GorillaSeriesState& state = series[seriesSlot(previousSensor)];
+        refill();
+        temperatures[i] = bitsFloat(readValue(state.temperature, state.temperatureLeading, state.temperatureTrailing));
+        refill();
+        humidities[i] = bitsFloat(readValue(state.humidity, state.humidityLeading, state.humidityTrailing));
+    }
+
+    rowsLeft -= count;
+    return count;
+}
+
+bool GorillaDecoder::isValid() const {
+    // Bits consumidos: los cargados en cache menos los que quedan sin leer
+    return position * 8 - available <= dataSize * 8;
+}
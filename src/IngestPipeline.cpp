@@ -0,0 +1,246 @@
+#include "../include/IngestPipeline.h"
+#include "../include/Logger.h"
+#include "../include/MetricsRegistry.h"
+
+const int IngestPipeline::STORAGE_ATTEMPTS;
+
+IngestPipeline::IngestPipeline(StorageStage storage, AlertStage alerts,
+                               size_t capacity, size_t batchSize)
+    : storageStage(storage), alertStage(alerts), storageQueue(capacity), alertQueue(capacity),
+      maxBatch(batchSize > 0 ? batchSize : 1), running(false), storageDone(false), activeSubmits(0),
+      submittedCount(0), rejectedCount(0), backpressureCount(0), storedCount(0), storageRetryCount(0),
+      storageFailureCount(0), droppedCount(0), storageBatchCount(0), evaluatedCount(0), alertBatchCount(0),
+      latencySumMicros(0), latencyMaxMicros(0),
+      sensorToDiskLatency(MetricsRegistry::instance().histogram(
+          "clima_ingest_sensor_to_disk_seconds",
+          "Latencia de una lectura desde que entra al pipeline de ingesta hasta que queda guardada")) {
+    storageSignal.sleeping = false;
+    alertSignal.sleeping = false;
+}
+
+IngestPipeline::~IngestPipeline() {
+    stop();
+}
+
+void IngestPipeline::start() {
+    if (running.exchange(true)) {
+        return;
+    }
+    storageDone = false;
+    storageThread = std::thread(&IngestPipeline::storageLoop, this);
+    alertThread = std::thread(&IngestPipeline::alertLoop, this);
+    LOG_INFO("IngestPipeline", "Iniciado", "capacity", storageQueue.capacity(), "batch", maxBatch);
+}
+
+void IngestPipeline::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+
+    // Primero se vacía el almacenamiento y recién después las alertas
+    wake(storageSignal);
+    storageThread.join();
+    storageDone = true;
+    wake(alertSignal);
+    alertThread.join();
+    LOG_INFO("IngestPipeline", "Detenido", "stored", storedCount.load(), "evaluated", evaluatedCount.load(),
+             "dropped", droppedCount.load());
+}
+
+bool IngestPipeline::isRunning() const {
+    return running.load();
+}
+
+bool IngestPipeline::enqueue(const ClimateReading& reading, bool wait) {
+    Entry entry;
+    entry.reading = reading;
+    entry.submittedAt = std::chrono::steady_clock::now();
+
+    // Registrarse antes de mirar running: stop() apaga running y la etapa de
+    // almacenamiento no termina mientras quede un productor en curso
+    ++activeSubmits;
+    bool pushed = false;
+    bool waited = false;
+    while (running.load() && !(pushed = storageQueue.tryPush(entry)) && wait) {
+        if (!waited) {
+            ++backpressureCount;
+            waited = true;
+        }
+        wake(storageSignal);
+        std::this_thread::yield();
+    }
+    --activeSubmits;
+
+    if (!pushed) {
+        ++rejectedCount;
+        return false;
+    }
+    ++submittedCount;
+    wake(storageSignal);
+    return true;
+}
+
+bool IngestPipeline::trySubmit(const ClimateReading& reading) {
+    return enqueue(reading, false);
+}
+
+bool IngestPipeline::submit(const ClimateReading& reading) {
+    return enqueue(reading, true);
+}
+
+void IngestPipeline::waitForWork(StageSignal& signal) {
+    std::unique_lock<std::mutex> lock(signal.mutex);
+    signal.sleeping = true;
+    // Espera acotada: un productor puede publicar justo antes de que se marque sleeping
+    signal.ready.wait_for(lock, std::chrono::milliseconds(1));
+    signal.sleeping = false;
+}
+
+void IngestPipeline::wake(StageSignal& signal) {
+    if (signal.sleeping.load()) {
+        std::lock_guard<std::mutex> lock(signal.mutex);
+        signal.ready.notify_one();
+    }
+}
+
+bool IngestPipeline::storeWithRetry(const std::vector<ClimateReading>& batch) {
+    std::chrono::milliseconds backoff(10);
+    for (int attempt = 1; attempt <= STORAGE_ATTEMPTS; ++attempt) {
+        if (storageStage(batch)) {
+            return true;
+        }
+        if (attempt < STORAGE_ATTEMPTS) {
+            LOG_WARN("IngestPipeline", "No se pudo guardar el lote, se reintenta", "readings", batch.size(),
+                     "attempt", attempt, "backoff_ms", static_cast<long long>(backoff.count()));
+            ++storageRetryCount;
+            std::this_thread::sleep_for(backoff);
+            backoff *= 2;
+        }
+    }
+    return false;
+}
+
+void IngestPipeline::storageLoop() {
+    std::vector<Entry> entries;
+    std::vector<ClimateReading> batch;
+    entries.reserve(maxBatch);
+    batch.reserve(maxBatch);
+
+    while (true) {
+        entries.clear();
+        if (storageQueue.popBatch(entries, maxBatch) == 0) {
+            if (running.load() || activeSubmits.load() != 0) {
+                waitForWork(storageSignal);
+                continue;
+            }
+            // Sin productores en curso, todo lo encolado ya es visible: última pasada
+            if (storageQueue.popBatch(entries, maxBatch) == 0) {
+                return;
+            }
+        }
+
+        batch.clear();
+        for (const auto& entry : entries) {
+            batch.push_back(entry.reading);
+        }
+
+        if (!storeWithRetry(batch)) {
+            // Una lectura sin guardar no se evalúa: las alertas deben poder consultarse en el historial
+            ++storageFailureCount;
+            droppedCount += batch.size();
+            LOG_ERROR("IngestPipeline", "Lote descartado tras agotar los reintentos", "readings", batch.size(),
+                      "attempts", STORAGE_ATTEMPTS);
+            continue;
+        }
+
+        // Latencia submit -> guardado, medida tras confirmar el lote
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        uint64_t batchMax = 0;
+        uint64_t batchSum = 0;
+        for (const auto& entry : entries) {
+            const std::chrono::steady_clock::duration elapsed = now - entry.submittedAt;
+            sensorToDiskLatency.record(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+            uint64_t latency = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+            batchSum += latency;
+            if (latency > batchMax) {
+                batchMax = latency;
+            }
+        }
+        latencySumMicros += batchSum;
+        if (batchMax > latencyMaxMicros.load()) {
+            latencyMaxMicros = batchMax;
+        }
+        storedCount += batch.size();
+        ++storageBatchCount;
+
+        if (!alertStage) {
+            continue;
+        }
+        bool waited = false;
+        for (const auto& reading : batch) {
+            while (!alertQueue.tryPush(reading)) {
+                if (!waited) {
+                    ++backpressureCount;
+                    waited = true;
+                }
+                wake(alertSignal);
+                std::this_thread::yield();
+            }
+        }
+        wake(alertSignal);
+    }
+}
+
+void IngestPipeline::alertLoop() {
+    std::vector<ClimateReading> batch;
+    batch.reserve(maxBatch);
+
+    while (true) {
+        batch.clear();
+        if (alertQueue.popBatch(batch, maxBatch) == 0) {
+            if (storageDone.load()) {
+                return;
+            }
+            waitForWork(alertSignal);
+            continue;
+        }
+
+        alertStage(batch);
+        evaluatedCount += batch.size();
+        ++alertBatchCount;
+    }
+}
+
+void IngestPipeline::drain() {
+    // Las lecturas descartadas no llegan a ninguna de las dos etapas
+    const uint64_t target = submittedCount.load();
+    while (running.load() &&
+           (storedCount.load() + droppedCount.load() < target ||
+            (alertStage && evaluatedCount.load() + droppedCount.load() < target))) {
+        wake(storageSignal);
+        wake(alertSignal);
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+IngestPipeline::Stats IngestPipeline::getStats() const {
+    Stats stats;
+    stats.submitted = submittedCount.load();
+    stats.rejected = rejectedCount.load();
+    stats.backpressureWaits = backpressureCount.load();
+    stats.stored = storedCount.load();
+    stats.storageRetries = storageRetryCount.load();
+    stats.storageFailures = storageFailureCount.load();
+    stats.dropped = droppedCount.load();
+    stats.storageBatches = storageBatchCount.load();
+    stats.evaluated = evaluatedCount.load();
+    stats.alertBatches = alertBatchCount.load();
+    stats.storageQueueDepth = storageQueue.sizeApprox();
+    stats.alertQueueDepth = alertQueue.sizeApprox();
+    stats.meanStorageBatch = stats.storageBatches ? static_cast<double>(stats.stored) / stats.storageBatches : 0.0;
+    stats.meanSensorToDiskMs = stats.stored ? latencySumMicros.load() / 1000.0 / stats.stored : 0.0;
+    stats.maxSensorToDiskMs = latencyMaxMicros.load() / 1000.0;
+    return stats;
+}
@@ -0,0 +1,84 @@
+#include "../include/InstrumentedForecast.h"
+
+namespace {
+
+const char* const LATENCY_NAME = "clima_forecast_request_duration_seconds";
+const char* const LATENCY_HELP = "Duración de las llamadas a la API MS-Forecast";
+const char* const ERRORS_NAME = "clima_forecast_errors_total";
+const char* const ERRORS_HELP = "Llamadas a la API MS-Forecast fallidas";
+
+} // namespace
+
+InstrumentedForecast::InstrumentedForecast(IMSForecast* forecast, MetricsRegistry& metrics)
+    : inner(forecast),
+      upTempLatency(metrics.histogram(LATENCY_NAME, LATENCY_HELP, "op=\"upTemp\"")),
+      downTempLatency(metrics.histogram(LATENCY_NAME, LATENCY_HELP, "op=\"downTemp\"")),
+      upHumidityLatency(metrics.histogram(LATENCY_NAME, LATENCY_HELP, "op=\"upHumidity\"")),
+      downHumidityLatency(metrics.histogram(LATENCY_NAME, LATENCY_HELP, "op=\"downHumidity\"")),
+      readTempLatency(metrics.histogram(LATENCY_NAME, LATENCY_HELP, "op=\"readTemp\"")),
+      readHumidityLatency(metrics.histogram(LATENCY_NAME, LATENCY_HELP, "op=\"readHumidity\"")),
+      readSnapshotLatency(metrics.histogram(LATENCY_NAME, LATENCY_HELP, "op=\"readSnapshot\"")),
+      readSnapshotsLatency(metrics.histogram(LATENCY_NAME, LATENCY_HELP, "op=\"readSnapshots\"")),
+      controlErrors(metrics.counter(ERRORS_NAME, ERRORS_HELP, "op=\"control\"")),
+      batchErrors(metrics.counter(ERRORS_NAME, ERRORS_HELP, "op=\"readSnapshots\"")) {}
+
+bool InstrumentedForecast::upTemp(int x) {
+    ScopedLatency timer(upTempLatency);
+    bool ok = inner->upTemp(x);
+    if (!ok) {
+        controlErrors.increment();
+    }
+    return ok;
+}
+
+bool InstrumentedForecast::downTemp(int x) {
+    ScopedLatency timer(downTempLatency);
+    bool ok = inner->downTemp(x);
+    if (!ok) {
+        controlErrors.increment();
+    }
+    return ok;
+}
+
+bool InstrumentedForecast::upHumidity(int x) {
+    ScopedLatency timer(upHumidityLatency);
+    bool ok = inner->upHumidity(x);
+    if (!ok) {
+        controlErrors.increment();
+    }
+    return ok;
+}
+
+bool InstrumentedForecast::downHumidity(int x) {
+    ScopedLatency timer(downHumidityLatency);
+    bool ok = inner->downHumidity(x);
+    if (!ok) {
+        controlErrors.increment();
+    }
+    return ok;
+}
+
+float InstrumentedForecast::readTemp() const {
+    ScopedLatency timer(readTempLatency);
+    return inner->readTemp();
+}
+
+float InstrumentedForecast::readHumidity() const {
+    ScopedLatency timer(readHumidityLatency);
+    return inner->readHumidity();
+}
+
+ClimateSnapshot InstrumentedForecast::readSnapshot() const {
+    ScopedLatency timer(readSnapshotLatency);
+    return inner->readSnapshot();
+}
+
+bool InstrumentedForecast::readSnapshots(const std::vector<int>& sensorIds,
+                                         std::vector<ClimateSnapshot>& snapshots) const {
+    ScopedLatency timer(readSnapshotsLatency);
+    bool ok = inner->readSnapshots(sensorIds, snapshots);
+    if (!ok) {
+        batchErrors.increment();
+    }
+    return ok;
+}
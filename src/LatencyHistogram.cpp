@@ -0,0 +1,110 @@
+#include "../include/LatencyHistogram.h"
+#include <algorithm>
+#include <unordered_map>
+
+const int LatencyHistogram::SUB_BUCKET_BITS;
+const size_t LatencyHistogram::SUB_BUCKETS;
+const int LatencyHistogram::MAX_EXPONENT;
+const uint64_t LatencyHistogram::MAX_TRACKABLE_NANOS;
+const size_t LatencyHistogram::BUCKET_COUNT;
+
+namespace {
+
+std::atomic<uint64_t> nextHistogramId(1);
+
+} // namespace
+
+uint64_t HistogramSnapshot::percentile(double quantile) const {
+    if (count == 0) {
+        return 0;
+    }
+    quantile = std::min(1.0, std::max(0.0, quantile));
+    uint64_t rank = static_cast<uint64_t>(quantile * count + 0.5);
+    rank = std::max<uint64_t>(1, std::min(rank, count));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            // El último bucket no tiene cota: se informa el máximo observado
+            return std::min(LatencyHistogram::bucketUpperBound(i), maxNanos);
+        }
+    }
+    return maxNanos;
+}
+
+void HistogramSnapshot::merge(const HistogramSnapshot& other) {
+    if (counts.size() < other.counts.size()) {
+        counts.resize(other.counts.size(), 0);
+    }
+    for (size_t i = 0; i < other.counts.size(); ++i) {
+        counts[i] += other.counts[i];
+    }
+    count += other.count;
+    sumNanos += other.sumNanos;
+    maxNanos = std::max(maxNanos, other.maxNanos);
+}
+
+LatencyHistogram::Shard::Shard() : sumNanos(0), maxNanos(0) {
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        counts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+LatencyHistogram::LatencyHistogram() : id(nextHistogramId.fetch_add(1)) {}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    if (index >= BUCKET_COUNT - 1) {
+        return MAX_TRACKABLE_NANOS;
+    }
+    const int shift = static_cast<int>(index / SUB_BUCKETS) - 1;
+    const uint64_t mantissa = SUB_BUCKETS + index % SUB_BUCKETS;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+LatencyHistogram::Shard& LatencyHistogram::localShard() {
+    // Cada hilo guarda sus contadores por id de histograma; como los ids no se
+    // reutilizan, un histograma destruido nunca recibe los de otro
+    thread_local std::unordered_map<uint64_t, std::shared_ptr<Shard>> local;
+    thread_local uint64_t lastId = 0;
+    thread_local Shard* lastShard = nullptr;
+    if (lastId == id) {
+        return *lastShard;
+    }
+
+    std::shared_ptr<Shard>& shard = local[id];
+    if (!shard) {
+        shard = std::make_shared<Shard>();
+        std::lock_guard<std::mutex> lock(shardsMutex);
+        shards.push_back(shard);
+    }
+    lastId = id;
+    lastShard = shard.get();
+    return *shard;
+}
+
+HistogramSnapshot LatencyHistogram::snapshot() const {
+    std::vector<std::shared_ptr<Shard>> current;
+    {
+        std::lock_guard<std::mutex> lock(shardsMutex);
+        current = shards;
+    }
+
+    HistogramSnapshot result;
+    result.counts.assign(BUCKET_COUNT, 0);
+    for (const std::shared_ptr<Shard>& shard : current) {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            result.counts[i] += shard->counts[i].load(std::memory_order_relaxed);
+        }
+        result.sumNanos += shard->sumNanos.load(std::memory_order_relaxed);
+        result.maxNanos = std::max(result.maxNanos, shard->maxNanos.load(std::memory_order_relaxed));
+    }
+    // El total se toma de los buckets para que los percentiles sean coherentes
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        result.count += result.counts[i];
+    }
+    return result;
+}
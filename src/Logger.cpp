@@ -0,0 +1,372 @@
+#include "../include/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+
+const size_t Logger::RECORD_SIZE;
+const size_t Logger::BUFFER_RECORDS;
+
+std::atomic<int> Logger::runtimeLevel(CLIMA_LOG_MIN_LEVEL);
+
+namespace {
+
+const char* levelName(int level) {
+    switch (level) {
+        case CLIMA_LOG_LEVEL_TRACE: return "TRACE";
+        case CLIMA_LOG_LEVEL_DEBUG: return "DEBUG";
+        case CLIMA_LOG_LEVEL_INFO: return "INFO";
+        case CLIMA_LOG_LEVEL_WARN: return "WARN";
+        default: return "ERROR";
+    }
+}
+
+/**
+ * @brief Línea formateada durante un vaciado (referencia dentro del texto acumulado)
+ */
+struct PendingLine {
+    int64_t timestampMicros;
+    size_t offset;
+    size_t length;
+};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// LogRecordWriter
+
+LogRecordWriter::LogRecordWriter(char* buffer, size_t size, bool jsonFormat)
+    : data(buffer), capacity(size), length(0), json(jsonFormat) {}
+
+void LogRecordWriter::appendRaw(const char* text, size_t size) {
+    size_t available = capacity - length;
+    if (size > available) {
+        size = available;
+    }
+    std::memcpy(data + length, text, size);
+    length += size;
+}
+
+void LogRecordWriter::appendChar(char c) {
+    if (length < capacity) {
+        data[length++] = c;
+    }
+}
+
+void LogRecordWriter::appendQuoted(const char* text, size_t size) {
+    appendChar('"');
+    for (size_t i = 0; i < size; ++i) {
+        // Los tramos sin caracteres especiales se copian de una vez
+        size_t run = i;
+        while (run < size && text[run] != '"' && text[run] != '\\' &&
+               static_cast<unsigned char>(text[run]) >= 0x20) {
+            ++run;
+        }
+        if (run > i) {
+            appendRaw(text + i, run - i);
+            i = run;
+            if (i == size) {
+                break;
+            }
+        }
+
+        char c = text[i];
+        if (c == '"' || c == '\\') {
+            appendChar('\\');
+            appendChar(c);
+        } else if (c == '\n') {
+            appendRaw("\\n", 2);
+        } else if (c == '\t') {
+            appendRaw("\\t", 2);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            appendChar(' ');
+        } else {
+            appendChar(c);
+        }
+    }
+    appendChar('"');
+}
+
+void LogRecordWriter::appendString(const char* text, size_t size) {
+    if (json) {
+        appendQuoted(text, size);
+        return;
+    }
+
+    // En clave=valor solo se entrecomilla lo que no se puede leer sin comillas
+    bool needsQuotes = (size == 0);
+    for (size_t i = 0; i < size && !needsQuotes; ++i) {
+        char c = text[i];
+        needsQuotes = (c == ' ' || c == '"' || c == '=' || c == '\\' ||
+                       static_cast<unsigned char>(c) < 0x20);
+    }
+    if (needsQuotes) {
+        appendQuoted(text, size);
+    } else {
+        appendRaw(text, size);
+    }
+}
+
+void LogRecordWriter::appendKey(const char* key) {
+    if (json) {
+        if (length > 0) {
+            appendChar(',');
+        }
+        appendChar('"');
+        appendRaw(key, std::strlen(key));
+        appendRaw("\":", 2);
+    } else {
+        if (length > 0) {
+            appendChar(' ');
+        }
+        appendRaw(key, std::strlen(key));
+        appendChar('=');
+    }
+}
+
+void LogRecordWriter::appendValue(const char* value) {
+    if (value == nullptr) {
+        value = "";
+    }
+    appendString(value, std::strlen(value));
+}
+
+void LogRecordWriter::appendValue(const std::string& value) {
+    appendString(value.data(), value.size());
+}
+
+void LogRecordWriter::appendValue(bool value) {
+    if (value) {
+        appendRaw("true", 4);
+    } else {
+        appendRaw("false", 5);
+    }
+}
+
+void LogRecordWriter::appendValue(int value) {
+    appendValue(static_cast<long long>(value));
+}
+
+void LogRecordWriter::appendValue(long value) {
+    appendValue(static_cast<long long>(value));
+}
+
+void LogRecordWriter::appendValue(long long value) {
+    char text[24];
+    int size = std::snprintf(text, sizeof(text), "%lld", value);
+    appendRaw(text, static_cast<size_t>(size));
+}
+
+void LogRecordWriter::appendValue(unsigned int value) {
+    appendValue(static_cast<unsigned long long>(value));
+}
+
+void LogRecordWriter::appendValue(unsigned long value) {
+    appendValue(static_cast<unsigned long long>(value));
+}
+
+void LogRecordWriter::appendValue(unsigned long long value) {
+    char text[24];
+    int size = std::snprintf(text, sizeof(text), "%llu", value);
+    appendRaw(text, static_cast<size_t>(size));
+}
+
+void LogRecordWriter::appendValue(float value) {
+    appendValue(static_cast<double>(value));
+}
+
+void LogRecordWriter::appendValue(double value) {
+    char text[32];
+    int size = std::snprintf(text, sizeof(text), "%.6g", value);
+    appendRaw(text, static_cast<size_t>(size));
+}
+
+// ---------------------------------------------------------------------------
+// Logger
+
+Logger::Logger()
+    : output(stderr), ownsOutput(false), format(static_cast<int>(LogFormat::KEY_VALUE)),
+      droppedCount(0), flushRequested(false), stopping(false) {
+    flusher = std::thread(&Logger::flusherLoop, this);
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    flusher.join();
+
+    flush();
+    if (ownsOutput) {
+        std::fclose(output);
+    }
+}
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+void Logger::setLevel(LogLevel level) {
+    runtimeLevel = std::max(static_cast<int>(level), CLIMA_LOG_MIN_LEVEL);
+}
+
+LogLevel Logger::getLevel() {
+    return static_cast<LogLevel>(std::min(runtimeLevel.load(), CLIMA_LOG_LEVEL_ERROR));
+}
+
+void Logger::setFormat(LogFormat logFormat) {
+    format = static_cast<int>(logFormat);
+}
+
+bool Logger::setOutputFile(const std::string& path) {
+    FILE* file = stderr;
+    if (!path.empty()) {
+        file = std::fopen(path.c_str(), "a");
+        if (file == nullptr) {
+            return false;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(flushMutex);
+    drainLocked();
+    if (ownsOutput) {
+        std::fclose(output);
+    }
+    output = file;
+    ownsOutput = !path.empty();
+    return true;
+}
+
+uint64_t Logger::getDroppedCount() const {
+    return droppedCount.load();
+}
+
+Logger::ThreadBuffer& Logger::localBuffer() {
+    // El registro mantiene su propia referencia: lo escrito por un hilo que
+    // termina se sigue vaciando y el buffer se libera en un vaciado posterior
+    thread_local std::shared_ptr<ThreadBuffer> local;
+    if (!local) {
+        local = std::make_shared<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffers.push_back(local);
+    }
+    return *local;
+}
+
+Logger::Record* Logger::reserve(ThreadBuffer& buffer) {
+    size_t head = buffer.head.load(std::memory_order_relaxed);
+    if (head - buffer.tail.load(std::memory_order_acquire) >= BUFFER_RECORDS) {
+        return nullptr;
+    }
+    return &buffer.records[head % BUFFER_RECORDS];
+}
+
+void Logger::publish(ThreadBuffer& buffer) {
+    size_t head = buffer.head.load(std::memory_order_relaxed) + 1;
+    buffer.head.store(head, std::memory_order_release);
+
+    if (head - buffer.tail.load(std::memory_order_relaxed) >= BUFFER_RECORDS / 2 &&
+        !flushRequested.exchange(true)) {
+        wakeUp.notify_one();
+    }
+}
+
+void Logger::flush() {
+    std::lock_guard<std::mutex> lock(flushMutex);
+    drainLocked();
+}
+
+void Logger::drainLocked() {
+    std::vector<std::shared_ptr<ThreadBuffer>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        snapshot = buffers;
+    }
+
+    std::vector<PendingLine> lines;
+    std::string text;
+    time_t cachedSecond = -1;
+    char stamp[32];
+    size_t stampLength = 0;
+
+    for (const auto& buffer : snapshot) {
+        size_t tail = buffer->tail.load(std::memory_order_relaxed);
+        size_t head = buffer->head.load(std::memory_order_acquire);
+
+        for (; tail < head; ++tail) {
+            const Record& record = buffer->records[tail % BUFFER_RECORDS];
+
+            // La fecha se formatea una vez por segundo; solo cambian los milisegundos
+            time_t seconds = static_cast<time_t>(record.timestampMicros / 1000000);
+            if (seconds != cachedSecond) {
+                struct tm utc;
+                gmtime_r(&seconds, &utc);
+                stampLength = std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%S", &utc);
+                cachedSecond = seconds;
+            }
+            char millis[8];
+            std::snprintf(millis, sizeof(millis), ".%03dZ",
+                          static_cast<int>((record.timestampMicros / 1000) % 1000));
+
+            PendingLine line;
+            line.timestampMicros = record.timestampMicros;
+            line.offset = text.size();
+            if (record.json) {
+                text.append("{\"ts\":\"").append(stamp, stampLength).append(millis);
+                text.append("\",\"level\":\"").append(levelName(record.level)).append("\",");
+                text.append(record.text, record.length);
+                text.append("}\n");
+            } else {
+                text.append("ts=").append(stamp, stampLength).append(millis);
+                text.append(" level=").append(levelName(record.level)).append(" ");
+                text.append(record.text, record.length);
+                text.append("\n");
+            }
+            line.length = text.size() - line.offset;
+            lines.push_back(line);
+        }
+        buffer->tail.store(tail, std::memory_order_release);
+    }
+
+    // Cada hilo ya está en orden; se intercalan los hilos por tiempo
+    if (snapshot.size() > 1) {
+        std::stable_sort(lines.begin(), lines.end(), [](const PendingLine& a, const PendingLine& b) {
+            return a.timestampMicros < b.timestampMicros;
+        });
+        for (const auto& line : lines) {
+            std::fwrite(text.data() + line.offset, 1, line.length, output);
+        }
+    } else if (!text.empty()) {
+        std::fwrite(text.data(), 1, text.size(), output);
+    }
+    if (!lines.empty()) {
+        std::fflush(output);
+    }
+
+    // Se liberan los buffers de hilos terminados que ya quedaron vacíos
+    snapshot.clear();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                 [](const std::shared_ptr<ThreadBuffer>& buffer) {
+                                     return buffer.use_count() == 1 &&
+                                            buffer->head.load() == buffer->tail.load();
+                                 }),
+                  buffers.end());
+}
+
+void Logger::flusherLoop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeUp.wait_for(lock, std::chrono::milliseconds(20),
+                            [this]() { return stopping.load() || flushRequested.load(); });
+            if (stopping) {
+                return;
+            }
+        }
+        flushRequested = false;
+        flush();
+    }
+}
@@ -0,0 +1,442 @@
+#include "../include/MSForecastClient.h"
+#include "../include/Logger.h"
+#include <algorithm>
+#include <random>
+#include <limits>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+namespace {
+
+const size_t READ_BUFFER_BYTES = 64 * 1024;     ///< Respuestas leídas por llamada a recv como máximo
+const size_t INLINE_REQUESTS = 4;               ///< Peticiones que se codifican sin reservar memoria
+
+/**
+ * @brief Envía todo el bloque
+ * @return Bytes enviados (menos que size si el socket falló)
+ */
+size_t sendAll(int fd, const uint8_t* data, size_t size) {
+    size_t sent = 0;
+    while (sent < size) {
+        ssize_t n = send(fd, data + sent, size - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return sent;
+}
+
+/**
+ * @brief Espera aleatoria antes de un reintento (full jitter)
+ * @param retry Número de reintento, desde 0
+ */
+std::chrono::milliseconds backoffDelay(int retry, std::chrono::milliseconds base, std::chrono::milliseconds maximum) {
+    static thread_local std::minstd_rand random(
+        static_cast<unsigned>(std::hash<std::thread::id>()(std::this_thread::get_id())));
+    const long long ceiling = std::min<long long>(maximum.count(), base.count() << std::min(retry, 20));
+    if (ceiling <= 0) {
+        return std::chrono::milliseconds(0);
+    }
+    return std::chrono::milliseconds(static_cast<long long>(random() % static_cast<unsigned long long>(ceiling + 1)));
+}
+
+ClimateSnapshot failedSnapshot(int sensorId) {
+    ClimateSnapshot snapshot;
+    snapshot.sensorId = sensorId;
+    snapshot.temperature = std::numeric_limits<float>::quiet_NaN();
+    snapshot.humidity = std::numeric_limits<float>::quiet_NaN();
+    snapshot.timestamp = time(nullptr);
+    return snapshot;
+}
+
+} // namespace
+
+ForecastClientConfig::ForecastClientConfig()
+    : host("127.0.0.1"), port(7070), poolSize(4), connectTimeout(1000), attemptTimeout(200),
+      deadline(1000), maxRetries(2), backoffBase(10), backoffMax(200) {}
+
+MSForecastClient::MSForecastClient(const ForecastClientConfig& clientConfig)
+    : config(clientConfig), nextConnection(0), callCount(0), requestCount(0), retryCount(0),
+      timeoutCount(0), failureCount(0), connectCount(0) {
+    if (config.poolSize == 0) {
+        config.poolSize = 1;
+    }
+    for (size_t i = 0; i < config.poolSize; ++i) {
+        pool.push_back(std::unique_ptr<Connection>(new Connection()));
+    }
+    LOG_INFO("MSForecastClient", "Cliente MS-Forecast creado", "host", config.host, "port", config.port,
+             "pool", config.poolSize);
+}
+
+MSForecastClient::~MSForecastClient() {
+    for (size_t i = 0; i < pool.size(); ++i) {
+        std::lock_guard<std::mutex> lock(pool[i]->connectMutex);
+        closeConnection(*pool[i]);
+    }
+}
+
+int MSForecastClient::openSocket() const {
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config.port);
+    if (inet_pton(AF_INET, config.host.c_str(), &addr.sin_addr) != 1) {
+        LOG_WARN("MSForecastClient", "Dirección inválida", "host", config.host);
+        return -1;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    // Conexión no bloqueante para poder acotar su duración
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        int error = errno;
+        if (error == EINPROGRESS) {
+            pollfd waiting;
+            waiting.fd = fd;
+            waiting.events = POLLOUT;
+            waiting.revents = 0;
+            socklen_t length = sizeof(error);
+            if (poll(&waiting, 1, static_cast<int>(config.connectTimeout.count())) == 1 &&
+                getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) == 0) {
+                // error queda en 0 si la conexión se completó
+            } else {
+                error = ETIMEDOUT;
+            }
+        }
+        if (error != 0) {
+            LOG_WARN("MSForecastClient", "No se pudo conectar", "host", config.host, "port", config.port,
+                     "error", strerror(error));
+            close(fd);
+            return -1;
+        }
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+    int noDelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    // Una escritura bloqueada (servidor que no lee) no puede exceder el intento
+    timeval timeout;
+    timeout.tv_sec = static_cast<time_t>(config.attemptTimeout.count() / 1000);
+    timeout.tv_usec = static_cast<suseconds_t>((config.attemptTimeout.count() % 1000) * 1000);
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    return fd;
+}
+
+bool MSForecastClient::ensureConnected(Connection& connection) const {
+    {
+        std::lock_guard<std::mutex> lock(connection.mutex);
+        if (connection.fd >= 0 && !connection.broken) {
+            return true;
+        }
+    }
+
+    std::lock_guard<std::mutex> connecting(connection.connectMutex);
+    {
+        // Otro hilo pudo haber reconectado mientras se esperaba el turno
+        std::lock_guard<std::mutex> lock(connection.mutex);
+        if (connection.fd >= 0 && !connection.broken) {
+            return true;
+        }
+    }
+    closeConnection(connection);
+
+    int fd = openSocket();
+    if (fd < 0) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> writing(connection.writeMutex);
+        std::lock_guard<std::mutex> lock(connection.mutex);
+        connection.fd = fd;
+        connection.broken = false;
+        ++connection.generation;
+    }
+    connection.reader = std::thread(&MSForecastClient::readLoop, &connection, fd);
+    if (++connectCount > pool.size()) {
+        LOG_INFO("MSForecastClient", "Conexión restablecida", "host", config.host, "port", config.port);
+    }
+    return true;
+}
+
+void MSForecastClient::closeConnection(Connection& connection) {
+    int fd;
+    {
+        std::lock_guard<std::mutex> lock(connection.mutex);
+        fd = connection.fd;
+    }
+    if (fd >= 0) {
+        // shutdown despierta al lector sin liberar el descriptor que todavía usa
+        shutdown(fd, SHUT_RDWR);
+    }
+    if (connection.reader.joinable()) {
+        connection.reader.join();
+    }
+    if (fd >= 0) {
+        std::lock_guard<std::mutex> writing(connection.writeMutex);
+        std::lock_guard<std::mutex> lock(connection.mutex);
+        close(fd);
+        connection.fd = -1;
+    }
+}
+
+void MSForecastClient::readLoop(Connection* connection, int fd) {
+    std::vector<uint8_t> buffer(READ_BUFFER_BYTES);
+    size_t buffered = 0;
+
+    while (true) {
+        ssize_t n = recv(fd, &buffer[buffered], buffer.size() - buffered, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        buffered += static_cast<size_t>(n);
+
+        const size_t count = buffered / ForecastProtocol::RESPONSE_SIZE;
+        {
+            std::lock_guard<std::mutex> lock(connection->mutex);
+            for (size_t i = 0; i < count; ++i) {
+                ForecastResponse response = ForecastProtocol::decodeResponse(
+                    &buffer[i * ForecastProtocol::RESPONSE_SIZE]);
+                std::unordered_map<uint32_t, Pending>::iterator it = connection->pending.find(response.id);
+                if (it == connection->pending.end()) {
+                    // Respuesta de un intento que ya venció
+                    continue;
+                }
+                Call* call = it->second.call;
+                *it->second.response = response;
+                connection->pending.erase(it);
+                // Se avisa con el lock tomado: al despertar, la llamada destruye Call
+                if (--call->remaining == 0) {
+                    call->completed.notify_one();
+                }
+            }
+        }
+        const size_t consumed = count * ForecastProtocol::RESPONSE_SIZE;
+        memmove(buffer.data(), buffer.data() + consumed, buffered - consumed);
+        buffered -= consumed;
+    }
+
+    std::lock_guard<std::mutex> lock(connection->mutex);
+    connection->broken = true;
+    for (std::unordered_map<uint32_t, Pending>::iterator it = connection->pending.begin();
+         it != connection->pending.end(); ++it) {
+        it->second.call->lost = true;
+        it->second.call->completed.notify_one();
+    }
+    connection->pending.clear();
+}
+
+MSForecastClient::AttemptResult MSForecastClient::attempt(Connection& connection, ForecastRequest* requests,
+                                                          ForecastResponse* responses, size_t count,
+                                                          std::chrono::steady_clock::time_point until) const {
+    if (!ensureConnected(connection)) {
+        return AttemptResult::NOT_SENT;
+    }
+
+    Call call;
+    call.remaining = count;
+    call.lost = false;
+    uint64_t generation;
+    uint32_t firstId;
+    {
+        std::lock_guard<std::mutex> lock(connection.mutex);
+        if (connection.broken) {
+            return AttemptResult::NOT_SENT;
+        }
+        generation = connection.generation;
+        firstId = connection.nextId;
+        connection.nextId += static_cast<uint32_t>(count);
+        for (size_t i = 0; i < count; ++i) {
+            requests[i].id = firstId + static_cast<uint32_t>(i);
+            Pending pending = { &call, &responses[i] };
+            connection.pending[requests[i].id] = pending;
+        }
+    }
+
+    uint8_t inlineBuffer[INLINE_REQUESTS * ForecastProtocol::REQUEST_SIZE];
+    std::vector<uint8_t> heapBuffer;
+    uint8_t* encoded = inlineBuffer;
+    if (count > INLINE_REQUESTS) {
+        heapBuffer.resize(count * ForecastProtocol::REQUEST_SIZE);
+        encoded = heapBuffer.data();
+    }
+    for (size_t i = 0; i < count; ++i) {
+        ForecastProtocol::encodeRequest(requests[i], encoded + i * ForecastProtocol::REQUEST_SIZE);
+    }
+
+    const size_t size = count * ForecastProtocol::REQUEST_SIZE;
+    size_t sent = 0;
+    {
+        std::lock_guard<std::mutex> writing(connection.writeMutex);
+        // fd y generation sólo cambian con writeMutex tomado
+        if (connection.generation == generation && connection.fd >= 0) {
+            sent = sendAll(connection.fd, encoded, size);
+            if (sent < size) {
+                // Un mensaje a medias desincroniza el flujo: la conexión se descarta
+                shutdown(connection.fd, SHUT_RDWR);
+            }
+        }
+    }
+    requestCount += count;
+
+    std::unique_lock<std::mutex> lock(connection.mutex);
+    if (sent == size) {
+        call.completed.wait_until(lock, until, [&call]() { return call.remaining == 0 || call.lost; });
+        if (call.remaining == 0) {
+            return AttemptResult::OK;
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        connection.pending.erase(requests[i].id);
+    }
+    if (sent == 0) {
+        return AttemptResult::NOT_SENT;
+    }
+    return sent < size || call.lost ? AttemptResult::LOST : AttemptResult::TIMEOUT;
+}
+
+bool MSForecastClient::execute(ForecastRequest* requests, ForecastResponse* responses, size_t count) const {
+    typedef std::chrono::steady_clock Clock;
+    ++callCount;
+    const Clock::time_point deadline = Clock::now() + config.deadline;
+    bool idempotent = true;
+    for (size_t i = 0; i < count; ++i) {
+        idempotent = idempotent && ForecastProtocol::isRead(requests[i].op);
+    }
+
+    AttemptResult result = AttemptResult::NOT_SENT;
+    for (int retry = 0;; ++retry) {
+        Connection& connection = *pool[nextConnection++ % pool.size()];
+        const Clock::time_point until = std::min(deadline, Clock::now() + config.attemptTimeout);
+        result = attempt(connection, requests, responses, count, until);
+        if (result == AttemptResult::OK) {
+            return true;
+        }
+        if (result == AttemptResult::TIMEOUT) {
+            ++timeoutCount;
+        }
+
+        // Un comando que pudo haber llegado al servidor no se repite
+        if (retry >= config.maxRetries || (result != AttemptResult::NOT_SENT && !idempotent)) {
+            break;
+        }
+        const std::chrono::milliseconds delay = backoffDelay(retry, config.backoffBase, config.backoffMax);
+        if (Clock::now() + delay >= deadline) {
+            break;
+        }
+        std::this_thread::sleep_for(delay);
+        ++retryCount;
+    }
+
+    ++failureCount;
+    LOG_WARN("MSForecastClient", "Llamada fallida", "op", static_cast<int>(requests[0].op), "requests", count,
+             "result", result == AttemptResult::TIMEOUT ? "timeout"
+                       : result == AttemptResult::LOST ? "conexión perdida" : "no enviada");
+    return false;
+}
+
+bool MSForecastClient::command(ForecastOp op, int amount) {
+    ForecastRequest request = { 0, op, amount };
+    ForecastResponse response;
+    return execute(&request, &response, 1) && response.status == ForecastStatus::OK;
+}
+
+bool MSForecastClient::read(ForecastOp op, ClimateSnapshot& snapshot) const {
+    ForecastRequest request = { 0, op, 0 };
+    ForecastResponse response;
+    if (execute(&request, &response, 1) && response.status == ForecastStatus::OK) {
+        snapshot = response.snapshot;
+        return true;
+    }
+    snapshot = failedSnapshot(0);
+    return false;
+}
+
+bool MSForecastClient::upTemp(int x) {
+    return command(ForecastOp::UP_TEMP, x);
+}
+
+bool MSForecastClient::downTemp(int x) {
+    return command(ForecastOp::DOWN_TEMP, x);
+}
+
+bool MSForecastClient::upHumidity(int x) {
+    return command(ForecastOp::UP_HUMIDITY, x);
+}
+
+bool MSForecastClient::downHumidity(int x) {
+    return command(ForecastOp::DOWN_HUMIDITY, x);
+}
+
+float MSForecastClient::readTemp() const {
+    ClimateSnapshot snapshot;
+    read(ForecastOp::READ_TEMP, snapshot);
+    return snapshot.temperature;
+}
+
+float MSForecastClient::readHumidity() const {
+    ClimateSnapshot snapshot;
+    read(ForecastOp::READ_HUMIDITY, snapshot);
+    return snapshot.humidity;
+}
+
+ClimateSnapshot MSForecastClient::readSnapshot() const {
+    ClimateSnapshot snapshot;
+    read(ForecastOp::READ_SNAPSHOT, snapshot);
+    return snapshot;
+}
+
+bool MSForecastClient::readSnapshots(const std::vector<int>& sensorIds,
+                                     std::vector<ClimateSnapshot>& snapshots) const {
+    snapshots.clear();
+    if (sensorIds.empty()) {
+        return true;
+    }
+
+    std::vector<ForecastRequest> requests(sensorIds.size());
+    std::vector<ForecastResponse> responses(sensorIds.size());
+    for (size_t i = 0; i < sensorIds.size(); ++i) {
+        requests[i].id = 0;
+        requests[i].op = ForecastOp::READ_SNAPSHOT;
+        requests[i].arg = sensorIds[i];
+    }
+    const bool answered = execute(requests.data(), responses.data(), requests.size());
+
+    // Un sensor rechazado no invalida al resto del lote: queda con NaN
+    snapshots.reserve(sensorIds.size());
+    for (size_t i = 0; i < sensorIds.size(); ++i) {
+        if (answered && responses[i].status == ForecastStatus::OK) {
+            snapshots.push_back(responses[i].snapshot);
+        } else {
+            snapshots.push_back(failedSnapshot(sensorIds[i]));
+        }
+    }
+    return answered;
+}
+
+ForecastClientStats MSForecastClient::getStats() const {
+    ForecastClientStats stats;
+    stats.calls = callCount.load();
+    stats.requests = requestCount.load();
+    stats.retries = retryCount.load();
+    stats.timeouts = timeoutCount.load();
+    stats.failures = failureCount.load();
+    stats.connects = connectCount.load();
+    return stats;
+}
@@ -1,48 +1,181 @@
 #include "../include/MSForecastMock.h"
-#include <iostream>
+#include "../include/Logger.h"
 #include <algorithm>
+#include <cmath>
 
-MSForecastMock::MSForecastMock() : currentTemp(22.0), currentHumidity(45.0) {
-    std::cout << "MSForecastMock inicializado - Temperatura: " << currentTemp 
-              << "°C, Humedad: " << currentHumidity << "%" << std::endl;
+ThermalPlant::ThermalPlant()
+    : ambientTemperature(27.0f), ambientHumidity(40.0f), degreesPerStep(1.0f), humidityPerStep(2.0f),
+      temperatureTimeConstantSec(600.0f), humidityTimeConstantSec(300.0f), timeScale(1.0) {}
+
+MSForecastMock::MSForecastMock()
+    : currentTemp(22.0), currentHumidity(45.0), requestCount(0), plantEnabled(false),
+      heatingSteps(0), humidifierSteps(0), heatLoad(0.0f) {
+    LOG_INFO("MSForecastMock", "Inicializado", "temperature", currentTemp, "humidity", currentHumidity);
+}
+
+void MSForecastMock::advanceLocked(double seconds) const {
+    if (seconds <= 0.0) {
+        return;
+    }
+    // Respuesta exacta de primer orden hacia el equilibrio de los actuadores
+    const float targetTemp = plant.ambientTemperature + heatLoad + plant.degreesPerStep * heatingSteps;
+    const float targetHumidity = std::max(0.0f, std::min(100.0f,
+        plant.ambientHumidity + plant.humidityPerStep * humidifierSteps));
+    currentTemp += (targetTemp - currentTemp) *
+        static_cast<float>(1.0 - std::exp(-seconds / plant.temperatureTimeConstantSec));
+    currentHumidity += (targetHumidity - currentHumidity) *
+        static_cast<float>(1.0 - std::exp(-seconds / plant.humidityTimeConstantSec));
+}
+
+void MSForecastMock::syncPlantLocked() const {
+    if (!plantEnabled) {
+        return;
+    }
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (plant.timeScale > 0.0) {
+        advanceLocked(std::chrono::duration<double>(now - plantClock).count() * plant.timeScale);
+    }
+    plantClock = now;
+}
+
+void MSForecastMock::enableThermalPlant(const ThermalPlant& thermalPlant) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    plant = thermalPlant;
+    plantEnabled = true;
+    heatingSteps = 0;
+    humidifierSteps = 0;
+    heatLoad = 0.0f;
+    plantClock = std::chrono::steady_clock::now();
+    LOG_INFO("MSForecastMock", "Planta térmica activada", "ambient", plant.ambientTemperature,
+             "tau_s", plant.temperatureTimeConstantSec, "time_scale", plant.timeScale);
+}
+
+void MSForecastMock::advancePlant(double seconds) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (plantEnabled) {
+        syncPlantLocked();
+        advanceLocked(seconds);
+    }
+}
+
+void MSForecastMock::setHeatLoad(float degrees) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    syncPlantLocked();
+    heatLoad = degrees;
 }
 
 bool MSForecastMock::upTemp(int x) {
-    currentTemp += x;
-    std::cout << "MSForecastMock: Temperatura aumentada en " << x 
-              << "°C. Nueva temperatura: " << currentTemp << "°C" << std::endl;
+    std::lock_guard<std::mutex> lock(stateMutex);
+    ++requestCount;
+    if (plantEnabled) {
+        // Con la planta activa el comando mueve el actuador, no el valor
+        syncPlantLocked();
+        heatingSteps += x;
+    } else {
+        currentTemp += x;
+    }
+    LOG_INFO("MSForecastMock", "Temperatura aumentada", "delta", x, "temperature", currentTemp);
     return true;
 }
 
 bool MSForecastMock::downTemp(int x) {
-    currentTemp -= x;
-    std::cout << "MSForecastMock: Temperatura disminuida en " << x 
-              << "°C. Nueva temperatura: " << currentTemp << "°C" << std::endl;
+    std::lock_guard<std::mutex> lock(stateMutex);
+    ++requestCount;
+    if (plantEnabled) {
+        syncPlantLocked();
+        heatingSteps -= x;
+    } else {
+        currentTemp -= x;
+    }
+    LOG_INFO("MSForecastMock", "Temperatura disminuida", "delta", x, "temperature", currentTemp);
     return true;
 }
 
 bool MSForecastMock::upHumidity(int x) {
-    currentHumidity = std::min(100.0f, currentHumidity + x);
-    std::cout << "MSForecastMock: Humedad aumentada en " << x 
-              << "%. Nueva humedad: " << currentHumidity << "%" << std::endl;
+    std::lock_guard<std::mutex> lock(stateMutex);
+    ++requestCount;
+    if (plantEnabled) {
+        syncPlantLocked();
+        humidifierSteps += x;
+    } else {
+        currentHumidity = std::min(100.0f, currentHumidity + x);
+    }
+    LOG_INFO("MSForecastMock", "Humedad aumentada", "delta", x, "humidity", currentHumidity);
     return true;
 }
 
 bool MSForecastMock::downHumidity(int x) {
-    currentHumidity = std::max(0.0f, currentHumidity - x);
-    std::cout << "MSForecastMock: Humedad disminuida en " << x 
-              << "%. Nueva humedad: " << currentHumidity << "%" << std::endl;
+    std::lock_guard<std::mutex> lock(stateMutex);
+    ++requestCount;
+    if (plantEnabled) {
+        syncPlantLocked();
+        humidifierSteps -= x;
+    } else {
+        currentHumidity = std::max(0.0f, currentHumidity - x);
+    }
+    LOG_INFO("MSForecastMock", "Humedad disminuida", "delta", x, "humidity", currentHumidity);
     return true;
 }
 
 float MSForecastMock::readTemp() const {
-    std::cout << "MSForecastMock: Leyendo temperatura actual: " 
-              << currentTemp << "°C" << std::endl;
+    std::lock_guard<std::mutex> lock(stateMutex);
+    ++requestCount;
+    syncPlantLocked();
+    LOG_DEBUG("MSForecastMock", "Lectura de temperatura", "temperature", currentTemp);
     return currentTemp;
 }
 
 float MSForecastMock::readHumidity() const {
-    std::cout << "MSForecastMock: Leyendo humedad actual: " 
-              << currentHumidity << "%" << std::endl;
+    std::lock_guard<std::mutex> lock(stateMutex);
+    ++requestCount;
+    syncPlantLocked();
+    LOG_DEBUG("MSForecastMock", "Lectura de humedad", "humidity", currentHumidity);
     return currentHumidity;
-} 
\ No newline at end of file
+}
+
+ClimateSnapshot MSForecastMock::snapshotLocked(int sensorId, time_t now) const {
+    ClimateSnapshot snapshot;
+    snapshot.sensorId = sensorId;
+    snapshot.timestamp = now;
+    snapshot.temperature = currentTemp;
+    snapshot.humidity = currentHumidity;
+
+    // Desvío fijo por sensor dentro de la fila: ±0.5°C y ±1.5% de humedad
+    if (sensorId != 0) {
+        snapshot.temperature += ((sensorId * 37) % 11 - 5) * 0.1f;
+        snapshot.humidity = std::max(0.0f, std::min(100.0f,
+            snapshot.humidity + ((sensorId * 53) % 7 - 3) * 0.5f));
+    }
+    return snapshot;
+}
+
+ClimateSnapshot MSForecastMock::readSnapshot() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    ++requestCount;
+    syncPlantLocked();
+    ClimateSnapshot snapshot = snapshotLocked(0, time(nullptr));
+    LOG_DEBUG("MSForecastMock", "Lectura de medición", "temperature", snapshot.temperature,
+              "humidity", snapshot.humidity);
+    return snapshot;
+}
+
+bool MSForecastMock::readSnapshots(const std::vector<int>& sensorIds,
+                                   std::vector<ClimateSnapshot>& snapshots) const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    ++requestCount;
+    syncPlantLocked();
+
+    // Todas las mediciones del lote comparten el instante de la petición
+    time_t now = time(nullptr);
+    snapshots.clear();
+    snapshots.reserve(sensorIds.size());
+    for (int sensorId : sensorIds) {
+        snapshots.push_back(snapshotLocked(sensorId, now));
+    }
+    LOG_DEBUG("MSForecastMock", "Lectura de mediciones por lote", "sensors", sensorIds.size());
+    return true;
+}
+
+uint64_t MSForecastMock::getRequestCount() const {
+    return requestCount.load();
+}
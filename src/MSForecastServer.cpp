@@ -0,0 +1,297 @@
+#include "../include/MSForecastServer.h"
+#include "../include/Logger.h"
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+#include <cmath>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+namespace {
+
+const int ACCEPT_POLL_MS = 200;             ///< Espera máxima entre comprobaciones de parada
+const size_t READ_BUFFER_BYTES = 64 * 1024; ///< Peticiones leídas por llamada a recv como máximo
+
+bool sendAll(int fd, const uint8_t* data, size_t size) {
+    size_t sent = 0;
+    while (sent < size) {
+        ssize_t n = send(fd, data + sent, size - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+void appendResponse(std::vector<uint8_t>& out, const ForecastResponse& response) {
+    const size_t offset = out.size();
+    out.resize(offset + ForecastProtocol::RESPONSE_SIZE);
+    ForecastProtocol::encodeResponse(response, &out[offset]);
+}
+
+} // namespace
+
+ServerFaults::ServerFaults() : responseDelay(0), dropEvery(0) {}
+
+MSForecastServer::MSForecastServer(IMSForecast* forecast)
+    : backend(forecast), listenFd(-1), listenPort(0), stopping(false),
+      connectionCount(0), requestCount(0), droppedCount(0) {}
+
+MSForecastServer::~MSForecastServer() {
+    stop();
+}
+
+bool MSForecastServer::start(uint16_t port, const std::string& address) {
+    if (acceptThread.joinable() || backend == nullptr) {
+        return false;
+    }
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, address.c_str(), &addr.sin_addr) != 1) {
+        LOG_WARN("MSForecastServer", "Dirección inválida", "address", address);
+        return false;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        LOG_WARN("MSForecastServer", "No se pudo crear el socket", "error", strerror(errno));
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(fd, 64) != 0) {
+        LOG_WARN("MSForecastServer", "No se pudo abrir el puerto", "address", address, "port", port,
+                 "error", strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    socklen_t length = sizeof(addr);
+    getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &length);
+    listenFd = fd;
+    listenPort = ntohs(addr.sin_port);
+    stopping = false;
+    acceptThread = std::thread(&MSForecastServer::acceptLoop, this);
+    LOG_INFO("MSForecastServer", "Servidor MS-Forecast iniciado", "address", address, "port", listenPort);
+    return true;
+}
+
+uint16_t MSForecastServer::getPort() const {
+    return listenFd >= 0 ? listenPort : 0;
+}
+
+void MSForecastServer::acceptLoop() {
+    pollfd waiting;
+    waiting.fd = listenFd;
+    waiting.events = POLLIN;
+
+    while (!stopping) {
+        waiting.revents = 0;
+        if (poll(&waiting, 1, ACCEPT_POLL_MS) <= 0) {
+            reapSessions(false);
+            continue;
+        }
+        int clientFd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (clientFd < 0) {
+            continue;
+        }
+        int noDelay = 1;
+        setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        ++connectionCount;
+
+        std::lock_guard<std::mutex> lock(sessionsMutex);
+        sessions.emplace_back();
+        Session& session = sessions.back();
+        session.fd = clientFd;
+        session.worker = std::thread(&MSForecastServer::serve, this, std::ref(session));
+    }
+}
+
+void MSForecastServer::reapSessions(bool all) {
+    std::lock_guard<std::mutex> lock(sessionsMutex);
+    for (std::list<Session>::iterator it = sessions.begin(); it != sessions.end();) {
+        if (!all && !it->finished) {
+            ++it;
+            continue;
+        }
+        // shutdown despierta al hilo bloqueado en recv sin liberar el descriptor
+        shutdown(it->fd, SHUT_RDWR);
+        it->worker.join();
+        close(it->fd);
+        it = sessions.erase(it);
+    }
+}
+
+void MSForecastServer::serve(Session& session) {
+    std::vector<uint8_t> in(READ_BUFFER_BYTES);
+    std::vector<uint8_t> out;
+    std::vector<int> sensorIds;
+    std::vector<ClimateSnapshot> snapshots;
+    size_t buffered = 0;
+
+    while (!stopping) {
+        ssize_t n = recv(session.fd, &in[buffered], in.size() - buffered, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        buffered += static_cast<size_t>(n);
+
+        ServerFaults current;
+        {
+            std::lock_guard<std::mutex> lock(faultsMutex);
+            current = faults;
+        }
+
+        // Se atienden todas las peticiones completas; el resto espera al próximo recv
+        const size_t count = buffered / ForecastProtocol::REQUEST_SIZE;
+        out.clear();
+        execute(in.data(), count, current.dropEvery, sensorIds, snapshots, out);
+        const size_t consumed = count * ForecastProtocol::REQUEST_SIZE;
+        memmove(in.data(), in.data() + consumed, buffered - consumed);
+        buffered -= consumed;
+
+        if (current.responseDelay.count() > 0) {
+            std::this_thread::sleep_for(current.responseDelay);
+        }
+        if (!out.empty() && !sendAll(session.fd, out.data(), out.size())) {
+            break;
+        }
+    }
+    session.finished = true;
+}
+
+void MSForecastServer::execute(const uint8_t* in, size_t count, uint32_t dropEvery, std::vector<int>& sensorIds,
+                               std::vector<ClimateSnapshot>& snapshots, std::vector<uint8_t>& out) {
+    size_t i = 0;
+    while (i < count) {
+        ForecastRequest request = ForecastProtocol::decodeRequest(in + i * ForecastProtocol::REQUEST_SIZE);
+        const uint64_t sequence = ++requestCount;
+        if (dropEvery != 0 && sequence % dropEvery == 0) {
+            ++droppedCount;
+            ++i;
+            continue;
+        }
+
+        ForecastResponse response;
+        response.id = request.id;
+        response.op = request.op;
+        response.status = ForecastStatus::OK;
+        response.snapshot.sensorId = 0;
+        response.snapshot.temperature = 0.0f;
+        response.snapshot.humidity = 0.0f;
+        response.snapshot.timestamp = time(nullptr);
+
+        if (request.op == ForecastOp::READ_SNAPSHOT) {
+            // Las lecturas de mediciones consecutivas se resuelven en una sola llamada
+            size_t end = i + 1;
+            while (end < count && in[end * ForecastProtocol::REQUEST_SIZE + 4] ==
+                                      static_cast<uint8_t>(ForecastOp::READ_SNAPSHOT)) {
+                ++end;
+            }
+            sensorIds.clear();
+            sensorIds.push_back(request.arg);
+            for (size_t j = i + 1; j < end; ++j) {
+                sensorIds.push_back(ForecastProtocol::decodeRequest(in + j * ForecastProtocol::REQUEST_SIZE).arg);
+            }
+
+            bool batched = backend->readSnapshots(sensorIds, snapshots) && snapshots.size() == sensorIds.size();
+            for (size_t j = i; j < end; ++j) {
+                ForecastRequest read = j == i ? request
+                    : ForecastProtocol::decodeRequest(in + j * ForecastProtocol::REQUEST_SIZE);
+                if (j > i) {
+                    const uint64_t readSequence = ++requestCount;
+                    if (dropEvery != 0 && readSequence % dropEvery == 0) {
+                        ++droppedCount;
+                        continue;
+                    }
+                }
+                response.id = read.id;
+                if (batched) {
+                    response.status = ForecastStatus::OK;
+                    response.snapshot = snapshots[j - i];
+                } else if (read.arg == 0) {
+                    // La API sin lecturas por lote sólo conoce el sensor por defecto
+                    response.status = ForecastStatus::OK;
+                    response.snapshot = backend->readSnapshot();
+                } else {
+                    response.status = ForecastStatus::REJECTED;
+                    response.snapshot.sensorId = read.arg;
+                }
+                appendResponse(out, response);
+            }
+            i = end;
+            continue;
+        }
+
+        bool accepted = true;
+        switch (request.op) {
+            case ForecastOp::UP_TEMP:
+                accepted = backend->upTemp(request.arg);
+                break;
+            case ForecastOp::DOWN_TEMP:
+                accepted = backend->downTemp(request.arg);
+                break;
+            case ForecastOp::UP_HUMIDITY:
+                accepted = backend->upHumidity(request.arg);
+                break;
+            case ForecastOp::DOWN_HUMIDITY:
+                accepted = backend->downHumidity(request.arg);
+                break;
+            case ForecastOp::READ_TEMP:
+                response.snapshot.temperature = backend->readTemp();
+                break;
+            case ForecastOp::READ_HUMIDITY:
+                response.snapshot.humidity = backend->readHumidity();
+                break;
+            default:
+                response.status = ForecastStatus::BAD_REQUEST;
+                break;
+        }
+        if (!accepted) {
+            response.status = ForecastStatus::REJECTED;
+        }
+        appendResponse(out, response);
+        ++i;
+    }
+}
+
+void MSForecastServer::stop() {
+    stopping = true;
+    if (acceptThread.joinable()) {
+        acceptThread.join();
+    }
+    reapSessions(true);
+    if (listenFd >= 0) {
+        close(listenFd);
+        listenFd = -1;
+        LOG_INFO("MSForecastServer", "Servidor MS-Forecast detenido", "connections", connectionCount.load(),
+                 "requests", requestCount.load());
+    }
+}
+
+void MSForecastServer::setFaults(const ServerFaults& serverFaults) {
+    std::lock_guard<std::mutex> lock(faultsMutex);
+    faults = serverFaults;
+}
+
+ForecastServerStats MSForecastServer::getStats() const {
+    ForecastServerStats stats;
+    stats.connections = connectionCount.load();
+    stats.requests = requestCount.load();
+    stats.dropped = droppedCount.load();
+    return stats;
+}
@@ -0,0 +1,206 @@
+#include "../include/MetricsExporter.h"
+#include "../include/Logger.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+namespace {
+
+const int ACCEPT_POLL_MS = 200;             ///< Espera máxima entre comprobaciones de parada
+const int CLIENT_TIMEOUT_MS = 2000;         ///< Tiempo máximo para recibir la petición
+const size_t MAX_REQUEST_BYTES = 4096;      ///< Tamaño máximo de la cabecera de la petición
+
+bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+std::string httpResponse(const char* status, const char* contentType, const std::string& body) {
+    std::string response = "HTTP/1.1 ";
+    response += status;
+    response += "\r\nContent-Type: ";
+    response += contentType;
+    response += "\r\nContent-Length: " + std::to_string(body.size());
+    response += "\r\nConnection: close\r\n\r\n";
+    response += body;
+    return response;
+}
+
+} // namespace
+
+MetricsExporter::MetricsExporter(MetricsRegistry& metrics)
+    : registry(metrics), fileIntervalMs(0), listenFd(-1), httpPort(0), stopping(false) {}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+bool MetricsExporter::writeFile(const std::string& path) const {
+    std::string text = registry.renderPrometheus();
+    std::string tmpPath = path + ".tmp";
+
+    FILE* file = fopen(tmpPath.c_str(), "w");
+    if (!file) {
+        LOG_WARN("MetricsExporter", "No se pudo abrir el archivo de métricas", "path", tmpPath,
+                 "error", strerror(errno));
+        return false;
+    }
+    bool ok = fwrite(text.data(), 1, text.size(), file) == text.size();
+    ok = fclose(file) == 0 && ok;
+    if (!ok || rename(tmpPath.c_str(), path.c_str()) != 0) {
+        LOG_WARN("MetricsExporter", "No se pudo escribir el archivo de métricas", "path", path);
+        remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool MetricsExporter::startFileExport(const std::string& path, unsigned intervalMs) {
+    if (fileThread.joinable() || path.empty() || intervalMs == 0) {
+        return false;
+    }
+    filePath = path;
+    fileIntervalMs = intervalMs;
+    stopping = false;
+    fileThread = std::thread(&MetricsExporter::fileLoop, this);
+    LOG_INFO("MetricsExporter", "Exportación a archivo iniciada", "path", filePath, "interval_ms", intervalMs);
+    return true;
+}
+
+void MetricsExporter::fileLoop() {
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    while (!stopping) {
+        lock.unlock();
+        writeFile(filePath);
+        lock.lock();
+        wakeUp.wait_for(lock, std::chrono::milliseconds(fileIntervalMs), [this]() { return stopping.load(); });
+    }
+    lock.unlock();
+    writeFile(filePath);
+}
+
+bool MetricsExporter::startHttpServer(uint16_t port, const std::string& address) {
+    if (httpThread.joinable()) {
+        return false;
+    }
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, address.c_str(), &addr.sin_addr) != 1) {
+        LOG_WARN("MetricsExporter", "Dirección inválida para el servidor de métricas", "address", address);
+        return false;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        LOG_WARN("MetricsExporter", "No se pudo crear el socket de métricas", "error", strerror(errno));
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(fd, 16) != 0) {
+        LOG_WARN("MetricsExporter", "No se pudo abrir el puerto de métricas", "address", address,
+                 "port", port, "error", strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    socklen_t length = sizeof(addr);
+    getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &length);
+    listenFd = fd;
+    httpPort = ntohs(addr.sin_port);
+    stopping = false;
+    httpThread = std::thread(&MetricsExporter::httpLoop, this);
+    LOG_INFO("MetricsExporter", "Servidor de métricas iniciado", "address", address, "port", httpPort);
+    return true;
+}
+
+uint16_t MetricsExporter::getHttpPort() const {
+    return listenFd >= 0 ? httpPort : 0;
+}
+
+void MetricsExporter::httpLoop() {
+    pollfd waiting;
+    waiting.fd = listenFd;
+    waiting.events = POLLIN;
+
+    while (!stopping) {
+        waiting.revents = 0;
+        if (poll(&waiting, 1, ACCEPT_POLL_MS) <= 0) {
+            continue;
+        }
+        int clientFd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (clientFd >= 0) {
+            serveClient(clientFd);
+        }
+    }
+}
+
+void MetricsExporter::serveClient(int clientFd) {
+    timeval timeout;
+    timeout.tv_sec = CLIENT_TIMEOUT_MS / 1000;
+    timeout.tv_usec = (CLIENT_TIMEOUT_MS % 1000) * 1000;
+    setsockopt(clientFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    // Sólo hace falta la línea de petición; el resto de la cabecera se ignora
+    std::string request;
+    char buffer[512];
+    while (request.find("\r\n") == std::string::npos && request.size() < MAX_REQUEST_BYTES) {
+        ssize_t n = recv(clientFd, buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        request.append(buffer, static_cast<size_t>(n));
+    }
+
+    std::string response;
+    if (request.compare(0, 13, "GET /metrics ") == 0 || request.compare(0, 6, "GET / ") == 0) {
+        response = httpResponse("200 OK", "text/plain; version=0.0.4; charset=utf-8", registry.renderPrometheus());
+    } else if (request.compare(0, 4, "GET ") == 0) {
+        response = httpResponse("404 Not Found", "text/plain", "Not Found\n");
+    } else {
+        response = httpResponse("400 Bad Request", "text/plain", "Bad Request\n");
+    }
+    sendAll(clientFd, response);
+    close(clientFd);
+}
+
+void MetricsExporter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+
+    if (fileThread.joinable()) {
+        fileThread.join();
+    }
+    if (httpThread.joinable()) {
+        httpThread.join();
+    }
+    if (listenFd >= 0) {
+        close(listenFd);
+        listenFd = -1;
+    }
+}
@@ -0,0 +1,135 @@
+#include "../include/MetricsRegistry.h"
+#include <cstdio>
+#include <cmath>
+
+namespace {
+
+const double EXPORTED_QUANTILES[] = { 0.5, 0.9, 0.99, 0.999 };
+
+/**
+ * @brief Une las etiquetas de una serie con una etiqueta adicional
+ */
+std::string joinLabels(const std::string& labels, const std::string& extra) {
+    if (labels.empty() && extra.empty()) {
+        return "";
+    }
+    if (labels.empty() || extra.empty()) {
+        return "{" + labels + extra + "}";
+    }
+    return "{" + labels + "," + extra + "}";
+}
+
+void appendSample(std::string& out, const std::string& name, const std::string& labels, double value) {
+    char number[32];
+    if (std::isnan(value)) {
+        snprintf(number, sizeof(number), "NaN");
+    } else {
+        snprintf(number, sizeof(number), "%.9g", value);
+    }
+    out += name;
+    out += labels;
+    out += ' ';
+    out += number;
+    out += '\n';
+}
+
+void appendSample(std::string& out, const std::string& name, const std::string& labels, uint64_t value) {
+    out += name;
+    out += labels;
+    out += ' ';
+    out += std::to_string(value);
+    out += '\n';
+}
+
+} // namespace
+
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+LatencyHistogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                             const std::string& labels) {
+    std::lock_guard<std::mutex> lock(familiesMutex);
+    Family& family = families[name];
+    if (family.help.empty()) {
+        family.help = help;
+    }
+    std::unique_ptr<LatencyHistogram>& slot = family.histograms[labels];
+    if (!slot) {
+        slot.reset(new LatencyHistogram());
+    }
+    return *slot;
+}
+
+MetricCounter& MetricsRegistry::counter(const std::string& name, const std::string& help,
+                                        const std::string& labels) {
+    std::lock_guard<std::mutex> lock(familiesMutex);
+    Family& family = families[name];
+    if (family.help.empty()) {
+        family.help = help;
+    }
+    std::unique_ptr<MetricCounter>& slot = family.counters[labels];
+    if (!slot) {
+        slot.reset(new MetricCounter());
+    }
+    return *slot;
+}
+
+bool MetricsRegistry::getHistogram(const std::string& name, const std::string& labels,
+                                   HistogramSnapshot& snapshot) const {
+    std::lock_guard<std::mutex> lock(familiesMutex);
+    std::map<std::string, Family>::const_iterator family = families.find(name);
+    if (family == families.end()) {
+        return false;
+    }
+    std::map<std::string, std::unique_ptr<LatencyHistogram>>::const_iterator entry =
+        family->second.histograms.find(labels);
+    if (entry == family->second.histograms.end()) {
+        return false;
+    }
+    snapshot = entry->second->snapshot();
+    return true;
+}
+
+std::string MetricsRegistry::renderPrometheus() const {
+    std::lock_guard<std::mutex> lock(familiesMutex);
+    std::string out;
+    out.reserve(4096);
+
+    for (const auto& entry : families) {
+        const std::string& name = entry.first;
+        const Family& family = entry.second;
+
+        if (!family.histograms.empty()) {
+            out += "# HELP " + name + " " + family.help + "\n";
+            out += "# TYPE " + name + " summary\n";
+            std::string maxSeries;
+            for (const auto& series : family.histograms) {
+                HistogramSnapshot snapshot = series.second->snapshot();
+                for (double quantile : EXPORTED_QUANTILES) {
+                    char label[32];
+                    snprintf(label, sizeof(label), "quantile=\"%g\"", quantile);
+                    // Sin muestras los cuantiles no están definidos
+                    appendSample(out, name, joinLabels(series.first, label),
+                                 snapshot.count ? snapshot.percentile(quantile) / 1e9 : std::nan(""));
+                }
+                appendSample(out, name + "_sum", joinLabels(series.first, ""), snapshot.sumNanos / 1e9);
+                appendSample(out, name + "_count", joinLabels(series.first, ""), snapshot.count);
+                appendSample(maxSeries, name + "_max", joinLabels(series.first, ""), snapshot.maxNanos / 1e9);
+            }
+            out += "# HELP " + name + "_max Máximo de " + name + "\n";
+            out += "# TYPE " + name + "_max gauge\n";
+            out += maxSeries;
+        }
+
+        if (!family.counters.empty()) {
+            out += "# HELP " + name + " " + family.help + "\n";
+            out += "# TYPE " + name + " counter\n";
+            for (const auto& series : family.counters) {
+                appendSample(out, name, joinLabels(series.first, ""), series.second->get());
+            }
+        }
+    }
+    return out;
+}
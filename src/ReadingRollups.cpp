@@ -0,0 +1,212 @@
+#include "../include/ReadingRollups.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+/**
+ * @brief Alinea un timestamp al inicio de su bucket
+ * @param timestamp Timestamp a alinear
+ * @param width Ancho del bucket en segundos
+ * @return Inicio del bucket (también para timestamps negativos)
+ */
+time_t alignDown(time_t timestamp, time_t width) {
+    time_t remainder = timestamp % width;
+    return remainder < 0 ? timestamp - remainder - width : timestamp - remainder;
+}
+
+} // namespace
+
+const int ReadingRollups::TIER_COUNT;
+const time_t ReadingRollups::ALLOWED_LATENESS;
+const time_t ReadingRollups::MINUTE_RETENTION;
+
+float RollupBucket::meanTemperature() const {
+    return count ? static_cast<float>(sumTemperature / count) : 0.0f;
+}
+
+float RollupBucket::meanHumidity() const {
+    return count ? static_cast<float>(sumHumidity / count) : 0.0f;
+}
+
+ReadingRollups::ReadingRollups() {
+    clear();
+}
+
+time_t ReadingRollups::tierWidth(RollupTier tier) {
+    switch (tier) {
+        case RollupTier::MINUTE: return 60;
+        case RollupTier::HOUR: return 3600;
+        case RollupTier::DAY: return 86400;
+        default: return 60;
+    }
+}
+
+const char* ReadingRollups::tierName(RollupTier tier) {
+    switch (tier) {
+        case RollupTier::MINUTE: return "minuto";
+        case RollupTier::HOUR: return "hora";
+        case RollupTier::DAY: return "día";
+        default: return "desconocido";
+    }
+}
+
+RollupBucket& ReadingRollups::bucketFor(Tier& tier, time_t start) {
+    auto result = tier.buckets.insert(std::make_pair(start, RollupBucket()));
+    RollupBucket& bucket = result.first->second;
+    if (result.second) {
+        bucket.start = start;
+        bucket.count = 0;
+        bucket.minTemperature = std::numeric_limits<float>::max();
+        bucket.maxTemperature = std::numeric_limits<float>::lowest();
+        bucket.sumTemperature = 0.0;
+        bucket.minHumidity = std::numeric_limits<float>::max();
+        bucket.maxHumidity = std::numeric_limits<float>::lowest();
+        bucket.sumHumidity = 0.0;
+        tier.firstStart = std::min(tier.firstStart, start);
+        tier.lastStart = std::max(tier.lastStart, start);
+    }
+    return bucket;
+}
+
+void ReadingRollups::add(time_t timestamp, float temperature, float humidity) {
+    latestTimestamp = std::max(latestTimestamp, timestamp);
+    for (int i = 0; i < TIER_COUNT; ++i) {
+        Tier& tier = tiers[i];
+        time_t start = alignDown(timestamp, tierWidth(static_cast<RollupTier>(i)));
+        if (i == static_cast<int>(RollupTier::MINUTE) && start < minuteCutoff) {
+            // Minuto ya descartado: sólo se actualizan la hora y el día
+            continue;
+        }
+
+        RollupBucket& bucket = bucketFor(tier, start);
+        ++bucket.count;
+        bucket.minTemperature = std::min(bucket.minTemperature, temperature);
+        bucket.maxTemperature = std::max(bucket.maxTemperature, temperature);
+        bucket.sumTemperature += temperature;
+        bucket.minHumidity = std::min(bucket.minHumidity, humidity);
+        bucket.maxHumidity = std::max(bucket.maxHumidity, humidity);
+        bucket.sumHumidity += humidity;
+
+        tier.dirty.insert(start);
+    }
+}
+
+void ReadingRollups::load(RollupTier tier, const RollupBucket& bucket) {
+    Tier& state = tiers[static_cast<int>(tier)];
+    bucketFor(state, bucket.start) = bucket;
+    if (tier == RollupTier::MINUTE) {
+        latestTimestamp = std::max(latestTimestamp, bucket.start);
+    }
+}
+
+std::vector<RollupBucket> ReadingRollups::getBuckets(RollupTier tier, time_t startTime, time_t endTime) const {
+    std::vector<RollupBucket> result;
+    const Tier& state = tiers[static_cast<int>(tier)];
+    if (state.buckets.empty()) {
+        return result;
+    }
+
+    // El recorrido se limita a los buckets existentes para no iterar rangos abiertos
+    time_t width = tierWidth(tier);
+    time_t from = alignDown(std::max(startTime, state.firstStart), width);
+    time_t to = std::min(endTime, state.lastStart);
+
+    for (time_t start = from; start <= to; start += width) {
+        auto it = state.buckets.find(start);
+        if (it != state.buckets.end()) {
+            result.push_back(it->second);
+        }
+    }
+    return result;
+}
+
+RollupTier ReadingRollups::selectTier(time_t startTime, time_t endTime, size_t maxBuckets) {
+    time_t span = endTime > startTime ? endTime - startTime : 0;
+    for (int i = 0; i < TIER_COUNT; ++i) {
+        RollupTier tier = static_cast<RollupTier>(i);
+        if (static_cast<size_t>(span / tierWidth(tier)) + 1 <= maxBuckets) {
+            return tier;
+        }
+    }
+    return RollupTier::DAY;
+}
+
+std::vector<std::pair<RollupTier, RollupBucket>> ReadingRollups::takeDirtyBuckets() {
+    std::vector<std::pair<RollupTier, RollupBucket>> result;
+    for (int i = 0; i < TIER_COUNT; ++i) {
+        Tier& tier = tiers[i];
+        for (time_t start : tier.dirty) {
+            result.push_back(std::make_pair(static_cast<RollupTier>(i), tier.buckets[start]));
+        }
+        tier.dirty.clear();
+    }
+    if (latestTimestamp != std::numeric_limits<time_t>::min()) {
+        flushedMinute = alignDown(latestTimestamp - ALLOWED_LATENESS, 60);
+    }
+    return result;
+}
+
+bool ReadingRollups::hasClosedMinute() const {
+    if (latestTimestamp == std::numeric_limits<time_t>::min()) {
+        return false;
+    }
+    return alignDown(latestTimestamp - ALLOWED_LATENESS, 60) > flushedMinute;
+}
+
+size_t ReadingRollups::evictExpiredMinutes() {
+    Tier& tier = tiers[static_cast<int>(RollupTier::MINUTE)];
+    if (latestTimestamp == std::numeric_limits<time_t>::min()) {
+        return 0;
+    }
+    const time_t cutoff = alignDown(latestTimestamp - ALLOWED_LATENESS - MINUTE_RETENTION, 60);
+    if (cutoff <= minuteCutoff) {
+        return 0;
+    }
+    minuteCutoff = cutoff;
+    if (tier.buckets.empty() || tier.firstStart >= cutoff) {
+        return 0;
+    }
+
+    size_t evicted = 0;
+    time_t firstStart = std::numeric_limits<time_t>::max();
+    for (auto it = tier.buckets.begin(); it != tier.buckets.end();) {
+        if (it->first < cutoff) {
+            tier.dirty.erase(it->first);
+            it = tier.buckets.erase(it);
+            ++evicted;
+        } else {
+            firstStart = std::min(firstStart, it->first);
+            ++it;
+        }
+    }
+    tier.firstStart = firstStart;
+    if (tier.buckets.empty()) {
+        tier.lastStart = std::numeric_limits<time_t>::min();
+    }
+    return evicted;
+}
+
+time_t ReadingRollups::getMinuteCutoff() const {
+    return minuteCutoff;
+}
+
+uint64_t ReadingRollups::totalCount() const {
+    uint64_t total = 0;
+    for (const auto& entry : tiers[static_cast<int>(RollupTier::DAY)].buckets) {
+        total += entry.second.count;
+    }
+    return total;
+}
+
+void ReadingRollups::clear() {
+    for (int i = 0; i < TIER_COUNT; ++i) {
+        tiers[i].buckets.clear();
+        tiers[i].dirty.clear();
+        tiers[i].firstStart = std::numeric_limits<time_t>::max();
+        tiers[i].lastStart = std::numeric_limits<time_t>::min();
+    }
+    latestTimestamp = std::numeric_limits<time_t>::min();
+    flushedMinute = std::numeric_limits<time_t>::min();
+    minuteCutoff = std::numeric_limits<time_t>::min();
+}
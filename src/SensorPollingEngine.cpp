@@ -0,0 +1,129 @@
+#include "../include/SensorPollingEngine.h"
+#include "../include/Logger.h"
+#include <algorithm>
+#include <ctime>
+
+const size_t SensorPollingEngine::SLOTS_PER_PERIOD;
+const size_t SensorPollingEngine::SENSORS_PER_TASK;
+
+SensorPollingEngine::SensorPollingEngine(ReadingSink readingSink, size_t threadCount,
+                                         std::chrono::milliseconds pollPeriod)
+    : sink(readingSink), period(pollPeriod), pool(threadCount), wheel(SLOTS_PER_PERIOD),
+      running(false), pollCount(0), overrunCount(0), lagSumMicros(0), lagMaxMicros(0) {
+    LOG_INFO("SensorPollingEngine", "Inicializado", "threads", pool.getThreadCount(),
+             "period_ms", static_cast<long long>(period.count()));
+}
+
+SensorPollingEngine::~SensorPollingEngine() {
+    stop();
+}
+
+bool SensorPollingEngine::addSensor(int sensorId, IMSForecast* forecast) {
+    std::lock_guard<std::mutex> lock(sensorsMutex);
+    if (sensorsById.count(sensorId)) {
+        delete forecast;
+        return false;
+    }
+
+    std::unique_ptr<SensorSlot> slot(new SensorSlot());
+    slot->sensorId = sensorId;
+    slot->forecast.reset(forecast);
+    slot->busy = false;
+
+    // Reparto en round-robin: cada ranura recibe la misma cantidad de sensores
+    wheel[sensors.size() % SLOTS_PER_PERIOD].push_back(slot.get());
+    sensorsById[sensorId] = slot.get();
+    sensors.push_back(std::move(slot));
+    return true;
+}
+
+IMSForecast* SensorPollingEngine::getSensor(int sensorId) const {
+    std::lock_guard<std::mutex> lock(sensorsMutex);
+    auto it = sensorsById.find(sensorId);
+    return it != sensorsById.end() ? it->second->forecast.get() : nullptr;
+}
+
+size_t SensorPollingEngine::getSensorCount() const {
+    std::lock_guard<std::mutex> lock(sensorsMutex);
+    return sensors.size();
+}
+
+void SensorPollingEngine::start() {
+    if (running.exchange(true)) {
+        return;
+    }
+    scheduler = std::thread(&SensorPollingEngine::schedulerLoop, this);
+    LOG_INFO("SensorPollingEngine", "Sondeo iniciado", "sensors", getSensorCount());
+}
+
+void SensorPollingEngine::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    scheduler.join();
+    pool.waitIdle();
+    LOG_INFO("SensorPollingEngine", "Sondeo detenido", "polls", pollCount.load(), "overruns", overrunCount.load());
+}
+
+bool SensorPollingEngine::isRunning() const {
+    return running.load();
+}
+
+void SensorPollingEngine::schedulerLoop() {
+    const std::chrono::steady_clock::duration tick = period / static_cast<int>(SLOTS_PER_PERIOD);
+    std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+    size_t slotIndex = 0;
+
+    while (running.load()) {
+        std::vector<SensorSlot*> slot;
+        {
+            std::lock_guard<std::mutex> lock(sensorsMutex);
+            slot = wheel[slotIndex];
+        }
+
+        for (size_t begin = 0; begin < slot.size(); begin += SENSORS_PER_TASK) {
+            size_t end = std::min(slot.size(), begin + SENSORS_PER_TASK);
+            std::vector<SensorSlot*> group(slot.begin() + begin, slot.begin() + end);
+            std::chrono::steady_clock::time_point scheduledAt = next;
+            pool.submit([this, group, scheduledAt]() { pollGroup(group, scheduledAt); });
+        }
+
+        // Planificación sobre un reloj absoluto: los retrasos de un tick no se acumulan
+        slotIndex = (slotIndex + 1) % SLOTS_PER_PERIOD;
+        next += tick;
+        std::this_thread::sleep_until(next);
+    }
+}
+
+void SensorPollingEngine::pollGroup(const std::vector<SensorSlot*>& group,
+                                    std::chrono::steady_clock::time_point scheduledAt) {
+    for (SensorSlot* sensor : group) {
+        if (sensor->busy.exchange(true)) {
+            ++overrunCount;
+            continue;
+        }
+
+        ClimateSnapshot snapshot = sensor->forecast->readSnapshot();
+        sink(ClimateReading(0, snapshot.temperature, snapshot.humidity,
+                            snapshot.timestamp, sensor->sensorId));
+        sensor->busy = false;
+
+        uint64_t lag = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - scheduledAt).count());
+        ++pollCount;
+        lagSumMicros += lag;
+
+        uint64_t currentMax = lagMaxMicros.load();
+        while (lag > currentMax && !lagMaxMicros.compare_exchange_weak(currentMax, lag)) {
+        }
+    }
+}
+
+SensorPollingEngine::Stats SensorPollingEngine::getStats() const {
+    Stats stats;
+    stats.polls = pollCount.load();
+    stats.overruns = overrunCount.load();
+    stats.meanLagMs = stats.polls ? lagSumMicros.load() / 1000.0 / stats.polls : 0.0;
+    stats.maxLagMs = lagMaxMicros.load() / 1000.0;
+    return stats;
+}
@@ -0,0 +1,27 @@
+#include "../include/SmtpTransportMock.h"
+#include "../include/Logger.h"
+#include <thread>
+#include <chrono>
+
+SmtpTransportMock::SmtpTransportMock(int latencyMs, bool echoToConsole)
+    : latencyMillis(latencyMs), echo(echoToConsole), sentCount(0) {
+}
+
+bool SmtpTransportMock::send(const std::string& from, const std::string& to,
+                             const std::string& subject, const std::string& body) {
+    if (latencyMillis > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(latencyMillis));
+    }
+    
+    if (echo) {
+        LOG_INFO("SmtpTransportMock", "Email enviado (simulado)", "from", from, "to", to, "subject", subject);
+        LOG_DEBUG("SmtpTransportMock", "Cuerpo del email", "to", to, "body", body);
+    }
+    
+    ++sentCount;
+    return true;
+}
+
+uint64_t SmtpTransportMock::getSentCount() const {
+    return sentCount.load();
+}
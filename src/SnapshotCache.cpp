@@ -0,0 +1,82 @@
+#include "../include/SnapshotCache.h"
+
+SnapshotCache::SnapshotCache(Loader snapshotLoader, std::chrono::milliseconds timeToLive)
+    : loader(snapshotLoader), ttl(timeToLive), stats() {}
+
+bool SnapshotCache::get(int sensorId, ClimateSnapshot& snapshot) {
+    std::unique_lock<std::mutex> lock(mutex);
+    // Las referencias a elementos de unordered_map sobreviven a los rehash
+    Entry& entry = entries[sensorId];
+
+    if (entry.valid && std::chrono::steady_clock::now() - entry.fetched < ttl) {
+        ++stats.hits;
+        snapshot = entry.snapshot;
+        return true;
+    }
+
+    if (entry.loading) {
+        // Se comparte el resultado de la consulta en curso en lugar de pedir otra
+        ++stats.shared;
+        const uint64_t generation = entry.loadGeneration;
+        loaded.wait(lock, [&entry, generation]() { return entry.loadGeneration != generation; });
+        if (!entry.lastLoadOk) {
+            return false;
+        }
+        snapshot = entry.snapshot;
+        return true;
+    }
+
+    entry.loading = true;
+    ++stats.loads;
+    lock.unlock();
+
+    ClimateSnapshot fresh;
+    const bool ok = loader(sensorId, fresh);
+
+    lock.lock();
+    entry.loading = false;
+    entry.lastLoadOk = ok;
+    ++entry.loadGeneration;
+    if (ok) {
+        entry.snapshot = fresh;
+        entry.fetched = std::chrono::steady_clock::now();
+        entry.valid = true;
+        snapshot = fresh;
+    } else {
+        ++stats.failures;
+    }
+    lock.unlock();
+    loaded.notify_all();
+    return ok;
+}
+
+void SnapshotCache::store(const ClimateSnapshot& snapshot) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry& entry = entries[snapshot.sensorId];
+    entry.snapshot = snapshot;
+    entry.fetched = std::chrono::steady_clock::now();
+    entry.valid = true;
+    ++stats.stores;
+}
+
+void SnapshotCache::invalidate() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::unordered_map<int, Entry>::iterator it = entries.begin(); it != entries.end(); ++it) {
+        it->second.valid = false;
+    }
+}
+
+void SnapshotCache::setTtl(std::chrono::milliseconds timeToLive) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ttl = timeToLive.count() > 0 ? timeToLive : std::chrono::milliseconds(0);
+}
+
+std::chrono::milliseconds SnapshotCache::getTtl() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return ttl;
+}
+
+SnapshotCacheStats SnapshotCache::getStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
@@ -0,0 +1,312 @@
+#include "../include/StreamingStats.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+const uint32_t QuantileSketch::DEFAULT_K;
+const int ReadingStatistics::ALL_SENSORS;
+const size_t ReadingStatistics::METRIC_COUNT;
+
+namespace {
+
+/// Factor de reducción de la capacidad entre un nivel y el de abajo
+const double LEVEL_DECAY = 2.0 / 3.0;
+
+/// Capacidad mínima de un nivel
+const size_t MIN_LEVEL_CAPACITY = 2;
+
+inline time_t alignDown(time_t timestamp, time_t width) {
+    time_t remainder = timestamp % width;
+    return remainder < 0 ? timestamp - remainder - width : timestamp - remainder;
+}
+
+} // namespace
+
+RunningStats::RunningStats()
+    : count(0), mean(0.0), m2(0.0), min(0.0f), max(0.0f) {}
+
+void RunningStats::add(float value) {
+    if (count == 0) {
+        min = max = value;
+    } else {
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+    ++count;
+    const double delta = value - mean;
+    mean += delta / static_cast<double>(count);
+    m2 += delta * (value - mean);
+}
+
+void RunningStats::merge(const RunningStats& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    const double total = static_cast<double>(count + other.count);
+    const double delta = other.mean - mean;
+    mean += delta * static_cast<double>(other.count) / total;
+    m2 += other.m2 + delta * delta * static_cast<double>(count) * static_cast<double>(other.count) / total;
+    count += other.count;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+}
+
+double RunningStats::variance() const {
+    return count > 1 ? m2 / static_cast<double>(count) : 0.0;
+}
+
+double RunningStats::stddev() const {
+    return std::sqrt(variance());
+}
+
+QuantileSketch::QuantileSketch(uint32_t capacity)
+    : k(std::max<uint32_t>(capacity, 8)), n(0), random(0x9E3779B97F4A7C15ULL), retained(0),
+      retainedLimit(0), levels(1) {
+    updateLimit();
+}
+
+void QuantileSketch::updateLimit() {
+    // La capacidad decrece hacia abajo: el nivel superior tiene k
+    capacities.resize(levels.size());
+    retainedLimit = 0;
+    double capacity = k;
+    for (size_t level = levels.size(); level-- > 0;) {
+        capacities[level] = std::max(static_cast<size_t>(std::ceil(capacity)), MIN_LEVEL_CAPACITY);
+        retainedLimit += capacities[level];
+        capacity *= LEVEL_DECAY;
+    }
+}
+
+void QuantileSketch::compress() {
+    for (size_t level = 0; level < levels.size(); ++level) {
+        if (levels[level].size() < capacities[level]) {
+            continue;
+        }
+        if (level + 1 == levels.size()) {
+            levels.push_back(std::vector<float>());
+            updateLimit();
+        }
+
+        std::vector<float>& items = levels[level];
+        std::vector<float>& above = levels[level + 1];
+        std::sort(items.begin(), items.end());
+
+        // Con cantidad impar el último elemento se queda en el nivel
+        const size_t paired = items.size() & ~static_cast<size_t>(1);
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        for (size_t i = static_cast<size_t>(random & 1); i < paired; i += 2) {
+            above.push_back(items[i]);
+        }
+        retained -= paired / 2;
+        items.erase(items.begin(), items.begin() + static_cast<std::ptrdiff_t>(paired));
+        return;
+    }
+}
+
+void QuantileSketch::add(float value) {
+    levels[0].push_back(value);
+    ++n;
+    ++retained;
+    if (retained >= retainedLimit) {
+        compress();
+    }
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.n == 0) {
+        return;
+    }
+    if (levels.size() < other.levels.size()) {
+        levels.resize(other.levels.size());
+        updateLimit();
+    }
+    for (size_t level = 0; level < other.levels.size(); ++level) {
+        levels[level].insert(levels[level].end(), other.levels[level].begin(), other.levels[level].end());
+    }
+    n += other.n;
+    retained += other.retained;
+    while (retained >= retainedLimit) {
+        const size_t before = retained;
+        compress();
+        if (retained == before) {
+            break;
+        }
+    }
+}
+
+float QuantileSketch::quantile(double q) const {
+    if (n == 0) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+
+    std::vector<std::pair<float, uint64_t>> weighted;
+    weighted.reserve(retained);
+    for (size_t level = 0; level < levels.size(); ++level) {
+        for (float value : levels[level]) {
+            weighted.push_back(std::make_pair(value, 1ULL << level));
+        }
+    }
+    std::sort(weighted.begin(), weighted.end());
+
+    const double target = std::min(std::max(q, 0.0), 1.0) * static_cast<double>(n);
+    uint64_t cumulative = 0;
+    for (const auto& item : weighted) {
+        cumulative += item.second;
+        if (static_cast<double>(cumulative) >= target) {
+            return item.first;
+        }
+    }
+    return weighted.back().first;
+}
+
+MetricStatistics::MetricStatistics(uint32_t sketchCapacity)
+    : sketch(sketchCapacity) {}
+
+void MetricStatistics::add(float value) {
+    running.add(value);
+    sketch.add(value);
+}
+
+void MetricStatistics::merge(const MetricStatistics& other) {
+    running.merge(other.running);
+    sketch.merge(other.sketch);
+}
+
+float MetricStatistics::quantile(double q) const {
+    if (running.count == 0) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+    if (q <= 0.0) {
+        return running.min;
+    }
+    if (q >= 1.0) {
+        return running.max;
+    }
+    return std::min(std::max(sketch.quantile(q), running.min), running.max);
+}
+
+ReadingStatistics::ReadingStatistics(time_t windowWidth, size_t windowCount, uint32_t capacity)
+    : windowSeconds(windowWidth > 0 ? windowWidth : 3600), retainedWindows(std::max<size_t>(windowCount, 1)),
+      sketchCapacity(capacity) {
+    allTotal = makeTotals();
+}
+
+ReadingStatistics::Totals ReadingStatistics::makeTotals() const {
+    return Totals(METRIC_COUNT, MetricStatistics(sketchCapacity));
+}
+
+void ReadingStatistics::addLocked(const ClimateReading& reading) {
+    std::unordered_map<int, Totals>::iterator sensor = sensors.find(reading.getSensorId());
+    if (sensor == sensors.end()) {
+        sensor = sensors.insert(std::make_pair(reading.getSensorId(), makeTotals())).first;
+    }
+    const float values[METRIC_COUNT] = { reading.getTemperature(), reading.getHumidity() };
+    for (size_t m = 0; m < METRIC_COUNT; ++m) {
+        sensor->second[m].add(values[m]);
+        allTotal[m].add(values[m]);
+    }
+    addToWindow(reading.getTimestamp(), values);
+}
+
+void ReadingStatistics::addToWindow(time_t timestamp, const float* values) {
+    const time_t start = alignDown(timestamp, windowSeconds);
+    std::deque<Window>& windows = allWindows;
+    if (!windows.empty() && start == windows.back().start) {
+        // Caso habitual: la lectura cae en la ventana actual
+        for (size_t m = 0; m < METRIC_COUNT; ++m) {
+            windows.back().metrics[m].add(values[m]);
+        }
+        return;
+    }
+    if (!windows.empty() && start < windows.back().start) {
+        // Lectura atrasada: se busca su ventana si todavía está retenida
+        if (start < windows.back().start - static_cast<time_t>(retainedWindows - 1) * windowSeconds) {
+            return;
+        }
+    }
+
+    std::deque<Window>::iterator window = std::lower_bound(windows.begin(), windows.end(), start,
+        [](const Window& w, time_t t) { return w.start < t; });
+    if (window == windows.end() || window->start != start) {
+        Window created;
+        created.start = start;
+        created.metrics.assign(METRIC_COUNT, MetricStatistics(sketchCapacity));
+        window = windows.insert(window, created);
+    }
+    for (size_t m = 0; m < METRIC_COUNT; ++m) {
+        window->metrics[m].add(values[m]);
+    }
+
+    // Se descartan las ventanas que quedaron fuera del rango retenido
+    const time_t oldest = windows.back().start - static_cast<time_t>(retainedWindows - 1) * windowSeconds;
+    while (windows.front().start < oldest) {
+        windows.pop_front();
+    }
+}
+
+void ReadingStatistics::add(const ClimateReading& reading) {
+    std::lock_guard<std::mutex> lock(mutex);
+    addLocked(reading);
+}
+
+void ReadingStatistics::addBatch(const std::vector<ClimateReading>& readings) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& reading : readings) {
+        addLocked(reading);
+    }
+}
+
+const ReadingStatistics::Totals* ReadingStatistics::findTotals(int sensorId) const {
+    if (sensorId == ALL_SENSORS) {
+        return &allTotal;
+    }
+    std::unordered_map<int, Totals>::const_iterator sensor = sensors.find(sensorId);
+    return sensor != sensors.end() ? &sensor->second : nullptr;
+}
+
+MetricStatistics ReadingStatistics::total(AlertMetric metric, int sensorId) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const Totals* totals = findTotals(sensorId);
+    return totals ? (*totals)[static_cast<size_t>(metric)] : MetricStatistics(sketchCapacity);
+}
+
+MetricStatistics ReadingStatistics::range(AlertMetric metric, time_t startTime, time_t endTime) const {
+    MetricStatistics result(sketchCapacity);
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& window : allWindows) {
+        if (window.start + windowSeconds > startTime && window.start <= endTime) {
+            result.merge(window.metrics[static_cast<size_t>(metric)]);
+        }
+    }
+    return result;
+}
+
+MetricStatistics ReadingStatistics::combine(AlertMetric metric, const std::vector<int>& sensorIds) const {
+    MetricStatistics result(sketchCapacity);
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int sensorId : sensorIds) {
+        const Totals* totals = findTotals(sensorId);
+        if (totals) {
+            result.merge((*totals)[static_cast<size_t>(metric)]);
+        }
+    }
+    return result;
+}
+
+std::vector<int> ReadingStatistics::sensorIds() const {
+    std::vector<int> ids;
+    std::lock_guard<std::mutex> lock(mutex);
+    ids.reserve(sensors.size());
+    for (const auto& entry : sensors) {
+        ids.push_back(entry.first);
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
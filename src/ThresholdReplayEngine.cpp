@@ -0,0 +1,225 @@
+#include "../include/ThresholdReplayEngine.h"
+#include "../include/ColumnarReadingStore.h"
+#include "../include/Logger.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+const size_t REPLAY_CHUNK_ROWS = 4096;       ///< Filas clasificadas por vuelta
+const int64_t MAX_TIMELINE_BUCKETS = 1 << 20; ///< Límite de puntos de la línea de tiempo
+
+/**
+ * @brief Resta dos conjuntos de contadores del seguimiento de alertas
+ */
+AlertTrackerStats subtractStats(const AlertTrackerStats& a, const AlertTrackerStats& b) {
+    AlertTrackerStats diff;
+    diff.raised = a.raised - b.raised;
+    diff.escalated = a.escalated - b.escalated;
+    diff.renotified = a.renotified - b.renotified;
+    diff.cleared = a.cleared - b.cleared;
+    diff.suppressed = a.suppressed - b.suppressed;
+    diff.rateLimited = a.rateLimited - b.rateLimited;
+    return diff;
+}
+
+void addStats(AlertTrackerStats& total, const AlertTrackerStats& delta) {
+    total.raised += delta.raised;
+    total.escalated += delta.escalated;
+    total.renotified += delta.renotified;
+    total.cleared += delta.cleared;
+    total.suppressed += delta.suppressed;
+    total.rateLimited += delta.rateLimited;
+}
+
+} // namespace
+
+ReplayRequest::ReplayRequest()
+    : applyPolicy(true), startTime(0), endTime(0), bucketSeconds(3600),
+      warmupSeconds(policy.renotifyIntervalSec), partitions(0) {}
+
+ThresholdReplayEngine::ThresholdReplayEngine(ClimateDataManager* dataMgr, size_t threadCount)
+    : dataManager(dataMgr), pool(threadCount) {}
+
+ReplayResult ThresholdReplayEngine::replay(const ReplayRequest& request) {
+    auto clockStart = std::chrono::steady_clock::now();
+    ReplayResult total = ReplayResult();
+
+    if (!dataManager || request.endTime < request.startTime) {
+        LOG_WARN("ThresholdReplayEngine", "Rango de simulación inválido",
+                 "start", request.startTime, "end", request.endTime);
+        return total;
+    }
+
+    ReplayRequest effective = request;
+    const int64_t span = static_cast<int64_t>(request.endTime) - request.startTime + 1;
+    if (effective.bucketSeconds <= 0) {
+        effective.bucketSeconds = 3600;
+    }
+    if (span / effective.bucketSeconds > MAX_TIMELINE_BUCKETS) {
+        effective.bucketSeconds = static_cast<int>((span + MAX_TIMELINE_BUCKETS - 1) / MAX_TIMELINE_BUCKETS);
+    }
+
+    const int64_t bucketCount = (span + effective.bucketSeconds - 1) / effective.bucketSeconds;
+    total.timeline.resize(static_cast<size_t>(bucketCount));
+    for (int64_t b = 0; b < bucketCount; ++b) {
+        total.timeline[b].bucketStart = static_cast<time_t>(request.startTime + b * effective.bucketSeconds);
+    }
+
+    size_t partitionCount = effective.partitions ? effective.partitions : pool.getThreadCount() * 4;
+    partitionCount = static_cast<size_t>(std::min<int64_t>(static_cast<int64_t>(partitionCount), span));
+    const int64_t partitionSpan = (span + partitionCount - 1) / partitionCount;
+
+    std::vector<ReplayResult> partials(partitionCount);
+    for (size_t p = 0; p < partitionCount; ++p) {
+        const time_t partStart = static_cast<time_t>(request.startTime + p * partitionSpan);
+        const time_t partEnd = static_cast<time_t>(std::min<int64_t>(request.endTime,
+                                                                    partStart + partitionSpan - 1));
+        ReplayResult* partial = &partials[p];
+        pool.submit([this, &effective, partStart, partEnd, partial]() {
+            replayPartition(effective, partStart, partEnd, *partial);
+        });
+    }
+    pool.waitIdle();
+
+    for (const ReplayResult& partial : partials) {
+        merge(total, partial, effective.bucketSeconds);
+    }
+    total.partitions = partitionCount;
+    total.elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - clockStart).count();
+
+    LOG_INFO("ThresholdReplayEngine", "Simulación de umbrales completada", "readings", total.readings,
+             "hits", total.readingsOutOfRange, "notifications", total.notifications,
+             "partitions", total.partitions, "elapsed_ms", total.elapsedMs);
+    return total;
+}
+
+void ThresholdReplayEngine::replayPartition(const ReplayRequest& request, time_t partStart, time_t partEnd,
+                                            ReplayResult& result) {
+    result = ReplayResult();
+
+    const int bucketSeconds = request.bucketSeconds;
+    const int64_t firstBucket = (static_cast<int64_t>(partStart) - request.startTime) / bucketSeconds;
+    const int64_t lastBucket = (static_cast<int64_t>(partEnd) - request.startTime) / bucketSeconds;
+    result.timeline.resize(static_cast<size_t>(lastBucket - firstBucket + 1));
+    for (size_t b = 0; b < result.timeline.size(); ++b) {
+        result.timeline[b].bucketStart = static_cast<time_t>(request.startTime + (firstBucket + b) * bucketSeconds);
+    }
+
+    const AlertThresholds& t = request.thresholds;
+    const AlertPolicy& policy = request.policy;
+    const bool applyPolicy = request.applyPolicy;
+    const time_t scanStart = applyPolicy && request.warmupSeconds > 0 ? partStart - request.warmupSeconds
+                                                                      : partStart;
+
+    AlertTracker tracker(policy);
+    AlertTrackerStats warmupStats = AlertTrackerStats();
+    uint8_t codes[REPLAY_CHUNK_ROWS];
+
+    dataManager->forEachReadingColumns(scanStart, partEnd,
+        [&](const SegmentView& view, size_t begin, size_t end) {
+            for (size_t base = begin; base < end; base += REPLAY_CHUNK_ROWS) {
+                const size_t rows = std::min(REPLAY_CHUNK_ROWS, end - base);
+                const size_t hits = AlertKernels::evaluate(view.temperatures + base, view.humidities + base,
+                                                           rows, t, codes);
+                // Sin métricas fuera de rango ni alertas activas solo hay que contar lecturas
+                const bool needsTracker = applyPolicy && (hits > 0 || tracker.getActiveCount() > 0);
+
+                for (size_t row = 0; row < rows; ++row) {
+                    const size_t i = base + row;
+                    const int64_t ts = view.timestamps[i];
+                    if (ts < scanStart || ts > partEnd) {
+                        continue;
+                    }
+                    const bool counting = ts >= partStart;
+                    ReplayBucket* bucket = nullptr;
+                    if (counting) {
+                        bucket = &result.timeline[static_cast<size_t>(
+                            (ts - request.startTime) / bucketSeconds - firstBucket)];
+                        ++result.readings;
+                        ++bucket->readings;
+                    }
+
+                    const uint8_t code = codes[row];
+                    if (counting && code != 0) {
+                        ++result.readingsOutOfRange;
+                        if (AlertKernels::temperatureLevel(code) != 0) {
+                            ++result.hitsBySeverity[static_cast<int>(AlertKernels::temperatureSeverity(code))];
+                            ++bucket->thresholdHits;
+                        }
+                        if (AlertKernels::humidityLevel(code) != 0) {
+                            ++result.hitsBySeverity[static_cast<int>(AlertKernels::humiditySeverity(code))];
+                            ++bucket->thresholdHits;
+                        }
+                    }
+                    if (!needsTracker) {
+                        continue;
+                    }
+
+                    // Misma evaluación que ClimateControlService::checkAlerts
+                    const int sensorId = view.sensorAt(i);
+                    const float temperature = view.temperatures[i];
+                    const float humidity = view.humidities[i];
+                    const AlertTrackerStats before = counting ? AlertTrackerStats() : tracker.getStats();
+
+                    int direction = AlertKernels::temperatureDirection(code);
+                    AlertSeverity severity = direction != 0 ? AlertKernels::temperatureSeverity(code)
+                                                            : AlertSeverity::LOW;
+                    bool cleared = temperature <= t.tempHigh - policy.temperatureHysteresis &&
+                                   temperature >= t.tempLow + policy.temperatureHysteresis;
+                    AlertTransition transition = tracker.evaluate(sensorId, AlertMetric::TEMPERATURE, direction,
+                                                                  severity, cleared, static_cast<time_t>(ts));
+                    if (counting && transition != AlertTransition::NONE) {
+                        ++result.notifications;
+                        ++result.notificationsBySeverity[static_cast<int>(
+                            transition == AlertTransition::CLEAR ? AlertSeverity::LOW : severity)];
+                        ++bucket->notifications;
+                    }
+
+                    direction = AlertKernels::humidityDirection(code);
+                    severity = direction != 0 ? AlertKernels::humiditySeverity(code) : AlertSeverity::LOW;
+                    cleared = humidity <= t.humidityHigh - policy.humidityHysteresis &&
+                              humidity >= t.humidityLow + policy.humidityHysteresis;
+                    transition = tracker.evaluate(sensorId, AlertMetric::HUMIDITY, direction,
+                                                  severity, cleared, static_cast<time_t>(ts));
+                    if (counting && transition != AlertTransition::NONE) {
+                        ++result.notifications;
+                        ++result.notificationsBySeverity[static_cast<int>(
+                            transition == AlertTransition::CLEAR ? AlertSeverity::LOW : severity)];
+                        ++bucket->notifications;
+                    }
+
+                    if (!counting) {
+                        addStats(warmupStats, subtractStats(tracker.getStats(), before));
+                    }
+                }
+            }
+            return true;
+        });
+
+    result.transitions = subtractStats(tracker.getStats(), warmupStats);
+}
+
+void ThresholdReplayEngine::merge(ReplayResult& total, const ReplayResult& partial, int bucketSeconds) {
+    total.readings += partial.readings;
+    total.readingsOutOfRange += partial.readingsOutOfRange;
+    total.notifications += partial.notifications;
+    for (int s = 0; s < 4; ++s) {
+        total.hitsBySeverity[s] += partial.hitsBySeverity[s];
+        total.notificationsBySeverity[s] += partial.notificationsBySeverity[s];
+    }
+    addStats(total.transitions, partial.transitions);
+
+    if (partial.timeline.empty() || total.timeline.empty()) {
+        return;
+    }
+    for (const ReplayBucket& bucket : partial.timeline) {
+        const size_t index = static_cast<size_t>((bucket.bucketStart - total.timeline[0].bucketStart) / bucketSeconds);
+        if (index < total.timeline.size()) {
+            total.timeline[index].readings += bucket.readings;
+            total.timeline[index].thresholdHits += bucket.thresholdHits;
+            total.timeline[index].notifications += bucket.notifications;
+        }
+    }
+}
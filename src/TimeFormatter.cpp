@@ -0,0 +1,95 @@
+#include "../include/TimeFormatter.h"
+#include <cstring>
+#include <cstdio>
+
+const size_t TimeFormatter::DATETIME_LENGTH;
+const size_t TimeFormatter::MINUTE_LENGTH;
+const size_t TimeFormatter::BUFFER_SIZE;
+
+namespace {
+
+/**
+ * @brief Prefijo "YYYY-MM-DD HH:MM:" del último minuto formateado por el hilo
+ */
+struct MinuteCache {
+    time_t minuteStart;                         ///< Primer segundo del minuto cacheado
+    bool valid;                                 ///< Indica si el prefijo es válido
+    char prefix[TimeFormatter::MINUTE_LENGTH + 1]; ///< Fecha, hora, minutos y ':'
+};
+
+inline void writeTwoDigits(char* out, int value) {
+    out[0] = static_cast<char>('0' + value / 10);
+    out[1] = static_cast<char>('0' + value % 10);
+}
+
+/**
+ * @brief Recalcula el prefijo del minuto que contiene el instante
+ * @return false si localtime_r no puede representar el instante
+ */
+bool refreshCache(MinuteCache& cache, time_t timestamp) {
+    struct tm timeinfo;
+    if (localtime_r(&timestamp, &timeinfo) == nullptr) {
+        return false;
+    }
+    int year = timeinfo.tm_year + 1900;
+    if (year < 0 || year > 9999) {
+        return false;
+    }
+
+    char* out = cache.prefix;
+    writeTwoDigits(out, year / 100);
+    writeTwoDigits(out + 2, year % 100);
+    out[4] = '-';
+    writeTwoDigits(out + 5, timeinfo.tm_mon + 1);
+    out[7] = '-';
+    writeTwoDigits(out + 8, timeinfo.tm_mday);
+    out[10] = ' ';
+    writeTwoDigits(out + 11, timeinfo.tm_hour);
+    out[13] = ':';
+    writeTwoDigits(out + 14, timeinfo.tm_min);
+    out[16] = ':';
+
+    // tm_sec puede valer 60 en zonas con segundos intercalares
+    cache.minuteStart = timestamp - timeinfo.tm_sec;
+    cache.valid = timeinfo.tm_sec < 60;
+    return true;
+}
+
+} // namespace
+
+size_t TimeFormatter::formatDateTime(time_t timestamp, char* buffer) {
+    thread_local MinuteCache cache = MinuteCache();
+
+    if (!cache.valid || timestamp < cache.minuteStart || timestamp - cache.minuteStart >= 60) {
+        if (!refreshCache(cache, timestamp)) {
+            buffer[0] = '\0';
+            return 0;
+        }
+        if (!cache.valid) {
+            // Segundo intercalar: se formatea sin caché
+            struct tm timeinfo;
+            localtime_r(&timestamp, &timeinfo);
+            memcpy(buffer, cache.prefix, MINUTE_LENGTH + 1);
+            writeTwoDigits(buffer + MINUTE_LENGTH + 1, timeinfo.tm_sec);
+            buffer[DATETIME_LENGTH] = '\0';
+            return DATETIME_LENGTH;
+        }
+    }
+
+    memcpy(buffer, cache.prefix, MINUTE_LENGTH + 1);
+    writeTwoDigits(buffer + MINUTE_LENGTH + 1, static_cast<int>(timestamp - cache.minuteStart));
+    buffer[DATETIME_LENGTH] = '\0';
+    return DATETIME_LENGTH;
+}
+
+std::string TimeFormatter::dateTime(time_t timestamp) {
+    char buffer[BUFFER_SIZE];
+    size_t length = formatDateTime(timestamp, buffer);
+    return std::string(buffer, length);
+}
+
+void TimeFormatter::appendDateTime(time_t timestamp, std::string& out) {
+    char buffer[BUFFER_SIZE];
+    size_t length = formatDateTime(timestamp, buffer);
+    out.append(buffer, length);
+}
@@ -0,0 +1,160 @@
+#include "../include/TrendForecaster.h"
+#include <cmath>
+
+const size_t TrendForecaster::MAX_CROSSINGS;
+const size_t TrendForecaster::METRIC_COUNT;
+
+ForecastPolicy::ForecastPolicy()
+    : levelTimeConstantSec(60.0f), trendTimeConstantSec(300.0f), horizonSec(1800), warmupSec(300) {}
+
+TrendForecaster::TrendForecaster(const ForecastPolicy& forecastPolicy)
+    : policy(forecastPolicy), cachedInterval(0), cachedLevelFactor(0.0f), cachedTrendFactor(0.0f) {}
+
+void TrendForecaster::smooth(SensorModel& model, size_t metric, float value, float dt,
+                             float levelFactor, float trendFactor) {
+    const float level = model.level[metric];
+    const float expected = level + model.trend[metric] * dt;
+    const float updated = expected + levelFactor * (value - expected);
+    model.trend[metric] += trendFactor * ((updated - level) / dt - model.trend[metric]);
+    model.level[metric] = updated;
+}
+
+void TrendForecaster::evaluate(SensorModel& model, size_t metric, float value, float high, float low) const {
+    int8_t& predicted = model.predicted[metric];
+    if (value >= high || value <= low) {
+        // Ya cruzó: se encarga la alerta del umbral
+        predicted = 0;
+        return;
+    }
+
+    const float level = model.level[metric];
+    const float trend = model.trend[metric];
+    int direction = 0;
+    float seconds = 0.0f;
+    if (trend > 0.0f) {
+        direction = 1;
+        seconds = level < high ? (high - level) / trend : 0.0f;
+    } else if (trend < 0.0f) {
+        direction = -1;
+        seconds = level > low ? (low - level) / trend : 0.0f;
+    }
+
+    if (direction != 0 && seconds <= policy.horizonSec) {
+        predicted = static_cast<int8_t>(direction);
+    } else if (predicted != 0 && (direction != predicted || seconds > 2.0f * policy.horizonSec)) {
+        // Se retira sólo si el pronóstico se alejó con margen
+        predicted = 0;
+    }
+}
+
+bool TrendForecaster::describe(const SensorModel& model, size_t metric, float high, float low,
+                               ThresholdCrossing& crossing) const {
+    const int direction = model.predicted[metric];
+    if (direction == 0) {
+        return false;
+    }
+
+    const float level = model.level[metric];
+    const float trend = model.trend[metric];
+    float seconds = 0.0f;
+    if (direction * trend <= 0.0f) {
+        // Lectura desordenada con la pendiente en contra: el cruce sigue vigente hasta la próxima
+        seconds = static_cast<float>(policy.horizonSec);
+    } else if (direction > 0) {
+        seconds = level < high ? (high - level) / trend : 0.0f;
+    } else {
+        seconds = level > low ? (low - level) / trend : 0.0f;
+    }
+    crossing.metric = static_cast<AlertMetric>(metric);
+    crossing.direction = direction;
+    crossing.minutes = std::ceil(seconds / 60.0f);
+    return true;
+}
+
+size_t TrendForecaster::update(const ClimateReading& reading, const AlertThresholds& thresholds,
+                               ThresholdCrossing* crossings) {
+    const float values[METRIC_COUNT] = { reading.getTemperature(), reading.getHumidity() };
+    const time_t now = reading.getTimestamp();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<int, SensorModel>::iterator it = models.find(reading.getSensorId());
+    if (it == models.end()) {
+        SensorModel model;
+        model.firstTimestamp = now;
+        model.lastTimestamp = now;
+        for (size_t m = 0; m < METRIC_COUNT; ++m) {
+            model.level[m] = values[m];
+            model.trend[m] = 0.0f;
+            model.predicted[m] = 0;
+        }
+        models.insert(std::make_pair(reading.getSensorId(), model));
+        return 0;
+    }
+
+    SensorModel& model = it->second;
+    const float highs[METRIC_COUNT] = { thresholds.tempHigh, thresholds.humidityHigh };
+    const float lows[METRIC_COUNT] = { thresholds.tempLow, thresholds.humidityLow };
+    size_t count = 0;
+    if (now <= model.lastTimestamp) {
+        for (size_t m = 0; m < METRIC_COUNT; ++m) {
+            count += describe(model, m, highs[m], lows[m], crossings[count]) ? 1 : 0;
+        }
+        return count;
+    }
+
+    // Los sensores suelen informar a intervalo fijo: los factores se reusan
+    const time_t interval = now - model.lastTimestamp;
+    if (interval != cachedInterval) {
+        cachedInterval = interval;
+        cachedLevelFactor = 1.0f - std::exp(-static_cast<float>(interval) / policy.levelTimeConstantSec);
+        cachedTrendFactor = 1.0f - std::exp(-static_cast<float>(interval) / policy.trendTimeConstantSec);
+    }
+    const float dt = static_cast<float>(interval);
+    for (size_t m = 0; m < METRIC_COUNT; ++m) {
+        smooth(model, m, values[m], dt, cachedLevelFactor, cachedTrendFactor);
+    }
+    model.lastTimestamp = now;
+
+    if (policy.horizonSec <= 0 || now - model.firstTimestamp < policy.warmupSec) {
+        model.predicted[0] = 0;
+        model.predicted[1] = 0;
+        return 0;
+    }
+    for (size_t m = 0; m < METRIC_COUNT; ++m) {
+        evaluate(model, m, values[m], highs[m], lows[m]);
+        count += describe(model, m, highs[m], lows[m], crossings[count]) ? 1 : 0;
+    }
+    return count;
+}
+
+bool TrendForecaster::forecast(int sensorId, AlertMetric metric, int aheadSec, float& value) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unordered_map<int, SensorModel>::const_iterator it = models.find(sensorId);
+    if (it == models.end()) {
+        return false;
+    }
+    const size_t m = static_cast<size_t>(metric);
+    value = it->second.level[m] + it->second.trend[m] * static_cast<float>(aheadSec);
+    return true;
+}
+
+void TrendForecaster::setPolicy(const ForecastPolicy& forecastPolicy) {
+    std::lock_guard<std::mutex> lock(mutex);
+    policy = forecastPolicy;
+    cachedInterval = 0;
+}
+
+ForecastPolicy TrendForecaster::getPolicy() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return policy;
+}
+
+size_t TrendForecaster::getSensorCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return models.size();
+}
+
+void TrendForecaster::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    models.clear();
+}
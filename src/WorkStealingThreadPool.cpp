@@ -0,0 +1,121 @@
+#include "../include/WorkStealingThreadPool.h"
+
+namespace {
+
+// Pool e índice del trabajador que ejecuta el hilo actual (nullptr / 0 fuera del pool)
+thread_local WorkStealingThreadPool* currentPool = nullptr;
+thread_local size_t currentWorker = 0;
+
+} // namespace
+
+WorkStealingThreadPool::WorkStealingThreadPool(size_t threadCount)
+    : nextQueue(0), queuedTasks(0), activeTasks(0), stealCount(0), stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+
+    for (size_t i = 0; i < threadCount; ++i) {
+        queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.push_back(std::thread(&WorkStealingThreadPool::workerLoop, this, i));
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkStealingThreadPool::submit(Task task) {
+    size_t index = (currentPool == this) ? currentWorker : nextQueue++ % queues.size();
+
+    ++activeTasks;
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+
+    // El contador se publica bajo sleepMutex para no perder el aviso a un hilo que se duerme
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        ++queuedTasks;
+    }
+    wakeUp.notify_one();
+}
+
+bool WorkStealingThreadPool::popLocal(size_t index, Task& task) {
+    WorkerQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingThreadPool::steal(size_t thief, Task& task) {
+    for (size_t offset = 1; offset < queues.size(); ++offset) {
+        WorkerQueue& victim = *queues[(thief + offset) % queues.size()];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || victim.tasks.empty()) {
+            continue;
+        }
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        ++stealCount;
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingThreadPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentWorker = index;
+
+    while (true) {
+        Task task;
+        if (popLocal(index, task) || steal(index, task)) {
+            --queuedTasks;
+            task();
+
+            if (--activeTasks == 0) {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        if (stopping && queuedTasks == 0) {
+            return;
+        }
+        // Espera acotada: un robo con try_to_lock puede fallar aunque haya tareas
+        wakeUp.wait_for(lock, std::chrono::milliseconds(10),
+                        [this]() { return stopping.load() || queuedTasks.load() > 0; });
+    }
+}
+
+void WorkStealingThreadPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    idle.wait(lock, [this]() { return activeTasks.load() == 0; });
+}
+
+size_t WorkStealingThreadPool::getThreadCount() const {
+    return workers.size();
+}
+
+uint64_t WorkStealingThreadPool::getStealCount() const {
+    return stealCount.load();
+}
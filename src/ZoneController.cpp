@@ -0,0 +1,289 @@
+#include "../include/ZoneController.h"
+#include "../include/MetricsRegistry.h"
+#include "../include/Logger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/// Distancia en pasos que debe recorrer la salida del PID para mover el actuador
+const float OUTPUT_HYSTERESIS = 0.75f;
+
+void updateMax(std::atomic<uint64_t>& maximum, uint64_t value) {
+    uint64_t current = maximum.load();
+    while (value > current && !maximum.compare_exchange_weak(current, value)) {
+    }
+}
+
+} // namespace
+
+ZoneConfig::ZoneConfig()
+    : name("principal"), forecast(nullptr), temperatureSetpoint(22.0f), humiditySetpoint(45.0f),
+      mode(ControlMode::PID), temperatureDeadband(0.5f), humidityDeadband(2.0f),
+      maxOutput(10), maxStepPerIteration(2) {
+    // Sintonía por asignación de la constante de tiempo (lambda) para una
+    // sala de primer orden con constante de 10 minutos (5 para la humedad)
+    temperatureGains.kp = 2.0f;
+    temperatureGains.ki = 2.0f / 600.0f;
+    temperatureGains.kd = 0.0f;
+    humidityGains.kp = 1.0f;
+    humidityGains.ki = 1.0f / 300.0f;
+    humidityGains.kd = 0.0f;
+}
+
+ControlLoopConfig::ControlLoopConfig()
+    : period(1000), spin(200), timeScale(1.0) {}
+
+ZoneController::ZoneController(const ControlLoopConfig& config)
+    : loopConfig(config), running(false), iterationCount(0), overrunCount(0), jitterSumNanos(0),
+      jitterMaxNanos(0), iterationSumNanos(0), iterationMaxNanos(0),
+      iterationLatency(MetricsRegistry::instance().histogram(
+          "clima_auto_control_iteration_duration_seconds",
+          "Duración de una iteración del control automático: lectura, cálculo y comandos de todas las zonas")),
+      jitterLatency(MetricsRegistry::instance().histogram(
+          "clima_auto_control_jitter_seconds",
+          "Atraso del inicio de cada iteración del control automático respecto del instante planificado")) {
+    if (loopConfig.period.count() <= 0) {
+        loopConfig.period = std::chrono::milliseconds(1000);
+    }
+}
+
+ZoneController::~ZoneController() {
+    stop();
+}
+
+bool ZoneController::addZone(const ZoneConfig& config) {
+    if (config.forecast == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(zonesMutex);
+    for (const Zone& zone : zones) {
+        if (zone.config.name == config.name) {
+            return false;
+        }
+    }
+
+    Zone zone;
+    zone.config = config;
+    zone.temperature = Loop();
+    zone.humidity = Loop();
+    zone.last = ClimateSnapshot();
+    zone.commands = 0;
+    zone.commandFailures = 0;
+    zone.invalidReadings = 0;
+    zones.push_back(zone);
+    LOG_INFO("ZoneController", "Zona agregada", "zone", config.name,
+             "temp_setpoint", config.temperatureSetpoint, "humidity_setpoint", config.humiditySetpoint);
+    return true;
+}
+
+bool ZoneController::setSetpoints(const std::string& name, float temperature, float humidity) {
+    std::lock_guard<std::mutex> lock(zonesMutex);
+    for (Zone& zone : zones) {
+        if (zone.config.name == name) {
+            zone.config.temperatureSetpoint = temperature;
+            zone.config.humiditySetpoint = humidity;
+            LOG_INFO("ZoneController", "Setpoints actualizados", "zone", name,
+                     "temp_setpoint", temperature, "humidity_setpoint", humidity);
+            return true;
+        }
+    }
+    return false;
+}
+
+int ZoneController::computeOutput(Loop& state, const PidGains& gains, ControlMode mode, float deadband,
+                                  float setpoint, float measurement, float dt, int maxOutput) {
+    if (!std::isfinite(measurement)) {
+        return state.output;
+    }
+    const float error = setpoint - measurement;
+    if (mode == ControlMode::BANG_BANG) {
+        // Dentro de la banda muerta se mantiene el último sentido
+        if (error > deadband) {
+            state.bangBangDirection = 1;
+        } else if (error < -deadband) {
+            state.bangBangDirection = -1;
+        }
+        return state.bangBangDirection * maxOutput;
+    }
+
+    const float derivative = state.primed && dt > 0.0f ? (measurement - state.lastMeasurement) / dt : 0.0f;
+    state.lastMeasurement = measurement;
+    state.primed = true;
+
+    const float proportional = gains.kp * error - gains.kd * derivative;
+    const float integral = state.integral + error * dt;
+    float output = proportional + gains.ki * integral;
+    const float limit = static_cast<float>(maxOutput);
+    if ((output > limit && error > 0.0f) || (output < -limit && error < 0.0f)) {
+        // Saturado en el sentido del error: integrar sólo agrandaría el sobrepaso
+        output = proportional + gains.ki * state.integral;
+    } else if (std::isfinite(integral)) {
+        state.integral = integral;
+    }
+    output = std::max(-limit, std::min(limit, output));
+
+    // Los comandos son enteros: sin histéresis, una salida cerca de la mitad
+    // entre dos pasos haría oscilar el actuador en cada iteración
+    if (std::fabs(output - static_cast<float>(state.output)) < OUTPUT_HYSTERESIS) {
+        return state.output;
+    }
+    return static_cast<int>(std::lround(output));
+}
+
+bool ZoneController::actuate(Zone& zone, Loop& state, int target, bool temperature) {
+    const int maxStep = std::max(1, zone.config.maxStepPerIteration);
+    const int delta = std::max(-maxStep, std::min(maxStep, target - state.output));
+    if (delta == 0) {
+        return true;
+    }
+
+    IMSForecast* forecast = zone.config.forecast;
+    bool accepted;
+    if (temperature) {
+        accepted = delta > 0 ? forecast->upTemp(delta) : forecast->downTemp(-delta);
+    } else {
+        accepted = delta > 0 ? forecast->upHumidity(delta) : forecast->downHumidity(-delta);
+    }
+    if (!accepted) {
+        ++zone.commandFailures;
+        return false;
+    }
+    state.output += delta;
+    ++zone.commands;
+    return true;
+}
+
+void ZoneController::runOnce(float dtSeconds) {
+    std::lock_guard<std::mutex> lock(zonesMutex);
+    for (Zone& zone : zones) {
+        const ZoneConfig& config = zone.config;
+        const ClimateSnapshot snapshot = config.forecast->readSnapshot();
+
+        // Una lectura fallida (NaN) no actualiza el lazo ni mueve el actuador:
+        // la integral quedaría en NaN y la salida saturada para siempre
+        if (std::isfinite(snapshot.temperature)) {
+            zone.last.temperature = snapshot.temperature;
+            const int target = computeOutput(zone.temperature, config.temperatureGains, config.mode,
+                                             config.temperatureDeadband, config.temperatureSetpoint,
+                                             snapshot.temperature, dtSeconds, config.maxOutput);
+            if (!actuate(zone, zone.temperature, target, true)) {
+                LOG_WARN("ZoneController", "La API rechazó el comando de temperatura", "zone", config.name);
+            }
+        } else {
+            ++zone.invalidReadings;
+            LOG_WARN("ZoneController", "Temperatura inválida, se omite la iteración", "zone", config.name);
+        }
+
+        if (std::isfinite(snapshot.humidity)) {
+            zone.last.humidity = snapshot.humidity;
+            const int target = computeOutput(zone.humidity, config.humidityGains, config.mode,
+                                             config.humidityDeadband, config.humiditySetpoint,
+                                             snapshot.humidity, dtSeconds, config.maxOutput);
+            if (!actuate(zone, zone.humidity, target, false)) {
+                LOG_WARN("ZoneController", "La API rechazó el comando de humedad", "zone", config.name);
+            }
+        } else {
+            ++zone.invalidReadings;
+            LOG_WARN("ZoneController", "Humedad inválida, se omite la iteración", "zone", config.name);
+        }
+        zone.last.sensorId = snapshot.sensorId;
+        zone.last.timestamp = snapshot.timestamp;
+    }
+}
+
+void ZoneController::start() {
+    if (running.exchange(true)) {
+        return;
+    }
+    worker = std::thread(&ZoneController::loop, this);
+    LOG_INFO("ZoneController", "Control automático iniciado",
+             "period_ms", static_cast<long long>(loopConfig.period.count()));
+}
+
+void ZoneController::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    worker.join();
+    LOG_INFO("ZoneController", "Control automático detenido", "iterations", iterationCount.load(),
+             "overruns", overrunCount.load());
+}
+
+bool ZoneController::isRunning() const {
+    return running.load();
+}
+
+void ZoneController::loop() {
+    typedef std::chrono::steady_clock Clock;
+    const Clock::duration period = loopConfig.period;
+    const float dt = static_cast<float>(std::chrono::duration<double>(period).count() * loopConfig.timeScale);
+    Clock::time_point next = Clock::now();
+
+    while (running.load()) {
+        // Dormir hasta poco antes del instante planificado y esperar el resto activamente
+        const Clock::time_point wake = next - loopConfig.spin;
+        if (Clock::now() < wake) {
+            std::this_thread::sleep_until(wake);
+        }
+        while (Clock::now() < next) {
+        }
+
+        const Clock::time_point start = Clock::now();
+        runOnce(dt);
+        const Clock::time_point end = Clock::now();
+
+        const uint64_t jitter = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(start - next).count());
+        const uint64_t duration = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        jitterLatency.record(jitter);
+        iterationLatency.record(duration);
+        ++iterationCount;
+        jitterSumNanos += jitter;
+        iterationSumNanos += duration;
+        updateMax(jitterMaxNanos, jitter);
+        updateMax(iterationMaxNanos, duration);
+
+        // Reloj absoluto: un atraso no corre las iteraciones siguientes, y
+        // los períodos que ya pasaron se omiten en lugar de encadenarse
+        next += period;
+        if (end > next) {
+            const Clock::duration::rep missed = (end - next) / period + 1;
+            overrunCount += static_cast<uint64_t>(missed);
+            next += period * missed;
+        }
+    }
+}
+
+std::vector<ZoneStatus> ZoneController::getZoneStatus() const {
+    std::vector<ZoneStatus> result;
+    std::lock_guard<std::mutex> lock(zonesMutex);
+    result.reserve(zones.size());
+    for (const Zone& zone : zones) {
+        ZoneStatus status;
+        status.name = zone.config.name;
+        status.temperature = zone.last.temperature;
+        status.humidity = zone.last.humidity;
+        status.temperatureSetpoint = zone.config.temperatureSetpoint;
+        status.humiditySetpoint = zone.config.humiditySetpoint;
+        status.temperatureOutput = zone.temperature.output;
+        status.humidityOutput = zone.humidity.output;
+        status.commands = zone.commands;
+        status.commandFailures = zone.commandFailures;
+        status.invalidReadings = zone.invalidReadings;
+        result.push_back(status);
+    }
+    return result;
+}
+
+ControlLoopStats ZoneController::getStats() const {
+    ControlLoopStats stats;
+    stats.iterations = iterationCount.load();
+    stats.overruns = overrunCount.load();
+    stats.meanJitterUs = stats.iterations ? jitterSumNanos.load() / 1000.0 / stats.iterations : 0.0;
+    stats.maxJitterUs = jitterMaxNanos.load() / 1000.0;
+    stats.meanIterationUs = stats.iterations ? iterationSumNanos.load() / 1000.0 / stats.iterations : 0.0;
+    stats.maxIterationUs = iterationMaxNanos.load() / 1000.0;
+    return stats;
+}
@@ -4,11 +4,18 @@
 #include <limits>
 #include <cstdlib>
 #include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <cmath>
 
 #include "../include/MSForecastMock.h"
+#include "../include/MSForecastClient.h"
 #include "../include/ClimateDataManager.h"
 #include "../include/EmailService.h"
 #include "../include/ClimateControlService.h"
+#include "../include/InstrumentedForecast.h"
+#include "../include/MetricsExporter.h"
+#include "../include/TimeFormatter.h"
 
 void mostrarMenu() {
     std::cout << "\n=== SISTEMA DE CONTROL DE CLIMA - DATACENTER ===" << std::endl;
@@ -20,14 +27,17 @@ void mostrarMenu() {
     std::cout << "6. Ver estado actual" << std::endl;
     std::cout << "7. Configurar umbrales de alerta" << std::endl;
     std::cout << "8. Ver configuración del sistema" << std::endl;
+    std::cout << "9. Control automático (activar/desactivar)" << std::endl;
     std::cout << "0. Salir" << std::endl;
     std::cout << "Seleccione una opción: ";
 }
 
 void mostrarEstadoActual(ClimateControlService& service) {
     std::cout << "\n=== ESTADO ACTUAL DEL SISTEMA ===" << std::endl;
-    std::cout << "Temperatura actual: " << service.getCurrentTemperature() << "°C" << std::endl;
-    std::cout << "Humedad actual: " << service.getCurrentHumidity() << "%" << std::endl;
+    // Temperatura y humedad del mismo instante, desde la caché de mediciones si está vigente
+    ClimateSnapshot actual = service.getCurrentSnapshot();
+    std::cout << "Temperatura actual: " << actual.temperature << "°C" << std::endl;
+    std::cout << "Humedad actual: " << actual.humidity << "%" << std::endl;
     
     float tempHigh, tempLow, humidityHigh, humidityLow;
     service.getAlertThresholds(tempHigh, tempLow, humidityHigh, humidityLow);
@@ -35,6 +45,37 @@ void mostrarEstadoActual(ClimateControlService& service) {
     std::cout << "\nUmbrales de alerta:" << std::endl;
     std::cout << "  Temperatura: " << tempLow << "°C - " << tempHigh << "°C" << std::endl;
     std::cout << "  Humedad: " << humidityLow << "% - " << humidityHigh << "%" << std::endl;
+    
+    // Pronóstico según la tendencia de las últimas lecturas del sensor principal
+    const int horizonte = service.getForecastPolicy().horizonSec;
+    float temperaturaPronosticada, humedadPronosticada;
+    if (horizonte > 0 &&
+        service.forecastMetric(0, AlertMetric::TEMPERATURE, horizonte, temperaturaPronosticada) &&
+        service.forecastMetric(0, AlertMetric::HUMIDITY, horizonte, humedadPronosticada)) {
+        std::cout << "\nPronóstico a " << horizonte / 60 << " minutos: " << temperaturaPronosticada
+                  << "°C, " << humedadPronosticada << "%" << std::endl;
+    }
+    
+    // Estadísticas en streaming: no recorren el historial
+    const ReadingStatistics& estadisticas = service.getReadingStatistics();
+    time_t ahora = time(nullptr);
+    MetricStatistics temperatura = estadisticas.range(AlertMetric::TEMPERATURE, ahora - 24 * 3600, ahora);
+    MetricStatistics humedad = estadisticas.range(AlertMetric::HUMIDITY, ahora - 24 * 3600, ahora);
+    if (temperatura.count() == 0) {
+        return;
+    }
+    std::cout << "\nÚltimas 24 horas (" << temperatura.count() << " lecturas, "
+              << estadisticas.sensorIds().size() << " sensores):" << std::endl;
+    // Se formatea aparte para no cambiar la precisión de std::cout
+    std::ostringstream resumen;
+    resumen << std::fixed << std::setprecision(1);
+    resumen << "  Temperatura: media " << temperatura.mean() << "°C (desvío " << temperatura.stddev()
+            << "), p50 " << temperatura.quantile(0.5) << ", p95 " << temperatura.quantile(0.95)
+            << ", mín " << temperatura.min() << ", máx " << temperatura.max() << "\n";
+    resumen << "  Humedad: media " << humedad.mean() << "% (desvío " << humedad.stddev()
+            << "), p50 " << humedad.quantile(0.5) << ", p95 " << humedad.quantile(0.95)
+            << ", mín " << humedad.min() << ", máx " << humedad.max();
+    std::cout << resumen.str() << std::endl;
 }
 
 void controlarTemperatura(ClimateControlService& service) {
@@ -101,42 +142,75 @@ void controlarHumedad(ClimateControlService& service) {
     }
 }
 
-void verLecturasHistoricas(ClimateControlService& service) {
-    std::cout << "\n=== LECTURAS HISTÓRICAS ===" << std::endl;
-    
-    std::vector<ClimateReading> lecturas = service.getAllReadings();
+void mostrarResumenAgregado(ClimateControlService& service) {
+    time_t ahora = time(nullptr);
+    RollupTier nivel;
+    std::vector<RollupBucket> resumen = service.getReadingSummary(ahora - 24 * 3600, ahora, 48, nivel);
     
-    if (lecturas.empty()) {
-        std::cout << "No hay lecturas registradas" << std::endl;
+    if (resumen.empty()) {
         return;
     }
     
-    std::cout << "Total de lecturas: " << lecturas.size() << std::endl;
-    std::cout << "\nÚltimas lecturas:" << std::endl;
+    std::cout << "\nResumen de las últimas 24 horas (por " << ReadingRollups::tierName(nivel) << "):" << std::endl;
     std::cout << "----------------------------------------" << std::endl;
     
-    for (const auto& lectura : lecturas) {
-        std::cout << lectura.toString() << std::endl;
+    for (const auto& bucket : resumen) {
+        char fecha[TimeFormatter::BUFFER_SIZE];
+        TimeFormatter::formatDateTime(bucket.start, fecha);
+        fecha[TimeFormatter::MINUTE_LENGTH] = '\0';
+        // Se formatea aparte para no cambiar la precisión de std::cout
+        std::ostringstream linea;
+        linea << fecha
+              << " | Lecturas: " << bucket.count
+              << std::fixed << std::setprecision(1)
+              << " | Temp: " << bucket.minTemperature << "/" << bucket.meanTemperature()
+              << "/" << bucket.maxTemperature << "°C"
+              << " | Hum: " << bucket.minHumidity << "/" << bucket.meanHumidity()
+              << "/" << bucket.maxHumidity << "%";
+        std::cout << linea.str() << std::endl;
     }
+    std::cout << "(mín/media/máx)" << std::endl;
 }
 
-void verAlertasHistoricas(ClimateControlService& service) {
-    std::cout << "\n=== ALERTAS HISTÓRICAS ===" << std::endl;
+void verLecturasHistoricas(ClimateControlService& service) {
+    std::cout << "\n=== LECTURAS HISTÓRICAS ===" << std::endl;
     
-    std::vector<Alert> alertas = service.getAllAlerts();
+    mostrarResumenAgregado(service);
     
-    if (alertas.empty()) {
-        std::cout << "No hay alertas registradas" << std::endl;
+    std::cout << "\nÚltimas lecturas:" << std::endl;
+    std::cout << "----------------------------------------" << std::endl;
+    
+    // Se recorre en streaming: la memoria no crece con el historial
+    size_t total = service.forEachReading([](const ClimateReading& lectura) {
+        std::cout << lectura.toString() << std::endl;
+        return true;
+    });
+    
+    if (total == 0) {
+        std::cout << "No hay lecturas registradas" << std::endl;
         return;
     }
     
-    std::cout << "Total de alertas: " << alertas.size() << std::endl;
+    std::cout << "Total de lecturas: " << total << std::endl;
+}
+
+void verAlertasHistoricas(ClimateControlService& service) {
+    std::cout << "\n=== ALERTAS HISTÓRICAS ===" << std::endl;
+    
     std::cout << "\nÚltimas alertas:" << std::endl;
     std::cout << "----------------------------------------" << std::endl;
     
-    for (const auto& alerta : alertas) {
+    size_t total = service.forEachAlert([](const Alert& alerta) {
         std::cout << alerta.toString() << std::endl;
+        return true;
+    });
+    
+    if (total == 0) {
+        std::cout << "No hay alertas registradas" << std::endl;
+        return;
     }
+    
+    std::cout << "Total de alertas: " << total << std::endl;
 }
 
 void configurarUmbrales(ClimateControlService& service) {
@@ -172,11 +246,64 @@ void configurarUmbrales(ClimateControlService& service) {
         return;
     }
     
+    // Comparar contra el historial de los últimos 30 días antes de aplicar
+    time_t ahora = time(nullptr);
+    time_t desde = ahora - 30 * 24 * 3600;
+    AlertThresholds candidatos = service.getAlertThresholds();
+    ReplayResult actual = service.replayThresholds(candidatos, desde, ahora);
+    candidatos.tempHigh = tempHigh;
+    candidatos.tempLow = tempLow;
+    candidatos.humidityHigh = humidityHigh;
+    candidatos.humidityLow = humidityLow;
+    ReplayResult simulado = service.replayThresholds(candidatos, desde, ahora);
+    
+    std::cout << "\nSimulación sobre los últimos 30 días (" << simulado.readings << " lecturas):" << std::endl;
+    std::cout << "  Lecturas fuera de rango: " << actual.readingsOutOfRange << " -> "
+              << simulado.readingsOutOfRange << std::endl;
+    std::cout << "  Alertas notificadas: " << actual.notifications << " -> "
+              << simulado.notifications << std::endl;
+    
     service.setAlertThresholds(tempHigh, tempLow, humidityHigh, humidityLow);
     std::cout << "Umbrales configurados exitosamente" << std::endl;
 }
 
-void verConfiguracionSistema(ClimateControlService& service) {
+void alternarControlAutomatico(ClimateControlService& service) {
+    std::cout << "\n=== CONTROL AUTOMÁTICO ===" << std::endl;
+    
+    ZoneController* controlador = service.getZoneController();
+    if (controlador) {
+        ControlLoopStats stats = controlador->getStats();
+        for (const ZoneStatus& zona : controlador->getZoneStatus()) {
+            std::cout << "Zona " << zona.name << ": " << zona.temperature << "°C (setpoint "
+                      << zona.temperatureSetpoint << "), " << zona.humidity << "% (setpoint "
+                      << zona.humiditySetpoint << "), " << zona.commands << " comandos" << std::endl;
+        }
+        std::cout << "Iteraciones: " << stats.iterations << ", períodos perdidos: " << stats.overruns
+                  << ", jitter medio " << stats.meanJitterUs << " us (máx " << stats.maxJitterUs
+                  << " us), iteración media " << stats.meanIterationUs << " us" << std::endl;
+        service.disableAutomaticControl();
+        std::cout << "Control automático desactivado" << std::endl;
+        return;
+    }
+    
+    float temperatura, humedad;
+    std::cout << "Temperatura deseada (°C): ";
+    std::cin >> temperatura;
+    std::cout << "Humedad deseada (%): ";
+    std::cin >> humedad;
+    
+    if (std::cin.fail()) {
+        std::cout << "Valores inválidos" << std::endl;
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        return;
+    }
+    
+    service.enableAutomaticControl(temperatura, humedad);
+    std::cout << "Control automático activado (1 Hz); el control manual queda deshabilitado" << std::endl;
+}
+
+void verConfiguracionSistema(ClimateControlService& service, const std::string& api) {
     std::cout << "\n=== CONFIGURACIÓN DEL SISTEMA ===" << std::endl;
     
     std::cout << "Estado del sistema: " << (service.isSystemHealthy() ? "SALUDABLE" : "ERROR") << std::endl;
@@ -185,11 +312,50 @@ void verConfiguracionSistema(ClimateControlService& service) {
     service.getAlertThresholds(tempHigh, tempLow, humidityHigh, humidityLow);
     
     std::cout << "\nConfiguración actual:" << std::endl;
-    std::cout << "  API MS-Forecast: Mock (simulado)" << std::endl;
-    std::cout << "  Base de datos: SQLite (simulado)" << std::endl;
+    std::cout << "  API MS-Forecast: " << api << std::endl;
+    std::cout << "  Base de datos: SQLite (modo WAL)" << std::endl;
     std::cout << "  Servicio de email: Configurado (simulado)" << std::endl;
+    std::cout << "  Métricas: output/metrics.prom y http://127.0.0.1:9464/metrics" << std::endl;
     std::cout << "  Umbrales de temperatura: " << tempLow << "°C - " << tempHigh << "°C" << std::endl;
     std::cout << "  Umbrales de humedad: " << humidityLow << "% - " << humidityHigh << "%" << std::endl;
+    
+    AlertPolicy policy = service.getAlertPolicy();
+    AlertTrackerStats alertStats = service.getAlertStats();
+    std::cout << "  Histéresis de alertas: " << policy.temperatureHysteresis << "°C / "
+              << policy.humidityHysteresis << "%" << std::endl;
+    std::cout << "  Recordatorio de alertas activas: cada " << policy.renotifyIntervalSec << " s" << std::endl;
+    std::cout << "  Límite de notificaciones: " << policy.notificationsPerMinute << "/min (ráfaga "
+              << policy.notificationBurst << ")" << std::endl;
+    std::cout << "  Alertas notificadas: " << alertStats.raised + alertStats.escalated + alertStats.renotified + alertStats.cleared
+              << ", suprimidas: " << alertStats.suppressed << ", limitadas: " << alertStats.rateLimited << std::endl;
+}
+
+/**
+ * @brief Crea la API MS-Forecast
+ *
+ * Con la variable de entorno CLIMA_MSFORECAST=host:puerto se usa el
+ * cliente de red; sin ella, el mock.
+ * @param api Descripción para la pantalla de configuración (salida)
+ * @return API creada
+ */
+IMSForecast* crearForecast(std::string& api) {
+    const char* address = std::getenv("CLIMA_MSFORECAST");
+    const std::string value = address ? address : "";
+    const size_t colon = value.rfind(':');
+    if (colon != std::string::npos && colon > 0) {
+        ForecastClientConfig config;
+        config.host = value.substr(0, colon);
+        config.port = static_cast<uint16_t>(std::atoi(value.c_str() + colon + 1));
+        if (config.port != 0) {
+            api = "Red (" + value + ", pool de " + std::to_string(config.poolSize) + " conexiones)";
+            return new MSForecastClient(config);
+        }
+    }
+    if (!value.empty()) {
+        std::cout << "CLIMA_MSFORECAST inválida (se espera host:puerto), se usa el mock" << std::endl;
+    }
+    api = "Mock (simulado)";
+    return new MSForecastMock();
 }
 
 int main() {
@@ -197,12 +363,21 @@ int main() {
     std::cout << "Inicializando componentes..." << std::endl;
     
     // Crear instancias de los componentes
-    MSForecastMock* forecast = new MSForecastMock();
+    std::string api;
+    IMSForecast* forecast = crearForecast(api);
+    InstrumentedForecast* measuredForecast = new InstrumentedForecast(forecast);
     ClimateDataManager* dataManager = new ClimateDataManager();
     EmailService* emailService = new EmailService();
+    emailService->startAsync(2, 256, EmailOverflowPolicy::DROP_LOWEST_SEVERITY);
+    
+    // Exportar las métricas de latencia para Prometheus
+    MetricsExporter metricsExporter;
+    metricsExporter.startFileExport("output/metrics.prom", 10000);
+    metricsExporter.startHttpServer(9464);
     
     // Crear el servicio principal
-    ClimateControlService service(forecast, dataManager, emailService);
+    ClimateControlService service(measuredForecast, dataManager, emailService);
+    service.enableIngestPipeline();
     
     std::cout << "Sistema inicializado correctamente" << std::endl;
     
@@ -229,7 +404,11 @@ int main() {
             case 1:
                 {
                     ClimateReading lectura = service.takeReading();
-                    std::cout << "Lectura tomada: " << lectura.toString() << std::endl;
+                    if (std::isfinite(lectura.getTemperature()) && std::isfinite(lectura.getHumidity())) {
+                        std::cout << "Lectura tomada: " << lectura.toString() << std::endl;
+                    } else {
+                        std::cout << "No se pudo tomar la lectura: la API MS-Forecast no respondió" << std::endl;
+                    }
                 }
                 break;
                 
@@ -258,7 +437,11 @@ int main() {
                 break;
                 
             case 8:
-                verConfiguracionSistema(service);
+                verConfiguracionSistema(service, api);
+                break;
+                
+            case 9:
+                alternarControlAutomatico(service);
                 break;
                 
             default:
@@ -267,7 +450,13 @@ int main() {
         }
     }
     
+    // Detener el control automático y vaciar el pipeline antes de liberar los componentes que utilizan
+    service.disableAutomaticControl();
+    service.disableIngestPipeline();
+    
     // Limpieza de memoria
+    metricsExporter.stop();
+    delete measuredForecast;
     delete forecast;
     delete dataManager;
     delete emailService;